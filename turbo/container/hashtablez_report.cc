@@ -0,0 +1,239 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/container/hashtablez_report.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "turbo/base/bits.h"
+#include "turbo/container/flat_hash_map.h"
+#include "turbo/container/internal/hashtablez_sampler.h"
+#include "turbo/debugging/symbolize.h"
+#include "turbo/flags/flag.h"
+#include "turbo/flags/marshalling.h"
+#include "turbo/log/turbo_log.h"
+#include "turbo/profiling/internal/log2_histogram.h"
+#include "turbo/strings/str_format.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/time/clock.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+using container_internal::HashtablezInfo;
+
+// Below this many elements, hash bits are likely to be equal in all elements
+// by chance.
+constexpr size_t kMinSizeForConstantHashBits = 32;
+
+// The statistics of a single table, copied while the sampler is walked.
+struct TableStats {
+  size_t weight;
+  size_t size;
+  size_t capacity;
+  size_t erases_since_rehash;
+  size_t total_probe_length;
+  size_t max_probe_length;
+  size_t constant_hash_bits;
+  size_t slot_size;
+  std::vector<void*> stack;
+};
+
+TURBO_CONST_INIT turbo::Mutex report_dumper_mu(turbo::kConstInit);
+bool report_dumper_running TURBO_GUARDED_BY(report_dumper_mu) = false;
+
+turbo::Duration ReportInterval() {
+  return turbo::GetFlag(FLAGS_hashtablez_report_interval);
+}
+
+// Logs a report every `--hashtablez_report_interval` until the flag is reset.
+void DumpReports() {
+  while (true) {
+    const turbo::Duration interval = ReportInterval();
+    if (interval <= turbo::ZeroDuration()) {
+      // The flag may have been set again since it was read; its update
+      // callback does not start another thread while this one runs.
+      turbo::MutexLock lock(&report_dumper_mu);
+      if (ReportInterval() <= turbo::ZeroDuration()) {
+        report_dumper_running = false;
+        return;
+      }
+      continue;
+    }
+    turbo::SleepFor(interval);
+    if (ReportInterval() > turbo::ZeroDuration()) {
+      TURBO_LOG(INFO) << "hashtablez report:\n"
+                      << GetHashtablezReport().ToString();
+    }
+  }
+}
+
+void StartReportDumper() {
+  turbo::MutexLock lock(&report_dumper_mu);
+  if (report_dumper_running) return;
+  report_dumper_running = true;
+  std::thread(DumpReports).detach();
+}
+
+}  // namespace
+
+std::string HashtablezReport::ToString() const {
+  std::string out;
+  turbo::StrAppendFormat(
+      &out,
+      "sampled tables: %u (estimated %u)\nsize: %u\ncapacity: %u\n"
+      "load factor: %.3f\naverage probe length: %.3f\n"
+      "erases since rehash: %u (at most %.1f%% tombstones)\n"
+      "wasted bytes: %u\n",
+      tables, estimated_tables, size, capacity, load_factor(),
+      average_probe_length(), erases_since_rehash,
+      100 * max_tombstone_ratio(), wasted_bytes);
+  profiling_internal::AppendLog2Histogram("tables by max probe length",
+                                          max_probe_length_histogram, &out);
+  profiling_internal::AppendLog2Histogram("tables by average probe length",
+                                          average_probe_length_histogram, &out);
+  if (!sites.empty()) {
+    // Symbolize the stacks of all sites at once.
+    std::vector<void*> pcs;
+    for (const Site& site : sites) {
+      pcs.insert(pcs.end(), site.stack.begin(), site.stack.end());
+    }
+    const std::vector<std::string> symbols = turbo::SymbolizeMany(pcs);
+    size_t next_symbol = 0;
+    out += "sites by wasted bytes:\n";
+    for (const Site& site : sites) {
+      turbo::StrAppendFormat(
+          &out,
+          "  tables=%u (estimated %u) size=%u capacity=%u slot=%u "
+          "load=%.3f avg_probe=%.3f max_probe=%u erases=%u "
+          "constant_hash_bits=%u wasted=%u\n",
+          site.tables, site.estimated_tables, site.size, site.capacity,
+          site.slot_size, site.load_factor(), site.average_probe_length(),
+          site.max_probe_length, site.erases_since_rehash,
+          site.constant_hash_bits, site.wasted_bytes);
+      for (void* pc : site.stack) {
+        const std::string& symbol = symbols[next_symbol++];
+        if (symbol.empty()) {
+          turbo::StrAppendFormat(&out, "    @ %p\n", pc);
+        } else {
+          turbo::StrAppendFormat(&out, "    @ %p %s\n", pc, symbol);
+        }
+      }
+    }
+  }
+  return out;
+}
+
+HashtablezReport GetHashtablezReport(size_t max_sites) {
+  // Copy the statistics out first: the callback runs with the sample locked,
+  // and grouping may allocate (and sample) a hash table.
+  std::vector<TableStats> tables;
+  container_internal::GlobalHashtablezSampler().Iterate(
+      [&tables](const HashtablezInfo& info) {
+        TableStats stats;
+        stats.weight = static_cast<size_t>(std::max<int64_t>(info.weight, 1));
+        stats.size = info.size.load(std::memory_order_relaxed);
+        stats.capacity = info.capacity.load(std::memory_order_relaxed);
+        stats.erases_since_rehash =
+            info.num_erases.load(std::memory_order_relaxed);
+        stats.total_probe_length =
+            info.total_probe_length.load(std::memory_order_relaxed);
+        stats.max_probe_length =
+            info.max_probe_length.load(std::memory_order_relaxed);
+        stats.constant_hash_bits = 0;
+        if (stats.size >= kMinSizeForConstantHashBits) {
+          // A bit is constant if it is the same in the OR and the AND of all
+          // hashes.
+          const size_t varying =
+              info.hashes_bitwise_or.load(std::memory_order_relaxed) ^
+              info.hashes_bitwise_and.load(std::memory_order_relaxed);
+          stats.constant_hash_bits =
+              static_cast<size_t>(turbo::popcount(~varying));
+        }
+        stats.slot_size = info.inline_element_size;
+        stats.stack.assign(info.stack, info.stack + info.depth);
+        tables.push_back(std::move(stats));
+      });
+
+  HashtablezReport report;
+  turbo::flat_hash_map<std::vector<void*>, size_t> site_index;
+  for (TableStats& stats : tables) {
+    const size_t wasted =
+        (stats.capacity - std::min(stats.size, stats.capacity)) *
+        stats.slot_size;
+    report.tables++;
+    report.estimated_tables += stats.weight;
+    report.size += stats.size;
+    report.capacity += stats.capacity;
+    report.erases_since_rehash += stats.erases_since_rehash;
+    report.total_probe_length += stats.total_probe_length;
+    report.wasted_bytes += wasted;
+    report.max_probe_length_histogram[profiling_internal::Log2Bucket(
+        static_cast<double>(stats.max_probe_length),
+        HashtablezReport::kHistogramBuckets)]++;
+    report.average_probe_length_histogram[profiling_internal::Log2Bucket(
+        stats.size == 0 ? 0.0
+                        : static_cast<double>(stats.total_probe_length) /
+                              stats.size,
+        HashtablezReport::kHistogramBuckets)]++;
+
+    auto inserted = site_index.emplace(stats.stack, report.sites.size());
+    if (inserted.second) {
+      report.sites.emplace_back();
+      report.sites.back().stack = std::move(stats.stack);
+      report.sites.back().slot_size = stats.slot_size;
+    }
+    HashtablezReport::Site& site = report.sites[inserted.first->second];
+    site.tables++;
+    site.estimated_tables += stats.weight;
+    site.size += stats.size;
+    site.capacity += stats.capacity;
+    site.erases_since_rehash += stats.erases_since_rehash;
+    site.total_probe_length += stats.total_probe_length;
+    site.wasted_bytes += wasted;
+    site.max_probe_length =
+        std::max(site.max_probe_length, stats.max_probe_length);
+    site.constant_hash_bits =
+        std::max(site.constant_hash_bits, stats.constant_hash_bits);
+  }
+
+  auto more_wasteful = [](const HashtablezReport::Site& a,
+                          const HashtablezReport::Site& b) {
+    if (a.wasted_bytes != b.wasted_bytes) return a.wasted_bytes > b.wasted_bytes;
+    return a.capacity > b.capacity;
+  };
+  const size_t kept = std::min(max_sites, report.sites.size());
+  std::partial_sort(report.sites.begin(), report.sites.begin() + kept,
+                    report.sites.end(), more_wasteful);
+  report.sites.resize(kept);
+  return report;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+TURBO_FLAG(turbo::Duration, hashtablez_report_interval, turbo::ZeroDuration(),
+           "If positive, enables hashtablez sampling and logs a report of the "
+           "sampled hash tables at this interval.")
+    .OnUpdate([] {
+      if (turbo::GetFlag(FLAGS_hashtablez_report_interval) <=
+          turbo::ZeroDuration()) {
+        return;
+      }
+      turbo::container_internal::SetHashtablezEnabled(true);
+      turbo::StartReportDumper();
+    });
@@ -0,0 +1,163 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: hashtablez_report.h
+// -----------------------------------------------------------------------------
+//
+// This file exports aggregated statistics over the Swiss tables currently
+// sampled by hashtablez, the hash table sampling profiler. Sampled tables are
+// grouped by the stack trace which created them, so that poorly hashed tables
+// (long probe sequences, hash bits which never change) and oversized tables
+// (low load factor, many erased elements) can be traced back to the code
+// owning them.
+//
+// Example:
+//
+//   turbo::HashtablezReport report = turbo::GetHashtablezReport();
+//   for (const auto& site : report.sites) {
+//     if (site.average_probe_length() > 2) {
+//       TURBO_LOG(WARNING) << "Poorly hashed table:\n" << report.ToString();
+//     }
+//   }
+//
+// The report can also be logged periodically by setting the
+// `--hashtablez_report_interval` flag to a positive duration, which also
+// enables hashtablez sampling.
+//
+// All values are empty unless hashtablez is compiled in, see
+// `TURBO_INTERNAL_HASHTABLEZ_SAMPLE`, and enabled.
+
+#ifndef TURBO_CONTAINER_HASHTABLEZ_REPORT_H_
+#define TURBO_CONTAINER_HASHTABLEZ_REPORT_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "turbo/flags/declare.h"
+#include "turbo/platform/port.h"
+#include "turbo/time/time.h"
+
+TURBO_DECLARE_FLAG(turbo::Duration, hashtablez_report_interval);
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// HashtablezReport
+//
+// Aggregated statistics over a set of sampled hash tables. Counts of tables
+// are those of sampled tables; `estimated_tables` scales them by the sampling
+// rate.
+struct HashtablezReport {
+  // Histograms use power of two buckets: bucket `i` counts values in
+  // [2^i, 2^(i+1)), bucket 0 also counts zero.
+  static constexpr size_t kHistogramBuckets = 16;
+  using Histogram = std::array<size_t, kHistogramBuckets>;
+
+  // Statistics of the sampled tables created by the same stack trace.
+  struct Site {
+    size_t tables = 0;
+    size_t estimated_tables = 0;
+    // Sums over the tables of the site.
+    size_t size = 0;
+    size_t capacity = 0;
+    size_t erases_since_rehash = 0;
+    size_t total_probe_length = 0;
+    size_t wasted_bytes = 0;
+    // The longest probe sequence of any insertion into a table of the site.
+    size_t max_probe_length = 0;
+    // The largest number of hash bits which had the same value for every
+    // element of a table. Only tables with enough elements for this to be
+    // meaningful are considered, so a non-zero value is a sign of a weak hash.
+    size_t constant_hash_bits = 0;
+    // Size of a slot of the tables.
+    size_t slot_size = 0;
+    // Stack of the call which created the tables.
+    std::vector<void*> stack;
+
+    double load_factor() const {
+      return capacity == 0 ? 0.0 : static_cast<double>(size) / capacity;
+    }
+
+    // Average number of probes past the ideal group per insertion.
+    double average_probe_length() const {
+      return size == 0 ? 0.0 : static_cast<double>(total_probe_length) / size;
+    }
+
+    // See `HashtablezReport::max_tombstone_ratio()`.
+    double max_tombstone_ratio() const {
+      return size + erases_since_rehash == 0
+                 ? 0.0
+                 : static_cast<double>(erases_since_rehash) /
+                       (size + erases_since_rehash);
+    }
+  };
+
+  // Number of sampled tables and their accumulated statistics.
+  size_t tables = 0;
+  size_t estimated_tables = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+  // Number of erases since the tables were last rehashed. This is an upper
+  // bound on their tombstones, not a count of them: an erase leaves its slot
+  // empty when no probe sequence can have gone through it, and an insert may
+  // reuse a tombstone.
+  size_t erases_since_rehash = 0;
+  size_t total_probe_length = 0;
+  // Bytes of slots not holding an element, `(capacity - size) * slot_size`.
+  size_t wasted_bytes = 0;
+
+  // Number of tables by maximum and by average probe length.
+  Histogram max_probe_length_histogram = {};
+  Histogram average_probe_length_histogram = {};
+
+  // The allocation sites wasting the most memory first.
+  std::vector<Site> sites;
+
+  double load_factor() const {
+    return capacity == 0 ? 0.0 : static_cast<double>(size) / capacity;
+  }
+
+  double average_probe_length() const {
+    return size == 0 ? 0.0 : static_cast<double>(total_probe_length) / size;
+  }
+
+  // An upper bound on the fraction of the occupied slots which are
+  // tombstones, from `erases_since_rehash`.
+  double max_tombstone_ratio() const {
+    return size + erases_since_rehash == 0
+               ? 0.0
+               : static_cast<double>(erases_since_rehash) /
+                     (size + erases_since_rehash);
+  }
+
+  // Returns a human readable multi-line summary of the report, with the
+  // stacks of the sites symbolized.
+  std::string ToString() const;
+};
+
+// GetHashtablezReport()
+//
+// Aggregates the statistics of all tables currently sampled by hashtablez. At
+// most `max_sites` entries are kept in `sites`.
+//
+// This walks every sampled table and should not be called on a hot path.
+HashtablezReport GetHashtablezReport(size_t max_sites = 20);
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_CONTAINER_HASHTABLEZ_REPORT_H_
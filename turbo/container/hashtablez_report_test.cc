@@ -0,0 +1,125 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/container/hashtablez_report.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/container/internal/hashtablez_sampler.h"
+
+namespace {
+
+using ::testing::HasSubstr;
+using turbo::container_internal::GlobalHashtablezSampler;
+using turbo::container_internal::HashtablezInfo;
+
+// Registers a table with the global sampler, attributed to the fake stack
+// `{site}` so that tests do not depend on the stack unwinder.
+HashtablezInfo* RegisterTable(uintptr_t site, int64_t weight, size_t slot_size,
+                              size_t size, size_t capacity) {
+  HashtablezInfo* info = GlobalHashtablezSampler().Register(weight, slot_size);
+  info->depth = 1;
+  info->stack[0] = reinterpret_cast<void*>(site);
+  turbo::container_internal::RecordStorageChangedSlow(info, size, capacity);
+  return info;
+}
+
+const turbo::HashtablezReport::Site* FindSite(
+    const turbo::HashtablezReport& report, uintptr_t site) {
+  for (const auto& s : report.sites) {
+    if (s.stack.size() == 1 && s.stack[0] == reinterpret_cast<void*>(site)) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+TEST(HashtablezReportTest, AggregatesBySite) {
+  constexpr uintptr_t kSiteA = 0x1000;
+  constexpr uintptr_t kSiteB = 0x2000;
+  std::vector<HashtablezInfo*> infos;
+  infos.push_back(RegisterTable(kSiteA, 10, 8, 10, 15));
+  infos.push_back(RegisterTable(kSiteA, 10, 8, 2, 63));
+  infos.push_back(RegisterTable(kSiteB, 5, 16, 7, 15));
+  turbo::container_internal::RecordInsertSlow(infos[2], 0x1234, 16);
+  turbo::container_internal::RecordInsertSlow(infos[2], 0x5678, 32);
+  turbo::container_internal::RecordEraseSlow(infos[2]);
+
+  const turbo::HashtablezReport report = turbo::GetHashtablezReport(100);
+  EXPECT_GE(report.tables, 3u);
+  EXPECT_GE(report.estimated_tables, 25u);
+
+  const auto* a = FindSite(report, kSiteA);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(2u, a->tables);
+  EXPECT_EQ(20u, a->estimated_tables);
+  EXPECT_EQ(12u, a->size);
+  EXPECT_EQ(78u, a->capacity);
+  EXPECT_EQ((5u + 61u) * 8, a->wasted_bytes);
+  EXPECT_DOUBLE_EQ(12.0 / 78, a->load_factor());
+
+  const auto* b = FindSite(report, kSiteB);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(1u, b->tables);
+  EXPECT_EQ(16u, b->slot_size);
+  // Probe lengths are recorded in groups of 8 or 16 slots.
+  EXPECT_GE(b->max_probe_length, 2u);
+  EXPECT_EQ(1u, b->erases_since_rehash);
+  EXPECT_GT(b->average_probe_length(), 0.0);
+  EXPECT_GT(b->max_tombstone_ratio(), 0.0);
+
+  // Sites are ordered by wasted bytes.
+  EXPECT_LT(a - report.sites.data(), b - report.sites.data());
+
+  const std::string text = report.ToString();
+  EXPECT_THAT(text, HasSubstr("sites by wasted bytes:\n"));
+  EXPECT_THAT(text, HasSubstr("tables by max probe length:\n"));
+  EXPECT_THAT(text, HasSubstr(" wasted=528\n"));
+
+  for (HashtablezInfo* info : infos) GlobalHashtablezSampler().Unregister(info);
+  EXPECT_EQ(nullptr, FindSite(turbo::GetHashtablezReport(100), kSiteA));
+}
+
+TEST(HashtablezReportTest, ConstantHashBits) {
+  constexpr uintptr_t kSite = 0x3000;
+  HashtablezInfo* info = RegisterTable(kSite, 1, 8, 0, 0);
+  // All hashes share their low 8 bits.
+  for (size_t i = 0; i < 64; ++i) {
+    turbo::container_internal::RecordInsertSlow(info, (i * 0x9E3779B97F4A7C15u)
+                                                          << 8,
+                                                0);
+  }
+  const turbo::HashtablezReport report = turbo::GetHashtablezReport(100);
+  const auto* site = FindSite(report, kSite);
+  ASSERT_NE(site, nullptr);
+  EXPECT_GE(site->constant_hash_bits, 8u);
+  EXPECT_LT(site->constant_hash_bits, 16u);
+  GlobalHashtablezSampler().Unregister(info);
+}
+
+TEST(HashtablezReportTest, MaxSites) {
+  std::vector<HashtablezInfo*> infos;
+  for (uintptr_t site = 1; site <= 5; ++site) {
+    infos.push_back(RegisterTable(site * 0x10000, 1, 8, 0, site * 16 - 1));
+  }
+  const turbo::HashtablezReport report = turbo::GetHashtablezReport(2);
+  EXPECT_EQ(2u, report.sites.size());
+  EXPECT_GE(report.tables, 5u);
+  for (HashtablezInfo* info : infos) GlobalHashtablezSampler().Unregister(info);
+}
+
+}  // namespace
@@ -209,6 +209,13 @@ CpuType GetCpuType() {
 
 bool SupportsArmCRC32PMULL() { return false; }
 
+bool SupportsX86AesNi() {
+  int cpu_info[4];
+  __cpuid(cpu_info, 1);
+  // AES-NI support is reported in bit 25 of ecx.
+  return (cpu_info[2] & (1 << 25)) != 0;
+}
+
 #elif defined(__aarch64__) && defined(__linux__)
 
 #ifndef HWCAP_CPUID
@@ -243,12 +250,16 @@ bool SupportsArmCRC32PMULL() {
   return (hwcaps & HWCAP_CRC32) && (hwcaps & HWCAP_PMULL);
 }
 
+bool SupportsX86AesNi() { return false; }
+
 #else
 
 CpuType GetCpuType() { return CpuType::kUnknown; }
 
 bool SupportsArmCRC32PMULL() { return false; }
 
+bool SupportsX86AesNi() { return false; }
+
 #endif
 
 }  // namespace crc_internal
@@ -50,6 +50,9 @@ CpuType GetCpuType();
 // tuning.
 bool SupportsArmCRC32PMULL();
 
+// Returns whether the host CPU supports the x86 AES-NI instructions.
+bool SupportsX86AesNi();
+
 }  // namespace crc_internal
 TURBO_NAMESPACE_END
 }  // namespace turbo
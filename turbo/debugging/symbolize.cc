@@ -41,3 +41,20 @@
 #else
 #include "turbo/debugging/symbolize_unimplemented.inc"
 #endif
+
+#if !defined(TURBO_INTERNAL_HAVE_ELF_SYMBOLIZE)
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+std::vector<std::string> SymbolizeMany(turbo::Span<void *const> pcs) {
+  std::vector<std::string> names(pcs.size());
+  char buf[1024];
+  for (size_t i = 0; i < pcs.size(); ++i) {
+    if (Symbolize(pcs[i], buf, sizeof(buf))) names[i] = buf;
+  }
+  return names;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+#endif  // !defined(TURBO_INTERNAL_HAVE_ELF_SYMBOLIZE)
@@ -52,7 +52,11 @@
 #ifndef TURBO_DEBUGGING_SYMBOLIZE_H_
 #define TURBO_DEBUGGING_SYMBOLIZE_H_
 
+#include <string>
+#include <vector>
+
 #include "turbo/debugging/internal/symbolize.h"
+#include "turbo/meta/span.h"
 
 namespace turbo {
 TURBO_NAMESPACE_BEGIN
@@ -93,6 +97,26 @@ void InitializeSymbolizer(const char* argv0);
 //  }
 bool Symbolize(const void *pc, char *out, int out_size);
 
+// SymbolizeMany()
+//
+// Symbolizes the program counters `pcs`, and returns their demangled names in
+// the same order, or empty strings for those which could not be symbolized.
+//
+// `SymbolizeMany()` is intended for symbolizing many stacks at once, such as
+// those of a profile. On ELF platforms it reads the symbol table of each
+// loaded object once, on the first lookup of one of its addresses, and keeps
+// it sorted by address, with the demangled names of the symbols looked up,
+// until the object is unloaded. Unlike `Symbolize()`, it allocates memory and
+// takes locks, and must not be called from signal handlers.
+//
+// Example:
+//
+//   void* stack[64];
+//   int depth = turbo::GetStackTrace(stack, 64, 0);
+//   std::vector<std::string> names =
+//       turbo::SymbolizeMany(turbo::MakeSpan(stack, depth));
+std::vector<std::string> SymbolizeMany(turbo::Span<void *const> pcs);
+
 TURBO_NAMESPACE_END
 }  // namespace turbo
 
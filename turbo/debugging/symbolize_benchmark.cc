@@ -0,0 +1,124 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <link.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/debugging/stacktrace.h"
+#include "turbo/debugging/symbolize.h"
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+static constexpr int kMaxStackDepth = 64;
+
+// Captures stacks of different depths, as a profile holds.
+TURBO_ATTRIBUTE_NOINLINE void Capture(int x, std::vector<void*>* pcs) {
+  if (x <= 0) {
+    void* stack[kMaxStackDepth];
+    const int depth = turbo::GetStackTrace(stack, kMaxStackDepth, 0);
+    pcs->insert(pcs->end(), stack, stack + depth);
+    return;
+  }
+  TURBO_BLOCK_TAIL_CALL_OPTIMIZATION();
+  Capture(x - 1, pcs);
+}
+
+std::vector<void*> CaptureStacks(int num_stacks) {
+  std::vector<void*> pcs;
+  for (int i = 0; i < num_stacks; ++i) Capture(i % 32, &pcs);
+  return pcs;
+}
+
+// Symbolizes each frame, as profilers did before SymbolizeMany().
+void BM_Symbolize(benchmark::State& state) {
+  const std::vector<void*> pcs = CaptureStacks(state.range(0));
+  char buf[1024];
+  for (auto s : state) {
+    for (void* pc : pcs) {
+      benchmark::DoNotOptimize(turbo::Symbolize(pc, buf, sizeof(buf)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pcs.size());
+}
+
+void BM_SymbolizeMany(benchmark::State& state) {
+  const std::vector<void*> pcs = CaptureStacks(state.range(0));
+  for (auto s : state) {
+    benchmark::DoNotOptimize(turbo::SymbolizeMany(pcs));
+  }
+  state.SetItemsProcessed(state.iterations() * pcs.size());
+}
+
+// Returns the bounds of the first executable segment of the program.
+int FindText(struct dl_phdr_info* info, size_t, void* arg) {
+  auto* text = static_cast<std::pair<uintptr_t, uintptr_t>*>(arg);
+  for (int i = 0; i < info->dlpi_phnum; ++i) {
+    const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+    if (phdr.p_type == PT_LOAD && (phdr.p_flags & PF_X) != 0) {
+      text->first = info->dlpi_addr + phdr.p_vaddr;
+      text->second = text->first + phdr.p_memsz;
+      break;
+    }
+  }
+  return 1;
+}
+
+// Returns program counters spread over more functions than the cache of
+// Symbolize() holds, as the stacks of a large program are.
+std::vector<void*> SpreadPcs(int n) {
+  std::pair<uintptr_t, uintptr_t> text(0, 0);
+  dl_iterate_phdr(FindText, &text);
+  std::vector<void*> pcs;
+  for (int i = 0; i < n; ++i) {
+    const uintptr_t offset =
+        static_cast<uintptr_t>(i) * 4099 % (text.second - text.first);
+    pcs.push_back(reinterpret_cast<void*>(text.first + offset));
+  }
+  return pcs;
+}
+
+void BM_SymbolizeSpread(benchmark::State& state) {
+  const std::vector<void*> pcs = SpreadPcs(state.range(0));
+  char buf[1024];
+  for (auto s : state) {
+    for (void* pc : pcs) {
+      benchmark::DoNotOptimize(turbo::Symbolize(pc, buf, sizeof(buf)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pcs.size());
+}
+
+void BM_SymbolizeManySpread(benchmark::State& state) {
+  const std::vector<void*> pcs = SpreadPcs(state.range(0));
+  for (auto s : state) {
+    benchmark::DoNotOptimize(turbo::SymbolizeMany(pcs));
+  }
+  state.SetItemsProcessed(state.iterations() * pcs.size());
+}
+
+BENCHMARK(BM_Symbolize)->Range(8, 1024);
+BENCHMARK(BM_SymbolizeMany)->Range(8, 1024);
+BENCHMARK(BM_SymbolizeSpread)->Range(64, 4096);
+BENCHMARK(BM_SymbolizeManySpread)->Range(64, 4096);
+
+}  // namespace
+TURBO_NAMESPACE_END
+}  // namespace turbo
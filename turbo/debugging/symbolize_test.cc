@@ -26,6 +26,7 @@
 #include "turbo/base/casts.h"
 #include "turbo/base/internal/raw_logging.h"
 #include "turbo/debugging/internal/stack_consumption.h"
+#include "turbo/debugging/stacktrace.h"
 #include "turbo/log/turbo_log.h"
 #include "turbo/memory/memory.h"
 #include "turbo/platform/port.h"
@@ -35,6 +36,7 @@
 #include "gtest/gtest.h"
 
 using testing::Contains;
+using testing::ElementsAre;
 
 #ifdef _WIN32
 #define TURBO_SYMBOLIZE_TEST_NOINLINE __declspec(noinline)
@@ -208,6 +210,34 @@ TEST(Symbolize, SymbolizeSplitTextSections) {
   EXPECT_STREQ("regular_func()", TrySymbolize((void *)(&regular_func)));
 }
 
+TEST(Symbolize, SymbolizeMany) {
+  void *pcs[] = {(void *)(&nonstatic_func), (void *)(&Foo::func), nullptr,
+                 (void *)(&unlikely_func),  (void *)(&nonstatic_func)};
+  const std::vector<std::string> names = turbo::SymbolizeMany(pcs);
+  EXPECT_THAT(names, ElementsAre("nonstatic_func", "Foo::func()", "",
+                                 "unlikely_func()", "nonstatic_func"));
+  EXPECT_TRUE(turbo::SymbolizeMany(turbo::Span<void *const>()).empty());
+}
+
+TEST(Symbolize, SymbolizeManyMatchesSymbolize) {
+  std::vector<void *> pcs(64);
+  pcs.resize(static_cast<size_t>(turbo::GetStackTrace(
+      pcs.data(), static_cast<int>(pcs.size()), 0)));
+  ASSERT_FALSE(pcs.empty());
+  pcs.push_back((void *)(&static_func));
+  pcs.push_back((void *)(&hot_func));
+  pcs.push_back((void *)(&TrySymbolizeWithLimit));
+  // Symbolize them twice, the second time from the symbol table.
+  for (int i = 0; i < 2; ++i) {
+    const std::vector<std::string> names = turbo::SymbolizeMany(pcs);
+    ASSERT_EQ(names.size(), pcs.size());
+    for (size_t j = 0; j < pcs.size(); ++j) {
+      const char *symbol = TrySymbolize(pcs[j]);
+      EXPECT_EQ(names[j], symbol != nullptr ? symbol : "") << pcs[j];
+    }
+  }
+}
+
 // Tests that verify that Symbolize stack footprint is within some limit.
 #ifdef TURBO_INTERNAL_HAVE_DEBUGGING_STACK_CONSUMPTION
 
@@ -0,0 +1,139 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/files/cord_io.h"
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <vector>
+#include "turbo/strings/cord_buffer.h"
+
+namespace turbo {
+
+    namespace {
+
+#if defined(IOV_MAX)
+        constexpr size_t kMaxIov = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+        constexpr size_t kMaxIov = 16;
+#endif
+
+        // Upper bound of buffer space allocated ahead of a single readv(2) when
+        // the amount of data to read is not known.
+        constexpr size_t kMaxReadAhead = 256 << 10;
+
+        // Writes iov[0, count), advancing over partial writes.
+        turbo::Status WriteIov(int fd, struct iovec *iov, size_t count) {
+            while (count > 0) {
+                ssize_t written = ::writev(fd, iov, static_cast<int>(count));
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return ErrnoToStatus(errno, "writev");
+                }
+                size_t left = static_cast<size_t>(written);
+                while (count > 0 && left >= iov->iov_len) {
+                    left -= iov->iov_len;
+                    ++iov;
+                    --count;
+                }
+                if (left > 0) {
+                    iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                }
+            }
+            return turbo::OkStatus();
+        }
+
+    }  // namespace
+
+    turbo::Status WriteCord(int fd, const turbo::Cord &cord) {
+        struct iovec iov[kMaxIov];
+        size_t count = 0;
+        for (turbo::string_view chunk : cord.Chunks()) {
+            if (count == kMaxIov) {
+                auto rs = WriteIov(fd, iov, count);
+                if (!rs.ok()) {
+                    return rs;
+                }
+                count = 0;
+            }
+            iov[count].iov_base = const_cast<char *>(chunk.data());
+            iov[count].iov_len = chunk.size();
+            ++count;
+        }
+        return WriteIov(fd, iov, count);
+    }
+
+    turbo::Status ReadIntoCord(int fd, turbo::Cord *dst, size_t n) {
+        const size_t read_ahead = std::min(n, kMaxReadAhead);
+        // Buffers not filled by one readv(2) are kept for the next one. Only
+        // the first of them may hold data: a partially filled buffer keeps
+        // being filled by subsequent short reads instead of being appended as
+        // a mostly empty chunk.
+        std::vector<turbo::CordBuffer> buffers;
+        struct iovec iov[kMaxIov];
+        turbo::Status rs;
+        size_t left = n;
+        while (left > 0) {
+            size_t want = std::min(left, read_ahead);
+            size_t count = 0;
+            size_t reserved = 0;
+            for (; count < kMaxIov && reserved < want; ++count) {
+                if (count == buffers.size()) {
+                    buffers.push_back(turbo::CordBuffer::CreateWithDefaultLimit(want - reserved));
+                }
+                turbo::Span<char> space = buffers[count].available();
+                size_t len = std::min(space.size(), want - reserved);
+                iov[count].iov_base = space.data();
+                iov[count].iov_len = len;
+                reserved += len;
+            }
+
+            ssize_t read_len = ::readv(fd, iov, static_cast<int>(count));
+            if (read_len < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                rs = ErrnoToStatus(errno, "readv");
+                break;
+            }
+            if (read_len == 0) {
+                break;
+            }
+
+            size_t got = static_cast<size_t>(read_len);
+            left -= got;
+            for (size_t i = 0; got > 0; ++i) {
+                size_t len = std::min(got, iov[i].iov_len);
+                buffers[i].IncreaseLengthBy(len);
+                got -= len;
+            }
+            size_t full = 0;
+            while (full < buffers.size() && buffers[full].available().empty()) {
+                dst->Append(std::move(buffers[full]));
+                ++full;
+            }
+            buffers.erase(buffers.begin(), buffers.begin() + static_cast<ptrdiff_t>(full));
+        }
+        if (!buffers.empty()) {
+            dst->Append(std::move(buffers.front()));
+        }
+        return rs;
+    }
+
+}  // namespace turbo
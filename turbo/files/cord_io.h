@@ -0,0 +1,47 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TURBO_FILES_CORD_IO_H_
+#define TURBO_FILES_CORD_IO_H_
+
+#include <cstddef>
+#include <limits>
+
+#include "turbo/base/status.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/cord.h"
+
+// Scatter-gather I/O between file descriptors and cords.
+//
+// Both functions work on the cord's chunks directly: `WriteCord()` hands the
+// chunks to writev(2) without flattening and `ReadIntoCord()` reads with
+// readv(2) straight into freshly allocated `CordBuffer`s which are then
+// appended to the cord, so no intermediate copy is made in either direction.
+
+namespace turbo {
+
+    // Writes all of `cord` to `fd`, retrying on partial writes and EINTR.
+    // Chunks are passed to writev(2) in batches of at most IOV_MAX entries.
+    // On error some prefix of `cord` may already have been written.
+    turbo::Status WriteCord(int fd, const turbo::Cord &cord);
+
+    // Reads up to `n` bytes from `fd` and appends them to `dst`. Reading stops
+    // early only at end of file; pass the default `n` to read until then.
+    // Data read before an error occurs is still appended to `dst`.
+    turbo::Status ReadIntoCord(int fd, turbo::Cord *dst,
+                               size_t n = std::numeric_limits<size_t>::max());
+
+}  // namespace turbo
+
+#endif  // TURBO_FILES_CORD_IO_H_
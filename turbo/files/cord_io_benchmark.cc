@@ -0,0 +1,127 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/files/cord_io.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+    // A cord of `total` bytes made of `piece` sized chunks.
+    turbo::Cord MakeCord(size_t total, size_t piece) {
+        std::vector<std::string> parts;
+        for (size_t i = 0; i < total; i += piece) {
+            parts.emplace_back(std::min(piece, total - i), 'x');
+        }
+        return turbo::MakeFragmentedCord(parts);
+    }
+
+    void BM_WriteCord(benchmark::State &state) {
+        int fd = ::open("/dev/null", O_WRONLY);
+        turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)),
+                                    static_cast<size_t>(state.range(1)));
+        for (auto _ : state) {
+            if (!turbo::WriteCord(fd, cord).ok()) {
+                state.SkipWithError("write failed");
+                break;
+            }
+        }
+        ::close(fd);
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_WriteCord)->Args({1 << 20, 64})->Args({1 << 20, 4096})->Args({16 << 20, 65536});
+
+    // Baseline: flatten the cord and write the contiguous copy.
+    void BM_FlattenAndWrite(benchmark::State &state) {
+        int fd = ::open("/dev/null", O_WRONLY);
+        turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)),
+                                    static_cast<size_t>(state.range(1)));
+        for (auto _ : state) {
+            std::string flat(cord);
+            if (::write(fd, flat.data(), flat.size()) < 0) {
+                state.SkipWithError("write failed");
+                break;
+            }
+        }
+        ::close(fd);
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_FlattenAndWrite)->Args({1 << 20, 64})->Args({1 << 20, 4096})->Args({16 << 20, 65536});
+
+    class InputFile {
+    public:
+        explicit InputFile(size_t size) {
+            _fd = ::mkstemp(_path);
+            std::string data(size, 'x');
+            if (::write(_fd, data.data(), data.size()) < 0) {
+                std::abort();
+            }
+        }
+
+        ~InputFile() {
+            ::close(_fd);
+            ::unlink(_path);
+        }
+
+        int rewind() {
+            ::lseek(_fd, 0, SEEK_SET);
+            return _fd;
+        }
+
+    private:
+        char _path[32] = "/tmp/cord_io_bench_XXXXXX";
+        int _fd;
+    };
+
+    void BM_ReadIntoCord(benchmark::State &state) {
+        InputFile file(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            turbo::Cord cord;
+            if (!turbo::ReadIntoCord(file.rewind(), &cord).ok()) {
+                state.SkipWithError("read failed");
+                break;
+            }
+            benchmark::DoNotOptimize(cord);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_ReadIntoCord)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+    // Baseline: read into a temporary buffer and append a copy to the cord.
+    void BM_ReadAndAppend(benchmark::State &state) {
+        InputFile file(static_cast<size_t>(state.range(0)));
+        std::vector<char> tmp(4096);
+        for (auto _ : state) {
+            int fd = file.rewind();
+            turbo::Cord cord;
+            ssize_t n;
+            while ((n = ::read(fd, tmp.data(), tmp.size())) > 0) {
+                cord.Append(turbo::string_view(tmp.data(), static_cast<size_t>(n)));
+            }
+            benchmark::DoNotOptimize(cord);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_ReadAndAppend)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+}  // namespace
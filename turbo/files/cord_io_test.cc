@@ -0,0 +1,156 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/files/cord_io.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "turbo/files/sequential_read_file.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+    std::string MakeData(size_t n) {
+        std::string s(n, '\0');
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+        }
+        return s;
+    }
+
+    class TempFile {
+    public:
+        TempFile() {
+            _fd = ::mkstemp(_path);
+        }
+
+        ~TempFile() {
+            ::close(_fd);
+            ::unlink(_path);
+        }
+
+        int fd() const { return _fd; }
+
+        const char *path() const { return _path; }
+
+        void rewind() { ::lseek(_fd, 0, SEEK_SET); }
+
+    private:
+        char _path[32] = "/tmp/cord_io_test_XXXXXX";
+        int _fd;
+    };
+
+    TEST(CordIoTest, WriteAndReadFlat) {
+        TempFile file;
+        ASSERT_GE(file.fd(), 0);
+        std::string data = MakeData(1 << 20);
+        ASSERT_TRUE(turbo::WriteCord(file.fd(), turbo::Cord(data)).ok());
+
+        file.rewind();
+        turbo::Cord cord;
+        ASSERT_TRUE(turbo::ReadIntoCord(file.fd(), &cord).ok());
+        EXPECT_EQ(data, std::string(cord));
+    }
+
+    TEST(CordIoTest, WriteManyChunks) {
+        TempFile file;
+        ASSERT_GE(file.fd(), 0);
+        // More chunks than fit into a single writev(2) call.
+        std::string data = MakeData(5000 * 3);
+        std::vector<std::string> parts;
+        for (size_t i = 0; i < data.size(); i += 3) {
+            parts.push_back(data.substr(i, 3));
+        }
+        turbo::Cord cord = turbo::MakeFragmentedCord(parts);
+        ASSERT_TRUE(turbo::WriteCord(file.fd(), cord).ok());
+        ASSERT_TRUE(turbo::WriteCord(file.fd(), turbo::Cord()).ok());
+
+        file.rewind();
+        turbo::Cord read;
+        ASSERT_TRUE(turbo::ReadIntoCord(file.fd(), &read).ok());
+        EXPECT_EQ(data, std::string(read));
+    }
+
+    TEST(CordIoTest, ReadExactly) {
+        TempFile file;
+        ASSERT_GE(file.fd(), 0);
+        std::string data = MakeData(100000);
+        ASSERT_TRUE(turbo::WriteCord(file.fd(), turbo::Cord(data)).ok());
+
+        file.rewind();
+        turbo::Cord cord("prefix");
+        for (size_t n : {0, 1, 10, 4096, 50000}) {
+            ASSERT_TRUE(turbo::ReadIntoCord(file.fd(), &cord, n).ok());
+        }
+        EXPECT_EQ("prefix" + data.substr(0, 54107), std::string(cord));
+        // Reading past the end stops at end of file.
+        ASSERT_TRUE(turbo::ReadIntoCord(file.fd(), &cord, 1 << 20).ok());
+        EXPECT_EQ("prefix" + data, std::string(cord));
+    }
+
+    TEST(CordIoTest, ShortReadsFromPipe) {
+        int fds[2];
+        ASSERT_EQ(0, ::pipe(fds));
+        std::string data = MakeData(20000);
+        std::thread writer([&] {
+            for (size_t i = 0; i < data.size(); i += 10) {
+                EXPECT_TRUE(turbo::WriteCord(fds[1], turbo::Cord(data.substr(i, 10))).ok());
+            }
+            ::close(fds[1]);
+        });
+        turbo::Cord cord;
+        turbo::Status rs = turbo::ReadIntoCord(fds[0], &cord);
+        writer.join();
+        ::close(fds[0]);
+        ASSERT_TRUE(rs.ok());
+        EXPECT_EQ(data, std::string(cord));
+        // Short reads keep filling the current buffer rather than creating a
+        // chunk per read.
+        size_t chunks = 0;
+        for (turbo::string_view chunk : cord.Chunks()) {
+            (void) chunk;
+            ++chunks;
+        }
+        EXPECT_LE(chunks, data.size() / 1000);
+    }
+
+    TEST(CordIoTest, Errors) {
+        turbo::Cord cord("abc");
+        EXPECT_FALSE(turbo::WriteCord(-1, cord).ok());
+        EXPECT_FALSE(turbo::ReadIntoCord(-1, &cord).ok());
+        EXPECT_EQ("abc", std::string(cord));
+    }
+
+    TEST(CordIoTest, SequentialReadFile) {
+        TempFile file;
+        ASSERT_GE(file.fd(), 0);
+        std::string data = MakeData(30000);
+        ASSERT_TRUE(turbo::WriteCord(file.fd(), turbo::Cord(data)).ok());
+
+        turbo::SequentialReadFile reader;
+        ASSERT_TRUE(reader.open(file.path()).ok());
+        turbo::Cord cord;
+        ASSERT_TRUE(reader.read(&cord, 1000).ok());
+        ASSERT_TRUE(reader.read(&cord).ok());
+        EXPECT_EQ(data, std::string(cord));
+        EXPECT_EQ(data.size(), reader.has_read());
+        turbo::Status rs;
+        EXPECT_TRUE(reader.is_eof(&rs));
+    }
+
+}  // namespace
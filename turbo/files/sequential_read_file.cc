@@ -18,6 +18,7 @@
 #include <fcntl.h>
 #include <cerrno>
 #include <cstring>
+#include "turbo/files/cord_io.h"
 #include "turbo/log/logging.h"
 #include "turbo/base/casts.h"
 
@@ -51,29 +52,14 @@ namespace turbo {
     }
 
     turbo::Status SequentialReadFile::read(turbo::Cord *buf, size_t n) {
-        size_t left = n;
-        turbo::Status frs;
-        std::vector<char> tmpBuf;
-        static const size_t kMaxTempSize = 4096;
-        tmpBuf.resize(kMaxTempSize);
-        char *ptr = tmpBuf.data();
-        while (left > 0) {
-            ssize_t read_len = ::read(_fd, ptr, std::min(left, kMaxTempSize));
-            if (read_len > 0) {
-                left -= static_cast<size_t>(read_len);
-            } else if (read_len == 0) {
-                break;
-            } else if (errno == EINTR) {
-                continue;
-            } else {
-                TURBO_LOG(WARNING) << "read failed, err: " << errno
-                                   << " fd: " << _fd << " size: " << n;
-                return ErrnoToStatus(errno,"");
-            }
-            buf->Append(turbo::string_view(ptr, static_cast<size_t>(read_len)));
-            _has_read += static_cast<size_t>(read_len);
+        size_t before = buf->size();
+        auto frs = ReadIntoCord(_fd, buf, n);
+        _has_read += buf->size() - before;
+        if (!frs.ok()) {
+            TURBO_LOG(WARNING) << "read failed, err: " << frs.message()
+                               << " fd: " << _fd << " size: " << n;
         }
-        return turbo::OkStatus();
+        return frs;
     }
 
     void SequentialReadFile::close() {
@@ -33,13 +33,13 @@
 #include "turbo/flags/config.h"
 #include "turbo/flags/internal/commandlineflag.h"
 #include "turbo/flags/internal/registry.h"
-#include "turbo/flags/internal/sequence_lock.h"
 #include "turbo/flags/marshalling.h"
 #include "turbo/meta/type_traits.h"
 #include "turbo/meta/utility.h"
 #include "turbo/platform/port.h"
 #include "turbo/platform/thread_annotations.h"
 #include "turbo/strings/string_view.h"
+#include "turbo/synchronization/internal/sequence_lock.h"
 #include "turbo/synchronization/mutex.h"
 
 namespace turbo {
@@ -358,7 +358,7 @@ struct FlagValue;
 template <typename T>
 struct FlagValue<T, FlagValueStorageKind::kValueAndInitBit> : FlagOneWordValue {
   constexpr FlagValue() : FlagOneWordValue(0) {}
-  bool Get(const SequenceLock&, T& dst) const {
+  bool Get(const synchronization_internal::SequenceLock&, T& dst) const {
     int64_t storage = value.load(std::memory_order_acquire);
     if (TURBO_PREDICT_FALSE(storage == 0)) {
       return false;
@@ -371,7 +371,7 @@ struct FlagValue<T, FlagValueStorageKind::kValueAndInitBit> : FlagOneWordValue {
 template <typename T>
 struct FlagValue<T, FlagValueStorageKind::kOneWordAtomic> : FlagOneWordValue {
   constexpr FlagValue() : FlagOneWordValue(UninitializedFlagValue()) {}
-  bool Get(const SequenceLock&, T& dst) const {
+  bool Get(const synchronization_internal::SequenceLock&, T& dst) const {
     int64_t one_word_val = value.load(std::memory_order_acquire);
     if (TURBO_PREDICT_FALSE(one_word_val == UninitializedFlagValue())) {
       return false;
@@ -383,12 +383,13 @@ struct FlagValue<T, FlagValueStorageKind::kOneWordAtomic> : FlagOneWordValue {
 
 template <typename T>
 struct FlagValue<T, FlagValueStorageKind::kSequenceLocked> {
-  bool Get(const SequenceLock& lock, T& dst) const {
+  bool Get(const synchronization_internal::SequenceLock& lock, T& dst) const {
     return lock.TryRead(&dst, value_words, sizeof(T));
   }
 
   static constexpr int kNumWords =
-      flags_internal::AlignUp(sizeof(T), sizeof(uint64_t)) / sizeof(uint64_t);
+      synchronization_internal::AlignUp(sizeof(T), sizeof(uint64_t)) /
+      sizeof(uint64_t);
 
   alignas(T) alignas(
       std::atomic<uint64_t>) std::atomic<uint64_t> value_words[kNumWords];
@@ -396,7 +397,9 @@ struct FlagValue<T, FlagValueStorageKind::kSequenceLocked> {
 
 template <typename T>
 struct FlagValue<T, FlagValueStorageKind::kAlignedBuffer> {
-  bool Get(const SequenceLock&, T&) const { return false; }
+  bool Get(const synchronization_internal::SequenceLock&, T&) const {
+    return false;
+  }
 
   alignas(T) char value[sizeof(T)];
 };
@@ -607,7 +610,7 @@ class FlagImpl final : public CommandLineFlag {
   turbo::once_flag init_control_;
 
   // Sequence lock / mutation counter.
-  flags_internal::SequenceLock seq_lock_;
+  synchronization_internal::SequenceLock seq_lock_;
 
   // Optional flag's callback and turbo::Mutex to guard the invocations.
   FlagCallback* callback_ TURBO_GUARDED_BY(*DataGuard());
@@ -0,0 +1,38 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/fingerprint.h"
+
+#include "turbo/hash/internal/xxh3.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+turbo::uint128 Fingerprint128(turbo::string_view data) {
+  return hash_internal::Xxh3Hash128(data.data(), data.size(), 0);
+}
+
+turbo::uint128 Fingerprint128(const turbo::Cord& data) {
+  if (turbo::optional<turbo::string_view> flat = data.TryFlat()) {
+    return Fingerprint128(*flat);
+  }
+  hash_internal::Xxh3Hasher hasher;
+  for (turbo::string_view chunk : data.Chunks()) {
+    hasher.Update(chunk.data(), chunk.size());
+  }
+  return hasher.Digest128();
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
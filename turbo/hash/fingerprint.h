@@ -0,0 +1,66 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: fingerprint.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::Fingerprint128()`, a fast 128-bit hash of a
+// byte sequence for identifying content, e.g. to detect duplicate records.
+// With 128 bits, the probability of any collision among 2^40 distinct inputs
+// is below 2^-48, which 64-bit hashes such as `turbo::Hash` cannot provide.
+//
+// Fingerprints are stable: they never change between processes, platforms or
+// releases of this library and may be persisted. They are the XXH3 128-bit
+// hash (https://github.com/Cyan4973/xxHash) of the input, with the high and low
+// 64 bits of the `turbo::uint128` equal to the `high64` and `low64` fields of
+// `XXH3_128bits()`.
+//
+// Fingerprints are not cryptographic: they must not be used where an
+// adversary may choose the inputs to provoke collisions.
+//
+// Example:
+//
+//   turbo::flat_hash_set<turbo::uint128> seen;
+//   for (const turbo::Cord& record : records) {
+//     if (!seen.insert(turbo::Fingerprint128(record)).second) {
+//       // `record` is a duplicate.
+//     }
+//   }
+
+#ifndef TURBO_HASH_FINGERPRINT_H_
+#define TURBO_HASH_FINGERPRINT_H_
+
+#include "turbo/base/int128.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// Fingerprint128()
+//
+// Returns the 128-bit fingerprint of `data`.
+turbo::uint128 Fingerprint128(turbo::string_view data);
+
+// Overload of `Fingerprint128()` for cords. The fingerprint is computed chunk
+// by chunk without flattening the cord, and equals the fingerprint of the
+// flattened contents.
+turbo::uint128 Fingerprint128(const turbo::Cord& data);
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_HASH_FINGERPRINT_H_
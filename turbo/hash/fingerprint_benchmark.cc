@@ -0,0 +1,94 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/hash/fingerprint.h"
+#include "turbo/hash/internal/city.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+std::string MakeData(size_t size) {
+  std::string data(size, '\0');
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i * 131 + 7);
+  return data;
+}
+
+turbo::Cord MakeFragmented(size_t size, size_t chunk) {
+  const std::string data = MakeData(size);
+  std::vector<std::string> pieces;
+  for (size_t i = 0; i < size; i += chunk) pieces.push_back(data.substr(i, chunk));
+  return turbo::MakeFragmentedCord(pieces);
+}
+
+void SetBytes(benchmark::State& state, size_t size) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+
+void BM_Fingerprint128String(benchmark::State& state) {
+  const std::string data = MakeData(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::Fingerprint128(data));
+  }
+  SetBytes(state, data.size());
+}
+BENCHMARK(BM_Fingerprint128String)->Range(1, 1 << 20);
+
+// CityHash64 for reference, which is about as fast but only 64 bits wide.
+void BM_CityHash64String(benchmark::State& state) {
+  const std::string data = MakeData(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        turbo::hash_internal::CityHash64(data.data(), data.size()));
+  }
+  SetBytes(state, data.size());
+}
+BENCHMARK(BM_CityHash64String)->Range(1, 1 << 20);
+
+void FragmentedArgs(benchmark::internal::Benchmark* b) {
+  for (int size : {4 << 10, 1 << 20}) {
+    for (int chunk : {64, 4096}) b->Args({size, chunk});
+  }
+  b->ArgNames({"size", "chunk"});
+}
+
+void BM_Fingerprint128FragmentedCord(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  const turbo::Cord cord =
+      MakeFragmented(size, static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::Fingerprint128(cord));
+  }
+  SetBytes(state, size);
+}
+BENCHMARK(BM_Fingerprint128FragmentedCord)->Apply(FragmentedArgs);
+
+// The alternative to streaming: copying the cord into a string first.
+void BM_Fingerprint128FlattenedCord(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  const turbo::Cord cord =
+      MakeFragmented(size, static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::Fingerprint128(std::string(cord)));
+  }
+  SetBytes(state, size);
+}
+BENCHMARK(BM_Fingerprint128FlattenedCord)->Apply(FragmentedArgs);
+
+}  // namespace
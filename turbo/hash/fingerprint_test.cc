@@ -0,0 +1,112 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/fingerprint.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/container/flat_hash_set.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+std::string TestBytes(size_t len) {
+  std::string s(len, '\0');
+  for (size_t i = 0; i < len; ++i) s[i] = static_cast<char>(i * 7 + 3);
+  return s;
+}
+
+// Values of XXH3_128bits() from the reference implementation.
+TEST(Fingerprint128, MatchesReferenceXxh3) {
+  static const struct {
+    size_t len;
+    turbo::uint128 fingerprint;
+  } kCases[] = {
+      {0, turbo::MakeUint128(0x99aa06d3014798d8, 0x6001c324468d497f)},
+      {2, turbo::MakeUint128(0xa6b9dd53b1448722, 0x1c9074b93943b86c)},
+      {5, turbo::MakeUint128(0x5787f33cbc36d4c8, 0xd3497975144f78a7)},
+      {12, turbo::MakeUint128(0xf7314c62630bc633, 0x381c69c9c2498dfa)},
+      {40, turbo::MakeUint128(0x326a4fe50de2f05b, 0x302ddc191e5fd24e)},
+      {200, turbo::MakeUint128(0x32200a52a918beaf, 0x380142cdd5843bbd)},
+      {1000, turbo::MakeUint128(0x6bcc7eff62da44c2, 0x6c4f14bd97bd9e82)},
+      {5000, turbo::MakeUint128(0xc98ae385d09887cc, 0x799aaddd7339581d)},
+  };
+  for (const auto& c : kCases) {
+    EXPECT_EQ(c.fingerprint, turbo::Fingerprint128(TestBytes(c.len))) << c.len;
+  }
+}
+
+TEST(Fingerprint128, CordMatchesFlat) {
+  const std::string data = TestBytes(20000);
+  for (size_t len : {0, 10, 240, 241, 300, 1024, 5000, 20000}) {
+    const std::string flat = data.substr(0, len);
+    const turbo::uint128 expected = turbo::Fingerprint128(flat);
+    EXPECT_EQ(expected, turbo::Fingerprint128(turbo::Cord(flat))) << len;
+    for (size_t piece : {1, 7, 64, 100, 257, 4096}) {
+      std::vector<std::string> pieces;
+      for (size_t pos = 0; pos < len; pos += piece) {
+        pieces.push_back(flat.substr(pos, piece));
+      }
+      EXPECT_EQ(expected,
+                turbo::Fingerprint128(turbo::MakeFragmentedCord(pieces)))
+          << len << " " << piece;
+    }
+  }
+}
+
+// Neither the fingerprint nor any of its 64-bit halves may collide on inputs
+// which differ in a few bits only.
+TEST(Fingerprint128, NoCollisions) {
+  turbo::flat_hash_set<turbo::uint128> fingerprints;
+  turbo::flat_hash_set<uint64_t> lows;
+  turbo::flat_hash_set<uint64_t> highs;
+  auto add = [&](turbo::string_view data) {
+    const turbo::uint128 f = turbo::Fingerprint128(data);
+    EXPECT_TRUE(fingerprints.insert(f).second);
+    EXPECT_TRUE(lows.insert(turbo::Uint128Low64(f)).second);
+    EXPECT_TRUE(highs.insert(turbo::Uint128High64(f)).second);
+  };
+
+  // Sequential 8-byte keys.
+  for (uint64_t i = 0; i < (1 << 18); ++i) {
+    add(turbo::string_view(reinterpret_cast<const char*>(&i), sizeof(i)));
+  }
+  // Records of various sizes with one or two bits flipped.
+  for (size_t len : {3, 16, 100, 300, 2000}) {
+    std::string record = TestBytes(len);
+    add(record);
+    const size_t bits = std::min<size_t>(len * 8, 800);
+    for (size_t i = 0; i < bits; ++i) {
+      record[i / 8] ^= static_cast<char>(1 << (i % 8));
+      add(record);
+      for (size_t j = i + 1; j < bits; j += 7) {
+        record[j / 8] ^= static_cast<char>(1 << (j % 8));
+        add(record);
+        record[j / 8] ^= static_cast<char>(1 << (j % 8));
+      }
+      record[i / 8] ^= static_cast<char>(1 << (i % 8));
+    }
+  }
+  // Prefixes of the same data.
+  const std::string data(4096, 'x');
+  for (size_t len = 1; len <= data.size(); ++len) {
+    add(turbo::string_view(data).substr(0, len));
+  }
+}
+
+}  // namespace
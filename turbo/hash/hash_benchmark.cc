@@ -21,6 +21,11 @@
 #include "benchmark/benchmark.h"
 #include "turbo/container/flat_hash_set.h"
 #include "turbo/hash/hash.h"
+#include "turbo/hash/internal/aes_hash.h"
+#include "turbo/hash/internal/city.h"
+#include "turbo/hash/internal/low_level_hash.h"
+#include "turbo/hash/internal/xxh3.h"
+#include "turbo/hash/stable_hash.h"
 #include "turbo/platform/port.h"
 #include "turbo/random/random.h"
 #include "turbo/strings/cord.h"
@@ -45,6 +50,9 @@ void RunBenchmark(benchmark::State& state, T value) {
 template <typename T>
 using TurboHash = turbo::Hash<T>;
 
+template <typename T>
+using TurboStableHash = turbo::StableHash<T>;
+
 class TypeErasedInterface {
  public:
   virtual ~TypeErasedInterface() = default;
@@ -250,6 +258,20 @@ MAKE_BENCHMARK(TypeErasedTurboHash, FastUnorderedSetInt64_1000,
 MAKE_BENCHMARK(TypeErasedTurboHash, FastUnorderedSetDouble_1000,
                FastUnorderedSet<double>(1000));
 
+MAKE_BENCHMARK(TurboStableHash, Int64, int64_t{});
+MAKE_BENCHMARK(TurboStableHash, PairInt64Int64, std::pair<int64_t, int64_t>{});
+MAKE_BENCHMARK(TurboStableHash, String_0, std::string());
+MAKE_BENCHMARK(TurboStableHash, String_10, std::string(10, 'a'));
+MAKE_BENCHMARK(TurboStableHash, String_30, std::string(30, 'a'));
+MAKE_BENCHMARK(TurboStableHash, String_90, std::string(90, 'a'));
+MAKE_BENCHMARK(TurboStableHash, String_200, std::string(200, 'a'));
+MAKE_BENCHMARK(TurboStableHash, String_5000, std::string(5000, 'a'));
+MAKE_BENCHMARK(TurboStableHash, Cord_Flat_5000, FlatCord(5000));
+MAKE_BENCHMARK(TurboStableHash, Cord_Fragmented_5000, FragmentedCord(5000));
+MAKE_BENCHMARK(TurboStableHash, VectorInt64_1000, Vector<int64_t>(1000));
+MAKE_BENCHMARK(TurboStableHash, PairStringString_30,
+               std::make_pair(std::string(30, 'a'), std::string(30, 'b')));
+
 // The latency benchmark attempts to model the speed of the hash function in
 // production. When a hash function is used for hashtable lookups it is rarely
 // used to hash N items in a tight loop nor on constant sized strings. Instead,
@@ -321,3 +343,86 @@ MAKE_LATENCY_BENCHMARK(TurboHash, String9, StringRand<9>);
 MAKE_LATENCY_BENCHMARK(TurboHash, String33, StringRand<33>);
 MAKE_LATENCY_BENCHMARK(TurboHash, String65, StringRand<65>);
 MAKE_LATENCY_BENCHMARK(TurboHash, String257, StringRand<257>);
+
+// Compares the byte-sequence hash functions of turbo::Hash (LowLevelHash and
+// AesHash) and turbo::StableHash (XXH3) with CityHash on inputs of 1 to 1024
+// bytes, both for throughput on a fixed length and for latency on random
+// lengths, see the latency benchmarks above.
+namespace {
+
+constexpr uint64_t kBackendSalt[5] = {
+    uint64_t{0x243F6A8885A308D3}, uint64_t{0x13198A2E03707344},
+    uint64_t{0xA4093822299F31D0}, uint64_t{0x082EFA98EC4E6C89},
+    uint64_t{0x452821E638D01377},
+};
+
+struct LowLevelHashBackend {
+  static bool Supported() { return true; }
+  uint64_t operator()(const void* data, size_t len, uint64_t seed) const {
+    return turbo::hash_internal::LowLevelHash(data, len, seed, kBackendSalt);
+  }
+};
+
+struct CityHashBackend {
+  static bool Supported() { return true; }
+  uint64_t operator()(const void* data, size_t len, uint64_t seed) const {
+    return turbo::hash_internal::CityHash64WithSeed(
+        static_cast<const char*>(data), len, seed);
+  }
+};
+
+struct Xxh3Backend {
+  static bool Supported() { return true; }
+  uint64_t operator()(const void* data, size_t len, uint64_t seed) const {
+    return turbo::hash_internal::Xxh3Hash64(data, len, seed);
+  }
+};
+
+struct AesHashBackend {
+  static bool Supported() { return turbo::hash_internal::AesHashSupported(); }
+  uint64_t operator()(const void* data, size_t len, uint64_t seed) const {
+    return turbo::hash_internal::AesHash(data, len, seed);
+  }
+};
+
+template <typename Backend>
+void BM_HashBackend(benchmark::State& state) {
+  if (!Backend::Supported()) {
+    state.SkipWithError("backend not supported on this CPU");
+    return;
+  }
+  const size_t len = static_cast<size_t>(state.range(0));
+  Backend hash;
+  uint64_t seed = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(seed = hash(entropy, len, seed));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_HashBackend, LowLevelHashBackend)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_HashBackend, CityHashBackend)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_HashBackend, Xxh3Backend)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_HashBackend, AesHashBackend)->Range(1, 1024);
+
+template <typename Backend>
+void BM_latency_HashBackend(benchmark::State& state) {
+  if (!Backend::Supported()) {
+    state.SkipWithError("backend not supported on this CPU");
+    return;
+  }
+  const size_t max_len = static_cast<size_t>(state.range(0));
+  Backend hash;
+  size_t i = 871401241;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        i = hash(&entropy[i % kEntropySize], i % max_len + 1, 0));
+  }
+}
+BENCHMARK_TEMPLATE(BM_latency_HashBackend, LowLevelHashBackend)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_latency_HashBackend, CityHashBackend)->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_latency_HashBackend, Xxh3Backend)->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_latency_HashBackend, AesHashBackend)->Range(16, 1024);
+
+}  // namespace
@@ -0,0 +1,141 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/internal/aes_hash.h"
+
+#include <cstring>
+
+#include "turbo/crypto/internal/cpu_detect.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TURBO_INTERNAL_HAVE_AES_HASH 1
+#include <immintrin.h>
+#define TURBO_INTERNAL_TARGET_AES __attribute__((target("aes,sse2")))
+#endif
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace hash_internal {
+
+#ifdef TURBO_INTERNAL_HAVE_AES_HASH
+
+namespace {
+
+// Digits of the fractional part of pi, used to derive the round keys.
+constexpr uint64_t kPi[8] = {
+    uint64_t{0x243F6A8885A308D3}, uint64_t{0x13198A2E03707344},
+    uint64_t{0xA4093822299F31D0}, uint64_t{0x082EFA98EC4E6C89},
+    uint64_t{0x452821E638D01377}, uint64_t{0xBE5466CF34E90C6C},
+    uint64_t{0xC0AC29B7C97C50DD}, uint64_t{0x3F84D5B5B5470917},
+};
+
+inline TURBO_INTERNAL_TARGET_AES __m128i Load(const unsigned char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline TURBO_INTERNAL_TARGET_AES __m128i Round(__m128i state, __m128i key) {
+  return _mm_aesenc_si128(state, key);
+}
+
+// Combines the lanes and runs enough rounds for every input bit to affect
+// every output bit, then folds the 128-bit state to 64 bits.
+inline TURBO_INTERNAL_TARGET_AES uint64_t Finalize(__m128i a, __m128i b,
+                                                   __m128i k0, __m128i k1) {
+  __m128i h = Round(a, b);
+  h = Round(h, k0);
+  h = Round(h, k1);
+  h = Round(h, k0);
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(h)) ^
+         static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(h, h)));
+}
+
+TURBO_INTERNAL_TARGET_AES uint64_t AesHashImpl(const unsigned char* ptr,
+                                               size_t len, uint64_t seed) {
+  // The length is folded into the keys so that zero padding of short inputs
+  // and the overlapping loads below cannot produce equal states for inputs of
+  // different lengths.
+  const __m128i k0 = _mm_set_epi64x(static_cast<int64_t>(seed ^ kPi[0]),
+                                    static_cast<int64_t>(len ^ kPi[1]));
+  const __m128i k1 = _mm_set_epi64x(static_cast<int64_t>(seed + kPi[2]),
+                                    static_cast<int64_t>(kPi[3]));
+  if (len <= 16) {
+    unsigned char buf[16] = {};
+    if (len > 0) memcpy(buf, ptr, len);
+    return Finalize(_mm_xor_si128(Load(buf), k0), k1, k0, k1);
+  }
+
+  const __m128i k2 = _mm_set_epi64x(static_cast<int64_t>(seed ^ kPi[4]),
+                                    static_cast<int64_t>(kPi[5]));
+  const __m128i k3 = _mm_set_epi64x(static_cast<int64_t>(seed + kPi[6]),
+                                    static_cast<int64_t>(kPi[7]));
+  if (len <= 32) {
+    // Two lanes over the (possibly overlapping) first and last 16 bytes.
+    __m128i a = Round(_mm_xor_si128(Load(ptr), k0), k1);
+    __m128i b = Round(_mm_xor_si128(Load(ptr + len - 16), k2), k3);
+    return Finalize(a, b, k0, k1);
+  }
+
+  __m128i s0 = k0;
+  __m128i s1 = k1;
+  __m128i s2 = k2;
+  __m128i s3 = k3;
+  if (len > 64) {
+    // Four independent lanes absorbing 64 bytes per iteration.
+    const unsigned char* last = ptr + len - 64;
+    do {
+      s0 = Round(_mm_xor_si128(s0, Load(ptr)), k1);
+      s1 = Round(_mm_xor_si128(s1, Load(ptr + 16)), k2);
+      s2 = Round(_mm_xor_si128(s2, Load(ptr + 32)), k3);
+      s3 = Round(_mm_xor_si128(s3, Load(ptr + 48)), k0);
+      ptr += 64;
+    } while (ptr < last);
+    // The final (possibly overlapping) 64 bytes.
+    ptr = last;
+    s0 = Round(_mm_xor_si128(s0, Load(ptr)), k1);
+    s1 = Round(_mm_xor_si128(s1, Load(ptr + 16)), k2);
+    s2 = Round(_mm_xor_si128(s2, Load(ptr + 32)), k3);
+    s3 = Round(_mm_xor_si128(s3, Load(ptr + 48)), k0);
+  } else {
+    // 33 to 64 bytes: the first and last 32 bytes, which may overlap.
+    const unsigned char* tail = ptr + len - 32;
+    s0 = Round(_mm_xor_si128(s0, Load(ptr)), k1);
+    s1 = Round(_mm_xor_si128(s1, Load(ptr + 16)), k2);
+    s2 = Round(_mm_xor_si128(s2, Load(tail)), k3);
+    s3 = Round(_mm_xor_si128(s3, Load(tail + 16)), k0);
+  }
+  return Finalize(Round(s0, s2), Round(s1, s3), k0, k1);
+}
+
+}  // namespace
+
+bool AesHashSupported() {
+  static const bool supported = crc_internal::SupportsX86AesNi();
+  return supported;
+}
+
+uint64_t AesHash(const void* data, size_t len, uint64_t seed) {
+  return AesHashImpl(static_cast<const unsigned char*>(data), len, seed);
+}
+
+#else  // TURBO_INTERNAL_HAVE_AES_HASH
+
+bool AesHashSupported() { return false; }
+
+uint64_t AesHash(const void*, size_t, uint64_t) { return 0; }
+
+#endif  // TURBO_INTERNAL_HAVE_AES_HASH
+
+}  // namespace hash_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,48 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file provides AesHash, a hash function for byte arrays built from AES
+// encryption rounds as provided by the x86 AES-NI instructions. Input is
+// absorbed 16 bytes per round in up to four independent lanes, which gives it
+// a short dependency chain on small inputs and high throughput on large ones.
+// Like LowLevelHash this is not meant to be secure - just fast.
+//
+// `turbo::Hash` uses AesHash for inputs longer than 16 bytes when built with
+// `TURBO_OPTION_HASH_AES` set to 1 and running on a CPU supporting AES-NI.
+
+#ifndef TURBO_HASH_INTERNAL_AES_HASH_H_
+#define TURBO_HASH_INTERNAL_AES_HASH_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace hash_internal {
+
+// Returns true if AesHash() is implemented for this platform and the host CPU
+// supports the instructions it needs.
+bool AesHashSupported();
+
+// Hash function for a byte array of any length, mixed with a 64-bit seed.
+// Must only be called if AesHashSupported() returns true.
+uint64_t AesHash(const void* data, size_t len, uint64_t seed);
+
+}  // namespace hash_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_HASH_INTERNAL_AES_HASH_H_
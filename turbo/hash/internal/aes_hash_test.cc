@@ -0,0 +1,146 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/internal/aes_hash.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/base/bits.h"
+#include "turbo/container/flat_hash_set.h"
+#include "turbo/random/random.h"
+
+namespace {
+
+using turbo::hash_internal::AesHash;
+using turbo::hash_internal::AesHashSupported;
+
+class AesHashTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!AesHashSupported()) GTEST_SKIP() << "AES-NI is not available";
+  }
+
+  std::string RandomBytes(size_t len) {
+    std::string s(len, '\0');
+    for (char& c : s) c = static_cast<char>(turbo::Uniform<uint8_t>(gen_));
+    return s;
+  }
+
+  turbo::BitGen gen_;
+};
+
+TEST_F(AesHashTest, Deterministic) {
+  for (size_t len = 0; len <= 1024; ++len) {
+    std::string s = RandomBytes(len);
+    std::string copy = s;
+    EXPECT_EQ(AesHash(s.data(), len, 42), AesHash(copy.data(), len, 42))
+        << len;
+  }
+}
+
+TEST_F(AesHashTest, IndependentOfAlignment) {
+  std::string s = RandomBytes(300);
+  std::vector<char> buffer(s.size() + 16);
+  for (size_t len : {0, 1, 15, 16, 17, 32, 33, 64, 65, 100, 300}) {
+    const uint64_t expected = AesHash(s.data(), len, 1);
+    for (size_t offset = 0; offset < 16; ++offset) {
+      memcpy(buffer.data() + offset, s.data(), len);
+      EXPECT_EQ(expected, AesHash(buffer.data() + offset, len, 1))
+          << len << " " << offset;
+    }
+  }
+}
+
+TEST_F(AesHashTest, SeedChangesHash) {
+  for (size_t len : {0, 8, 16, 24, 48, 64, 200, 1024}) {
+    std::string s = RandomBytes(len);
+    EXPECT_NE(AesHash(s.data(), len, 0), AesHash(s.data(), len, 1)) << len;
+  }
+}
+
+// Zero-filled inputs of every length must all hash differently, which checks
+// that the length is mixed in and the overlapping loads do not cancel out.
+TEST_F(AesHashTest, LengthChangesHash) {
+  const std::string zeros(1024, '\0');
+  turbo::flat_hash_set<uint64_t> hashes;
+  for (size_t len = 0; len <= zeros.size(); ++len) {
+    EXPECT_TRUE(hashes.insert(AesHash(zeros.data(), len, 0)).second) << len;
+  }
+}
+
+// Every input with one or two bits set must hash differently (the SMHasher
+// "sparse keys" test) for lengths covering each code path.
+TEST_F(AesHashTest, SparseKeys) {
+  for (size_t len : {4, 16, 24, 40, 96, 256}) {
+    std::string s(len, '\0');
+    turbo::flat_hash_set<uint64_t> hashes;
+    const size_t bits = len * 8;
+    for (size_t i = 0; i < bits; ++i) {
+      s[i / 8] ^= static_cast<char>(1 << (i % 8));
+      EXPECT_TRUE(hashes.insert(AesHash(s.data(), len, 0)).second);
+      for (size_t j = i + 1; j < bits && j < i + 64; ++j) {
+        s[j / 8] ^= static_cast<char>(1 << (j % 8));
+        EXPECT_TRUE(hashes.insert(AesHash(s.data(), len, 0)).second);
+        s[j / 8] ^= static_cast<char>(1 << (j % 8));
+      }
+      s[i / 8] ^= static_cast<char>(1 << (i % 8));
+    }
+  }
+}
+
+// Flipping any single input bit must flip each output bit with a probability
+// close to 1/2 (the SMHasher "avalanche" test).
+TEST_F(AesHashTest, Avalanche) {
+  constexpr int kTrials = 200;
+  for (size_t len : {3, 16, 17, 31, 48, 64, 65, 130, 1024}) {
+    std::vector<int> flips(len * 8 * 64);
+    for (int trial = 0; trial < kTrials; ++trial) {
+      std::string s = RandomBytes(len);
+      const uint64_t seed = turbo::Uniform<uint64_t>(gen_);
+      const uint64_t h = AesHash(s.data(), len, seed);
+      for (size_t bit = 0; bit < len * 8; ++bit) {
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        uint64_t diff = h ^ AesHash(s.data(), len, seed);
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        while (diff != 0) {
+          flips[bit * 64 + static_cast<size_t>(turbo::countr_zero(diff))]++;
+          diff &= diff - 1;
+        }
+      }
+    }
+    // With 200 trials the expected count is 100 with a standard deviation of
+    // about 7; this bounds each input/output bit pair at about 7 sigma.
+    for (size_t i = 0; i < flips.size(); ++i) {
+      ASSERT_GT(flips[i], 50) << "len=" << len << " in=" << i / 64
+                              << " out=" << i % 64;
+      ASSERT_LT(flips[i], 150) << "len=" << len << " in=" << i / 64
+                               << " out=" << i % 64;
+    }
+  }
+}
+
+// The 64-byte block loop must depend on the order of the blocks.
+TEST_F(AesHashTest, BlockOrderMatters) {
+  std::string a = RandomBytes(64);
+  std::string b = RandomBytes(64);
+  std::string ab = a + b + a;
+  std::string ba = b + a + a;
+  EXPECT_NE(AesHash(ab.data(), ab.size(), 0), AesHash(ba.data(), ba.size(), 0));
+}
+
+}  // namespace
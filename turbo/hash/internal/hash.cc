@@ -14,6 +14,8 @@
 
 #include "turbo/hash/internal/hash.h"
 
+#include "turbo/hash/internal/aes_hash.h"
+
 namespace turbo {
 TURBO_NAMESPACE_BEGIN
 namespace hash_internal {
@@ -61,6 +63,9 @@ constexpr uint64_t kHashSalt[5] = {
 
 uint64_t MixingHashState::LowLevelHashImpl(const unsigned char* data,
                                            size_t len) {
+#if TURBO_OPTION_HASH_AES
+  if (AesHashSupported()) return AesHash(data, len, Seed());
+#endif
   return LowLevelHash(data, len, Seed(), kHashSalt);
 }
 
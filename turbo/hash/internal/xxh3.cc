@@ -0,0 +1,581 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/internal/xxh3.h"
+
+#include <cstring>
+
+#include "turbo/base/bits.h"
+#include "turbo/base/endian.h"
+#include "turbo/base/int128.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TURBO_INTERNAL_XXH3_SSE2 1
+#endif
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace hash_internal {
+namespace {
+
+constexpr uint64_t kPrime32_1 = 0x9E3779B1U;
+constexpr uint64_t kPrime32_2 = 0x85EBCA77U;
+constexpr uint64_t kPrime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87U;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FU;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9U;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63U;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5U;
+constexpr uint64_t kPrimeMx1 = 0x165667919E3779F9U;
+constexpr uint64_t kPrimeMx2 = 0x9FB21C651E98DF25U;
+
+constexpr size_t kStripeLen = 64;
+constexpr size_t kSecretSize = 192;
+constexpr size_t kSecretConsumeRate = 8;
+constexpr size_t kSecretLimit = kSecretSize - kStripeLen;
+constexpr size_t kStripesPerBlock = kSecretLimit / kSecretConsumeRate;
+constexpr size_t kSecretLastAccStart = 7;
+constexpr size_t kSecretMergeAccsStart = 11;
+constexpr size_t kMidSizeMax = 240;
+constexpr size_t kMidSizeStartOffset = 3;
+constexpr size_t kMidSizeLastOffset = 17;
+constexpr size_t kSecretSizeMin = 136;
+
+// The default secret of the specification.
+alignas(16) constexpr unsigned char kSecret[kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
+    0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e,
+    0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6,
+    0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97,
+    0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7,
+    0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83,
+    0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26,
+    0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f,
+    0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint64_t Read64(const unsigned char* p) {
+  return turbo::little_endian::Load64(p);
+}
+
+inline uint64_t Read32(const unsigned char* p) {
+  return turbo::little_endian::Load32(p);
+}
+
+inline uint64_t MulFold64(uint64_t lhs, uint64_t rhs) {
+  turbo::uint128 product = lhs;
+  product *= rhs;
+  return turbo::Uint128Low64(product) ^ turbo::Uint128High64(product);
+}
+
+inline uint64_t XorShift(uint64_t v, int shift) { return v ^ (v >> shift); }
+
+uint64_t Xxh64Avalanche(uint64_t h) {
+  h = XorShift(h, 33) * kPrime64_2;
+  h = XorShift(h, 29) * kPrime64_3;
+  return XorShift(h, 32);
+}
+
+uint64_t Avalanche(uint64_t h) {
+  h = XorShift(h, 37) * kPrimeMx1;
+  return XorShift(h, 32);
+}
+
+uint64_t RrMxMx(uint64_t h, uint64_t len) {
+  h ^= turbo::rotl(h, 49) ^ turbo::rotl(h, 24);
+  h *= kPrimeMx2;
+  h ^= (h >> 35) + len;
+  h *= kPrimeMx2;
+  return XorShift(h, 28);
+}
+
+uint64_t Len1To3(const unsigned char* p, size_t len, const unsigned char* secret,
+                 uint64_t seed) {
+  const uint32_t combined = (uint32_t{p[0]} << 16) |
+                            (uint32_t{p[len >> 1]} << 24) |
+                            uint32_t{p[len - 1]} |
+                            (static_cast<uint32_t>(len) << 8);
+  const uint64_t bitflip = (Read32(secret) ^ Read32(secret + 4)) + seed;
+  return Xxh64Avalanche(uint64_t{combined} ^ bitflip);
+}
+
+uint64_t Len4To8(const unsigned char* p, size_t len, const unsigned char* secret,
+                 uint64_t seed) {
+  seed ^= uint64_t{turbo::gbswap_32(static_cast<uint32_t>(seed))} << 32;
+  const uint64_t input1 = Read32(p);
+  const uint64_t input2 = Read32(p + len - 4);
+  const uint64_t bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+  const uint64_t input64 = input2 + (input1 << 32);
+  return RrMxMx(input64 ^ bitflip, len);
+}
+
+uint64_t Len9To16(const unsigned char* p, size_t len,
+                  const unsigned char* secret, uint64_t seed) {
+  const uint64_t bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+  const uint64_t bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+  const uint64_t lo = Read64(p) ^ bitflip1;
+  const uint64_t hi = Read64(p + len - 8) ^ bitflip2;
+  const uint64_t acc = len + turbo::gbswap_64(lo) + hi + MulFold64(lo, hi);
+  return Avalanche(acc);
+}
+
+uint64_t Len0To16(const unsigned char* p, size_t len,
+                  const unsigned char* secret, uint64_t seed) {
+  if (len > 8) return Len9To16(p, len, secret, seed);
+  if (len >= 4) return Len4To8(p, len, secret, seed);
+  if (len > 0) return Len1To3(p, len, secret, seed);
+  return Xxh64Avalanche(seed ^ (Read64(secret + 56) ^ Read64(secret + 64)));
+}
+
+inline uint64_t Mix16(const unsigned char* p, const unsigned char* secret,
+                      uint64_t seed) {
+  return MulFold64(Read64(p) ^ (Read64(secret) + seed),
+                   Read64(p + 8) ^ (Read64(secret + 8) - seed));
+}
+
+uint64_t Len17To128(const unsigned char* p, size_t len,
+                    const unsigned char* secret, uint64_t seed) {
+  uint64_t acc = len * kPrime64_1;
+  if (len > 32) {
+    if (len > 64) {
+      if (len > 96) {
+        acc += Mix16(p + 48, secret + 96, seed);
+        acc += Mix16(p + len - 64, secret + 112, seed);
+      }
+      acc += Mix16(p + 32, secret + 64, seed);
+      acc += Mix16(p + len - 48, secret + 80, seed);
+    }
+    acc += Mix16(p + 16, secret + 32, seed);
+    acc += Mix16(p + len - 32, secret + 48, seed);
+  }
+  acc += Mix16(p, secret, seed);
+  acc += Mix16(p + len - 16, secret + 16, seed);
+  return Avalanche(acc);
+}
+
+uint64_t Len129To240(const unsigned char* p, size_t len,
+                     const unsigned char* secret, uint64_t seed) {
+  uint64_t acc = len * kPrime64_1;
+  for (size_t i = 0; i < 8; ++i) {
+    acc += Mix16(p + 16 * i, secret + 16 * i, seed);
+  }
+  acc = Avalanche(acc);
+  uint64_t acc_end =
+      Mix16(p + len - 16, secret + kSecretSizeMin - kMidSizeLastOffset, seed);
+  const size_t rounds = len / 16;
+  for (size_t i = 8; i < rounds; ++i) {
+    acc_end += Mix16(p + 16 * i, secret + 16 * (i - 8) + kMidSizeStartOffset,
+                     seed);
+  }
+  return Avalanche(acc + acc_end);
+}
+
+// The 128-bit variants of the short input paths.
+
+turbo::uint128 Mul64To128(uint64_t lhs, uint64_t rhs) {
+  turbo::uint128 product = lhs;
+  return product * rhs;
+}
+
+turbo::uint128 Len1To3_128(const unsigned char* p, size_t len,
+                           const unsigned char* secret, uint64_t seed) {
+  const uint32_t combined_lo = (uint32_t{p[0]} << 16) |
+                               (uint32_t{p[len >> 1]} << 24) |
+                               uint32_t{p[len - 1]} |
+                               (static_cast<uint32_t>(len) << 8);
+  const uint32_t combined_hi = turbo::rotl(turbo::gbswap_32(combined_lo), 13);
+  const uint64_t bitflip_lo = (Read32(secret) ^ Read32(secret + 4)) + seed;
+  const uint64_t bitflip_hi = (Read32(secret + 8) ^ Read32(secret + 12)) - seed;
+  return turbo::MakeUint128(Xxh64Avalanche(combined_hi ^ bitflip_hi),
+                            Xxh64Avalanche(combined_lo ^ bitflip_lo));
+}
+
+turbo::uint128 Len4To8_128(const unsigned char* p, size_t len,
+                           const unsigned char* secret, uint64_t seed) {
+  seed ^= uint64_t{turbo::gbswap_32(static_cast<uint32_t>(seed))} << 32;
+  const uint64_t input64 = Read32(p) + (Read32(p + len - 4) << 32);
+  const uint64_t bitflip = (Read64(secret + 16) ^ Read64(secret + 24)) + seed;
+  const turbo::uint128 m =
+      Mul64To128(input64 ^ bitflip, kPrime64_1 + (len << 2));
+  uint64_t high = turbo::Uint128High64(m);
+  uint64_t low = turbo::Uint128Low64(m);
+  high += low << 1;
+  low ^= high >> 3;
+  low = XorShift(low, 35) * kPrimeMx2;
+  low = XorShift(low, 28);
+  return turbo::MakeUint128(Avalanche(high), low);
+}
+
+turbo::uint128 Len9To16_128(const unsigned char* p, size_t len,
+                            const unsigned char* secret, uint64_t seed) {
+  const uint64_t bitflip_lo = (Read64(secret + 32) ^ Read64(secret + 40)) - seed;
+  const uint64_t bitflip_hi = (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+  const uint64_t input_lo = Read64(p);
+  uint64_t input_hi = Read64(p + len - 8);
+  const turbo::uint128 m =
+      Mul64To128(input_lo ^ input_hi ^ bitflip_lo, kPrime64_1);
+  uint64_t m_low = turbo::Uint128Low64(m) + (uint64_t{len - 1} << 54);
+  input_hi ^= bitflip_hi;
+  const uint64_t m_high = turbo::Uint128High64(m) + input_hi +
+                          (input_hi & 0xFFFFFFFF) * (kPrime32_2 - 1);
+  m_low ^= turbo::gbswap_64(m_high);
+  const turbo::uint128 h = Mul64To128(m_low, kPrime64_2);
+  return turbo::MakeUint128(
+      Avalanche(turbo::Uint128High64(h) + m_high * kPrime64_2),
+      Avalanche(turbo::Uint128Low64(h)));
+}
+
+turbo::uint128 Len0To16_128(const unsigned char* p, size_t len,
+                            const unsigned char* secret, uint64_t seed) {
+  if (len > 8) return Len9To16_128(p, len, secret, seed);
+  if (len >= 4) return Len4To8_128(p, len, secret, seed);
+  if (len > 0) return Len1To3_128(p, len, secret, seed);
+  const uint64_t bitflip_lo = Read64(secret + 64) ^ Read64(secret + 72);
+  const uint64_t bitflip_hi = Read64(secret + 80) ^ Read64(secret + 88);
+  return turbo::MakeUint128(Xxh64Avalanche(seed ^ bitflip_hi),
+                            Xxh64Avalanche(seed ^ bitflip_lo));
+}
+
+struct Acc128 {
+  uint64_t low;
+  uint64_t high;
+};
+
+inline void Mix32(Acc128* acc, const unsigned char* p1,
+                  const unsigned char* p2, const unsigned char* secret,
+                  uint64_t seed) {
+  acc->low += Mix16(p1, secret, seed);
+  acc->low ^= Read64(p2) + Read64(p2 + 8);
+  acc->high += Mix16(p2, secret + 16, seed);
+  acc->high ^= Read64(p1) + Read64(p1 + 8);
+}
+
+turbo::uint128 Finalize128(const Acc128& acc, size_t len, uint64_t seed) {
+  const uint64_t low = acc.low + acc.high;
+  const uint64_t high = acc.low * kPrime64_1 + acc.high * kPrime64_4 +
+                        (len - seed) * kPrime64_2;
+  return turbo::MakeUint128(0 - Avalanche(high), Avalanche(low));
+}
+
+turbo::uint128 Len17To128_128(const unsigned char* p, size_t len,
+                              const unsigned char* secret, uint64_t seed) {
+  Acc128 acc = {len * kPrime64_1, 0};
+  if (len > 32) {
+    if (len > 64) {
+      if (len > 96) Mix32(&acc, p + 48, p + len - 64, secret + 96, seed);
+      Mix32(&acc, p + 32, p + len - 48, secret + 64, seed);
+    }
+    Mix32(&acc, p + 16, p + len - 32, secret + 32, seed);
+  }
+  Mix32(&acc, p, p + len - 16, secret, seed);
+  return Finalize128(acc, len, seed);
+}
+
+turbo::uint128 Len129To240_128(const unsigned char* p, size_t len,
+                               const unsigned char* secret, uint64_t seed) {
+  Acc128 acc = {len * kPrime64_1, 0};
+  for (size_t i = 32; i < 160; i += 32) {
+    Mix32(&acc, p + i - 32, p + i - 16, secret + i - 32, seed);
+  }
+  acc.low = Avalanche(acc.low);
+  acc.high = Avalanche(acc.high);
+  for (size_t i = 160; i <= len; i += 32) {
+    Mix32(&acc, p + i - 32, p + i - 16,
+          secret + kMidSizeStartOffset + i - 160, seed);
+  }
+  Mix32(&acc, p + len - 16, p + len - 32,
+        secret + kSecretSizeMin - kMidSizeLastOffset - 16, 0 - seed);
+  return Finalize128(acc, len, seed);
+}
+
+// Long inputs. The accumulator array must be 16-byte aligned.
+
+#ifdef TURBO_INTERNAL_XXH3_SSE2
+
+inline void Accumulate512(uint64_t* acc, const unsigned char* p,
+                          const unsigned char* secret) {
+  __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+  for (size_t i = 0; i < kStripeLen / sizeof(__m128i); ++i) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p) + i);
+    const __m128i key =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+    const __m128i data_key = _mm_xor_si128(data, key);
+    // The low 32 bits of each lane times its high 32 bits.
+    const __m128i product = _mm_mul_epu32(
+        data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+    // Adds the input to the adjacent lane.
+    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], swapped));
+  }
+}
+
+inline void ScrambleAcc(uint64_t* acc, const unsigned char* secret) {
+  __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+  const __m128i prime32 = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+  for (size_t i = 0; i < kStripeLen / sizeof(__m128i); ++i) {
+    const __m128i shifted = _mm_xor_si128(xacc[i], _mm_srli_epi64(xacc[i], 47));
+    const __m128i key =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+    const __m128i data_key = _mm_xor_si128(shifted, key);
+    // 64-bit multiplication by a 32-bit prime from two 32x32 products.
+    const __m128i data_key_hi =
+        _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+    const __m128i prod_lo = _mm_mul_epu32(data_key, prime32);
+    const __m128i prod_hi = _mm_mul_epu32(data_key_hi, prime32);
+    xacc[i] = _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32));
+  }
+}
+
+#else  // TURBO_INTERNAL_XXH3_SSE2
+
+inline void Accumulate512(uint64_t* acc, const unsigned char* p,
+                          const unsigned char* secret) {
+  for (size_t i = 0; i < 8; ++i) {
+    const uint64_t data = Read64(p + 8 * i);
+    const uint64_t data_key = data ^ Read64(secret + 8 * i);
+    acc[i ^ 1] += data;
+    acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+  }
+}
+
+inline void ScrambleAcc(uint64_t* acc, const unsigned char* secret) {
+  for (size_t i = 0; i < 8; ++i) {
+    acc[i] = (XorShift(acc[i], 47) ^ Read64(secret + 8 * i)) * kPrime32_1;
+  }
+}
+
+#endif  // TURBO_INTERNAL_XXH3_SSE2
+
+inline void Accumulate(uint64_t* acc, const unsigned char* p,
+                       const unsigned char* secret, size_t stripes) {
+  for (size_t n = 0; n < stripes; ++n) {
+    Accumulate512(acc, p + n * kStripeLen, secret + n * kSecretConsumeRate);
+  }
+}
+
+void InitAcc(uint64_t* acc) {
+  acc[0] = kPrime32_3;
+  acc[1] = kPrime64_1;
+  acc[2] = kPrime64_2;
+  acc[3] = kPrime64_3;
+  acc[4] = kPrime64_4;
+  acc[5] = kPrime32_2;
+  acc[6] = kPrime64_5;
+  acc[7] = kPrime32_1;
+}
+
+void InitSecret(unsigned char* secret, uint64_t seed) {
+  for (size_t i = 0; i < kSecretSize; i += 16) {
+    turbo::little_endian::Store64(secret + i, Read64(kSecret + i) + seed);
+    turbo::little_endian::Store64(secret + i + 8,
+                                  Read64(kSecret + i + 8) - seed);
+  }
+}
+
+uint64_t MergeAccs(const uint64_t* acc, const unsigned char* secret,
+                   uint64_t start) {
+  uint64_t result = start;
+  for (size_t i = 0; i < 4; ++i) {
+    result += MulFold64(acc[2 * i] ^ Read64(secret + 16 * i),
+                        acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+  }
+  return Avalanche(result);
+}
+
+// Accumulates all of `p[0, len)`, len > 240, into `acc`.
+void HashLongLoop(uint64_t* acc, const unsigned char* p, size_t len,
+                  const unsigned char* secret) {
+  InitAcc(acc);
+  constexpr size_t kBlockLen = kStripeLen * kStripesPerBlock;
+  const size_t blocks = (len - 1) / kBlockLen;
+  for (size_t n = 0; n < blocks; ++n) {
+    Accumulate(acc, p + n * kBlockLen, secret, kStripesPerBlock);
+    ScrambleAcc(acc, secret + kSecretLimit);
+  }
+  const size_t stripes = ((len - 1) - kBlockLen * blocks) / kStripeLen;
+  Accumulate(acc, p + blocks * kBlockLen, secret, stripes);
+  // The last stripe, which may overlap the previous one.
+  Accumulate512(acc, p + len - kStripeLen,
+                secret + kSecretLimit - kSecretLastAccStart);
+}
+
+uint64_t Merge64(const uint64_t* acc, const unsigned char* secret,
+                 uint64_t len) {
+  return MergeAccs(acc, secret + kSecretMergeAccsStart, len * kPrime64_1);
+}
+
+turbo::uint128 Merge128(const uint64_t* acc, const unsigned char* secret,
+                        uint64_t len) {
+  const uint64_t low = Merge64(acc, secret, len);
+  const uint64_t high =
+      MergeAccs(acc, secret + kSecretSize - 64 - kSecretMergeAccsStart,
+                ~(len * kPrime64_2));
+  return turbo::MakeUint128(high, low);
+}
+
+// Accumulates the stripes in `p[0, 64 * stripes)` into `acc`, continuing a
+// block of which `*stripes_so_far` stripes were already consumed.
+void ConsumeStripes(uint64_t* acc, size_t* stripes_so_far,
+                    const unsigned char* p, size_t stripes,
+                    const unsigned char* secret) {
+  const unsigned char* block_secret =
+      secret + *stripes_so_far * kSecretConsumeRate;
+  if (stripes >= kStripesPerBlock - *stripes_so_far) {
+    size_t stripes_this_block = kStripesPerBlock - *stripes_so_far;
+    do {
+      Accumulate(acc, p, block_secret, stripes_this_block);
+      ScrambleAcc(acc, secret + kSecretLimit);
+      p += stripes_this_block * kStripeLen;
+      stripes -= stripes_this_block;
+      stripes_this_block = kStripesPerBlock;
+      block_secret = secret;
+    } while (stripes >= kStripesPerBlock);
+    *stripes_so_far = 0;
+  }
+  if (stripes > 0) {
+    Accumulate(acc, p, block_secret, stripes);
+    *stripes_so_far += stripes;
+  }
+}
+
+}  // namespace
+
+uint64_t Xxh3Hash64(const void* data, size_t len, uint64_t seed) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  if (len <= 16) return Len0To16(p, len, kSecret, seed);
+  if (len <= 128) return Len17To128(p, len, kSecret, seed);
+  if (len <= kMidSizeMax) return Len129To240(p, len, kSecret, seed);
+  alignas(16) uint64_t acc[8];
+  if (seed == 0) {
+    HashLongLoop(acc, p, len, kSecret);
+    return Merge64(acc, kSecret, len);
+  }
+  alignas(16) unsigned char secret[kSecretSize];
+  InitSecret(secret, seed);
+  HashLongLoop(acc, p, len, secret);
+  return Merge64(acc, secret, len);
+}
+
+turbo::uint128 Xxh3Hash128(const void* data, size_t len, uint64_t seed) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  if (len <= 16) return Len0To16_128(p, len, kSecret, seed);
+  if (len <= 128) return Len17To128_128(p, len, kSecret, seed);
+  if (len <= kMidSizeMax) return Len129To240_128(p, len, kSecret, seed);
+  alignas(16) uint64_t acc[8];
+  if (seed == 0) {
+    HashLongLoop(acc, p, len, kSecret);
+    return Merge128(acc, kSecret, len);
+  }
+  alignas(16) unsigned char secret[kSecretSize];
+  InitSecret(secret, seed);
+  HashLongLoop(acc, p, len, secret);
+  return Merge128(acc, secret, len);
+}
+
+Xxh3Hasher::Xxh3Hasher(uint64_t seed) : seed_(seed) { InitAcc(acc_); }
+
+void Xxh3Hasher::Update(const void* data, size_t len) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  total_len_ += len;
+  if (len <= kBufferSize - buffered_) {
+    if (len > 0) memcpy(buffer_ + buffered_, p, len);
+    buffered_ += len;
+    return;
+  }
+
+  if (!secret_ready_) {
+    InitSecret(secret_, seed_);
+    secret_ready_ = true;
+  }
+  const unsigned char* end = p + len;
+  constexpr size_t kBufferStripes = kBufferSize / kStripeLen;
+  if (buffered_ > 0) {
+    const size_t fill = kBufferSize - buffered_;
+    memcpy(buffer_ + buffered_, p, fill);
+    p += fill;
+    ConsumeStripes(acc_, &stripes_so_far_, buffer_, kBufferStripes, secret_);
+    buffered_ = 0;
+  }
+  if (static_cast<size_t>(end - p) > kBufferSize) {
+    // Consume all but the last (possibly partial) stripe directly from the
+    // input, and keep a copy of the last consumed stripe at the end of the
+    // buffer in case Digest() needs it to complete a short final stripe.
+    const size_t stripes = static_cast<size_t>(end - 1 - p) / kStripeLen;
+    ConsumeStripes(acc_, &stripes_so_far_, p, stripes, secret_);
+    p += stripes * kStripeLen;
+    memcpy(buffer_ + kBufferSize - kStripeLen, p - kStripeLen, kStripeLen);
+  }
+  buffered_ = static_cast<size_t>(end - p);
+  memcpy(buffer_, p, buffered_);
+}
+
+const unsigned char* Xxh3Hasher::DigestLong(
+    uint64_t* acc, unsigned char* local_secret) const {
+  const unsigned char* secret = secret_;
+  if (!secret_ready_) {
+    InitSecret(local_secret, seed_);
+    secret = local_secret;
+  }
+  memcpy(acc, acc_, sizeof(acc_));
+  unsigned char last_stripe[kStripeLen];
+  const unsigned char* last_stripe_ptr;
+  if (buffered_ >= kStripeLen) {
+    size_t stripes_so_far = stripes_so_far_;
+    ConsumeStripes(acc, &stripes_so_far, buffer_,
+                   (buffered_ - 1) / kStripeLen, secret);
+    last_stripe_ptr = buffer_ + buffered_ - kStripeLen;
+  } else {
+    // Completes the last stripe with the end of the previously consumed one.
+    const size_t catchup = kStripeLen - buffered_;
+    memcpy(last_stripe, buffer_ + kBufferSize - catchup, catchup);
+    memcpy(last_stripe + catchup, buffer_, buffered_);
+    last_stripe_ptr = last_stripe;
+  }
+  Accumulate512(acc, last_stripe_ptr,
+                secret + kSecretLimit - kSecretLastAccStart);
+  return secret;
+}
+
+uint64_t Xxh3Hasher::Digest() const {
+  if (total_len_ <= kMidSizeMax) {
+    return Xxh3Hash64(buffer_, static_cast<size_t>(total_len_), seed_);
+  }
+  alignas(16) uint64_t acc[8];
+  alignas(16) unsigned char local_secret[kSecretSize];
+  const unsigned char* secret = DigestLong(acc, local_secret);
+  return Merge64(acc, secret, total_len_);
+}
+
+turbo::uint128 Xxh3Hasher::Digest128() const {
+  if (total_len_ <= kMidSizeMax) {
+    return Xxh3Hash128(buffer_, static_cast<size_t>(total_len_), seed_);
+  }
+  alignas(16) uint64_t acc[8];
+  alignas(16) unsigned char local_secret[kSecretSize];
+  const unsigned char* secret = DigestLong(acc, local_secret);
+  return Merge128(acc, secret, total_len_);
+}
+
+}  // namespace hash_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
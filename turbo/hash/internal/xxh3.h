@@ -0,0 +1,91 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file provides an implementation of the 64 and 128-bit XXH3 hash
+// functions (https://github.com/Cyan4973/xxHash, algorithm specification
+// version 0.8). Results are identical to `XXH3_64bits_withSeed()` and
+// `XXH3_128bits_withSeed()` of the reference implementation on all platforms,
+// which makes them suitable for persisting and for exchanging with other
+// systems.
+//
+// Inputs longer than 240 bytes are processed in 64-byte stripes by eight
+// 64-bit accumulators, which use SSE2 where available.
+
+#ifndef TURBO_HASH_INTERNAL_XXH3_H_
+#define TURBO_HASH_INTERNAL_XXH3_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "turbo/base/int128.h"
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace hash_internal {
+
+// Returns the XXH3 64-bit hash of `data[0, len)` with the given `seed`.
+uint64_t Xxh3Hash64(const void* data, size_t len, uint64_t seed);
+
+// Returns the XXH3 128-bit hash of `data[0, len)` with the given `seed`.
+turbo::uint128 Xxh3Hash128(const void* data, size_t len, uint64_t seed);
+
+// Xxh3Hasher
+//
+// Streaming variant of Xxh3Hash64() and Xxh3Hash128(): feeding the input to
+// Update() in pieces of any size produces the same result as a single call on
+// the concatenated input.
+class Xxh3Hasher {
+ public:
+  explicit Xxh3Hasher(uint64_t seed = 0);
+
+  Xxh3Hasher(const Xxh3Hasher&) = default;
+  Xxh3Hasher& operator=(const Xxh3Hasher&) = default;
+
+  // Appends `data[0, len)` to the hashed input.
+  void Update(const void* data, size_t len);
+
+  // Returns the 64 or 128-bit hash of all input appended so far. Does not
+  // modify the state, more input may be appended afterwards.
+  uint64_t Digest() const;
+  turbo::uint128 Digest128() const;
+
+  uint64_t seed() const { return seed_; }
+
+ private:
+  static constexpr size_t kSecretSize = 192;
+  static constexpr size_t kBufferSize = 256;
+
+  // Consumes the buffered input into a copy of the accumulators, for inputs
+  // longer than 240 bytes, and returns the secret.
+  const unsigned char* DigestLong(uint64_t* acc,
+                                  unsigned char* local_secret) const;
+
+  alignas(16) uint64_t acc_[8];
+  // The secret derived from the seed, only initialized once the input is long
+  // enough to need it, so hashing short values stays cheap.
+  alignas(16) unsigned char secret_[kSecretSize];
+  unsigned char buffer_[kBufferSize];
+  uint64_t seed_;
+  uint64_t total_len_ = 0;
+  size_t buffered_ = 0;
+  size_t stripes_so_far_ = 0;
+  bool secret_ready_ = false;
+};
+
+}  // namespace hash_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_HASH_INTERNAL_XXH3_H_
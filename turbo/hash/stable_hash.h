@@ -0,0 +1,191 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: stable_hash.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::StableHash`, a hash functor whose values
+// may be persisted or sent to other processes, e.g. to pick the shard of a key
+// or to build on-disk hash tables. `turbo::Hash` cannot be used for this, its
+// values change between program invocations.
+//
+// `turbo::StableHash` hashes every type supported by the Turbo hashing
+// framework, including user types which define `TurboHashValue` (see
+// hash.h), with a fixed algorithm: the value is expanded into the byte
+// sequence produced by its `TurboHashValue` overload, and that sequence is
+// hashed with the 64-bit XXH3 hash function and the given seed.
+//
+// Example:
+//
+//   struct Key {
+//     std::string tenant;
+//     int64_t id;
+//
+//     template <typename H>
+//     friend H TurboHashValue(H h, const Key& k) {
+//       return H::combine(std::move(h), k.tenant, k.id);
+//     }
+//   };
+//
+//   size_t shard = turbo::StableHash<Key>{}(key) % num_shards;
+//
+// Stability guarantees
+//
+// The values of `kStableHashVersion` never change, in any process, build or
+// release of this library, for inputs whose byte expansion is the same. The
+// byte expansion is the same on all little-endian 64-bit platforms for
+// integers, floating point numbers, strings, `turbo::Cord`, and standard
+// containers and tuples of these types. It is NOT stable for types whose
+// `TurboHashValue` hashes pointers or other process specific state, nor for
+// types hashed through a `std::hash` specialization.
+//
+// `turbo::StableHashBytes()` hashes a plain byte sequence without framing and
+// is identical to `XXH3_64bits_withSeed()` of the reference xxHash library, so
+// its values can be reproduced by other languages and systems.
+
+#ifndef TURBO_HASH_STABLE_HASH_H_
+#define TURBO_HASH_STABLE_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "turbo/hash/hash.h"
+#include "turbo/hash/internal/xxh3.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// The version of the algorithm used by `turbo::StableHash`,
+// `turbo::StableHasher` and `turbo::StableHashBytes`.
+constexpr int kStableHashVersion = 1;
+
+class StableHasher;
+
+// StableHashState
+//
+// The hash state type passed to `TurboHashValue` by `turbo::StableHash`. User
+// code never needs to name it, `TurboHashValue` overloads should be templates
+// on the state type.
+class StableHashState : public hash_internal::HashStateBase<StableHashState> {
+ public:
+  StableHashState(StableHashState&&) = default;
+  StableHashState& operator=(StableHashState&&) = default;
+
+  // StableHashState::combine_contiguous()
+  //
+  // Fundamental base case for hash recursion: appends the given range of bytes
+  // to the hashed byte sequence.
+  static StableHashState combine_contiguous(StableHashState state,
+                                            const unsigned char* first,
+                                            size_t size) {
+    state.hasher_->Update(first, size);
+    return state;
+  }
+  using StableHashState::HashStateBase::combine_contiguous;
+
+ private:
+  explicit StableHashState(hash_internal::Xxh3Hasher* hasher)
+      : hasher_(hasher) {}
+
+  friend class StableHashState::HashStateBase;
+  friend class turbo::HashState;
+  friend class StableHasher;
+
+  // Unordered collections are hashed as the wrapping sum of the hashes of
+  // their elements, so the result does not depend on the iteration order.
+  template <typename CombinerT>
+  static StableHashState RunCombineUnordered(StableHashState state,
+                                             CombinerT combiner) {
+    const uint64_t seed = state.hasher_->seed();
+    uint64_t sum = 0;
+    hash_internal::Xxh3Hasher inner(seed);
+    combiner(StableHashState(&inner), [&](StableHashState&) {
+      sum += inner.Digest();
+      inner = hash_internal::Xxh3Hasher(seed);
+    });
+    return StableHashState::combine(std::move(state), sum);
+  }
+
+  hash_internal::Xxh3Hasher* hasher_;
+};
+
+// StableHasher
+//
+// Streaming interface to `turbo::StableHash`, for values which are too large
+// or too scattered to be hashed at once. Values and bytes added one after
+// another hash the same as a tuple of all the values:
+//
+//   turbo::StableHasher hasher(seed);
+//   hasher.Add(header.version, header.name);
+//   for (const Record& r : records) hasher.Add(r);
+//   uint64_t fingerprint = hasher.Digest();
+class StableHasher {
+ public:
+  explicit StableHasher(uint64_t seed = 0) : hasher_(seed) {}
+
+  // Appends the hash expansion of `values` to the hashed sequence.
+  template <typename... Ts>
+  StableHasher& Add(const Ts&... values) {
+    StableHashState::combine(StableHashState(&hasher_), values...);
+    return *this;
+  }
+
+  // Appends `bytes` as is, without any length framing.
+  StableHasher& AddBytes(turbo::string_view bytes) {
+    hasher_.Update(bytes.data(), bytes.size());
+    return *this;
+  }
+
+  // Returns the hash of everything added so far. More values may be added
+  // afterwards.
+  uint64_t Digest() const { return hasher_.Digest(); }
+
+ private:
+  hash_internal::Xxh3Hasher hasher_;
+};
+
+// StableHash
+//
+// A hash functor with stable values, see the top of this file.
+template <typename T>
+struct StableHash {
+  static_assert(hash_internal::is_hashable<T>::value,
+                "turbo::StableHash requires a type hashable by turbo::Hash");
+
+  StableHash() = default;
+  explicit StableHash(uint64_t seed) : seed_(seed) {}
+
+  uint64_t operator()(const T& value) const {
+    return StableHasher(seed_).Add(value).Digest();
+  }
+
+ private:
+  uint64_t seed_ = 0;
+};
+
+// StableHashBytes()
+//
+// Returns the XXH3 64-bit hash of `bytes` with `seed`.
+inline uint64_t StableHashBytes(turbo::string_view bytes, uint64_t seed = 0) {
+  return hash_internal::Xxh3Hash64(bytes.data(), bytes.size(), seed);
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_HASH_STABLE_HASH_H_
@@ -0,0 +1,203 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/hash/stable_hash.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/container/flat_hash_set.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+std::string TestBytes(size_t len) {
+  std::string s(len, '\0');
+  for (size_t i = 0; i < len; ++i) s[i] = static_cast<char>(i * 7 + 3);
+  return s;
+}
+
+std::string Le64(uint64_t v) {
+  std::string s(8, '\0');
+  for (int i = 0; i < 8; ++i) s[i] = static_cast<char>(v >> (8 * i));
+  return s;
+}
+
+// Values of XXH3_64bits_withSeed() from the reference implementation.
+TEST(StableHashBytes, MatchesReferenceXxh3) {
+  static const struct {
+    size_t len;
+    uint64_t seed;
+    uint64_t hash;
+  } kCases[] = {
+      {0, 0u, uint64_t{0x2d06800538d394c2}},
+      {0, 42u, uint64_t{0xb029411ff43d84d2}},
+      {3, 0u, uint64_t{0xa9088dda485b481c}},
+      {3, 42u, uint64_t{0x3a6eb7a191052c81}},
+      {8, 0u, uint64_t{0x60539db630471163}},
+      {8, 42u, uint64_t{0x53a895ca319fab31}},
+      {16, 0u, uint64_t{0xb8c859b0f030b585}},
+      {16, 42u, uint64_t{0x6b1b54f65d114c69}},
+      {100, 0u, uint64_t{0xb5937857f0d78c9f}},
+      {100, 42u, uint64_t{0x223ce4409957d0ce}},
+      {200, 0u, uint64_t{0x746cd0025327bf5b}},
+      {200, 42u, uint64_t{0xb04cc37ae5a4a48d}},
+      {1000, 0u, uint64_t{0x6c4f14bd97bd9e82}},
+      {1000, 42u, uint64_t{0xf0f163846cbf0c33}},
+  };
+  for (const auto& c : kCases) {
+    EXPECT_EQ(c.hash, turbo::StableHashBytes(TestBytes(c.len), c.seed))
+        << c.len << " " << c.seed;
+  }
+}
+
+// Feeding the input in pieces of any size, including the boundaries of the
+// internal buffer and of the accumulator blocks, must not change the result.
+TEST(StableHasher, StreamingMatchesOneShot) {
+  const std::string data = TestBytes(4000);
+  for (size_t len : {0, 1, 17, 129, 240, 241, 256, 257, 1024, 1025, 4000}) {
+    const uint64_t expected =
+        turbo::StableHashBytes(turbo::string_view(data.data(), len), 7);
+    for (size_t piece : {1, 13, 64, 255, 256, 1000}) {
+      turbo::StableHasher hasher(7);
+      for (size_t pos = 0; pos < len; pos += piece) {
+        hasher.AddBytes(turbo::string_view(data.data() + pos,
+                                           std::min(piece, len - pos)));
+      }
+      EXPECT_EQ(expected, hasher.Digest()) << len << " " << piece;
+    }
+  }
+}
+
+TEST(StableHasher, DigestDoesNotConsumeState) {
+  const std::string data = TestBytes(600);
+  turbo::StableHasher hasher;
+  hasher.AddBytes(turbo::string_view(data).substr(0, 300));
+  EXPECT_EQ(turbo::StableHashBytes(turbo::string_view(data).substr(0, 300)),
+            hasher.Digest());
+  hasher.AddBytes(turbo::string_view(data).substr(300));
+  EXPECT_EQ(turbo::StableHashBytes(data), hasher.Digest());
+}
+
+// The byte expansion of common types is part of the stability guarantee.
+TEST(StableHash, ByteExpansion) {
+  EXPECT_EQ(turbo::StableHashBytes(Le64(42)), turbo::StableHash<int64_t>{}(42));
+  EXPECT_EQ(turbo::StableHashBytes("abc" + Le64(3)),
+            turbo::StableHash<std::string>{}("abc"));
+  EXPECT_EQ(turbo::StableHashBytes("abc" + Le64(3), 5),
+            turbo::StableHash<turbo::string_view>(5)("abc"));
+}
+
+TEST(StableHash, Golden) {
+  EXPECT_EQ(uint64_t{0xc27a66ebdd1e5533},
+            (turbo::StableHash<std::pair<std::string, int64_t>>{}(
+                {"tenant", 42})));
+  EXPECT_EQ(uint64_t{0x7a77e527936446af},
+            turbo::StableHash<std::vector<int>>(7)({1, 2, 3}));
+}
+
+TEST(StableHash, SeedChangesHash) {
+  EXPECT_NE(turbo::StableHash<std::string>(1)("key"),
+            turbo::StableHash<std::string>(2)("key"));
+}
+
+TEST(StableHash, CordHashesLikeString) {
+  const std::string data = TestBytes(5000);
+  const turbo::Cord fragmented = turbo::MakeFragmentedCord(
+      {data.substr(0, 10), data.substr(10, 2000), data.substr(2010)});
+  EXPECT_EQ(turbo::StableHash<std::string>{}(data),
+            turbo::StableHash<turbo::Cord>{}(fragmented));
+  EXPECT_EQ(turbo::StableHash<std::string>{}(data),
+            turbo::StableHash<turbo::Cord>{}(turbo::Cord(data)));
+}
+
+TEST(StableHash, UnorderedContainersIgnoreOrder) {
+  std::unordered_set<std::string> a = {"one", "two", "three", "four"};
+  std::unordered_set<std::string> b(a.begin(), a.end(), 100);
+  EXPECT_EQ(turbo::StableHash<std::unordered_set<std::string>>{}(a),
+            turbo::StableHash<std::unordered_set<std::string>>{}(b));
+  turbo::flat_hash_set<int> c = {1, 2, 3};
+  turbo::flat_hash_set<int> d = {3, 2, 1};
+  d.reserve(1000);
+  EXPECT_EQ(turbo::StableHash<turbo::flat_hash_set<int>>{}(c),
+            turbo::StableHash<turbo::flat_hash_set<int>>{}(d));
+  EXPECT_NE(turbo::StableHash<turbo::flat_hash_set<int>>{}(c),
+            turbo::StableHash<turbo::flat_hash_set<int>>{}({1, 2, 4}));
+}
+
+struct Key {
+  std::string tenant;
+  int64_t id;
+
+  template <typename H>
+  friend H TurboHashValue(H h, const Key& k) {
+    return H::combine(std::move(h), k.tenant, k.id);
+  }
+};
+
+// A type hashed through the type-erased turbo::HashState.
+struct Erased {
+  std::vector<std::string> parts;
+
+  template <typename H>
+  friend H TurboHashValue(H h, const Erased& e) {
+    auto state = turbo::HashState::Create(&h);
+    for (const std::string& part : e.parts) {
+      state = turbo::HashState::combine(std::move(state), part);
+    }
+    return h;
+  }
+};
+
+TEST(StableHash, UserTypes) {
+  EXPECT_EQ((turbo::StableHash<std::tuple<std::string, int64_t>>{}(
+                std::make_tuple("a", 1))),
+            turbo::StableHash<Key>{}(Key{"a", 1}));
+  EXPECT_NE(turbo::StableHash<Key>{}(Key{"a", 1}),
+            turbo::StableHash<Key>{}(Key{"a", 2}));
+
+  turbo::StableHasher expected;
+  expected.Add(std::string("x"), std::string("y"));
+  EXPECT_EQ(expected.Digest(), turbo::StableHash<Erased>{}(Erased{{"x", "y"}}));
+}
+
+TEST(StableHasher, AddMatchesTuple) {
+  turbo::StableHasher hasher(3);
+  hasher.Add(std::string("name"));
+  hasher.Add(int32_t{7}, 2.5);
+  EXPECT_EQ(
+      (turbo::StableHash<std::tuple<std::string, int32_t, double>>(3)(
+          std::make_tuple("name", 7, 2.5))),
+      hasher.Digest());
+}
+
+TEST(StableHash, FewCollisions) {
+  turbo::flat_hash_set<uint64_t> hashes;
+  for (int64_t i = 0; i < 100000; ++i) {
+    hashes.insert(turbo::StableHash<int64_t>{}(i));
+  }
+  EXPECT_EQ(100000u, hashes.size());
+}
+
+}  // namespace
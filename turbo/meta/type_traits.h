@@ -37,6 +37,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <string>
 #include <type_traits>
 
 #include "turbo/platform/port.h"
@@ -229,4 +229,22 @@
 
 #define TURBO_OPTION_HARDENED 0
 
+// TURBO_OPTION_HASH_AES
+//
+// This option selects the hash function `turbo::Hash` uses for byte sequences
+// longer than 16 bytes, such as strings.
+//
+// A value of 0 means that `turbo::Hash` always uses the portable
+// multiply-based LowLevelHash.
+//
+// A value of 1 means that `turbo::Hash` uses a hash built from AES encryption
+// rounds when the host CPU supports the x86 AES-NI instructions, which is
+// checked once at runtime, and LowLevelHash otherwise.
+//
+// The AES backend is faster on long inputs on CPUs with fast AES units. Hash
+// values differ between the two backends, which is allowed as `turbo::Hash`
+// values are never stable across program invocations.
+
+#define TURBO_OPTION_HASH_AES 0
+
 #endif  // TURBO_PLATFORM_OPTIONS_H_
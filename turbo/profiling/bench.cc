@@ -0,0 +1,484 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/bench.h"
+
+#if defined(_WIN32)
+#include <windows.h>  // NOLINT
+#elif defined(__linux__) && !defined(__ANDROID__)
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "turbo/base/internal/raw_logging.h"
+#include "turbo/files/sequential_read_file.h"
+#include "turbo/json/document.h"
+#include "turbo/json/stringbuffer.h"
+#include "turbo/json/writer.h"
+#include "turbo/platform/internal/sysinfo.h"
+#include "turbo/random/internal/nanobenchmark.h"
+#include "turbo/strings/numbers.h"
+#include "turbo/strings/str_cat.h"
+#include "turbo/strings/str_format.h"
+#include "turbo/strings/strip.h"
+#include "turbo/synchronization/mutex.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+namespace nanobenchmark = random_internal_nanobenchmark;
+
+struct Benchmark {
+  std::string name;
+  BenchFunction function;
+  std::vector<size_t> inputs;
+};
+
+TURBO_CONST_INIT turbo::Mutex registry_mu(turbo::kConstInit);
+std::vector<Benchmark>* benchmarks TURBO_GUARDED_BY(registry_mu) = nullptr;
+
+// Pins the calling thread to `cpu` as `nanobenchmark::PinThreadToCPU()` does,
+// and restores its previous CPU affinity on destruction.
+class ScopedThreadPin {
+ public:
+  explicit ScopedThreadPin(int cpu) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    saved_ = sched_getaffinity(0, sizeof(mask_), &mask_) == 0;
+#endif
+    nanobenchmark::PinThreadToCPU(cpu);
+  }
+
+  ~ScopedThreadPin() {
+#if defined(_WIN32)
+    // Threads have no affinity getter: return to that of the process.
+    DWORD_PTR process_mask, system_mask;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask,
+                               &system_mask)) {
+      SetThreadAffinityMask(GetCurrentThread(), process_mask);
+    }
+#elif defined(__linux__) && !defined(__ANDROID__)
+    if (saved_ && sched_setaffinity(0, sizeof(mask_), &mask_) != 0) {
+      TURBO_RAW_LOG(WARNING, "Failed to restore the CPU affinity: errno %d",
+                    errno);
+    }
+#endif
+  }
+
+  ScopedThreadPin(const ScopedThreadPin&) = delete;
+  ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+ private:
+#if defined(__linux__) && !defined(__ANDROID__)
+  bool saved_ = false;
+  cpu_set_t mask_;
+#endif
+};
+
+double Median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  const size_t mid = values.size() / 2;
+  return values.size() % 2 == 1 ? values[mid]
+                                : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Combines the repetitions of one input, rejecting those further than
+// `options.outlier_mads` median absolute deviations from their median.
+BenchResult Summarize(const std::string& name, size_t input,
+                      const std::vector<nanobenchmark::Result>& repetitions,
+                      const BenchOptions& options, double ticks_per_second) {
+  std::vector<double> ticks;
+  for (const auto& repetition : repetitions) ticks.push_back(repetition.ticks);
+  const double median = Median(ticks);
+  std::vector<double> deviations;
+  for (double t : ticks) deviations.push_back(std::fabs(t - median));
+  // Repetitions which agree within the target precision are never outliers,
+  // even when most are identical and the deviation is zero.
+  const double mad = std::max(Median(deviations),
+                              std::fabs(median) * options.target_rel_mad);
+
+  BenchResult result;
+  result.name = name;
+  result.input = input;
+  double sum = 0;
+  double variability = 0;
+  for (const auto& repetition : repetitions) {
+    if (std::fabs(repetition.ticks - median) > options.outlier_mads * mad) {
+      ++result.outliers;
+      continue;
+    }
+    ++result.repetitions;
+    sum += repetition.ticks;
+    variability = std::max(variability,
+                           static_cast<double>(repetition.variability));
+  }
+  // Options rejecting every repetition leave the median as the best estimate.
+  result.ticks = result.repetitions > 0
+                     ? sum / static_cast<double>(result.repetitions)
+                     : median;
+  result.nanoseconds = result.ticks * 1e9 / ticks_per_second;
+  if (median != 0) {
+    variability = std::max(variability, Median(deviations) / median);
+  }
+  result.variability = variability;
+  return result;
+}
+
+// Returns the member `key` of `object`, or nullptr if it is missing or its
+// type does not match `is_type`.
+template <typename IsType>
+const rapidjson::Value* Member(const rapidjson::Value& object, const char* key,
+                               IsType is_type) {
+  auto it = object.FindMember(key);
+  if (it == object.MemberEnd() || !is_type(it->value)) return nullptr;
+  return &it->value;
+}
+
+turbo::Status ReadFile(const std::string& path, std::string* content) {
+  SequentialReadFile file;
+  turbo::Status status = file.open(path);
+  if (!status.ok()) return status;
+  return file.read(content);
+}
+
+turbo::Status WriteFile(const std::string& path, turbo::string_view content) {
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  if (file == nullptr) {
+    return turbo::ErrnoToStatus(errno, turbo::StrCat("fopen ", path));
+  }
+  const size_t written = std::fwrite(content.data(), 1, content.size(), file);
+  const int error = written == content.size() ? 0 : errno;
+  if (std::fclose(file) != 0 || error != 0) {
+    return turbo::ErrnoToStatus(error != 0 ? error : errno,
+                                turbo::StrCat("write ", path));
+  }
+  return turbo::OkStatus();
+}
+
+int BenchUsage(const char* program, turbo::string_view bad_flag) {
+  std::fprintf(stderr,
+               "%s: unknown or invalid flag '%.*s'\n"
+               "usage: %s [--filter=<substring>] [--cpu=<n>] [--no_pin]\n"
+               "       [--repetitions=<n>] [--json=<path>]\n"
+               "       [--compare=<baseline>,<contender>] "
+               "[--threshold=<ratio>]\n",
+               program, static_cast<int>(bad_flag.size()), bad_flag.data(),
+               program);
+  return 1;
+}
+
+}  // namespace
+
+void RegisterBenchmark(std::string name, BenchFunction function,
+                       std::vector<size_t> inputs) {
+  TURBO_RAW_CHECK(!inputs.empty(), "A benchmark needs at least one input");
+  turbo::MutexLock lock(&registry_mu);
+  if (benchmarks == nullptr) benchmarks = new std::vector<Benchmark>;
+  benchmarks->push_back(
+      Benchmark{std::move(name), std::move(function), std::move(inputs)});
+}
+
+std::vector<BenchResult> RunBenchmarks(const BenchOptions& options) {
+  std::vector<Benchmark> selected;
+  {
+    turbo::MutexLock lock(&registry_mu);
+    if (benchmarks != nullptr) {
+      for (const Benchmark& benchmark : *benchmarks) {
+        if (benchmark.name.find(options.filter) != std::string::npos) {
+          selected.push_back(benchmark);
+        }
+      }
+    }
+  }
+  std::vector<BenchResult> results;
+  if (selected.empty()) return results;
+
+  std::unique_ptr<ScopedThreadPin> pin;
+  if (options.pin_thread) pin.reset(new ScopedThreadPin(options.cpu));
+  double ticks_per_second = nanobenchmark::InvariantTicksPerSecond();
+  if (!(ticks_per_second > 0) || !std::isfinite(ticks_per_second)) {
+    // The nominal frequency is missing from the brand string of some virtual
+    // CPUs; the operating system's estimate of it is the next best.
+    ticks_per_second = base_internal::NominalCPUFrequency();
+  }
+  nanobenchmark::Params params;
+  params.target_rel_mad = options.target_rel_mad;
+  params.max_evals = options.max_evals;
+  params.verbose = false;
+
+  for (const Benchmark& benchmark : selected) {
+    const BenchFunction& function = benchmark.function;
+    auto closure = [&function](nanobenchmark::FuncInput input) {
+      return static_cast<nanobenchmark::FuncOutput>(function(input));
+    };
+
+    volatile uint64_t sink = 0;
+    for (size_t i = 0; i < options.warmup_calls; ++i) {
+      for (size_t input : benchmark.inputs) sink = sink + closure(input);
+    }
+
+    std::map<size_t, std::vector<nanobenchmark::Result>> repetitions;
+    std::vector<nanobenchmark::Result> measured(benchmark.inputs.size());
+    for (size_t i = 0; i < options.repetitions; ++i) {
+      const size_t count = nanobenchmark::MeasureClosure(
+          closure, benchmark.inputs.data(), benchmark.inputs.size(),
+          measured.data(), params);
+      for (size_t j = 0; j < count; ++j) {
+        repetitions[measured[j].input].push_back(measured[j]);
+      }
+    }
+
+    std::vector<size_t> inputs = benchmark.inputs;
+    std::sort(inputs.begin(), inputs.end());
+    inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+    for (size_t input : inputs) {
+      auto it = repetitions.find(input);
+      if (it == repetitions.end()) {
+        TURBO_RAW_LOG(WARNING, "%s/%zu: all measurements failed",
+                      benchmark.name.c_str(), input);
+        continue;
+      }
+      results.push_back(Summarize(benchmark.name, input, it->second, options,
+                                  ticks_per_second));
+    }
+  }
+  return results;
+}
+
+std::string BenchResultsToJson(const std::vector<BenchResult>& results) {
+  rapidjson::StringBuffer out;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(out);
+  writer.StartObject();
+  writer.Key("ticks_per_second");
+  writer.Double(results.empty() || results[0].nanoseconds == 0
+                    ? 0.0
+                    : results[0].ticks * 1e9 / results[0].nanoseconds);
+  writer.Key("benchmarks");
+  writer.StartArray();
+  for (const BenchResult& result : results) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(result.name.data(),
+                  static_cast<rapidjson::SizeType>(result.name.size()));
+    writer.Key("input");
+    writer.Uint64(result.input);
+    writer.Key("ticks");
+    writer.Double(result.ticks);
+    writer.Key("nanoseconds");
+    writer.Double(result.nanoseconds);
+    writer.Key("variability");
+    writer.Double(result.variability);
+    writer.Key("repetitions");
+    writer.Uint64(result.repetitions);
+    writer.Key("outliers");
+    writer.Uint64(result.outliers);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return std::string(out.GetString(), out.GetSize());
+}
+
+turbo::StatusOr<std::vector<BenchResult>> ParseBenchResults(
+    turbo::string_view json) {
+  rapidjson::Document document;
+  document.Parse(json.data(), json.size());
+  if (document.HasParseError()) {
+    return turbo::InvalidArgumentError(turbo::StrCat(
+        "invalid JSON at offset ", document.GetErrorOffset()));
+  }
+  const auto is_array = [](const rapidjson::Value& v) { return v.IsArray(); };
+  const auto is_string = [](const rapidjson::Value& v) { return v.IsString(); };
+  const auto is_uint64 = [](const rapidjson::Value& v) { return v.IsUint64(); };
+  const auto is_number = [](const rapidjson::Value& v) { return v.IsNumber(); };
+  const rapidjson::Value* array =
+      document.IsObject() ? Member(document, "benchmarks", is_array) : nullptr;
+  if (array == nullptr) {
+    return turbo::InvalidArgumentError("missing \"benchmarks\" array");
+  }
+
+  std::vector<BenchResult> results;
+  for (rapidjson::SizeType i = 0; i < array->Size(); ++i) {
+    const rapidjson::Value& entry = (*array)[i];
+    const rapidjson::Value* name = nullptr;
+    const rapidjson::Value* input = nullptr;
+    const rapidjson::Value* ticks = nullptr;
+    const rapidjson::Value* nanoseconds = nullptr;
+    const rapidjson::Value* variability = nullptr;
+    const rapidjson::Value* repetitions = nullptr;
+    const rapidjson::Value* outliers = nullptr;
+    if (entry.IsObject()) {
+      name = Member(entry, "name", is_string);
+      input = Member(entry, "input", is_uint64);
+      ticks = Member(entry, "ticks", is_number);
+      nanoseconds = Member(entry, "nanoseconds", is_number);
+      variability = Member(entry, "variability", is_number);
+      repetitions = Member(entry, "repetitions", is_uint64);
+      outliers = Member(entry, "outliers", is_uint64);
+    }
+    if (name == nullptr || input == nullptr || ticks == nullptr ||
+        nanoseconds == nullptr || variability == nullptr ||
+        repetitions == nullptr || outliers == nullptr) {
+      return turbo::InvalidArgumentError(
+          turbo::StrCat("invalid benchmark entry ", i));
+    }
+    BenchResult result;
+    result.name.assign(name->GetString(), name->GetStringLength());
+    result.input = static_cast<size_t>(input->GetUint64());
+    result.ticks = ticks->GetDouble();
+    result.nanoseconds = nanoseconds->GetDouble();
+    result.variability = variability->GetDouble();
+    result.repetitions = static_cast<size_t>(repetitions->GetUint64());
+    result.outliers = static_cast<size_t>(outliers->GetUint64());
+    results.push_back(std::move(result));
+  }
+  return results;
+}
+
+std::vector<BenchComparison> CompareBenchResults(
+    const std::vector<BenchResult>& baseline,
+    const std::vector<BenchResult>& contender, double threshold) {
+  std::map<std::pair<std::string, size_t>, const BenchResult*> contenders;
+  for (const BenchResult& result : contender) {
+    contenders[{result.name, result.input}] = &result;
+  }
+  std::vector<BenchComparison> comparisons;
+  for (const BenchResult& base : baseline) {
+    auto it = contenders.find({base.name, base.input});
+    if (it == contenders.end() || base.nanoseconds <= 0) continue;
+    const BenchResult& other = *it->second;
+    BenchComparison comparison;
+    comparison.name = base.name;
+    comparison.input = base.input;
+    comparison.baseline_ns = base.nanoseconds;
+    comparison.contender_ns = other.nanoseconds;
+    comparison.ratio = other.nanoseconds / base.nanoseconds;
+    const double margin =
+        std::max(threshold, base.variability + other.variability);
+    comparison.regression = comparison.ratio > 1 + margin;
+    comparison.improvement = comparison.ratio < 1 / (1 + margin);
+    comparisons.push_back(std::move(comparison));
+  }
+  return comparisons;
+}
+
+std::string FormatBenchResults(const std::vector<BenchResult>& results) {
+  std::string out = turbo::StrFormat("%-40s %10s %12s %12s %8s %8s\n",
+                                     "Benchmark", "Input", "Ticks", "ns",
+                                     "MAD", "Outliers");
+  for (const BenchResult& result : results) {
+    turbo::StrAppendFormat(&out, "%-40s %10d %12.2f %12.3f %7.2f%% %8d\n",
+                           result.name, result.input, result.ticks,
+                           result.nanoseconds, result.variability * 100,
+                           result.outliers);
+  }
+  return out;
+}
+
+std::string FormatBenchComparisons(
+    const std::vector<BenchComparison>& comparisons) {
+  std::string out = turbo::StrFormat("%-40s %10s %12s %12s %8s\n", "Benchmark",
+                                     "Input", "Baseline ns", "Contender ns",
+                                     "Change");
+  for (const BenchComparison& comparison : comparisons) {
+    turbo::StrAppendFormat(
+        &out, "%-40s %10d %12.3f %12.3f %+7.2f%%%s\n", comparison.name,
+        comparison.input, comparison.baseline_ns, comparison.contender_ns,
+        (comparison.ratio - 1) * 100,
+        comparison.regression    ? "  REGRESSION"
+        : comparison.improvement ? "  improvement"
+                                 : "");
+  }
+  return out;
+}
+
+int BenchMain(int argc, char** argv) {
+  BenchOptions options;
+  std::string json_path;
+  std::string compare;
+  double threshold = 0.05;
+  for (int i = 1; i < argc; ++i) {
+    turbo::string_view arg = argv[i];
+    const turbo::string_view flag = arg;
+    bool ok = true;
+    if (turbo::ConsumePrefix(&arg, "--filter=")) {
+      options.filter = std::string(arg);
+    } else if (turbo::ConsumePrefix(&arg, "--cpu=")) {
+      ok = turbo::SimpleAtoi(arg, &options.cpu) && options.cpu >= 0;
+    } else if (arg == "--no_pin") {
+      options.pin_thread = false;
+    } else if (turbo::ConsumePrefix(&arg, "--repetitions=")) {
+      ok = turbo::SimpleAtoi(arg, &options.repetitions) &&
+           options.repetitions > 0;
+    } else if (turbo::ConsumePrefix(&arg, "--json=")) {
+      json_path = std::string(arg);
+    } else if (turbo::ConsumePrefix(&arg, "--compare=")) {
+      compare = std::string(arg);
+      ok = compare.find(',') != std::string::npos;
+    } else if (turbo::ConsumePrefix(&arg, "--threshold=")) {
+      ok = turbo::SimpleAtod(arg, &threshold) && threshold >= 0;
+    } else {
+      ok = false;
+    }
+    if (!ok) return BenchUsage(argv[0], flag);
+  }
+
+  if (!compare.empty()) {
+    const size_t comma = compare.find(',');
+    std::vector<BenchResult> runs[2];
+    const std::string paths[2] = {compare.substr(0, comma),
+                                  compare.substr(comma + 1)};
+    for (int i = 0; i < 2; ++i) {
+      std::string content;
+      turbo::Status status = ReadFile(paths[i], &content);
+      auto parsed = status.ok() ? ParseBenchResults(content)
+                                : turbo::StatusOr<std::vector<BenchResult>>(
+                                      std::move(status));
+      if (!parsed.ok()) {
+        std::fprintf(stderr, "%s: %s\n", paths[i].c_str(),
+                     parsed.status().ToString().c_str());
+        return 1;
+      }
+      runs[i] = *std::move(parsed);
+    }
+    const std::vector<BenchComparison> comparisons =
+        CompareBenchResults(runs[0], runs[1], threshold);
+    std::fputs(FormatBenchComparisons(comparisons).c_str(), stdout);
+    const bool regressed =
+        std::any_of(comparisons.begin(), comparisons.end(),
+                    [](const BenchComparison& c) { return c.regression; });
+    return regressed ? 1 : 0;
+  }
+
+  const std::vector<BenchResult> results = RunBenchmarks(options);
+  std::fputs(FormatBenchResults(results).c_str(), stdout);
+  if (!json_path.empty()) {
+    turbo::Status status = WriteFile(json_path, BenchResultsToJson(results));
+    if (!status.ok()) {
+      std::fprintf(stderr, "%s\n", status.ToString().c_str());
+      return 1;
+    }
+  }
+  return 0;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
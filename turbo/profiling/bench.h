@@ -0,0 +1,225 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: bench.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines a harness for micro-benchmarks of hot paths, built
+// on the cycle-counting measurements of the random library's nanobenchmark.
+// A benchmark is a function of a `size_t` input which returns a "proof of
+// work" derived from its computations, so that the compiler cannot elide
+// them:
+//
+//   uint64_t BM_Crc32c(size_t size) {
+//     return static_cast<uint32_t>(
+//         turbo::ComputeCrc32c(turbo::string_view(kData, size)));
+//   }
+//   TURBO_BENCHMARK(BM_Crc32c, 16, 64, 4096);
+//
+// The function is called with the inputs in a random order, which gives the
+// branch predictors realistic hit rates, and each input is measured
+// separately. Each input is measured `BenchOptions::repetitions` times; the
+// repetitions further than a few median absolute deviations from their median
+// are rejected as outliers, and the others are averaged.
+//
+// `turbo::BenchMain()` runs the registered benchmarks and implements a
+// command line for them, including a comparison of two runs for gating
+// releases on regressions:
+//
+//   $ ./crc_bench --json=baseline.json
+//   ... change the code ...
+//   $ ./crc_bench --json=contender.json
+//   $ ./crc_bench --compare=baseline.json,contender.json --threshold=0.03
+//
+// Measurements are in ticks of the cycle counter, converted to nanoseconds
+// with its invariant frequency; they are precise to about 0.2% for functions
+// of up to a few microseconds.
+
+#ifndef TURBO_PROFILING_BENCH_H_
+#define TURBO_PROFILING_BENCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "turbo/base/statusor.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// The function measured by a benchmark, returning a proof of work.
+using BenchFunction = std::function<uint64_t(size_t input)>;
+
+// BenchOptions
+//
+// Controls which benchmarks `RunBenchmarks()` runs and how they are measured.
+struct BenchOptions {
+  // Runs the benchmarks whose names contain `filter`, or all of them if it is
+  // empty.
+  std::string filter;
+
+  // Whether to pin the measuring thread to one CPU, which avoids migrations
+  // between CPUs with unsynchronized cycle counters. The thread is pinned to
+  // `cpu`, or to the one it runs on if `cpu` is negative, and its previous
+  // affinity is restored before `RunBenchmarks()` returns.
+  bool pin_thread = true;
+  int cpu = -1;
+
+  // The number of calls per input before measuring, which warm up the caches
+  // and the CPU frequency.
+  size_t warmup_calls = 1000;
+
+  // The number of independent measurements of each input.
+  size_t repetitions = 5;
+
+  // Repetitions further than `outlier_mads` median absolute deviations from
+  // their median are rejected.
+  double outlier_mads = 3.0;
+
+  // The variability, as a median absolute deviation relative to the median,
+  // at which a measurement stops, and the largest number of evaluations it
+  // tries to reach it with.
+  double target_rel_mad = 0.002;
+  size_t max_evals = 9;
+};
+
+// BenchResult
+//
+// The measurement of one input of a benchmark.
+struct BenchResult {
+  std::string name;
+  size_t input = 0;
+  // The average duration of a call over the repetitions kept, or the median
+  // over all repetitions if every one was rejected.
+  double ticks = 0;
+  double nanoseconds = 0;
+  // The larger of the variabilities of the repetitions kept and of the
+  // variability between them, relative to `ticks`.
+  double variability = 0;
+  // The number of repetitions kept, and of those rejected as outliers.
+  size_t repetitions = 0;
+  size_t outliers = 0;
+};
+
+// BenchComparison
+//
+// The change of one input of a benchmark between two runs.
+struct BenchComparison {
+  std::string name;
+  size_t input = 0;
+  double baseline_ns = 0;
+  double contender_ns = 0;
+  // contender_ns / baseline_ns.
+  double ratio = 1;
+  bool regression = false;
+  bool improvement = false;
+};
+
+// RegisterBenchmark()
+//
+// Registers a benchmark measuring `function` for each of `inputs`. Prefer
+// `TURBO_BENCHMARK` for functions; this also takes lambdas with captures.
+void RegisterBenchmark(std::string name, BenchFunction function,
+                       std::vector<size_t> inputs);
+
+// RunBenchmarks()
+//
+// Runs the registered benchmarks selected by `options`, and returns their
+// results in the order of registration, each benchmark's by increasing input.
+// Inputs whose measurements all fail are left out, with a warning.
+std::vector<BenchResult> RunBenchmarks(const BenchOptions& options);
+
+// BenchResultsToJson()
+//
+// Renders results as JSON, which `ParseBenchResults()` reads back:
+//
+//   {"ticks_per_second": 2.9e9,
+//    "benchmarks": [{"name": "BM_Crc32c", "input": 16, "ticks": 31.2,
+//                    "nanoseconds": 10.7, "variability": 0.001,
+//                    "repetitions": 5, "outliers": 0}, ...]}
+std::string BenchResultsToJson(const std::vector<BenchResult>& results);
+
+// ParseBenchResults()
+//
+// Parses results rendered by `BenchResultsToJson()`.
+turbo::StatusOr<std::vector<BenchResult>> ParseBenchResults(
+    turbo::string_view json);
+
+// CompareBenchResults()
+//
+// Compares the results of the benchmarks and inputs present in both runs. A
+// change is a regression, or an improvement, when the durations differ by
+// more than `threshold` and by more than the sum of their variabilities.
+std::vector<BenchComparison> CompareBenchResults(
+    const std::vector<BenchResult>& baseline,
+    const std::vector<BenchResult>& contender, double threshold = 0.05);
+
+// FormatBenchResults()
+// FormatBenchComparisons()
+//
+// Render results and comparisons as tables for humans.
+std::string FormatBenchResults(const std::vector<BenchResult>& results);
+std::string FormatBenchComparisons(
+    const std::vector<BenchComparison>& comparisons);
+
+// BenchMain()
+//
+// Implements the `main()` of a benchmark binary. It takes the flags:
+//
+//   --filter=<substring>  runs the benchmarks whose names contain it
+//   --cpu=<n>             pins the measuring thread to CPU n
+//   --no_pin              does not pin the measuring thread
+//   --repetitions=<n>     measures each input n times
+//   --json=<path>         also writes the results to a JSON file
+//   --compare=<baseline>,<contender>
+//                         compares two JSON files instead of running
+//   --threshold=<ratio>   the relative change of a regression, 0.05 by default
+//
+// and returns 1 when a comparison finds regressions or the flags are invalid,
+// and 0 otherwise.
+int BenchMain(int argc, char** argv);
+
+namespace profiling_internal {
+
+struct BenchRegisterer {
+  BenchRegisterer(const char* name, uint64_t (*function)(size_t),
+                  std::initializer_list<size_t> inputs) {
+    RegisterBenchmark(name, function, inputs);
+  }
+};
+
+}  // namespace profiling_internal
+
+// TURBO_BENCHMARK
+//
+// Registers the function `name`, of signature `uint64_t(size_t)`, as a
+// benchmark measured for each of the inputs following it.
+#define TURBO_BENCHMARK(name, ...)                                        \
+  static ::turbo::profiling_internal::BenchRegisterer                     \
+      TURBO_BENCH_INTERNAL_CONCAT(turbo_benchmark_registerer_, __LINE__)( \
+          #name, name, {__VA_ARGS__})
+
+#define TURBO_BENCH_INTERNAL_CONCAT(a, b) TURBO_BENCH_INTERNAL_CONCAT2(a, b)
+#define TURBO_BENCH_INTERNAL_CONCAT2(a, b) a##b
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_BENCH_H_
@@ -0,0 +1,269 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/bench.h"
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sched.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/strings/str_cat.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+uint64_t BenchTestSum(size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i) sum += i * i;
+  return sum;
+}
+TURBO_BENCHMARK(BenchTestSum, 10, 100, 10);
+
+turbo::BenchOptions FastOptions(const std::string& filter) {
+  turbo::BenchOptions options;
+  options.filter = filter;
+  // Tests measure on whichever CPU they run on.
+  options.pin_thread = false;
+  options.warmup_calls = 10;
+  options.repetitions = 3;
+  options.max_evals = 3;
+  return options;
+}
+
+TEST(BenchTest, RunsRegisteredBenchmark) {
+  const std::vector<turbo::BenchResult> results =
+      turbo::RunBenchmarks(FastOptions("BenchTestSum"));
+  // Measurements may fail on a loaded machine; those that succeed must be
+  // consistent.
+  for (const turbo::BenchResult& result : results) {
+    EXPECT_EQ("BenchTestSum", result.name);
+    EXPECT_GT(result.ticks, 0);
+    EXPECT_GT(result.nanoseconds, 0);
+    EXPECT_GE(result.variability, 0);
+    EXPECT_EQ(3, result.repetitions + result.outliers);
+    EXPECT_GT(result.repetitions, result.outliers);
+  }
+  if (results.size() == 2) {
+    EXPECT_EQ(10, results[0].input);
+    EXPECT_EQ(100, results[1].input);
+    EXPECT_LT(results[0].ticks, results[1].ticks);
+  }
+}
+
+TEST(BenchTest, AllRepetitionsRejected) {
+  turbo::BenchOptions options = FastOptions("BenchTestSum");
+  options.outlier_mads = -1;
+  const std::vector<turbo::BenchResult> results =
+      turbo::RunBenchmarks(options);
+  for (const turbo::BenchResult& result : results) {
+    EXPECT_EQ(0, result.repetitions);
+    EXPECT_EQ(3, result.outliers);
+    EXPECT_GT(result.ticks, 0);
+  }
+  // The median keeps the results valid JSON.
+  auto parsed = turbo::ParseBenchResults(turbo::BenchResultsToJson(results));
+  ASSERT_TRUE(parsed.ok()) << parsed.status();
+  EXPECT_EQ(results.size(), parsed->size());
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+TEST(BenchTest, RestoresThreadAffinity) {
+  cpu_set_t before;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(before), &before));
+  turbo::BenchOptions options = FastOptions("BenchTestSum");
+  options.pin_thread = true;
+  turbo::RunBenchmarks(options);
+  cpu_set_t after;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(after), &after));
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+#endif
+
+TEST(BenchTest, RegisterClosure) {
+  std::vector<uint64_t> table(1024, 3);
+  turbo::RegisterBenchmark(
+      "BenchTestClosure",
+      [&table](size_t i) { return table[i % table.size()] * i; }, {5});
+  const std::vector<turbo::BenchResult> results =
+      turbo::RunBenchmarks(FastOptions("BenchTestClosure"));
+  for (const turbo::BenchResult& result : results) {
+    EXPECT_EQ("BenchTestClosure", result.name);
+    EXPECT_EQ(5, result.input);
+  }
+}
+
+TEST(BenchTest, FilterSelectsNothing) {
+  EXPECT_THAT(turbo::RunBenchmarks(FastOptions("NoSuchBenchmark")), IsEmpty());
+}
+
+std::vector<turbo::BenchResult> MakeResults() {
+  turbo::BenchResult a;
+  a.name = "BM_A";
+  a.input = 16;
+  a.ticks = 30;
+  a.nanoseconds = 10;
+  a.variability = 0.001;
+  a.repetitions = 4;
+  a.outliers = 1;
+  turbo::BenchResult b = a;
+  b.name = "BM_B";
+  b.input = 1u << 20;
+  b.ticks = 3000.5;
+  b.nanoseconds = 1000.25;
+  b.outliers = 0;
+  return {a, b};
+}
+
+TEST(BenchTest, JsonRoundTrip) {
+  const std::vector<turbo::BenchResult> results = MakeResults();
+  const std::string json = turbo::BenchResultsToJson(results);
+  EXPECT_THAT(json, HasSubstr("\"ticks_per_second\":3"));
+  auto parsed = turbo::ParseBenchResults(json);
+  ASSERT_TRUE(parsed.ok()) << parsed.status();
+  ASSERT_EQ(2, parsed->size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].name, (*parsed)[i].name);
+    EXPECT_EQ(results[i].input, (*parsed)[i].input);
+    EXPECT_EQ(results[i].ticks, (*parsed)[i].ticks);
+    EXPECT_EQ(results[i].nanoseconds, (*parsed)[i].nanoseconds);
+    EXPECT_EQ(results[i].variability, (*parsed)[i].variability);
+    EXPECT_EQ(results[i].repetitions, (*parsed)[i].repetitions);
+    EXPECT_EQ(results[i].outliers, (*parsed)[i].outliers);
+  }
+}
+
+TEST(BenchTest, ParseErrors) {
+  EXPECT_FALSE(turbo::ParseBenchResults("").ok());
+  EXPECT_FALSE(turbo::ParseBenchResults("{\"benchmarks\": [").ok());
+  EXPECT_FALSE(turbo::ParseBenchResults("[]").ok());
+  EXPECT_FALSE(turbo::ParseBenchResults("{\"benchmarks\": {}}").ok());
+  EXPECT_FALSE(
+      turbo::ParseBenchResults("{\"benchmarks\": [{\"name\": \"BM_A\"}]}")
+          .ok());
+  auto empty = turbo::ParseBenchResults("{\"benchmarks\": []}");
+  ASSERT_TRUE(empty.ok());
+  EXPECT_THAT(*empty, IsEmpty());
+}
+
+TEST(BenchTest, Compare) {
+  const std::vector<turbo::BenchResult> baseline = MakeResults();
+  std::vector<turbo::BenchResult> contender = MakeResults();
+  contender[0].nanoseconds = 12;    // 20% slower.
+  contender[1].nanoseconds = 1010;  // 1% slower, within the threshold.
+  turbo::BenchResult extra = contender[0];
+  extra.name = "BM_New";
+  contender.push_back(extra);
+
+  std::vector<turbo::BenchComparison> comparisons =
+      turbo::CompareBenchResults(baseline, contender, 0.05);
+  ASSERT_THAT(comparisons,
+              ElementsAre(Field(&turbo::BenchComparison::name, "BM_A"),
+                          Field(&turbo::BenchComparison::name, "BM_B")));
+  EXPECT_DOUBLE_EQ(1.2, comparisons[0].ratio);
+  EXPECT_TRUE(comparisons[0].regression);
+  EXPECT_FALSE(comparisons[0].improvement);
+  EXPECT_FALSE(comparisons[1].regression);
+  EXPECT_FALSE(comparisons[1].improvement);
+  EXPECT_THAT(turbo::FormatBenchComparisons(comparisons),
+              HasSubstr("REGRESSION"));
+
+  // The reverse comparison is an improvement.
+  comparisons = turbo::CompareBenchResults(contender, baseline, 0.05);
+  EXPECT_FALSE(comparisons[0].regression);
+  EXPECT_TRUE(comparisons[0].improvement);
+
+  // Noisy measurements widen the margin.
+  contender[0].variability = 0.3;
+  comparisons = turbo::CompareBenchResults(baseline, contender, 0.05);
+  EXPECT_FALSE(comparisons[0].regression);
+}
+
+std::string WriteTempFile(const std::string& name,
+                          const std::string& content) {
+  const std::string path =
+      turbo::StrCat(testing::TempDir(), "/bench_test_", name);
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  EXPECT_NE(nullptr, file);
+  std::fwrite(content.data(), 1, content.size(), file);
+  std::fclose(file);
+  return path;
+}
+
+int RunMain(std::vector<std::string> args) {
+  args.insert(args.begin(), "bench_test");
+  std::vector<char*> argv;
+  for (std::string& arg : args) argv.push_back(&arg[0]);
+  return turbo::BenchMain(static_cast<int>(argv.size()), argv.data());
+}
+
+TEST(BenchTest, MainCompare) {
+  const std::vector<turbo::BenchResult> baseline = MakeResults();
+  std::vector<turbo::BenchResult> slower = MakeResults();
+  slower[1].nanoseconds *= 2;
+  const std::string baseline_path =
+      WriteTempFile("baseline.json", turbo::BenchResultsToJson(baseline));
+  const std::string slower_path =
+      WriteTempFile("slower.json", turbo::BenchResultsToJson(slower));
+  const std::string bad_path = WriteTempFile("bad.json", "not json");
+
+  EXPECT_EQ(0, RunMain({turbo::StrCat("--compare=", baseline_path, ",",
+                                      baseline_path)}));
+  EXPECT_EQ(1, RunMain({turbo::StrCat("--compare=", baseline_path, ",",
+                                      slower_path)}));
+  EXPECT_EQ(0, RunMain({turbo::StrCat("--compare=", baseline_path, ",",
+                                      slower_path),
+                        "--threshold=1.5"}));
+  EXPECT_EQ(1, RunMain({turbo::StrCat("--compare=", baseline_path, ",",
+                                      bad_path)}));
+  EXPECT_EQ(1, RunMain({turbo::StrCat("--compare=", baseline_path,
+                                      ",/nonexistent/bench.json")}));
+}
+
+TEST(BenchTest, MainRunWritesJson) {
+  const std::string path =
+      turbo::StrCat(testing::TempDir(), "/bench_test_run.json");
+  EXPECT_EQ(0, RunMain({"--filter=BenchTestSum", "--no_pin",
+                        "--repetitions=2", turbo::StrCat("--json=", path)}));
+  std::FILE* file = std::fopen(path.c_str(), "r");
+  ASSERT_NE(nullptr, file);
+  std::string content(1 << 16, '\0');
+  content.resize(std::fread(&content[0], 1, content.size(), file));
+  std::fclose(file);
+  auto parsed = turbo::ParseBenchResults(content);
+  ASSERT_TRUE(parsed.ok()) << parsed.status();
+  for (const turbo::BenchResult& result : *parsed) {
+    EXPECT_EQ("BenchTestSum", result.name);
+  }
+}
+
+TEST(BenchTest, MainRejectsInvalidFlags) {
+  EXPECT_EQ(1, RunMain({"--unknown"}));
+  EXPECT_EQ(1, RunMain({"--cpu=abc"}));
+  EXPECT_EQ(1, RunMain({"--repetitions=0"}));
+  EXPECT_EQ(1, RunMain({"--compare=only_one.json"}));
+  EXPECT_EQ(1, RunMain({"--threshold=-1"}));
+}
+
+}  // namespace
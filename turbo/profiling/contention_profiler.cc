@@ -0,0 +1,219 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/contention_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "turbo/container/flat_hash_map.h"
+#include "turbo/debugging/stacktrace.h"
+#include "turbo/platform/internal/cycleclock.h"
+#include "turbo/platform/internal/spinlock.h"
+#include "turbo/profiling/sampling_profiler.h"
+#include "turbo/strings/str_cat.h"
+#include "turbo/strings/str_format.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/time/clock.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+struct Totals {
+  int64_t events = 0;
+  int64_t cycles = 0;
+};
+
+struct LockTotals : Totals {
+  bool is_spinlock = false;
+};
+
+struct ContentionProfile {
+  turbo::flat_hash_map<std::vector<void*>, Totals> by_stack;
+  turbo::flat_hash_map<const void*, LockTotals> by_lock;
+  turbo::Time reset_time = turbo::Now();
+};
+
+// 0 while profiling is disabled.
+TURBO_CONST_INIT std::atomic<int64_t> contention_sampling_period{0};
+
+// A spin lock rather than a `turbo::Mutex`, as events are recorded from within
+// both. Contention on it is reported to the hooks again, and dropped there.
+TURBO_CONST_INIT base_internal::SpinLock profile_lock(
+    turbo::kConstInit, base_internal::SCHEDULE_KERNEL_ONLY);
+
+ContentionProfile& Profile() TURBO_EXCLUSIVE_LOCKS_REQUIRED(profile_lock) {
+  static auto* profile = new ContentionProfile;
+  return *profile;
+}
+
+struct ThreadState {
+  // Events to skip until the next one is recorded.
+  int64_t countdown;
+  // Set while recording, so that contention caused by the profiler itself is
+  // not recorded.
+  bool recording;
+};
+
+thread_local ThreadState contention_thread_state = {0, false};
+
+void RecordContention(const void* lock, bool is_spinlock, int64_t cycles) {
+  const int64_t period =
+      contention_sampling_period.load(std::memory_order_relaxed);
+  if (period <= 0 || cycles <= 0) return;
+  ThreadState& state = contention_thread_state;
+  if (state.recording || --state.countdown > 0) return;
+  state.countdown = period;
+  state.recording = true;
+
+  void* stack[profiling_internal::kMaxProfileStackDepth];
+  const int depth = turbo::GetStackTrace(
+      stack, profiling_internal::kMaxProfileStackDepth, /*skip_count=*/0);
+  {
+    base_internal::SpinLockHolder holder(&profile_lock);
+    ContentionProfile& profile = Profile();
+    // Each recorded event stands for `period` events.
+    Totals& site = profile.by_stack[std::vector<void*>(stack, stack + depth)];
+    site.events += period;
+    site.cycles += cycles * period;
+    LockTotals& totals = profile.by_lock[lock];
+    totals.events += period;
+    totals.cycles += cycles * period;
+    totals.is_spinlock = is_spinlock;
+  }
+  state.recording = false;
+}
+
+void MutexContentionHook(const char* /* msg */, const void* mu,
+                         int64_t wait_cycles) {
+  RecordContention(mu, /*is_spinlock=*/false, wait_cycles);
+}
+
+void SpinLockContentionHook(const void* lock, int64_t wait_cycles) {
+  RecordContention(lock, /*is_spinlock=*/true, wait_cycles);
+}
+
+turbo::Duration CyclesToDuration(int64_t cycles) {
+  return turbo::Nanoseconds(static_cast<int64_t>(
+      static_cast<double>(cycles) * 1e9 /
+      base_internal::CycleClock::Frequency()));
+}
+
+}  // namespace
+
+void StartContentionProfiling(int64_t sampling_period) {
+  static const bool hooks_registered = [] {
+    turbo::RegisterMutexTracer(MutexContentionHook);
+    base_internal::RegisterSpinLockProfiler(SpinLockContentionHook);
+    return true;
+  }();
+  (void)hooks_registered;
+  contention_sampling_period.store(std::max<int64_t>(sampling_period, 1),
+                                   std::memory_order_relaxed);
+}
+
+void StopContentionProfiling() {
+  contention_sampling_period.store(0, std::memory_order_relaxed);
+}
+
+bool IsContentionProfilingEnabled() {
+  return contention_sampling_period.load(std::memory_order_relaxed) > 0;
+}
+
+void ResetContentionProfile() {
+  base_internal::SpinLockHolder holder(&profile_lock);
+  ContentionProfile& profile = Profile();
+  profile.by_stack.clear();
+  profile.by_lock.clear();
+  profile.reset_time = turbo::Now();
+}
+
+std::vector<ContendedLock> GetTopContendedLocks(size_t n) {
+  std::vector<std::pair<const void*, LockTotals>> locks;
+  {
+    base_internal::SpinLockHolder holder(&profile_lock);
+    const ContentionProfile& profile = Profile();
+    locks.assign(profile.by_lock.begin(), profile.by_lock.end());
+  }
+  n = std::min(n, locks.size());
+  std::partial_sort(locks.begin(), locks.begin() + n, locks.end(),
+                    [](const auto& a, const auto& b) {
+                      return a.second.cycles > b.second.cycles;
+                    });
+  std::vector<ContendedLock> result(n);
+  for (size_t i = 0; i < n; ++i) {
+    result[i].lock = locks[i].first;
+    result[i].is_spinlock = locks[i].second.is_spinlock;
+    result[i].events = locks[i].second.events;
+    result[i].wait_time = CyclesToDuration(locks[i].second.cycles);
+  }
+  return result;
+}
+
+std::vector<ContentionSite> GetTopContentionSites(size_t n) {
+  std::vector<std::pair<std::vector<void*>, Totals>> sites;
+  {
+    base_internal::SpinLockHolder holder(&profile_lock);
+    const ContentionProfile& profile = Profile();
+    sites.assign(profile.by_stack.begin(), profile.by_stack.end());
+  }
+  n = std::min(n, sites.size());
+  std::partial_sort(sites.begin(), sites.begin() + n, sites.end(),
+                    [](const auto& a, const auto& b) {
+                      return a.second.cycles > b.second.cycles;
+                    });
+  std::vector<ContentionSite> result(n);
+  for (size_t i = 0; i < n; ++i) {
+    result[i].stack = std::move(sites[i].first);
+    result[i].events = sites[i].second.events;
+    result[i].wait_time = CyclesToDuration(sites[i].second.cycles);
+  }
+  return result;
+}
+
+std::string ExportContentionProfile() {
+  std::vector<std::pair<std::vector<void*>, Totals>> sites;
+  turbo::Time reset_time;
+  {
+    base_internal::SpinLockHolder holder(&profile_lock);
+    const ContentionProfile& profile = Profile();
+    sites.assign(profile.by_stack.begin(), profile.by_stack.end());
+    reset_time = profile.reset_time;
+  }
+  std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+    return a.second.cycles > b.second.cycles;
+  });
+
+  // The recorded values are already scaled by the sampling period.
+  std::string out = turbo::StrFormat(
+      "--- contention\ncycles/second = %d\nsampling period = 1\n"
+      "ms since reset = %d\n",
+      static_cast<int64_t>(base_internal::CycleClock::Frequency()),
+      turbo::ToInt64Milliseconds(turbo::Now() - reset_time));
+  for (const auto& site : sites) {
+    turbo::StrAppend(&out, turbo::StrFormat("%d %d @", site.second.cycles,
+                                            site.second.events));
+    for (void* pc : site.first) {
+      turbo::StrAppend(&out, turbo::StrFormat(" %p", pc));
+    }
+    out.push_back('\n');
+  }
+  profiling_internal::AppendMappedLibraries(&out);
+  return out;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,111 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: contention_profiler.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines a contention profiler for `turbo::Mutex` and the
+// internal `SpinLock`. While profiling is enabled, contended lock releases are
+// sampled and their wait times are accumulated by lock and by stack trace.
+//
+// As usual for contention profilers, wait times are attributed to the stack
+// which released the contended lock, i.e. to the critical section which made
+// others wait, rather than to the waiters.
+//
+// Example:
+//
+//   turbo::StartContentionProfiling();
+//   RunLoadTest();
+//   for (const auto& lock : turbo::GetTopContendedLocks(5)) {
+//     TURBO_LOG(INFO) << lock.lock << " waited " << lock.wait_time;
+//   }
+//   WriteFile("contention.txt", turbo::ExportContentionProfile());
+//   turbo::StopContentionProfiling();
+//
+// The exported profile is in the legacy pprof contention format:
+//
+//   $ pprof --top /path/to/binary contention.txt
+//
+// The profiler installs the hooks of `turbo::RegisterMutexTracer()` and
+// `base_internal::RegisterSpinLockProfiler()` the first time it is started, so
+// it cannot be used in binaries that install their own.
+
+#ifndef TURBO_PROFILING_CONTENTION_PROFILER_H_
+#define TURBO_PROFILING_CONTENTION_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "turbo/platform/port.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// StartContentionProfiling()
+//
+// Starts recording one in `sampling_period` contended lock releases of every
+// thread. Recording an event takes a stack trace and a lock, so a period
+// above 1 bounds the overhead for heavily contended binaries. Restarting only
+// changes the period; recorded events are kept until
+// `ResetContentionProfile()`.
+void StartContentionProfiling(int64_t sampling_period = 1);
+
+// Stops recording contention events.
+void StopContentionProfiling();
+
+bool IsContentionProfilingEnabled();
+
+// Discards the recorded contention events.
+void ResetContentionProfile();
+
+// ContendedLock
+//
+// The contention recorded for a lock. Values are estimates: each recorded
+// event counts for `sampling_period` events.
+struct ContendedLock {
+  // The address of the `turbo::Mutex` or `SpinLock`.
+  const void* lock = nullptr;
+  bool is_spinlock = false;
+  int64_t events = 0;
+  turbo::Duration wait_time;
+};
+
+// ContentionSite
+//
+// The contention recorded for a stack releasing contended locks.
+struct ContentionSite {
+  std::vector<void*> stack;
+  int64_t events = 0;
+  turbo::Duration wait_time;
+};
+
+// Returns the (at most) `n` locks and release sites with the longest total
+// wait time, longest first.
+std::vector<ContendedLock> GetTopContendedLocks(size_t n = 10);
+std::vector<ContentionSite> GetTopContentionSites(size_t n = 10);
+
+// ExportContentionProfile()
+//
+// Returns the recorded events aggregated by stack trace, in the legacy pprof
+// contention profile format.
+std::string ExportContentionProfile();
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_CONTENTION_PROFILER_H_
@@ -0,0 +1,137 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/contention_profiler.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/platform/internal/spinlock.h"
+#include "turbo/strings/str_split.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/synchronization/notification.h"
+#include "turbo/time/clock.h"
+
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+// Makes another thread wait for `lock` while this thread holds it.
+template <typename Lock>
+void Contend(Lock* lock) {
+  turbo::Notification started;
+  lock->Lock();
+  std::thread waiter([lock, &started] {
+    started.Notify();
+    lock->Lock();
+    lock->Unlock();
+  });
+  started.WaitForNotification();
+  turbo::SleepFor(turbo::Milliseconds(50));
+  lock->Unlock();
+  waiter.join();
+}
+
+// Returns the recorded contention of `lock`, whose `lock` is null if there is
+// none.
+turbo::ContendedLock FindLock(const void* lock) {
+  for (const auto& l : turbo::GetTopContendedLocks(100)) {
+    if (l.lock == lock) return l;
+  }
+  return turbo::ContendedLock();
+}
+
+TEST(ContentionProfilerTest, DisabledByDefault) {
+  EXPECT_FALSE(turbo::IsContentionProfilingEnabled());
+  turbo::Mutex mu;
+  Contend(&mu);
+  EXPECT_EQ(nullptr, FindLock(&mu).lock);
+}
+
+TEST(ContentionProfilerTest, RecordsMutexContention) {
+  turbo::ResetContentionProfile();
+  turbo::StartContentionProfiling();
+  EXPECT_TRUE(turbo::IsContentionProfilingEnabled());
+  turbo::Mutex mu;
+  Contend(&mu);
+  turbo::StopContentionProfiling();
+
+  const turbo::ContendedLock lock = FindLock(&mu);
+  ASSERT_EQ(&mu, lock.lock);
+  EXPECT_FALSE(lock.is_spinlock);
+  EXPECT_GE(lock.events, 1);
+  EXPECT_GT(lock.wait_time, turbo::Milliseconds(10));
+
+  const std::vector<turbo::ContentionSite> sites =
+      turbo::GetTopContentionSites(1);
+  ASSERT_EQ(1u, sites.size());
+  EXPECT_FALSE(sites[0].stack.empty());
+  EXPECT_GT(sites[0].wait_time, turbo::Milliseconds(10));
+
+  // Events are not recorded once profiling is stopped.
+  turbo::Mutex other;
+  Contend(&other);
+  EXPECT_EQ(nullptr, FindLock(&other).lock);
+}
+
+TEST(ContentionProfilerTest, RecordsSpinLockContention) {
+  turbo::ResetContentionProfile();
+  turbo::StartContentionProfiling();
+  turbo::base_internal::SpinLock lock(
+      turbo::base_internal::SCHEDULE_KERNEL_ONLY);
+  Contend(&lock);
+  turbo::StopContentionProfiling();
+
+  const turbo::ContendedLock contended = FindLock(&lock);
+  ASSERT_EQ(&lock, contended.lock);
+  EXPECT_TRUE(contended.is_spinlock);
+  EXPECT_GT(contended.wait_time, turbo::ZeroDuration());
+}
+
+TEST(ContentionProfilerTest, ExportsPprofProfile) {
+  turbo::ResetContentionProfile();
+  turbo::StartContentionProfiling();
+  turbo::Mutex mu;
+  Contend(&mu);
+  turbo::StopContentionProfiling();
+
+  const std::string profile = turbo::ExportContentionProfile();
+  EXPECT_THAT(profile, StartsWith("--- contention\ncycles/second = "));
+  EXPECT_THAT(profile, HasSubstr("\nsampling period = 1\n"));
+  std::vector<std::string> lines = turbo::StrSplit(profile, '\n');
+  ASSERT_GE(lines.size(), 5u);
+  EXPECT_THAT(lines[3], StartsWith("ms since reset = "));
+  EXPECT_THAT(lines[4], HasSubstr(" @ 0x"));
+
+  turbo::ResetContentionProfile();
+  EXPECT_TRUE(turbo::GetTopContendedLocks(100).empty());
+}
+
+TEST(ContentionProfilerTest, SamplingPeriod) {
+  turbo::ResetContentionProfile();
+  turbo::StartContentionProfiling(1000000);
+  turbo::Mutex mu;
+  Contend(&mu);
+  // The first event of a thread is recorded, and counts for a full period.
+  const turbo::ContendedLock lock = FindLock(&mu);
+  turbo::StopContentionProfiling();
+  ASSERT_EQ(&mu, lock.lock);
+  EXPECT_EQ(1000000, lock.events);
+}
+
+}  // namespace
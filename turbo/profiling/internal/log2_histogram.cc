@@ -0,0 +1,48 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/internal/log2_histogram.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "turbo/base/bits.h"
+#include "turbo/strings/str_format.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+
+size_t Log2Bucket(double value, size_t num_buckets) {
+  // Larger values do not fit in 64 bits; NaNs go to bucket 0.
+  if (value >= 18446744073709551616.0) return num_buckets - 1;
+  uint64_t v = !(value >= 1) ? 0 : static_cast<uint64_t>(value);
+  size_t bucket = v == 0 ? 0 : static_cast<size_t>(63 - turbo::countl_zero(v));
+  return std::min(bucket, num_buckets - 1);
+}
+
+void AppendLog2Histogram(turbo::string_view title,
+                         turbo::Span<const size_t> histogram,
+                         std::string* out) {
+  turbo::StrAppendFormat(out, "%s:\n", title);
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    if (histogram[i] == 0) continue;
+    turbo::StrAppendFormat(out, "  [%u, %u): %u\n", i == 0 ? 0 : size_t{1} << i,
+                           size_t{1} << (i + 1), histogram[i]);
+  }
+}
+
+}  // namespace profiling_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,50 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TURBO_PROFILING_INTERNAL_LOG2_HISTOGRAM_H_
+#define TURBO_PROFILING_INTERNAL_LOG2_HISTOGRAM_H_
+
+#include <cstddef>
+#include <string>
+
+#include "turbo/meta/span.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+
+// Histograms of the sampling reports, such as the cordz and hashtablez
+// reports, count values in power-of-two buckets: bucket i holds the values in
+// [2^i, 2^(i + 1)), except bucket 0, which also holds the values below 1, and
+// the last bucket, which also holds all larger values.
+
+// Returns the bucket of `value` in a histogram of `num_buckets` buckets.
+size_t Log2Bucket(double value, size_t num_buckets);
+
+// Appends `title` and a line per non-empty bucket of `histogram` to `out`:
+//
+//   cords by chunk count:
+//     [0, 2): 10
+//     [8, 16): 3
+void AppendLog2Histogram(turbo::string_view title,
+                         turbo::Span<const size_t> histogram,
+                         std::string* out);
+
+}  // namespace profiling_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_INTERNAL_LOG2_HISTOGRAM_H_
@@ -0,0 +1,49 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/internal/log2_histogram.h"
+
+#include <array>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+namespace {
+
+TEST(Log2HistogramTest, Bucket) {
+  EXPECT_EQ(0u, Log2Bucket(-1, 8));
+  EXPECT_EQ(0u, Log2Bucket(0, 8));
+  EXPECT_EQ(0u, Log2Bucket(0.5, 8));
+  EXPECT_EQ(0u, Log2Bucket(1, 8));
+  EXPECT_EQ(1u, Log2Bucket(2, 8));
+  EXPECT_EQ(1u, Log2Bucket(3.9, 8));
+  EXPECT_EQ(2u, Log2Bucket(4, 8));
+  EXPECT_EQ(7u, Log2Bucket(128, 8));
+  EXPECT_EQ(7u, Log2Bucket(1e30, 8));
+}
+
+TEST(Log2HistogramTest, Append) {
+  std::array<size_t, 4> histogram = {3, 0, 5, 1};
+  std::string out = "before\n";
+  AppendLog2Histogram("values", histogram, &out);
+  EXPECT_EQ("before\nvalues:\n  [0, 2): 3\n  [4, 8): 5\n  [8, 16): 1\n", out);
+}
+
+}  // namespace
+}  // namespace profiling_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,290 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include "turbo/base/bits.h"
+#include "turbo/json/stringbuffer.h"
+#include "turbo/json/writer.h"
+#include "turbo/strings/str_format.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+namespace {
+
+// Values below kLinear have their own bucket; every power of two range above
+// is split into kLinear buckets.
+constexpr int kSubBucketBits = 4;
+constexpr uint64_t kLinear = uint64_t{1} << kSubBucketBits;
+constexpr size_t kNumBuckets = kLinear + (64 - kSubBucketBits) * kLinear;
+
+inline size_t BucketIndex(uint64_t value) {
+  if (value < kLinear) return static_cast<size_t>(value);
+  const int exponent = 63 - turbo::countl_zero(value);
+  const int shift = exponent - kSubBucketBits;
+  const uint64_t sub = (value >> shift) - kLinear;
+  return static_cast<size_t>(kLinear + static_cast<uint64_t>(shift) * kLinear +
+                             sub);
+}
+
+inline uint64_t BucketLower(size_t index) {
+  if (index < kLinear) return index;
+  const size_t shift = (index - kLinear) / kLinear;
+  const uint64_t sub = (index - kLinear) % kLinear;
+  return (kLinear + sub) << shift;
+}
+
+inline uint64_t BucketUpper(size_t index) {
+  if (index < kLinear) return index;
+  const size_t shift = (index - kLinear) / kLinear;
+  return BucketLower(index) + ((uint64_t{1} << shift) - 1);
+}
+
+double NanosPerCycle() {
+  static const double nanos_per_cycle =
+      1e9 / base_internal::CycleClock::Frequency();
+  return nanos_per_cycle;
+}
+
+}  // namespace
+}  // namespace profiling_internal
+
+Counter::Counter()
+    : num_shards_(synchronization_internal::NumCounterShards()),
+      shards_(num_shards_) {}
+
+int64_t Counter::Value() const {
+  int64_t value = 0;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    value += shards_[i].value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+struct Histogram::Shard {
+  std::atomic<uint64_t> buckets[profiling_internal::kNumBuckets];
+  std::atomic<uint64_t> sum;
+  std::atomic<uint64_t> min;
+  std::atomic<uint64_t> max;
+
+  Shard() { Clear(); }
+
+  void Clear() {
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(~uint64_t{0}, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+  }
+};
+
+Histogram::Histogram()
+    : num_shards_(synchronization_internal::NumCounterShards()),
+      shards_(new std::atomic<Shard*>[num_shards_]) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    shards_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+Histogram::~Histogram() {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    delete shards_[i].load(std::memory_order_relaxed);
+  }
+}
+
+Histogram::Shard* Histogram::GetShard() {
+  std::atomic<Shard*>& slot =
+      shards_[synchronization_internal::CounterShardIndex(num_shards_)];
+  Shard* shard = slot.load(std::memory_order_acquire);
+  if (TURBO_PREDICT_FALSE(shard == nullptr)) {
+    Shard* fresh = new Shard;
+    if (slot.compare_exchange_strong(shard, fresh, std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      shard = fresh;
+    } else {
+      delete fresh;
+    }
+  }
+  return shard;
+}
+
+void Histogram::Record(uint64_t value) {
+  Shard* shard = GetShard();
+  shard->buckets[profiling_internal::BucketIndex(value)].fetch_add(
+      1, std::memory_order_relaxed);
+  shard->sum.fetch_add(value, std::memory_order_relaxed);
+  // Extremes change rarely once a few values have been recorded, so check
+  // before paying for an atomic read-modify-write.
+  uint64_t min = shard->min.load(std::memory_order_relaxed);
+  while (value < min && !shard->min.compare_exchange_weak(
+                            min, value, std::memory_order_relaxed)) {
+  }
+  uint64_t max = shard->max.load(std::memory_order_relaxed);
+  while (value > max && !shard->max.compare_exchange_weak(
+                            max, value, std::memory_order_relaxed)) {
+  }
+}
+
+void Histogram::Record(turbo::Duration duration) {
+  const int64_t nanos = turbo::ToInt64Nanoseconds(duration);
+  Record(nanos > 0 ? static_cast<uint64_t>(nanos) : 0);
+}
+
+void Histogram::RecordCycles(int64_t cycles) {
+  if (cycles <= 0) {
+    Record(uint64_t{0});
+    return;
+  }
+  Record(static_cast<uint64_t>(static_cast<double>(cycles) *
+                               profiling_internal::NanosPerCycle()));
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+  uint64_t counts[profiling_internal::kNumBuckets] = {};
+  HistogramSnapshot snapshot;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    const Shard* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard == nullptr) continue;
+    for (size_t b = 0; b < profiling_internal::kNumBuckets; ++b) {
+      counts[b] += shard->buckets[b].load(std::memory_order_relaxed);
+    }
+    snapshot.sum_ += shard->sum.load(std::memory_order_relaxed);
+    snapshot.min_ =
+        std::min(snapshot.min_, shard->min.load(std::memory_order_relaxed));
+    snapshot.max_ =
+        std::max(snapshot.max_, shard->max.load(std::memory_order_relaxed));
+  }
+  for (size_t b = 0; b < profiling_internal::kNumBuckets; ++b) {
+    if (counts[b] == 0) continue;
+    snapshot.count_ += counts[b];
+    snapshot.buckets_.push_back({profiling_internal::BucketLower(b),
+                                 profiling_internal::BucketUpper(b),
+                                 counts[b]});
+  }
+  if (snapshot.count_ == 0) {
+    snapshot.min_ = ~uint64_t{0};
+    snapshot.max_ = 0;
+  }
+  return snapshot;
+}
+
+void Histogram::Reset() {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard != nullptr) shard->Clear();
+  }
+}
+
+double HistogramSnapshot::Mean() const {
+  return count_ == 0 ? 0.0
+                     : static_cast<double>(sum_) / static_cast<double>(count_);
+}
+
+uint64_t HistogramSnapshot::Percentile(double percentile) const {
+  if (count_ == 0) return 0;
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  // The rank of the requested value, counting from 1.
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(
+             std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (const Bucket& bucket : buckets_) {
+    seen += bucket.count;
+    if (seen >= rank) {
+      const uint64_t mid = bucket.lower + (bucket.upper - bucket.lower) / 2;
+      return std::min(std::max(mid, min()), max());
+    }
+  }
+  return max();
+}
+
+void HistogramSnapshot::Merge(const HistogramSnapshot& other) {
+  if (other.count_ == 0) return;
+  std::vector<Bucket> merged;
+  merged.reserve(buckets_.size() + other.buckets_.size());
+  auto a = buckets_.begin();
+  auto b = other.buckets_.begin();
+  while (a != buckets_.end() || b != other.buckets_.end()) {
+    if (b == other.buckets_.end() ||
+        (a != buckets_.end() && a->lower < b->lower)) {
+      merged.push_back(*a++);
+    } else if (a == buckets_.end() || b->lower < a->lower) {
+      merged.push_back(*b++);
+    } else {
+      merged.push_back({a->lower, a->upper, a->count + b->count});
+      ++a;
+      ++b;
+    }
+  }
+  buckets_.swap(merged);
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+std::string HistogramSnapshot::ToString() const {
+  return turbo::StrFormat(
+      "count=%d mean=%.1f min=%d p50=%d p90=%d p99=%d p999=%d max=%d", count_,
+      Mean(), min(), Percentile(50), Percentile(90), Percentile(99),
+      Percentile(99.9), max());
+}
+
+std::string HistogramSnapshot::ToJson() const {
+  rapidjson::StringBuffer out;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(out);
+  writer.StartObject();
+  writer.Key("count");
+  writer.Uint64(count_);
+  writer.Key("sum");
+  writer.Uint64(sum_);
+  writer.Key("min");
+  writer.Uint64(min());
+  writer.Key("max");
+  writer.Uint64(max());
+  writer.Key("mean");
+  writer.Double(Mean());
+  writer.Key("p50");
+  writer.Uint64(Percentile(50));
+  writer.Key("p90");
+  writer.Uint64(Percentile(90));
+  writer.Key("p99");
+  writer.Uint64(Percentile(99));
+  writer.Key("p999");
+  writer.Uint64(Percentile(99.9));
+  writer.Key("buckets");
+  writer.StartArray();
+  for (const Bucket& bucket : buckets_) {
+    writer.StartObject();
+    writer.Key("lower");
+    writer.Uint64(bucket.lower);
+    writer.Key("upper");
+    writer.Uint64(bucket.upper);
+    writer.Key("count");
+    writer.Uint64(bucket.count);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return std::string(out.GetString(), out.GetSize());
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
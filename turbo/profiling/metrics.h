@@ -0,0 +1,236 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: metrics.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines in-process metrics which are cheap enough to be
+// updated on every request, even from many threads at once:
+//
+//   * `turbo::Counter`, a monotonically increasing count of events;
+//   * `turbo::Gauge`, a value which is set or adjusted, such as a queue size;
+//   * `turbo::Histogram`, the distribution of values such as latencies, with
+//     percentiles.
+//
+// Counters and histograms are sharded: every thread updates one of several
+// cache line separated shards with relaxed atomic operations, so updates never
+// lock and rarely contend. Reads merge the shards, which makes them much more
+// expensive than updates; they are meant for periodic export.
+//
+// Example:
+//
+//   turbo::Histogram rpc_latency;
+//   turbo::Counter rpc_errors;
+//
+//   void HandleRpc(...) {
+//     turbo::ScopedHistogramTimer timer(&rpc_latency);
+//     ...
+//     if (!status.ok()) rpc_errors.Increment();
+//   }
+//
+//   turbo::HistogramSnapshot s = rpc_latency.Snapshot();
+//   LOG(INFO) << "rpc latency (ns): " << s.ToString();
+//   uint64_t p99 = s.Percentile(99);
+
+#ifndef TURBO_PROFILING_METRICS_H_
+#define TURBO_PROFILING_METRICS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "turbo/platform/internal/cycleclock.h"
+#include "turbo/platform/port.h"
+#include "turbo/synchronization/internal/sharded_counters.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// Counter
+//
+// A sharded, monotonically increasing counter.
+class Counter {
+ public:
+  Counter();
+
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Increment() { Add(1); }
+
+  // Adds `delta`, which should not be negative, to the counter.
+  void Add(int64_t delta) {
+    shards_[synchronization_internal::CounterShardIndex(num_shards_)]
+        .value.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  // Returns the sum of all additions. Concurrent additions may or may not be
+  // included.
+  int64_t Value() const;
+
+ private:
+  const size_t num_shards_;
+  synchronization_internal::PaddedCounterArray shards_;
+};
+
+// Gauge
+//
+// A value which is set or adjusted, e.g. the number of active connections.
+// Gauges are not sharded: `Set()` must be seen by every reader immediately.
+class Gauge {
+ public:
+  Gauge() = default;
+
+  Gauge(const Gauge&) = delete;
+  Gauge& operator=(const Gauge&) = delete;
+
+  void Set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  void Add(int64_t delta) {
+    value_.fetch_add(delta, std::memory_order_relaxed);
+  }
+  int64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+// HistogramSnapshot
+//
+// A point in time copy of the contents of a `turbo::Histogram`.
+//
+// Values are counted in log-linear buckets: values below 16 have their own
+// bucket, and each power of two range above is split into 16 buckets of equal
+// width. A bucket therefore spans at most 1/16 of its values, and percentiles,
+// which are reported as the middle of the bucket they fall into, are accurate
+// to within about 3%.
+class HistogramSnapshot {
+ public:
+  struct Bucket {
+    uint64_t lower;  // Smallest value counted in this bucket.
+    uint64_t upper;  // Largest value counted in this bucket.
+    uint64_t count;
+  };
+
+  HistogramSnapshot() = default;
+
+  uint64_t count() const { return count_; }
+  // The sum of the recorded values, wrapping around on overflow.
+  uint64_t sum() const { return sum_; }
+  // The smallest and largest recorded values, 0 if the histogram is empty.
+  uint64_t min() const { return count_ == 0 ? 0 : min_; }
+  uint64_t max() const { return max_; }
+  double Mean() const;
+
+  // Returns an estimate of the value below which `percentile` percent of the
+  // recorded values fall, e.g. `Percentile(99.9)`. Returns 0 if the histogram
+  // is empty.
+  uint64_t Percentile(double percentile) const;
+
+  // The non-empty buckets, in increasing order of values.
+  const std::vector<Bucket>& buckets() const { return buckets_; }
+
+  // Adds the contents of `other` to this snapshot, e.g. to aggregate the
+  // histograms of several servers.
+  void Merge(const HistogramSnapshot& other);
+
+  // Returns a one line summary of the form
+  // "count=1000 mean=1520.3 min=980 p50=1462 p90=2112 p99=4128 p999=8320
+  // max=9001".
+  std::string ToString() const;
+
+  // Returns the summary statistics and the non-empty buckets as a JSON object:
+  // {"count":1000,"sum":1520300,"min":980,"max":9001,"mean":1520.3,
+  //  "p50":1462,"p90":2112,"p99":4128,"p999":8320,
+  //  "buckets":[{"lower":976,"upper":1007,"count":3},...]}
+  std::string ToJson() const;
+
+ private:
+  friend class Histogram;
+
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t min_ = ~uint64_t{0};
+  uint64_t max_ = 0;
+  std::vector<Bucket> buckets_;
+};
+
+// Histogram
+//
+// A sharded histogram of non-negative integer values, typically latencies in
+// nanoseconds.
+class Histogram {
+ public:
+  Histogram();
+  ~Histogram();
+
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  // Records `value` once.
+  void Record(uint64_t value);
+
+  // Records `duration` in nanoseconds; negative durations are recorded as 0.
+  void Record(turbo::Duration duration);
+
+  // Records an interval measured with `base_internal::CycleClock` in
+  // nanoseconds.
+  void RecordCycles(int64_t cycles);
+
+  // Returns the merged contents of all shards. Concurrent records may or may
+  // not be included.
+  HistogramSnapshot Snapshot() const;
+
+  // Removes all recorded values. Records concurrent with the reset may or may
+  // not be removed.
+  void Reset();
+
+ private:
+  struct Shard;
+
+  Shard* GetShard();
+
+  const size_t num_shards_;
+  // Shards are allocated by the first thread which records to them.
+  std::unique_ptr<std::atomic<Shard*>[]> shards_;
+};
+
+// ScopedHistogramTimer
+//
+// Records the time from its construction to its destruction in a histogram,
+// in nanoseconds, measured with `base_internal::CycleClock`.
+class ScopedHistogramTimer {
+ public:
+  explicit ScopedHistogramTimer(Histogram* histogram)
+      : histogram_(histogram), start_(base_internal::CycleClock::Now()) {}
+  ~ScopedHistogramTimer() {
+    histogram_->RecordCycles(base_internal::CycleClock::Now() - start_);
+  }
+
+  ScopedHistogramTimer(const ScopedHistogramTimer&) = delete;
+  ScopedHistogramTimer& operator=(const ScopedHistogramTimer&) = delete;
+
+ private:
+  Histogram* histogram_;
+  int64_t start_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_METRICS_H_
@@ -0,0 +1,67 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "turbo/profiling/metrics.h"
+
+namespace {
+
+// The baseline: every thread increments the same atomic.
+void BM_SharedAtomicIncrement(benchmark::State& state) {
+  static std::atomic<int64_t> counter{0};
+  for (auto _ : state) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+BENCHMARK(BM_SharedAtomicIncrement)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_CounterIncrement(benchmark::State& state) {
+  static turbo::Counter* counter = new turbo::Counter;
+  for (auto _ : state) {
+    counter->Increment();
+  }
+}
+BENCHMARK(BM_CounterIncrement)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_HistogramRecord(benchmark::State& state) {
+  static turbo::Histogram* histogram = new turbo::Histogram;
+  uint64_t value = static_cast<uint64_t>(state.thread_index()) * 1000;
+  for (auto _ : state) {
+    histogram->Record(value);
+    value = (value + 7919) & 0xfffff;
+  }
+}
+BENCHMARK(BM_HistogramRecord)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_ScopedHistogramTimer(benchmark::State& state) {
+  static turbo::Histogram* histogram = new turbo::Histogram;
+  for (auto _ : state) {
+    turbo::ScopedHistogramTimer timer(histogram);
+  }
+}
+BENCHMARK(BM_ScopedHistogramTimer)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_HistogramSnapshot(benchmark::State& state) {
+  turbo::Histogram histogram;
+  for (uint64_t v = 0; v < 100000; ++v) histogram.Record(v * v);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(histogram.Snapshot());
+  }
+}
+BENCHMARK(BM_HistogramSnapshot);
+
+}  // namespace
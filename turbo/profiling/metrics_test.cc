@@ -0,0 +1,206 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/json/document.h"
+#include "turbo/random/random.h"
+
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(CounterTest, SumsAcrossThreads) {
+  turbo::Counter counter;
+  EXPECT_EQ(0, counter.Value());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j < 10000; ++j) counter.Increment();
+      counter.Add(5);
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  EXPECT_EQ(8 * 10005, counter.Value());
+}
+
+TEST(GaugeTest, SetAndAdd) {
+  turbo::Gauge gauge;
+  gauge.Set(10);
+  gauge.Add(-3);
+  EXPECT_EQ(7, gauge.Value());
+}
+
+TEST(HistogramTest, Empty) {
+  turbo::Histogram histogram;
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_EQ(0u, s.count());
+  EXPECT_EQ(0u, s.min());
+  EXPECT_EQ(0u, s.max());
+  EXPECT_EQ(0u, s.Percentile(50));
+  EXPECT_EQ(0.0, s.Mean());
+  EXPECT_TRUE(s.buckets().empty());
+}
+
+TEST(HistogramTest, SmallValuesAreExact) {
+  turbo::Histogram histogram;
+  for (uint64_t v = 0; v < 16; ++v) histogram.Record(v);
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_EQ(16u, s.count());
+  EXPECT_EQ(120u, s.sum());
+  EXPECT_EQ(0u, s.min());
+  EXPECT_EQ(15u, s.max());
+  ASSERT_EQ(16u, s.buckets().size());
+  for (uint64_t v = 0; v < 16; ++v) {
+    EXPECT_EQ(v, s.buckets()[v].lower);
+    EXPECT_EQ(v, s.buckets()[v].upper);
+  }
+  EXPECT_EQ(7u, s.Percentile(50));
+  EXPECT_EQ(15u, s.Percentile(100));
+}
+
+// Buckets must tile the whole range of values without gaps or overlaps, with
+// a width of at most 1/16 of their lower bound.
+TEST(HistogramTest, BucketBoundaries) {
+  turbo::Histogram histogram;
+  for (int shift = 0; shift < 64; ++shift) {
+    const uint64_t v = uint64_t{1} << shift;
+    histogram.Record(v - 1);
+    histogram.Record(v);
+    histogram.Record(v + 1);
+  }
+  histogram.Record(~uint64_t{0});
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  uint64_t previous_upper = 0;
+  bool first = true;
+  for (const auto& bucket : s.buckets()) {
+    EXPECT_LE(bucket.lower, bucket.upper);
+    if (!first) {
+      EXPECT_GT(bucket.lower, previous_upper);
+    }
+    EXPECT_LE(bucket.upper - bucket.lower, bucket.lower / 16);
+    previous_upper = bucket.upper;
+    first = false;
+  }
+  EXPECT_EQ(~uint64_t{0}, s.buckets().back().upper);
+  EXPECT_EQ(~uint64_t{0}, s.max());
+}
+
+TEST(HistogramTest, PercentilesAreAccurate) {
+  turbo::BitGen gen;
+  std::vector<uint64_t> values;
+  turbo::Histogram histogram;
+  for (int i = 0; i < 100000; ++i) {
+    const uint64_t v = static_cast<uint64_t>(
+        turbo::Exponential<double>(gen, 1e-6) + 100);
+    values.push_back(v);
+    histogram.Record(v);
+  }
+  std::sort(values.begin(), values.end());
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_EQ(values.size(), s.count());
+  EXPECT_EQ(values.front(), s.min());
+  EXPECT_EQ(values.back(), s.max());
+  for (double p : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9}) {
+    const double exact = static_cast<double>(
+        values[static_cast<size_t>(std::ceil(p / 100 * values.size())) - 1]);
+    EXPECT_NEAR(exact, static_cast<double>(s.Percentile(p)), exact * 0.035)
+        << p;
+  }
+}
+
+TEST(HistogramTest, DurationsAndTimer) {
+  turbo::Histogram histogram;
+  histogram.Record(turbo::Microseconds(3));
+  histogram.Record(-turbo::Seconds(1));
+  {
+    turbo::ScopedHistogramTimer timer(&histogram);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_EQ(3u, s.count());
+  EXPECT_EQ(0u, s.min());
+  EXPECT_NEAR(3000.0, static_cast<double>(s.Percentile(50)), 100.0);
+  EXPECT_GT(s.max(), 1000000u);
+}
+
+TEST(HistogramTest, ConcurrentRecords) {
+  turbo::Histogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&histogram, i] {
+      for (uint64_t v = 0; v < 10000; ++v) histogram.Record(v + i);
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_EQ(80000u, s.count());
+  EXPECT_EQ(0u, s.min());
+  EXPECT_EQ(10006u, s.max());
+  histogram.Reset();
+  EXPECT_EQ(0u, histogram.Snapshot().count());
+}
+
+TEST(HistogramTest, Merge) {
+  turbo::Histogram a, b, both;
+  for (uint64_t v = 0; v < 1000; v += 3) {
+    a.Record(v);
+    both.Record(v);
+  }
+  for (uint64_t v = 500; v < 5000; v += 7) {
+    b.Record(v);
+    both.Record(v);
+  }
+  turbo::HistogramSnapshot merged = a.Snapshot();
+  merged.Merge(b.Snapshot());
+  turbo::HistogramSnapshot expected = both.Snapshot();
+  EXPECT_EQ(expected.count(), merged.count());
+  EXPECT_EQ(expected.sum(), merged.sum());
+  EXPECT_EQ(expected.min(), merged.min());
+  EXPECT_EQ(expected.max(), merged.max());
+  EXPECT_EQ(expected.ToJson(), merged.ToJson());
+}
+
+TEST(HistogramTest, Export) {
+  turbo::Histogram histogram;
+  for (uint64_t v = 1; v <= 100; ++v) histogram.Record(v);
+  turbo::HistogramSnapshot s = histogram.Snapshot();
+  EXPECT_THAT(s.ToString(), HasSubstr("count=100 mean=50.5 min=1 "));
+  EXPECT_THAT(s.ToString(), HasSubstr(" max=100"));
+
+  rapidjson::Document doc;
+  doc.Parse(s.ToJson().c_str());
+  ASSERT_FALSE(doc.HasParseError());
+  EXPECT_EQ(100u, doc["count"].GetUint64());
+  EXPECT_EQ(5050u, doc["sum"].GetUint64());
+  EXPECT_EQ(1u, doc["min"].GetUint64());
+  EXPECT_EQ(100u, doc["max"].GetUint64());
+  EXPECT_EQ(s.Percentile(99), doc["p99"].GetUint64());
+  uint64_t total = 0;
+  for (const auto& bucket : doc["buckets"].GetArray()) {
+    total += bucket["count"].GetUint64();
+  }
+  EXPECT_EQ(100u, total);
+}
+
+}  // namespace
@@ -0,0 +1,135 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/sampling_profiler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "turbo/container/flat_hash_map.h"
+#include "turbo/profiling/internal/exponential_biased.h"
+#include "turbo/strings/str_cat.h"
+#include "turbo/strings/str_format.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+namespace {
+
+// While sampling is disabled, threads check the period again after this many
+// units, so that enabling it takes effect without a hot path check.
+constexpr int64_t kDisabledStride = 1 << 16;
+
+thread_local ExponentialBiased profile_stride_generator;
+
+}  // namespace
+
+void AppendMappedLibraries(std::string* out) {
+#ifdef __linux__
+  FILE* maps = fopen("/proc/self/maps", "r");
+  if (maps == nullptr) return;
+  out->append("\nMAPPED_LIBRARIES:\n");
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+    out->append(buffer, n);
+  }
+  fclose(maps);
+#else
+  (void)out;
+#endif
+}
+
+bool ShouldSampleSlow(ProfileSamplingState* state, int64_t weight,
+                      int64_t mean_period) {
+  if (mean_period <= 0) {
+    state->stride = 0;
+    state->countdown = kDisabledStride;
+    return false;
+  }
+  if (state->stride == 0) {
+    // The first call on this thread, or since sampling was enabled: start
+    // counting with this call.
+    state->stride = state->countdown =
+        profile_stride_generator.GetStride(mean_period);
+    state->countdown -= weight;
+    if (state->countdown > 0) return false;
+  }
+  // The sample stands for all units counted since the previous one.
+  state->weight = state->stride - state->countdown;
+  state->stride = state->countdown =
+      profile_stride_generator.GetStride(mean_period);
+  return true;
+}
+
+struct StackProfile::Entries {
+  struct Totals {
+    int64_t samples = 0;
+    int64_t weight = 0;
+  };
+  turbo::flat_hash_map<std::vector<void*>, Totals> by_stack;
+};
+
+StackProfile::StackProfile() : entries_(new Entries) {}
+
+StackProfile::~StackProfile() { delete entries_; }
+
+void StackProfile::Add(void* const* stack, int depth, int64_t samples,
+                       int64_t weight) {
+  Entries::Totals& totals =
+      entries_->by_stack[std::vector<void*>(stack, stack + depth)];
+  totals.samples += samples;
+  totals.weight += weight;
+}
+
+void StackProfile::Clear() { entries_->by_stack.clear(); }
+
+std::string StackProfile::ToPprof() const {
+  // Heaviest stacks first, which is also what pprof would show first.
+  std::vector<const std::pair<const std::vector<void*>, Entries::Totals>*>
+      rows;
+  int64_t samples = 0;
+  int64_t weight = 0;
+  for (const auto& entry : entries_->by_stack) {
+    rows.push_back(&entry);
+    samples += entry.second.samples;
+    weight += entry.second.weight;
+  }
+  std::sort(rows.begin(), rows.end(), [](const auto* a, const auto* b) {
+    return a->second.weight > b->second.weight;
+  });
+
+  std::string out = turbo::StrFormat(
+      "heap profile: %d: %d [%d: %d] @ heapprofile\n", samples, weight,
+      samples, weight);
+  for (const auto* row : rows) {
+    turbo::StrAppend(&out,
+                     turbo::StrFormat("%d: %d [%d: %d] @", row->second.samples,
+                                      row->second.weight, row->second.samples,
+                                      row->second.weight));
+    for (void* pc : row->first) {
+      turbo::StrAppend(&out, turbo::StrFormat(" %p", pc));
+    }
+    out.push_back('\n');
+  }
+  AppendMappedLibraries(&out);
+  return out;
+}
+
+}  // namespace profiling_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
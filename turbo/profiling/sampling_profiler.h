@@ -0,0 +1,281 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: sampling_profiler.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::SamplingProfiler`, which profiles objects
+// or events of user code the way hashtablez profiles Swiss tables and cordz
+// profiles cords: a small random subset of them is recorded together with
+// the stack trace which created them, at a cost of a thread-local decrement
+// for the others.
+//
+// A profiler is declared by defining its sample type, which derives from
+// `turbo::ProfileSample` and defines `PrepareSample()`:
+//
+//   struct QueueSample : turbo::ProfileSample<QueueSample> {
+//     // Called when a queue is sampled, with the arguments of `Register()`.
+//     // Samples are reused, so all fields must be reset.
+//     void PrepareSample(size_t capacity_value) {
+//       capacity.store(capacity_value, std::memory_order_relaxed);
+//       max_size.store(0, std::memory_order_relaxed);
+//     }
+//
+//     std::atomic<size_t> capacity;
+//     std::atomic<size_t> max_size;
+//   };
+//
+//   using QueueProfiler = turbo::SamplingProfiler<QueueSample>;
+//
+// Live objects are sampled when they are created and unregistered when they
+// are destroyed:
+//
+//   Queue::Queue(size_t capacity) {
+//     if (TURBO_PREDICT_FALSE(QueueProfiler::ShouldSample())) {
+//       sample_ = QueueProfiler::Global().Register(capacity);
+//     }
+//   }
+//   Queue::~Queue() {
+//     if (sample_ != nullptr) QueueProfiler::Global().Unregister(sample_);
+//   }
+//
+// Events, such as slow paths being taken, are only counted per stack trace:
+//
+//   if (QueueProfiler::ShouldSample()) QueueProfiler::Global().RecordEvent();
+//
+// Sampling may be weighted, e.g. by allocation sizes: `ShouldSample(bytes)`
+// samples about once every `mean_period` bytes, and each sample's `weight` is
+// the number of bytes it stands for.
+//
+// `ExportLiveProfile()` and `ExportEventProfile()` aggregate the samples by
+// stack trace in the legacy pprof heap profile format, which `pprof` reads:
+//
+//   $ pprof --top /path/to/binary queue_profile.txt
+//
+// Each stack is reported with the number of samples taken and the sum of
+// their weights, which estimates the total number of events (or bytes); pprof
+// labels these as objects and bytes respectively.
+
+#ifndef TURBO_PROFILING_SAMPLING_PROFILER_H_
+#define TURBO_PROFILING_SAMPLING_PROFILER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "turbo/debugging/stacktrace.h"
+#include "turbo/platform/port.h"
+#include "turbo/profiling/internal/sample_recorder.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/time/clock.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+
+// The per-thread state of `SamplingProfiler::ShouldSample()`.
+struct ProfileSamplingState {
+  // Units left until the next sample.
+  int64_t countdown;
+  // The stride that `countdown` started from, 0 before the first call.
+  int64_t stride;
+  // The weight of the last sample taken on this thread.
+  int64_t weight;
+};
+
+// Decides whether the call of `weight` units which brought `state->countdown`
+// to zero or below is sampled, and starts the next stride.
+bool ShouldSampleSlow(ProfileSamplingState* state, int64_t weight,
+                      int64_t mean_period);
+
+constexpr int kMaxProfileStackDepth = 64;
+
+// Appends the memory mappings of the process, which pprof needs to symbolize
+// the addresses of a legacy profile.
+void AppendMappedLibraries(std::string* out);
+
+struct ProfileSampleInit {
+  int64_t weight;
+  int depth;
+  void* const* stack;
+};
+
+// Samples aggregated by stack trace, rendered in the legacy pprof heap profile
+// format.
+class StackProfile {
+ public:
+  StackProfile();
+  ~StackProfile();
+
+  StackProfile(const StackProfile&) = delete;
+  StackProfile& operator=(const StackProfile&) = delete;
+
+  void Add(void* const* stack, int depth, int64_t samples, int64_t weight);
+  void Clear();
+  std::string ToPprof() const;
+
+ private:
+  struct Entries;
+  Entries* entries_;
+};
+
+}  // namespace profiling_internal
+
+// ProfileSample
+//
+// The base class of sample types of `turbo::SamplingProfiler`. The fields
+// below are filled in by the profiler and may be read by `Iterate()`
+// callbacks.
+template <typename T>
+struct ProfileSample : profiling_internal::Sample<T> {
+  static constexpr int kMaxStackDepth =
+      profiling_internal::kMaxProfileStackDepth;
+
+  // Called by `profiling_internal::SampleRecorder` with `init_mu` held.
+  template <typename... Args>
+  void PrepareForSampling(const profiling_internal::ProfileSampleInit& init,
+                          Args&&... args) {
+    this->weight = init.weight;
+    depth = init.depth;
+    for (int i = 0; i < depth; ++i) stack[i] = init.stack[i];
+    create_time = turbo::Now();
+    static_cast<T*>(this)->PrepareSample(std::forward<Args>(args)...);
+  }
+
+  // The default for sample types without fields of their own.
+  void PrepareSample() {}
+
+  turbo::Time create_time;
+  int depth = 0;
+  void* stack[kMaxStackDepth];
+};
+
+// SamplingProfiler
+//
+// A process-wide sampling profiler for samples of type `T`. Thread-safe.
+template <typename T>
+class SamplingProfiler {
+ public:
+  // Returns the profiler of `T`.
+  static SamplingProfiler& Global() {
+    static auto* profiler = new SamplingProfiler;
+    return *profiler;
+  }
+
+  // ShouldSample()
+  //
+  // Counts `weight` units and returns true if they are sampled, on average
+  // once every `mean_period()` units. A true result must be followed by a call
+  // to `Register()` or `RecordEvent()` on the same thread, which records the
+  // sample with the weight it represents.
+  static bool ShouldSample(int64_t weight = 1) {
+    profiling_internal::ProfileSamplingState& state = ThreadState();
+    state.countdown -= weight;
+    if (TURBO_PREDICT_TRUE(state.countdown > 0)) return false;
+    return profiling_internal::ShouldSampleSlow(&state, weight,
+                                                Global().mean_period());
+  }
+
+  // Sets the average number of units between samples; 0, the default,
+  // disables sampling. Threads pick up a new period after their current
+  // stride, or after 65536 units while sampling is disabled.
+  void SetMeanPeriod(int64_t period) {
+    mean_period_.store(period, std::memory_order_relaxed);
+  }
+  int64_t mean_period() const {
+    return mean_period_.load(std::memory_order_relaxed);
+  }
+
+  // Sets the maximum number of live samples; further registrations return
+  // nullptr until samples are unregistered.
+  void SetMaxSamples(size_t max) { recorder_.SetMaxSamples(max); }
+
+  // Register()
+  //
+  // Records a live sample with the stack trace of the caller, initialized by
+  // `T::PrepareSample(args...)`. Returns nullptr if too many samples are live.
+  template <typename... Args>
+  T* Register(Args&&... args) {
+    void* stack[profiling_internal::kMaxProfileStackDepth];
+    const int depth = turbo::GetStackTrace(
+        stack, profiling_internal::kMaxProfileStackDepth, /*skip_count=*/0);
+    const profiling_internal::ProfileSampleInit init = {
+        ThreadState().weight, depth, stack};
+    return recorder_.Register(init, std::forward<Args>(args)...);
+  }
+
+  // Unregisters a sample returned by `Register()`.
+  void Unregister(T* sample) { recorder_.Unregister(sample); }
+
+  // RecordEvent()
+  //
+  // Counts the sampled event in the event profile, by the stack trace of the
+  // caller.
+  void RecordEvent() {
+    void* stack[profiling_internal::kMaxProfileStackDepth];
+    const int depth = turbo::GetStackTrace(
+        stack, profiling_internal::kMaxProfileStackDepth, /*skip_count=*/0);
+    turbo::MutexLock lock(&events_mu_);
+    events_.Add(stack, depth, 1, ThreadState().weight);
+  }
+
+  // Calls `f` on every live sample, returning the number of samples dropped
+  // because of the limit on live samples.
+  int64_t Iterate(const std::function<void(const T& sample)>& f) {
+    return recorder_.Iterate(f);
+  }
+
+  // Returns the live samples aggregated by stack trace, in the pprof legacy
+  // heap profile format.
+  std::string ExportLiveProfile() {
+    profiling_internal::StackProfile profile;
+    recorder_.Iterate([&profile](const T& sample) {
+      profile.Add(sample.stack, sample.depth, 1, sample.weight);
+    });
+    return profile.ToPprof();
+  }
+
+  // Returns the events recorded since the last call, aggregated by stack
+  // trace, in the pprof legacy heap profile format.
+  std::string ExportEventProfile() {
+    turbo::MutexLock lock(&events_mu_);
+    std::string result = events_.ToPprof();
+    events_.Clear();
+    return result;
+  }
+
+ private:
+  SamplingProfiler() = default;
+
+  static profiling_internal::ProfileSamplingState& ThreadState() {
+    static thread_local profiling_internal::ProfileSamplingState state = {0, 0,
+                                                                         0};
+    return state;
+  }
+
+  std::atomic<int64_t> mean_period_{0};
+  profiling_internal::SampleRecorder<T> recorder_;
+  turbo::Mutex events_mu_;
+  profiling_internal::StackProfile events_ TURBO_GUARDED_BY(events_mu_);
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_SAMPLING_PROFILER_H_
@@ -0,0 +1,53 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/benchmark.h"
+#include "turbo/profiling/sampling_profiler.h"
+
+namespace {
+
+struct BenchmarkSample : turbo::ProfileSample<BenchmarkSample> {};
+using BenchmarkProfiler = turbo::SamplingProfiler<BenchmarkSample>;
+
+// The cost on the hot path, with sampling disabled (period 0) and at typical
+// periods; sampled calls register and unregister a live sample.
+void BM_ShouldSample(benchmark::State& state) {
+  BenchmarkProfiler& profiler = BenchmarkProfiler::Global();
+  profiler.SetMeanPeriod(state.range(0));
+  for (auto _ : state) {
+    if (TURBO_PREDICT_FALSE(BenchmarkProfiler::ShouldSample())) {
+      BenchmarkSample* sample = profiler.Register();
+      if (sample != nullptr) profiler.Unregister(sample);
+    }
+  }
+  profiler.SetMeanPeriod(0);
+}
+BENCHMARK(BM_ShouldSample)
+    ->Arg(0)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->ThreadRange(1, 8);
+
+void BM_RecordEvent(benchmark::State& state) {
+  BenchmarkProfiler& profiler = BenchmarkProfiler::Global();
+  profiler.SetMeanPeriod(1);
+  for (auto _ : state) {
+    if (BenchmarkProfiler::ShouldSample()) profiler.RecordEvent();
+  }
+  profiler.SetMeanPeriod(0);
+  profiler.ExportEventProfile();
+}
+BENCHMARK(BM_RecordEvent);
+
+}  // namespace
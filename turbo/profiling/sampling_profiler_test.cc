@@ -0,0 +1,180 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/sampling_profiler.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/strings/numbers.h"
+#include "turbo/strings/str_split.h"
+
+namespace {
+
+using ::testing::HasSubstr;
+
+// Each test uses its own sample type, and so its own profiler.
+template <int kId>
+struct TestSample : turbo::ProfileSample<TestSample<kId>> {
+  void PrepareSample(int size_value) {
+    size.store(size_value, std::memory_order_relaxed);
+  }
+  std::atomic<int> size;
+};
+
+template <int kId>
+using TestProfiler = turbo::SamplingProfiler<TestSample<kId>>;
+
+TEST(SamplingProfilerTest, DisabledByDefault) {
+  for (int i = 0; i < 200000; ++i) {
+    ASSERT_FALSE(TestProfiler<0>::ShouldSample());
+  }
+}
+
+TEST(SamplingProfilerTest, RegisterAndUnregister) {
+  auto& profiler = TestProfiler<1>::Global();
+  profiler.SetMeanPeriod(1);
+  ASSERT_TRUE(TestProfiler<1>::ShouldSample());
+  TestSample<1>* sample = profiler.Register(42);
+  ASSERT_NE(sample, nullptr);
+  EXPECT_EQ(1, sample->weight);
+  EXPECT_EQ(42, sample->size.load());
+  EXPECT_GT(sample->depth, 0);
+
+  std::vector<int> sizes;
+  profiler.Iterate(
+      [&sizes](const TestSample<1>& s) { sizes.push_back(s.size.load()); });
+  EXPECT_THAT(sizes, testing::ElementsAre(42));
+
+  profiler.Unregister(sample);
+  sizes.clear();
+  profiler.Iterate(
+      [&sizes](const TestSample<1>& s) { sizes.push_back(s.size.load()); });
+  EXPECT_TRUE(sizes.empty());
+}
+
+TEST(SamplingProfilerTest, SamplesAtTheMeanPeriod) {
+  TestProfiler<2>::Global().SetMeanPeriod(100);
+  constexpr int kCalls = 1000000;
+  int samples = 0;
+  for (int i = 0; i < kCalls; ++i) {
+    if (TestProfiler<2>::ShouldSample()) ++samples;
+  }
+  EXPECT_NEAR(kCalls / 100, samples, kCalls / 100 / 10);
+}
+
+// With weighted sampling, the weights of the samples add up to the total
+// weight counted, up to the part of the last stride.
+TEST(SamplingProfilerTest, WeightsEstimateTotal) {
+  auto& profiler = TestProfiler<3>::Global();
+  profiler.SetMeanPeriod(4096);
+  int64_t total = 0;
+  int64_t sampled_weight = 0;
+  for (int i = 0; i < 100000; ++i) {
+    const int64_t bytes = 1 + (i * 37) % 2000;
+    total += bytes;
+    if (TestProfiler<3>::ShouldSample(bytes)) {
+      TestSample<3>* sample = profiler.Register(static_cast<int>(bytes));
+      ASSERT_NE(sample, nullptr);
+      sampled_weight += sample->weight;
+      profiler.Unregister(sample);
+    }
+  }
+  EXPECT_LE(sampled_weight, total);
+  EXPECT_GT(sampled_weight, total - 4096 * 20);
+}
+
+TEST(SamplingProfilerTest, MaxSamples) {
+  auto& profiler = TestProfiler<4>::Global();
+  profiler.SetMeanPeriod(1);
+  profiler.SetMaxSamples(3);
+  std::vector<TestSample<4>*> samples;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(TestProfiler<4>::ShouldSample());
+    if (TestSample<4>* s = profiler.Register(i)) samples.push_back(s);
+  }
+  EXPECT_LE(samples.size(), 4u);
+  EXPECT_GT(profiler.Iterate([](const TestSample<4>&) {}), 0);
+  for (TestSample<4>* s : samples) profiler.Unregister(s);
+}
+
+TURBO_ATTRIBUTE_NOINLINE void EventSiteA() {
+  if (TestProfiler<5>::ShouldSample()) TestProfiler<5>::Global().RecordEvent();
+}
+TURBO_ATTRIBUTE_NOINLINE void EventSiteB() {
+  if (TestProfiler<5>::ShouldSample()) TestProfiler<5>::Global().RecordEvent();
+}
+
+// Returns the sample lines of a legacy heap profile.
+std::vector<std::string> ProfileRows(const std::string& profile) {
+  std::vector<std::string> rows;
+  for (turbo::string_view line : turbo::StrSplit(profile, '\n')) {
+    if (line.empty() || line == "MAPPED_LIBRARIES:") break;
+    rows.emplace_back(line);
+  }
+  return rows;
+}
+
+TEST(SamplingProfilerTest, EventProfile) {
+  auto& profiler = TestProfiler<5>::Global();
+  profiler.SetMeanPeriod(1);
+  for (int i = 0; i < 3; ++i) EventSiteA();
+  EventSiteB();
+
+  const std::string profile = profiler.ExportEventProfile();
+  std::vector<std::string> rows = ProfileRows(profile);
+  ASSERT_GE(rows.size(), 2u) << profile;
+  EXPECT_EQ("heap profile: 4: 4 [4: 4] @ heapprofile", rows[0]);
+  // Calls from distinct sites are separate rows, but the stack unwinder may
+  // not be able to tell the sites apart, e.g. without frame pointers, so only
+  // the total is checked.
+  int total = 0;
+  for (size_t i = 1; i < rows.size(); ++i) {
+    EXPECT_THAT(rows[i], HasSubstr(" @ 0x"));
+    int samples = 0;
+    ASSERT_TRUE(turbo::SimpleAtoi(
+        turbo::string_view(rows[i]).substr(0, rows[i].find(':')), &samples));
+    total += samples;
+  }
+  EXPECT_EQ(4, total);
+#ifdef __linux__
+  EXPECT_THAT(profile, HasSubstr("\nMAPPED_LIBRARIES:\n"));
+#endif
+
+  // Exporting clears the event profile.
+  EXPECT_EQ(1u, ProfileRows(profiler.ExportEventProfile()).size());
+}
+
+TEST(SamplingProfilerTest, LiveProfile) {
+  auto& profiler = TestProfiler<6>::Global();
+  profiler.SetMeanPeriod(1);
+  std::vector<TestSample<6>*> samples;
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(TestProfiler<6>::ShouldSample());
+    samples.push_back(profiler.Register(i));
+  }
+  std::vector<std::string> rows = ProfileRows(profiler.ExportLiveProfile());
+  ASSERT_EQ(2u, rows.size());
+  EXPECT_EQ("heap profile: 5: 5 [5: 5] @ heapprofile", rows[0]);
+
+  for (TestSample<6>* s : samples) profiler.Unregister(s);
+  rows = ProfileRows(profiler.ExportLiveProfile());
+  ASSERT_EQ(1u, rows.size());
+  EXPECT_EQ("heap profile: 0: 0 [0: 0] @ heapprofile", rows[0]);
+}
+
+}  // namespace
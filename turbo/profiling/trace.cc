@@ -0,0 +1,245 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/trace.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "turbo/json/stringbuffer.h"
+#include "turbo/json/writer.h"
+#include "turbo/platform/internal/sysinfo.h"
+#include "turbo/synchronization/mutex.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace profiling_internal {
+
+TURBO_CONST_INIT std::atomic<bool> trace_enabled{false};
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  int64_t begin;
+  int64_t end;
+  uint32_t tid;
+};
+
+// Single producer, single consumer ring buffer of the spans of one thread. The
+// owning thread appends at `head_`, CollectTraceEvents() consumes from `tail_`
+// with `registry_mu` held, so there is only ever one consumer.
+class TraceBuffer {
+ public:
+  static constexpr size_t kCapacity = 8192;
+
+  explicit TraceBuffer(uint32_t tid) : tid_(tid) {}
+
+  void Push(const char* name, int64_t begin, int64_t end) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    events_[head % kCapacity] = {name, begin, end, tid_};
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Appends the buffered events to `out` and removes them from the buffer.
+  size_t Drain(std::vector<TraceEvent>* out) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    for (size_t i = tail; i != head; ++i) {
+      out->push_back(events_[i % kCapacity]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  uint64_t TakeDropped() {
+    return dropped_.exchange(0, std::memory_order_relaxed);
+  }
+
+  // Set when the owning thread exits; the buffer is deleted once drained.
+  std::atomic<bool> retired{false};
+
+ private:
+  const uint32_t tid_;
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint64_t> dropped_{0};
+  TraceEvent events_[kCapacity];
+};
+
+turbo::Mutex registry_mu(turbo::kConstInit);
+std::vector<TraceBuffer*>* buffers TURBO_GUARDED_BY(registry_mu) = nullptr;
+std::vector<TraceEvent>* collected TURBO_GUARDED_BY(registry_mu) = nullptr;
+uint64_t dropped TURBO_GUARDED_BY(registry_mu) = 0;
+std::atomic<int64_t> trace_epoch{0};
+
+thread_local TraceBuffer* tls_buffer = nullptr;
+thread_local bool tls_exiting = false;
+
+// Retires the thread's buffer when the thread exits.
+struct TraceBufferOwner {
+  ~TraceBufferOwner() {
+    tls_exiting = true;
+    if (tls_buffer != nullptr) {
+      tls_buffer->retired.store(true, std::memory_order_release);
+      tls_buffer = nullptr;
+    }
+  }
+};
+
+TURBO_ATTRIBUTE_NOINLINE TraceBuffer* CreateThreadBuffer() {
+  static thread_local TraceBufferOwner owner;
+  (void)owner;
+  auto* buffer =
+      new TraceBuffer(static_cast<uint32_t>(base_internal::GetTID()));
+  turbo::MutexLock lock(&registry_mu);
+  if (buffers == nullptr) buffers = new std::vector<TraceBuffer*>;
+  buffers->push_back(buffer);
+  tls_buffer = buffer;
+  return buffer;
+}
+
+size_t CollectLocked() TURBO_EXCLUSIVE_LOCKS_REQUIRED(registry_mu) {
+  if (collected == nullptr) collected = new std::vector<TraceEvent>;
+  if (buffers == nullptr) return 0;
+  size_t moved = 0;
+  auto it = buffers->begin();
+  while (it != buffers->end()) {
+    TraceBuffer* buffer = *it;
+    // Load `retired` first: once it is set the owner appends no more events,
+    // so the drain below sees all of them.
+    const bool retired = buffer->retired.load(std::memory_order_acquire);
+    moved += buffer->Drain(collected);
+    dropped += buffer->TakeDropped();
+    if (retired) {
+      delete buffer;
+      it = buffers->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return moved;
+}
+
+uint32_t ProcessId() {
+#ifdef _WIN32
+  return static_cast<uint32_t>(_getpid());
+#else
+  return static_cast<uint32_t>(getpid());
+#endif
+}
+
+}  // namespace
+
+void RecordTraceSpan(const char* name, int64_t begin, int64_t end) {
+  TraceBuffer* buffer = tls_buffer;
+  if (TURBO_PREDICT_FALSE(buffer == nullptr)) {
+    // Spans closed by thread-local destructors which run after the buffer
+    // has been retired are dropped.
+    if (tls_exiting) return;
+    buffer = CreateThreadBuffer();
+  }
+  buffer->Push(name, begin, end);
+}
+
+}  // namespace profiling_internal
+
+void StartTracing() {
+  int64_t expected = 0;
+  profiling_internal::trace_epoch.compare_exchange_strong(
+      expected, base_internal::CycleClock::Now(), std::memory_order_relaxed);
+  profiling_internal::trace_enabled.store(true, std::memory_order_relaxed);
+}
+
+void StopTracing() {
+  profiling_internal::trace_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool IsTracingEnabled() {
+  return profiling_internal::trace_enabled.load(std::memory_order_relaxed);
+}
+
+size_t CollectTraceEvents() {
+  turbo::MutexLock lock(&profiling_internal::registry_mu);
+  return profiling_internal::CollectLocked();
+}
+
+std::string ExportChromeTrace() {
+  using profiling_internal::TraceEvent;
+  std::vector<TraceEvent> events;
+  uint64_t dropped = 0;
+  {
+    turbo::MutexLock lock(&profiling_internal::registry_mu);
+    profiling_internal::CollectLocked();
+    events.swap(*profiling_internal::collected);
+    std::swap(dropped, profiling_internal::dropped);
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const TraceEvent& a, const TraceEvent& b) {
+                     return a.begin < b.begin;
+                   });
+
+  const int64_t epoch =
+      profiling_internal::trace_epoch.load(std::memory_order_relaxed);
+  const double us_per_tick = 1e6 / base_internal::CycleClock::Frequency();
+  const uint32_t pid = profiling_internal::ProcessId();
+
+  rapidjson::StringBuffer out;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(out);
+  writer.StartObject();
+  writer.Key("traceEvents");
+  writer.StartArray();
+  for (const TraceEvent& event : events) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(event.name);
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("ts");
+    writer.Double(static_cast<double>(event.begin - epoch) * us_per_tick);
+    writer.Key("dur");
+    writer.Double(static_cast<double>(event.end - event.begin) * us_per_tick);
+    writer.Key("pid");
+    writer.Uint(pid);
+    writer.Key("tid");
+    writer.Uint(event.tid);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.Key("displayTimeUnit");
+  writer.String("ns");
+  writer.Key("otherData");
+  writer.StartObject();
+  writer.Key("dropped_events");
+  writer.Uint64(dropped);
+  writer.EndObject();
+  writer.EndObject();
+  return std::string(out.GetString(), out.GetSize());
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,150 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: trace.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `TURBO_TRACE_SCOPE()`, a low-overhead way to record
+// how long regions of code take, and functions to export the recorded spans
+// as Chrome trace event JSON, which can be loaded into chrome://tracing or
+// https://ui.perfetto.dev.
+//
+// Example:
+//
+//   void Server::HandleRequest(const Request& request) {
+//     TURBO_TRACE_SCOPE("HandleRequest");
+//     ...
+//     {
+//       TURBO_TRACE_SCOPE("Lookup");
+//       ...
+//     }
+//   }
+//
+//   turbo::StartTracing();
+//   RunLoadTest();
+//   turbo::StopTracing();
+//   std::string json = turbo::ExportChromeTrace();
+//
+// While tracing is stopped, a trace scope costs a relaxed atomic load. While
+// it is running, each scope reads the cycle counter twice and appends one
+// event to a fixed-size ring buffer owned by the calling thread: there are no
+// locks and no allocations on this path, except for the allocation of the
+// buffer on the first span of each thread.
+//
+// Ring buffers are emptied by `CollectTraceEvents()`, which may be called
+// periodically from any thread to keep them from overflowing, and by
+// `ExportChromeTrace()`. A span which finds its buffer full is dropped and
+// counted in the exported trace's "dropped_events".
+
+#ifndef TURBO_PROFILING_TRACE_H_
+#define TURBO_PROFILING_TRACE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "turbo/platform/internal/cycleclock.h"
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// StartTracing()
+//
+// Starts recording trace scopes. Events recorded before a previous
+// `StopTracing()` and not yet exported are kept.
+void StartTracing();
+
+// StopTracing()
+//
+// Stops recording trace scopes. Scopes which are open when tracing stops are
+// still recorded when they close.
+void StopTracing();
+
+// IsTracingEnabled()
+//
+// Returns whether trace scopes are currently recorded.
+bool IsTracingEnabled();
+
+// CollectTraceEvents()
+//
+// Moves the events recorded so far out of the per-thread ring buffers into a
+// process-wide list, making room for new events. Returns the number of events
+// moved.
+size_t CollectTraceEvents();
+
+// ExportChromeTrace()
+//
+// Collects the recorded events and returns all events collected since the
+// previous export in the Chrome trace event JSON format, as complete ("X")
+// events with microsecond timestamps relative to the first `StartTracing()`.
+std::string ExportChromeTrace();
+
+namespace profiling_internal {
+
+TURBO_CONST_INIT extern std::atomic<bool> trace_enabled;
+
+// Appends a span to the calling thread's ring buffer.
+void RecordTraceSpan(const char* name, int64_t begin, int64_t end);
+
+}  // namespace profiling_internal
+
+// TraceScope
+//
+// The implementation of `TURBO_TRACE_SCOPE()`; records the time between its
+// construction and its destruction. `name` must outlive the export of the
+// trace, typically it is a string literal.
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name) {
+    if (TURBO_PREDICT_FALSE(profiling_internal::trace_enabled.load(
+            std::memory_order_relaxed))) {
+      name_ = name;
+      begin_ = base_internal::CycleClock::Now();
+    }
+  }
+
+  ~TraceScope() {
+    if (TURBO_PREDICT_FALSE(name_ != nullptr)) {
+      profiling_internal::RecordTraceSpan(name_, begin_,
+                                          base_internal::CycleClock::Now());
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* name_ = nullptr;
+  int64_t begin_ = 0;
+};
+
+#define TURBO_INTERNAL_TRACE_CONCAT2(a, b) a##b
+#define TURBO_INTERNAL_TRACE_CONCAT(a, b) TURBO_INTERNAL_TRACE_CONCAT2(a, b)
+
+// TURBO_TRACE_SCOPE()
+//
+// Records the time from this statement to the end of the enclosing scope as a
+// span named `name`, which must be a string literal or otherwise outlive the
+// trace export.
+#define TURBO_TRACE_SCOPE(name)                                         \
+  ::turbo::TraceScope TURBO_INTERNAL_TRACE_CONCAT(turbo_trace_scope_, \
+                                                  __LINE__)(name)
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_PROFILING_TRACE_H_
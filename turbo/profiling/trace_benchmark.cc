@@ -0,0 +1,77 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/benchmark.h"
+#include "turbo/platform/internal/cycleclock.h"
+#include "turbo/profiling/trace.h"
+
+namespace {
+
+// The cost of the timestamps alone, for comparison.
+void BM_CycleClockNow(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::base_internal::CycleClock::Now());
+  }
+}
+BENCHMARK(BM_CycleClockNow);
+
+void BM_TraceScopeDisabled(benchmark::State& state) {
+  turbo::StopTracing();
+  for (auto _ : state) {
+    TURBO_TRACE_SCOPE("disabled");
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_TraceScopeDisabled)->ThreadRange(1, 8);
+
+// Recorded spans, with the ring buffers drained outside of the timed region
+// before they fill up so that no span takes the cheaper dropping path.
+void BM_TraceScopeEnabled(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    turbo::ExportChromeTrace();
+    turbo::StartTracing();
+  }
+  int64_t spans = 0;
+  for (auto _ : state) {
+    TURBO_TRACE_SCOPE("enabled");
+    benchmark::ClobberMemory();
+    if (++spans % 4096 == 0) {
+      state.PauseTiming();
+      turbo::CollectTraceEvents();
+      state.ResumeTiming();
+    }
+  }
+  if (state.thread_index() == 0) {
+    turbo::StopTracing();
+    turbo::ExportChromeTrace();
+  }
+}
+BENCHMARK(BM_TraceScopeEnabled)->ThreadRange(1, 8);
+
+void BM_ExportChromeTrace(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    turbo::StartTracing();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      TURBO_TRACE_SCOPE("span");
+    }
+    turbo::StopTracing();
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(turbo::ExportChromeTrace());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExportChromeTrace)->Arg(1000)->Arg(8000);
+
+}  // namespace
@@ -0,0 +1,160 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/profiling/trace.h"
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/json/document.h"
+
+namespace {
+
+class TraceTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    turbo::StopTracing();
+    turbo::ExportChromeTrace();
+  }
+  void TearDown() override { turbo::StopTracing(); }
+
+  // Exports the trace and parses it, checking the overall structure.
+  rapidjson::Document Export() {
+    rapidjson::Document doc;
+    doc.Parse(turbo::ExportChromeTrace().c_str());
+    EXPECT_FALSE(doc.HasParseError());
+    EXPECT_TRUE(doc.IsObject());
+    EXPECT_TRUE(doc["traceEvents"].IsArray());
+    return doc;
+  }
+};
+
+void Nested() {
+  TURBO_TRACE_SCOPE("outer");
+  {
+    TURBO_TRACE_SCOPE("inner");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST_F(TraceTest, DisabledRecordsNothing) {
+  EXPECT_FALSE(turbo::IsTracingEnabled());
+  Nested();
+  rapidjson::Document doc = Export();
+  EXPECT_EQ(0u, doc["traceEvents"].Size());
+}
+
+TEST_F(TraceTest, RecordsNestedSpans) {
+  turbo::StartTracing();
+  EXPECT_TRUE(turbo::IsTracingEnabled());
+  Nested();
+  turbo::StopTracing();
+
+  rapidjson::Document doc = Export();
+  const rapidjson::Value& events = doc["traceEvents"];
+  ASSERT_EQ(2u, events.Size());
+  // Events are sorted by start time, so the enclosing span comes first.
+  const rapidjson::Value& outer = events[0];
+  const rapidjson::Value& inner = events[1];
+  EXPECT_STREQ("outer", outer["name"].GetString());
+  EXPECT_STREQ("inner", inner["name"].GetString());
+  EXPECT_STREQ("X", outer["ph"].GetString());
+  EXPECT_EQ(outer["tid"].GetUint(), inner["tid"].GetUint());
+  EXPECT_EQ(outer["pid"].GetUint(), inner["pid"].GetUint());
+  EXPECT_LE(outer["ts"].GetDouble(), inner["ts"].GetDouble());
+  EXPECT_GE(outer["ts"].GetDouble() + outer["dur"].GetDouble(),
+            inner["ts"].GetDouble() + inner["dur"].GetDouble());
+  // The inner span sleeps for 1ms; allow for a coarse cycle clock.
+  EXPECT_GT(inner["dur"].GetDouble(), 500.0);
+  EXPECT_EQ(0u, doc["otherData"]["dropped_events"].GetUint64());
+
+  // Exported events are not exported again.
+  EXPECT_EQ(0u, Export()["traceEvents"].Size());
+}
+
+TEST_F(TraceTest, ScopeOpenWhenStoppedIsRecorded) {
+  turbo::StartTracing();
+  {
+    TURBO_TRACE_SCOPE("open");
+    turbo::StopTracing();
+    TURBO_TRACE_SCOPE("after_stop");
+  }
+  rapidjson::Document doc = Export();
+  ASSERT_EQ(1u, doc["traceEvents"].Size());
+  EXPECT_STREQ("open", doc["traceEvents"][0]["name"].GetString());
+}
+
+TEST_F(TraceTest, ThreadsWhichExited) {
+  constexpr int kThreads = 4;
+  constexpr int kSpans = 100;
+  turbo::StartTracing();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([] {
+      for (int j = 0; j < kSpans; ++j) {
+        TURBO_TRACE_SCOPE("work");
+      }
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  turbo::StopTracing();
+
+  rapidjson::Document doc = Export();
+  const rapidjson::Value& events = doc["traceEvents"];
+  ASSERT_EQ(static_cast<size_t>(kThreads * kSpans), events.Size());
+  std::set<unsigned> tids;
+  for (const rapidjson::Value& event : events.GetArray()) {
+    EXPECT_STREQ("work", event["name"].GetString());
+    tids.insert(event["tid"].GetUint());
+  }
+  EXPECT_EQ(static_cast<size_t>(kThreads), tids.size());
+}
+
+TEST_F(TraceTest, FullBufferDropsSpans) {
+  constexpr int kSpans = 100000;
+  turbo::StartTracing();
+  for (int i = 0; i < kSpans; ++i) {
+    TURBO_TRACE_SCOPE("span");
+  }
+  turbo::StopTracing();
+
+  rapidjson::Document doc = Export();
+  const uint64_t dropped = doc["otherData"]["dropped_events"].GetUint64();
+  EXPECT_GT(dropped, 0u);
+  EXPECT_EQ(static_cast<uint64_t>(kSpans),
+            doc["traceEvents"].Size() + dropped);
+}
+
+TEST_F(TraceTest, CollectMakesRoom) {
+  constexpr int kSpans = 100000;
+  turbo::StartTracing();
+  size_t collected = 0;
+  for (int i = 0; i < kSpans; ++i) {
+    TURBO_TRACE_SCOPE("span");
+    if (i % 1000 == 0) collected += turbo::CollectTraceEvents();
+  }
+  turbo::StopTracing();
+
+  rapidjson::Document doc = Export();
+  EXPECT_GT(collected, 0u);
+  EXPECT_EQ(0u, doc["otherData"]["dropped_events"].GetUint64());
+  EXPECT_EQ(static_cast<size_t>(kSpans), doc["traceEvents"].Size());
+}
+
+}  // namespace
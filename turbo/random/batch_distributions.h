@@ -0,0 +1,185 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: batch_distributions.h
+// -----------------------------------------------------------------------------
+//
+// This header defines the batch counterparts of some of the distribution
+// functions of distributions.h, which fill a span with random values instead
+// of returning one value per call:
+//
+//   * `turbo::FillUniform` for `turbo::Uniform`
+//   * `turbo::FillGaussian` for `turbo::Gaussian`
+//   * `turbo::FillExponential` for `turbo::Exponential`
+//
+// Filling a span follows the same distribution as that many calls to the
+// corresponding function, but is faster for large spans: the parameters of
+// the distribution are checked once, the bits of the generator are drawn in
+// blocks when it can copy them in bulk from its buffer, as `turbo::BitGen`
+// does, and uniform integers of at most 32 bits are mapped to their interval
+// two per 64-bit value, by a loop which compilers vectorize. The values differ
+// from those of the per-call functions for the same generator state.
+//
+// Unlike the functions of distributions.h, these functions cannot be mocked
+// with `turbo::MockingBitGen`.
+//
+// Example:
+//
+//   turbo::BitGen bitgen;
+//   std::vector<int> dice(1 << 20);
+//   turbo::FillUniform(turbo::IntervalClosed, bitgen, 1, 6,
+//                      turbo::MakeSpan(dice));
+//
+//   std::vector<double> noise(1 << 20);
+//   turbo::FillGaussian(bitgen, 0.0, 0.5, turbo::MakeSpan(noise));
+
+#ifndef TURBO_RANDOM_BATCH_DISTRIBUTIONS_H_
+#define TURBO_RANDOM_BATCH_DISTRIBUTIONS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "turbo/base/internal/identity.h"
+#include "turbo/meta/span.h"
+#include "turbo/meta/type_traits.h"
+#include "turbo/random/distributions.h"
+#include "turbo/random/exponential_distribution.h"
+#include "turbo/random/gaussian_distribution.h"
+#include "turbo/random/internal/batch_bits.h"
+#include "turbo/random/internal/uniform_helper.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace random_internal {
+
+// Whether FillUniformNarrow() applies to `R`.
+template <typename R>
+using IsNarrowInteger =
+    std::integral_constant<bool, std::is_integral<R>::value &&
+                                     !std::is_same<R, bool>::value &&
+                                     sizeof(R) <= 4>;
+
+// Integers of at most 32 bits are mapped to the closed interval two per
+// 64-bit value.
+template <typename R, typename TagType, typename URBG>
+void FillUniformImpl(std::true_type /* narrow */, TagType tag,
+                     URBG& urbg,  // NOLINT(runtime/references)
+                     R lo, R hi, turbo::Span<R> out) {
+  using unsigned_type = typename std::make_unsigned<R>::type;
+  const R a = uniform_lower_bound<R>(tag, lo, hi);
+  const R b = uniform_upper_bound<R>(tag, lo, hi);
+  const auto range = static_cast<unsigned_type>(
+      static_cast<unsigned_type>(b) - static_cast<unsigned_type>(a));
+  FillUniformNarrow(urbg, a, static_cast<uint32_t>(range), out);
+}
+
+// Other types use the distribution of `turbo::Uniform()`.
+template <typename R, typename TagType, typename URBG>
+void FillUniformImpl(std::false_type /* narrow */, TagType tag,
+                     URBG& urbg,  // NOLINT(runtime/references)
+                     R lo, R hi, turbo::Span<R> out) {
+  UniformDistributionWrapper<R> distribution(tag, lo, hi);
+  FillFromDistribution(distribution, urbg, out);
+}
+
+}  // namespace random_internal
+
+// -----------------------------------------------------------------------------
+// turbo::FillUniform(tag, bitgen, lo, hi, out)
+// -----------------------------------------------------------------------------
+//
+// Fills `out` with random values uniformly distributed in the interval
+// {lo, hi}, whose type is given by `tag` as for `turbo::Uniform()`. The type
+// of the values is that of the span. Fills `out` with `lo` when the interval
+// is empty, as `turbo::Uniform()` returns `lo`.
+//
+// Example:
+//
+//   turbo::BitGen bitgen;
+//   std::vector<uint8_t> bytes(4096);
+//   turbo::FillUniform(turbo::IntervalClosed, bitgen, 0, 255,
+//                      turbo::MakeSpan(bytes));
+//
+template <typename R, typename TagType, typename URBG>
+void FillUniform(TagType tag,
+                 URBG&& urbg,  // NOLINT(runtime/references)
+                 turbo::internal::identity_t<R> lo,
+                 turbo::internal::identity_t<R> hi, turbo::Span<R> out) {
+  static_assert(std::is_arithmetic<R>::value,
+                "Span element type must be an arithmetic type, in "
+                "turbo::FillUniform(...)");
+  auto a = random_internal::uniform_lower_bound<R>(tag, lo, hi);
+  auto b = random_internal::uniform_upper_bound<R>(tag, lo, hi);
+  if (!random_internal::is_uniform_range_valid(a, b)) {
+    std::fill(out.begin(), out.end(), lo);
+    return;
+  }
+  random_internal::FillUniformImpl(random_internal::IsNarrowInteger<R>(), tag,
+                                   urbg, lo, hi, out);
+}
+
+// turbo::FillUniform(bitgen, lo, hi, out)
+//
+// Overload of `FillUniform()` using the default closed-open interval of
+// [lo, hi).
+template <typename R, typename URBG>
+void FillUniform(URBG&& urbg,  // NOLINT(runtime/references)
+                 turbo::internal::identity_t<R> lo,
+                 turbo::internal::identity_t<R> hi, turbo::Span<R> out) {
+  turbo::FillUniform(turbo::IntervalClosedOpen, urbg, lo, hi, out);
+}
+
+// -----------------------------------------------------------------------------
+// turbo::FillGaussian(bitgen, mean, stddev, out)
+// -----------------------------------------------------------------------------
+//
+// Fills `out` with random values from the Gaussian distribution of mean `mean`
+// and standard deviation `stddev`, as `turbo::Gaussian()`.
+template <typename RealType, typename URBG>
+void FillGaussian(URBG&& urbg,  // NOLINT(runtime/references)
+                  turbo::internal::identity_t<RealType> mean,
+                  turbo::internal::identity_t<RealType> stddev,
+                  turbo::Span<RealType> out) {
+  static_assert(
+      std::is_floating_point<RealType>::value,
+      "Span element type must be a floating-point type, in "
+      "turbo::FillGaussian(...)");
+  turbo::gaussian_distribution<RealType> distribution(mean, stddev);
+  random_internal::FillFromDistribution(distribution, urbg, out);
+}
+
+// -----------------------------------------------------------------------------
+// turbo::FillExponential(bitgen, lambda, out)
+// -----------------------------------------------------------------------------
+//
+// Fills `out` with random values from the exponential distribution of rate
+// `lambda`, as `turbo::Exponential()`.
+template <typename RealType, typename URBG>
+void FillExponential(URBG&& urbg,  // NOLINT(runtime/references)
+                     turbo::internal::identity_t<RealType> lambda,
+                     turbo::Span<RealType> out) {
+  static_assert(
+      std::is_floating_point<RealType>::value,
+      "Span element type must be a floating-point type, in "
+      "turbo::FillExponential(...)");
+  turbo::exponential_distribution<RealType> distribution(lambda);
+  random_internal::FillFromDistribution(distribution, urbg, out);
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_RANDOM_BATCH_DISTRIBUTIONS_H_
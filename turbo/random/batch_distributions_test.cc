@@ -0,0 +1,222 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/random/batch_distributions.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/base/internal/raw_logging.h"
+#include "turbo/meta/span.h"
+#include "turbo/random/internal/chi_square.h"
+#include "turbo/random/internal/distribution_test_util.h"
+#include "turbo/random/internal/pcg_engine.h"
+#include "turbo/random/random.h"
+#include "turbo/strings/str_cat.h"
+
+namespace {
+
+using turbo::random_internal::kChiSquared;
+
+// Fills buckets of equal width over [lo, hi) with `values`, and checks that
+// they are uniform with the chi-squared test.
+template <typename T>
+void ExpectUniformBuckets(const std::vector<T>& values, double lo, double hi,
+                          int buckets) {
+  std::vector<int32_t> counts(buckets, 0);
+  const double width = (hi - lo) / buckets;
+  for (const T& value : values) {
+    const double x = static_cast<double>(value);
+    ASSERT_GE(x, lo);
+    ASSERT_LE(x, hi);  // Wide integers may round up to `hi`.
+    ++counts[std::min(buckets - 1, static_cast<int>((x - lo) / width))];
+  }
+  const double expected =
+      static_cast<double>(values.size()) / static_cast<double>(buckets);
+  // Empirically validated with --runs_per_test=10000.
+  const double threshold =
+      turbo::random_internal::ChiSquareValue(buckets - 1, 0.999999);
+  const double chi_square = turbo::random_internal::ChiSquareWithExpected(
+      std::begin(counts), std::end(counts), expected);
+  if (chi_square > threshold) {
+    std::string msg;
+    for (const auto& a : counts) {
+      turbo::StrAppend(&msg, a, "\n");
+    }
+    turbo::StrAppend(
+        &msg, kChiSquared, " p-value ",
+        turbo::random_internal::ChiSquarePValue(chi_square, buckets - 1),
+        "\n");
+    turbo::StrAppend(&msg, "High ", kChiSquared, " value: ", chi_square, " > ",
+                     threshold);
+    TURBO_RAW_LOG(INFO, "%s", msg.c_str());
+    FAIL() << msg;
+  }
+}
+
+template <typename IntType>
+class FillUniformIntTest : public ::testing::Test {};
+
+using IntTypes = ::testing::Types<int8_t, uint8_t, int16_t, uint16_t, int32_t,
+                                  uint32_t, int64_t, uint64_t>;
+TYPED_TEST_SUITE(FillUniformIntTest, IntTypes);
+
+TYPED_TEST(FillUniformIntTest, ChiSquaredTest50) {
+  constexpr int kBuckets = 50;
+  const TypeParam min = std::is_unsigned<TypeParam>::value ? 37 : -37;
+  const TypeParam max = min + kBuckets;
+
+  // We use a fixed bit generator for distribution accuracy tests.  This allows
+  // these tests to be deterministic, while still testing the quality of the
+  // implementation.
+  turbo::random_internal::pcg64_2018_engine rng{0x2B7E151628AED2A6};
+  // An odd size, so that the last block draws half a 64-bit value.
+  std::vector<TypeParam> values(10001);
+  turbo::FillUniform(rng, min, max, turbo::MakeSpan(values));
+  ExpectUniformBuckets(values, min, max, kBuckets);
+}
+
+TYPED_TEST(FillUniformIntTest, Intervals) {
+  turbo::BitGen gen;
+  std::vector<TypeParam> values(1000);
+  const TypeParam lo = std::is_unsigned<TypeParam>::value ? 0 : -2;
+  const TypeParam hi = lo + 3;
+
+  turbo::FillUniform(turbo::IntervalClosed, gen, lo, hi,
+                     turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(::testing::AllOf(::testing::Ge(lo),
+                                                       ::testing::Le(hi))));
+  EXPECT_THAT(values, ::testing::Contains(lo));
+  EXPECT_THAT(values, ::testing::Contains(hi));
+
+  turbo::FillUniform(turbo::IntervalOpen, gen, lo, hi,
+                     turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(::testing::AllOf(::testing::Gt(lo),
+                                                       ::testing::Lt(hi))));
+
+  turbo::FillUniform(turbo::IntervalOpenClosed, gen, lo, hi,
+                     turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(::testing::AllOf(::testing::Gt(lo),
+                                                       ::testing::Le(hi))));
+  EXPECT_THAT(values, ::testing::Contains(hi));
+
+  // Empty intervals give `lo`, as turbo::Uniform() does.
+  turbo::FillUniform(gen, hi, lo, turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(hi));
+  turbo::FillUniform(turbo::IntervalOpen, gen, lo, lo + 1,
+                     turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(lo));
+}
+
+TYPED_TEST(FillUniformIntTest, FullRange) {
+  using Limits = std::numeric_limits<TypeParam>;
+  turbo::BitGen gen;
+  std::vector<TypeParam> values(20000);
+  turbo::FillUniform(turbo::IntervalClosed, gen, Limits::lowest(),
+                     (Limits::max)(), turbo::MakeSpan(values));
+  ExpectUniformBuckets(values, static_cast<double>(Limits::lowest()),
+                       static_cast<double>((Limits::max)()) + 1, 16);
+}
+
+// A range of 3 * 2^30 values rejects a quarter of the 32-bit samples, which
+// exercises the second pass of the narrow integers.
+TEST(FillUniformTest, FrequentRejections) {
+  turbo::random_internal::pcg64_2018_engine rng{0x2B7E151628AED2A6};
+  const uint32_t hi = 3 * (uint32_t{1} << 30);
+  std::vector<uint32_t> values(30000);
+  turbo::FillUniform(rng, 0, hi, turbo::MakeSpan(values));
+  ExpectUniformBuckets(values, 0, hi, 48);
+}
+
+TEST(FillUniformTest, Real) {
+  turbo::BitGen gen;
+  std::vector<double> values(10000);
+  turbo::FillUniform(gen, -1.5, 2.5, turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(::testing::Lt(2.5)));
+  ExpectUniformBuckets(values, -1.5, 2.5, 50);
+
+  std::vector<float> floats(10000);
+  turbo::FillUniform(turbo::IntervalOpen, gen, 0, 1, turbo::MakeSpan(floats));
+  EXPECT_THAT(floats, ::testing::Each(::testing::AllOf(::testing::Gt(0.0f),
+                                                       ::testing::Lt(1.0f))));
+  ExpectUniformBuckets(floats, 0, 1, 50);
+
+  turbo::FillUniform(gen, 1.0, 1.0, turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(1.0));
+}
+
+// Generators without bulk fill, and of 32-bit values.
+TEST(FillUniformTest, OtherGenerators) {
+  std::vector<int> values(10000);
+  std::mt19937 mt(42);
+  turbo::FillUniform(mt, 0, 10, turbo::MakeSpan(values));
+  ExpectUniformBuckets(values, 0, 10, 10);
+
+  turbo::InsecureBitGen insecure;
+  std::vector<double> reals(10000);
+  turbo::FillUniform(insecure, 0.0, 10.0, turbo::MakeSpan(reals));
+  ExpectUniformBuckets(reals, 0, 10, 10);
+}
+
+TEST(FillUniformTest, EmptySpan) {
+  turbo::random_internal::pcg64_2018_engine gen{0x2B7E151628AED2A6};
+  const turbo::random_internal::pcg64_2018_engine copy = gen;
+  turbo::FillUniform(gen, 0, 10, turbo::Span<int>());
+  turbo::FillGaussian(gen, 0.0, 1.0, turbo::Span<double>());
+  EXPECT_EQ(gen, copy);
+}
+
+TEST(FillGaussianTest, Moments) {
+  turbo::random_internal::pcg64_2018_engine rng{0x2B7E151628AED2A6};
+  const double kMean = 3.0;
+  const double kStddev = 2.0;
+  std::vector<double> values(100000);
+  turbo::FillGaussian(rng, kMean, kStddev, turbo::MakeSpan(values));
+  const auto moments =
+      turbo::random_internal::ComputeDistributionMoments(values);
+  // The standard errors of the moments are within the margins, which are
+  // those of gaussian_distribution_test.cc.
+  EXPECT_NEAR(kMean, moments.mean, 0.02);
+  EXPECT_NEAR(kStddev * kStddev, moments.variance, 0.05);
+  EXPECT_NEAR(0.0, moments.skewness, 0.03);
+  EXPECT_NEAR(3.0, moments.kurtosis, 0.1);
+
+  std::vector<float> floats(1000);
+  turbo::FillGaussian(rng, 0, 1, turbo::MakeSpan(floats));
+  EXPECT_THAT(floats, ::testing::Each(::testing::AllOf(::testing::Gt(-6.0f),
+                                                       ::testing::Lt(6.0f))));
+}
+
+TEST(FillExponentialTest, Moments) {
+  turbo::random_internal::pcg64_2018_engine rng{0x2B7E151628AED2A6};
+  const double kLambda = 4.0;
+  std::vector<double> values(100000);
+  turbo::FillExponential(rng, kLambda, turbo::MakeSpan(values));
+  EXPECT_THAT(values, ::testing::Each(::testing::Ge(0.0)));
+  const auto moments =
+      turbo::random_internal::ComputeDistributionMoments(values);
+  EXPECT_NEAR(1 / kLambda, moments.mean, 0.005);
+  EXPECT_NEAR(1 / (kLambda * kLambda), moments.variance, 0.003);
+  EXPECT_NEAR(2.0, moments.skewness, 0.1);
+  EXPECT_NEAR(9.0, moments.kurtosis, 1.0);
+}
+
+}  // namespace
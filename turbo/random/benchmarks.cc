@@ -26,20 +26,28 @@
 #include <vector>
 
 #include "benchmark/benchmark.h"
+#include "turbo/meta/span.h"
 #include "turbo/meta/type_traits.h"
 #include "turbo/platform/port.h"
+#include "turbo/random/batch_distributions.h"
 #include "turbo/random/bernoulli_distribution.h"
 #include "turbo/random/beta_distribution.h"
+#include "turbo/random/discrete_distribution.h"
+#include "turbo/random/distributions.h"
 #include "turbo/random/exponential_distribution.h"
 #include "turbo/random/gaussian_distribution.h"
 #include "turbo/random/internal/fast_uniform_bits.h"
+#include "turbo/random/internal/pool_urbg.h"
 #include "turbo/random/internal/randen_engine.h"
 #include "turbo/random/log_uniform_int_distribution.h"
 #include "turbo/random/poisson_distribution.h"
 #include "turbo/random/random.h"
 #include "turbo/random/uniform_int_distribution.h"
 #include "turbo/random/uniform_real_distribution.h"
+#include "turbo/random/weighted_reservoir.h"
+#include "turbo/random/weighted_sampler.h"
 #include "turbo/random/zipf_distribution.h"
+#include "turbo/random/zipf_table_distribution.h"
 
 namespace {
 
@@ -240,6 +248,177 @@ void BM_Thread(benchmark::State& state) {
   state.SetBytesProcessed(sizeof(value_type) * state.iterations());
 }
 
+// RandenPool seeds the default-constructed generators, and is shared by all
+// threads: run with several threads, these measure the contention on it.
+template <typename T>
+void BM_Pool(benchmark::State& state) {
+  turbo::random_internal::RandenPool<T> pool;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pool());
+  }
+  state.SetBytesProcessed(sizeof(T) * state.iterations());
+}
+
+template <typename Engine>
+void BM_DefaultConstruct(benchmark::State& state) {
+  for (auto _ : state) {
+    Engine rng;
+    benchmark::DoNotOptimize(rng());
+  }
+}
+
+// The batch benchmarks generate kBatchSize values per iteration, either one
+// call at a time ("Loop") or by filling a span ("Fill").
+constexpr size_t kBatchSize = 4096;
+
+template <typename Engine, typename T>
+void BM_UniformLoop(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<T> values(kBatchSize);
+  for (auto _ : state) {
+    for (T& value : values) value = turbo::Uniform<T>(rng, 0, 100);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+template <typename Engine, typename T>
+void BM_FillUniform(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<T> values(kBatchSize);
+  for (auto _ : state) {
+    turbo::FillUniform(rng, 0, 100, turbo::MakeSpan(values));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+template <typename Engine>
+void BM_GaussianLoop(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<double> values(kBatchSize);
+  for (auto _ : state) {
+    for (double& value : values) value = turbo::Gaussian(rng, 0.0, 1.0);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+template <typename Engine>
+void BM_FillGaussian(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<double> values(kBatchSize);
+  for (auto _ : state) {
+    turbo::FillGaussian(rng, 0.0, 1.0, turbo::MakeSpan(values));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+template <typename Engine>
+void BM_ExponentialLoop(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<double> values(kBatchSize);
+  for (auto _ : state) {
+    for (double& value : values) value = turbo::Exponential(rng, 1.0);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+template <typename Engine>
+void BM_FillExponential(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<double> values(kBatchSize);
+  for (auto _ : state) {
+    turbo::FillExponential(rng, 1.0, turbo::MakeSpan(values));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(kBatchSize * state.iterations());
+}
+
+// Weighted sampling over state.range(0) indices whose weights change, as the
+// backends of a load balancer. WeightedSampler updates a weight in O(log n)
+// time, where discrete_distribution is rebuilt in O(n) time.
+std::vector<double> MakeWeights(size_t n) {
+  turbo::InsecureBitGen gen;
+  std::vector<double> weights(n);
+  for (double& w : weights) w = turbo::Uniform(gen, 1.0, 100.0);
+  return weights;
+}
+
+template <typename Engine>
+void BM_WeightedSamplerUpdate(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  const std::vector<double> weights = MakeWeights(state.range(0));
+  turbo::WeightedSampler sampler(weights.begin(), weights.end());
+  size_t i = 0;
+  for (auto _ : state) {
+    sampler.Set(i, weights[i] + 1);
+    if (++i == weights.size()) i = 0;
+    benchmark::DoNotOptimize(sampler(rng));
+  }
+}
+
+template <typename Engine>
+void BM_DiscreteRebuild(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  std::vector<double> weights = MakeWeights(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    weights[i] += 1;
+    if (++i == weights.size()) i = 0;
+    turbo::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+    benchmark::DoNotOptimize(dist(rng));
+  }
+}
+
+template <typename Engine>
+void BM_WeightedSamplerSample(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  const std::vector<double> weights = MakeWeights(state.range(0));
+  turbo::WeightedSampler sampler(weights.begin(), weights.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sampler(rng));
+  }
+}
+
+template <typename Engine>
+void BM_DiscreteSample(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  const std::vector<double> weights = MakeWeights(state.range(0));
+  turbo::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dist(rng));
+  }
+}
+
+template <typename Engine>
+void BM_WeightedReservoir(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  const std::vector<double> weights = MakeWeights(state.range(0));
+  turbo::WeightedReservoir<size_t> reservoir(100);
+  for (auto _ : state) {
+    reservoir.Clear();
+    for (size_t i = 0; i < weights.size(); ++i) {
+      reservoir.Add(rng, i, weights[i]);
+    }
+    benchmark::DoNotOptimize(reservoir.size());
+  }
+  state.SetItemsProcessed(weights.size() * state.iterations());
+}
+
+// Zipf variates over state.range(0) + 1 values, as the popularity of keys.
+// zipf_distribution requires q > 1.
+template <typename Engine, typename Dist>
+void BM_ZipfRange(benchmark::State& state) {
+  auto rng = make_engine<Engine>();
+  Dist dist(static_cast<typename Dist::result_type>(state.range(0)), 2.0, 1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dist(rng));
+  }
+}
+
 // NOTES:
 //
 // std::geometric_distribution is similar to the zipf distributions.
@@ -293,6 +472,20 @@ void BM_Thread(benchmark::State& state) {
   BENCHMARK_TEMPLATE(BM_ShuffleReuse, Engine, 100)->ThreadPerCpu(); \
   BENCHMARK_TEMPLATE(BM_ShuffleReuse, Engine, 1000)->ThreadPerCpu();
 
+#define BM_BATCH(Engine)                                     \
+  BENCHMARK_TEMPLATE(BM_UniformLoop, Engine, int32_t);       \
+  BENCHMARK_TEMPLATE(BM_FillUniform, Engine, int32_t);       \
+  BENCHMARK_TEMPLATE(BM_UniformLoop, Engine, uint8_t);       \
+  BENCHMARK_TEMPLATE(BM_FillUniform, Engine, uint8_t);       \
+  BENCHMARK_TEMPLATE(BM_UniformLoop, Engine, int64_t);       \
+  BENCHMARK_TEMPLATE(BM_FillUniform, Engine, int64_t);       \
+  BENCHMARK_TEMPLATE(BM_UniformLoop, Engine, double);        \
+  BENCHMARK_TEMPLATE(BM_FillUniform, Engine, double);        \
+  BENCHMARK_TEMPLATE(BM_GaussianLoop, Engine);               \
+  BENCHMARK_TEMPLATE(BM_FillGaussian, Engine);               \
+  BENCHMARK_TEMPLATE(BM_ExponentialLoop, Engine);            \
+  BENCHMARK_TEMPLATE(BM_FillExponential, Engine)
+
 #define BM_EXTENDED(Engine)                                                    \
   /* -------------- Extended Uniform -----------------------*/                 \
   BENCHMARK_TEMPLATE(BM_Small, Engine,                                         \
@@ -357,11 +550,36 @@ void BM_Thread(benchmark::State& state) {
   BENCHMARK_TEMPLATE(BM_Gamma, Engine, std::gamma_distribution<float>, 199);   \
   BENCHMARK_TEMPLATE(BM_Gamma, Engine, std::gamma_distribution<double>, 199);
 
+#define BM_WEIGHTED(Engine)                                                    \
+  BENCHMARK_TEMPLATE(BM_WeightedSamplerUpdate, Engine)->Arg(1000)->Arg(100000); \
+  BENCHMARK_TEMPLATE(BM_DiscreteRebuild, Engine)->Arg(1000)->Arg(100000);       \
+  BENCHMARK_TEMPLATE(BM_WeightedSamplerSample, Engine)->Arg(1000)->Arg(100000); \
+  BENCHMARK_TEMPLATE(BM_DiscreteSample, Engine)->Arg(1000)->Arg(100000);        \
+  BENCHMARK_TEMPLATE(BM_WeightedReservoir, Engine)->Arg(100000);                \
+  BENCHMARK_TEMPLATE(BM_ZipfRange, Engine, turbo::zipf_distribution<int>)       \
+      ->Arg(100000);                                                            \
+  BENCHMARK_TEMPLATE(BM_ZipfRange, Engine, turbo::zipf_table_distribution<int>) \
+      ->Arg(100000)
+
 // TURBO Recommended interfaces.
 BM_BASIC(turbo::InsecureBitGen);  // === pcg64_2018_engine
 BM_BASIC(turbo::BitGen);    // === randen_engine<uint64_t>.
 BM_THREAD(turbo::BitGen);
 BM_EXTENDED(turbo::BitGen);
+BM_BATCH(turbo::BitGen);
+BM_BATCH(turbo::InsecureBitGen);
+BM_WEIGHTED(turbo::InsecureBitGen);
+
+// Contended seeding.
+BENCHMARK_TEMPLATE(BM_Pool, uint64_t)->Threads(1)->Threads(8)->Threads(64);
+BENCHMARK_TEMPLATE(BM_DefaultConstruct, turbo::InsecureBitGen)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(64);
+BENCHMARK_TEMPLATE(BM_DefaultConstruct, turbo::BitGen)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(64);
 
 // Instantiate benchmarks for multiple engines.
 using randen_engine_64 = turbo::random_internal::randen_engine<uint64_t>;
@@ -0,0 +1,212 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TURBO_RANDOM_INTERNAL_BATCH_BITS_H_
+#define TURBO_RANDOM_INTERNAL_BATCH_BITS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "turbo/meta/span.h"
+#include "turbo/meta/type_traits.h"
+#include "turbo/platform/port.h"
+#include "turbo/random/internal/fast_uniform_bits.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace random_internal {
+
+// HasBulkFill<URBG>
+//
+// Whether `URBG` produces 64-bit values and can fill a span of them in bulk,
+// as `randen_engine<uint64_t>` and `turbo::BitGen` do.
+template <typename URBG, typename = void>
+struct HasBulkFill : std::false_type {};
+
+template <typename URBG>
+struct HasBulkFill<URBG,
+                   turbo::void_t<decltype(std::declval<URBG&>().Fill(
+                       std::declval<turbo::Span<uint64_t>>()))>>
+    : std::is_same<typename URBG::result_type, uint64_t> {};
+
+// FillBits()
+//
+// Fills `out` with uniformly distributed 64-bit values from `urbg`.
+template <typename URBG>
+typename turbo::enable_if_t<HasBulkFill<URBG>::value> FillBits(
+    URBG& urbg,  // NOLINT(runtime/references)
+    turbo::Span<uint64_t> out) {
+  urbg.Fill(out);
+}
+
+template <typename URBG>
+typename turbo::enable_if_t<!HasBulkFill<URBG>::value> FillBits(
+    URBG& urbg,  // NOLINT(runtime/references)
+    turbo::Span<uint64_t> out) {
+  FastUniformBits<uint64_t> fast_bits;
+  for (uint64_t& bits : out) bits = fast_bits(urbg);
+}
+
+// BatchBits
+//
+// A URBG which returns the 64-bit values of another one, fetched with
+// FillBits() a block at a time, for the distributions filling a span. Blocks
+// are no larger than the number of values the caller expects to need, so that
+// filling a short span does not draw a whole block.
+template <typename URBG>
+class BatchBits {
+ public:
+  using result_type = uint64_t;
+
+  static constexpr result_type(min)() { return 0; }
+  static constexpr result_type(max)() {
+    return (std::numeric_limits<uint64_t>::max)();
+  }
+
+  BatchBits(URBG& urbg, size_t expected)  // NOLINT(runtime/references)
+      : urbg_(urbg), expected_(expected) {}
+
+  BatchBits(const BatchBits&) = delete;
+  BatchBits& operator=(const BatchBits&) = delete;
+
+  result_type operator()() {
+    if (TURBO_PREDICT_FALSE(next_ == size_)) Refill();
+    return buffer_[next_++];
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 64;
+
+  void Refill() {
+    size_ = expected_ < kBlockSize ? std::max<size_t>(expected_, 1)
+                                   : kBlockSize;
+    expected_ -= std::min(expected_, size_);
+    FillBits(urbg_, turbo::Span<uint64_t>(buffer_, size_));
+    next_ = 0;
+  }
+
+  URBG& urbg_;
+  size_t expected_;
+  size_t next_ = 0;
+  size_t size_ = 0;
+  uint64_t buffer_[kBlockSize];
+};
+
+// FillFromDistribution()
+//
+// Fills `out` with values of `distribution`, drawing the bits of `urbg` a
+// block at a time when it can fill them in bulk.
+template <typename Distribution, typename URBG, typename R>
+void FillFromDistribution(
+    std::true_type /* bulk */,
+    Distribution& distribution,  // NOLINT(runtime/references)
+    URBG& urbg,                  // NOLINT(runtime/references)
+    turbo::Span<R> out) {
+  BatchBits<URBG> bits(urbg, out.size());
+  for (R& value : out) value = distribution(bits);
+}
+
+template <typename Distribution, typename URBG, typename R>
+void FillFromDistribution(
+    std::false_type /* bulk */,
+    Distribution& distribution,  // NOLINT(runtime/references)
+    URBG& urbg,                  // NOLINT(runtime/references)
+    turbo::Span<R> out) {
+  for (R& value : out) value = distribution(urbg);
+}
+
+template <typename Distribution, typename URBG, typename R>
+void FillFromDistribution(
+    Distribution& distribution,  // NOLINT(runtime/references)
+    URBG& urbg,                  // NOLINT(runtime/references)
+    turbo::Span<R> out) {
+  FillFromDistribution(HasBulkFill<URBG>(), distribution, urbg, out);
+}
+
+// FillUniformNarrow()
+//
+// Fills `out` with integers uniformly distributed in the closed interval
+// [lo, lo + range], for integer types of at most 32 bits. Each 64-bit value
+// of `urbg` gives two 32-bit samples, mapped to the interval by Lemire's
+// multiplication method as in `uniform_int_distribution`. A block is mapped
+// in a first pass free of branches, which compilers vectorize, and the rare
+// samples falling in the rejection zone are drawn again in a second pass.
+template <typename R, typename URBG>
+void FillUniformNarrow(URBG& urbg,  // NOLINT(runtime/references)
+                       R lo, uint32_t range, turbo::Span<R> out) {
+  static_assert(std::is_integral<R>::value && sizeof(R) <= 4,
+                "FillUniformNarrow() requires an integer type of at most 32 "
+                "bits");
+  using unsigned_type = typename std::make_unsigned<R>::type;
+  constexpr size_t kBlockWords = 64;
+  const uint64_t lim = uint64_t{range} + 1;
+  // A sample is rejected when the low half of its product with `lim` is below
+  // 2^32 mod lim, which is zero when `lim` is a power of two.
+  const uint32_t threshold =
+      static_cast<uint32_t>(((uint64_t{1} << 32) - lim) % lim);
+  const unsigned_type base = static_cast<unsigned_type>(lo);
+
+  uint64_t words[kBlockWords];
+  R* dst = out.data();
+  size_t remaining = out.size();
+  while (remaining > 0) {
+    const size_t n = std::min(remaining, 2 * kBlockWords);
+    const size_t word_count = (n + 1) / 2;
+    FillBits(urbg, turbo::Span<uint64_t>(words, word_count));
+    // The low and high halves of each value give two samples.
+    bool rejected = false;
+    for (size_t i = 0; i < n / 2; ++i) {
+      const uint64_t low = (words[i] & 0xffffffff) * lim;
+      const uint64_t high = (words[i] >> 32) * lim;
+      rejected |= (static_cast<uint32_t>(low) < threshold) |
+                  (static_cast<uint32_t>(high) < threshold);
+      dst[2 * i] =
+          static_cast<R>(static_cast<unsigned_type>(base + (low >> 32)));
+      dst[2 * i + 1] =
+          static_cast<R>(static_cast<unsigned_type>(base + (high >> 32)));
+    }
+    if (n % 2 != 0) {
+      const uint64_t low = (words[n / 2] & 0xffffffff) * lim;
+      rejected |= static_cast<uint32_t>(low) < threshold;
+      dst[n - 1] =
+          static_cast<R>(static_cast<unsigned_type>(base + (low >> 32)));
+    }
+    if (TURBO_PREDICT_FALSE(rejected)) {
+      FastUniformBits<uint32_t> fast_bits;
+      for (size_t i = 0; i < n; ++i) {
+        uint32_t bits = static_cast<uint32_t>(words[i / 2] >> (i % 2 * 32));
+        uint64_t product = bits * lim;
+        if (static_cast<uint32_t>(product) >= threshold) continue;
+        do {
+          bits = fast_bits(urbg);
+          product = bits * lim;
+        } while (static_cast<uint32_t>(product) < threshold);
+        dst[i] = static_cast<R>(
+            static_cast<unsigned_type>(base + (product >> 32)));
+      }
+    }
+    dst += n;
+    remaining -= n;
+  }
+}
+
+}  // namespace random_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_RANDOM_INTERNAL_BATCH_BITS_H_
@@ -670,7 +670,7 @@ Ticks TotalDuration(const Func func, const void* arg, const InputVec* inputs,
 
 // (Nearly) empty Func for measuring timer overhead/resolution.
 TURBO_RANDOM_INTERNAL_ATTRIBUTE_NEVER_INLINE FuncOutput
-EmptyFunc(const void* arg, const FuncInput input) {
+EmptyFunc(const void* /*arg*/, const FuncInput input) {
   return input;
 }
 
@@ -736,6 +736,8 @@ double InvariantTicksPerSecond() {
 #endif
 }
 
+namespace {
+
 size_t MeasureImpl(const Func func, const void* arg, const size_t num_skip,
                    const InputVec& unique, const InputVec& full,
                    const Params& p, Result* results) {
@@ -777,6 +779,8 @@ size_t MeasureImpl(const Func func, const void* arg, const size_t num_skip,
   return unique.size();
 }
 
+}  // namespace
+
 size_t Measure(const Func func, const void* arg, const FuncInput* inputs,
                const size_t num_inputs, Result* results, const Params& p) {
   TURBO_RAW_CHECK(num_inputs != 0, "No inputs");
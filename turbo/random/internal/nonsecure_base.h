@@ -125,6 +125,16 @@ class NonsecureURBGBase {
   // NonsecureURBGBase::operator()()
   result_type operator()() { return urbg_(); }
 
+  // NonsecureURBGBase::Fill()
+  //
+  // Fills `out` with the values of as many calls to operator(), when the
+  // underlying engine can do so in bulk.
+  template <typename U = URBG>
+  auto Fill(turbo::Span<result_type> out)
+      -> decltype(std::declval<U&>().Fill(out)) {
+    return urbg_.Fill(out);
+  }
+
   // NonsecureURBGBase::discard()
   void discard(unsigned long long values) {  // NOLINT(runtime/int)
     urbg_.discard(values);
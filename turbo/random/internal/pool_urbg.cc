@@ -14,99 +14,131 @@
 
 #include "turbo/random/internal/pool_urbg.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include <algorithm>
-#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
 
-#include "turbo/base/call_once.h"
 #include "turbo/base/endian.h"
 #include "turbo/base/internal/raw_logging.h"
-#include "turbo/platform/internal/spinlock.h"
-#include "turbo/platform/internal/sysinfo.h"
-#include "turbo/platform/internal/unaligned_access.h"
 #include "turbo/platform/port.h"
 #include "turbo/random/internal/randen.h"
 #include "turbo/random/internal/seed_material.h"
 #include "turbo/random/seed_gen_exception.h"
 
-using turbo::base_internal::SpinLock;
-using turbo::base_internal::SpinLockHolder;
-
 namespace turbo {
 TURBO_NAMESPACE_BEGIN
 namespace random_internal {
 namespace {
 
-// RandenPoolEntry is a thread-safe pseudorandom bit generator, implementing a
-// single generator within a RandenPool<T>. It is an internal implementation
-// detail, and does not aim to conform to [rand.req.urng].
+// RandenPoolEntry is the pseudorandom bit generator of a thread, implementing
+// RandenPool<T> for that thread. It is an internal implementation detail, and
+// does not aim to conform to [rand.req.urng].
+//
+// An entry is seeded from OS entropy on its first use, and again on its first
+// use after fork() in the child, so that the parent and the child do not share
+// a sequence.
 //
 // NOTE: There are alignment issues when used on ARM, for instance.
-// See the allocation code in PoolAlignedAlloc().
+// See the allocation code in Create().
 class RandenPoolEntry {
  public:
   static constexpr size_t kState = RandenTraits::kStateBytes / sizeof(uint32_t);
   static constexpr size_t kCapacity =
       RandenTraits::kCapacityBytes / sizeof(uint32_t);
 
-  void Init(turbo::Span<const uint32_t> data) {
-    SpinLockHolder l(&mu_);  // Always uncontested.
-    std::copy(data.begin(), data.end(), std::begin(state_));
+  // Allocates an entry with at least 32-byte alignment, which is required by
+  // ARM platform code.
+  static RandenPoolEntry* Create();
+  static void Destroy(RandenPoolEntry* entry);
+
+  // Seeds the entry again before its next use.
+  void Reset() {
+    seeded_ = false;
     next_ = kState;
   }
 
   // Copy bytes into out.
-  void Fill(uint8_t* out, size_t bytes) TURBO_LOCKS_EXCLUDED(mu_);
+  void Fill(uint8_t* out, size_t bytes);
 
   // Returns random bits from the buffer in units of T.
   template <typename T>
-  inline T Generate() TURBO_LOCKS_EXCLUDED(mu_);
+  inline T Generate();
 
-  inline void MaybeRefill() TURBO_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    if (next_ >= kState) {
-      next_ = kCapacity;
-      impl_.Generate(state_);
-    }
+  inline void MaybeRefill() {
+    if (next_ >= kState) Refill();
   }
 
  private:
+  explicit RandenPoolEntry(char* memory) : memory_(memory) {}
+
+  // Seeds the state if needed, and generates the next buffer.
+  void Refill();
+
   // Randen URBG state.
-  uint32_t state_[kState] TURBO_GUARDED_BY(mu_);  // First to satisfy alignment.
-  SpinLock mu_;
+  uint32_t state_[kState];  // First to satisfy alignment.
   const Randen impl_;
-  size_t next_ TURBO_GUARDED_BY(mu_);
+  size_t next_ = kState;
+  bool seeded_ = false;
+  char* const memory_;  // The allocation holding the entry.
 };
 
+RandenPoolEntry* RandenPoolEntry::Create() {
+  constexpr size_t kAlignment =
+      TURBO_CACHELINE_SIZE > 32 ? TURBO_CACHELINE_SIZE : 32;
+
+  // Not all the platforms that we build for have std::aligned_alloc, so we
+  // over allocate and munge the pointers to the correct alignment.
+  char* memory = new char[sizeof(RandenPoolEntry) + kAlignment];
+  uintptr_t x = reinterpret_cast<uintptr_t>(memory);
+  auto y = x % kAlignment;
+  void* aligned = reinterpret_cast<void*>(y == 0 ? x : (x + kAlignment - y));
+  return new (aligned) RandenPoolEntry(memory);
+}
+
+void RandenPoolEntry::Destroy(RandenPoolEntry* entry) {
+  char* memory = entry->memory_;
+  entry->~RandenPoolEntry();
+  delete[] memory;
+}
+
+void RandenPoolEntry::Refill() {
+  if (TURBO_PREDICT_FALSE(!seeded_)) {
+    if (!random_internal::ReadSeedMaterialFromOSEntropy(
+            turbo::MakeSpan(state_))) {
+      random_internal::ThrowSeedGenException();
+    }
+    seeded_ = true;
+  }
+  next_ = kCapacity;
+  impl_.Generate(state_);
+}
+
 template <>
 inline uint8_t RandenPoolEntry::Generate<uint8_t>() {
-  SpinLockHolder l(&mu_);
   MaybeRefill();
   return static_cast<uint8_t>(state_[next_++]);
 }
 
 template <>
 inline uint16_t RandenPoolEntry::Generate<uint16_t>() {
-  SpinLockHolder l(&mu_);
   MaybeRefill();
   return static_cast<uint16_t>(state_[next_++]);
 }
 
 template <>
 inline uint32_t RandenPoolEntry::Generate<uint32_t>() {
-  SpinLockHolder l(&mu_);
   MaybeRefill();
   return state_[next_++];
 }
 
 template <>
 inline uint64_t RandenPoolEntry::Generate<uint64_t>() {
-  SpinLockHolder l(&mu_);
-  if (next_ >= kState - 1) {
-    next_ = kCapacity;
-    impl_.Generate(state_);
-  }
+  if (next_ >= kState - 1) Refill();
   auto p = state_ + next_;
   next_ += 2;
 
@@ -116,7 +148,6 @@ inline uint64_t RandenPoolEntry::Generate<uint64_t>() {
 }
 
 void RandenPoolEntry::Fill(uint8_t* out, size_t bytes) {
-  SpinLockHolder l(&mu_);
   while (bytes > 0) {
     MaybeRefill();
     size_t remaining = (kState - next_) * sizeof(state_[0]);
@@ -128,102 +159,107 @@ void RandenPoolEntry::Fill(uint8_t* out, size_t bytes) {
   }
 }
 
-// Number of pooled urbg entries.
-static constexpr size_t kPoolSize = 8;
+// Each thread has an entry of its own, created on its first use of the pool
+// and destroyed when it exits, so that no lock is needed.
+//
+// The destructors of thread_locals may draw random numbers, so the entry must
+// remain usable while they run: the pointer to it is trivially destructible,
+// and on POSIX systems the entry is owned by a pthread key, whose destructors
+// run after those of thread_locals. An entry created by a later destructor is
+// destroyed by the next round of key destructors.
+#ifdef TURBO_HAVE_THREAD_LOCAL
+thread_local RandenPoolEntry* thread_entry = nullptr;
+#endif
 
-// Shared pool entries.
-static turbo::once_flag pool_once;
-TURBO_CACHELINE_ALIGNED static RandenPoolEntry* shared_pools[kPoolSize];
+#ifdef _WIN32
+// Destroys the entry of the thread along with its other thread_locals. An
+// entry created after that by the destructor of another thread_local is
+// leaked, rather than used after its destruction.
+struct ThreadEntryOwner {
+  ~ThreadEntryOwner();
+};
+thread_local bool thread_entry_owner_destroyed = false;
 
-// Returns an id in the range [0 ... kPoolSize), which indexes into the
-// pool of random engines.
-//
-// Each thread to access the pool is assigned a sequential ID (without reuse)
-// from the pool-id space; the id is cached in a thread_local variable.
-// This id is assigned based on the arrival-order of the thread to the
-// GetPoolID call; this has no binary, CL, or runtime stability because
-// on subsequent runs the order within the same program may be significantly
-// different. However, as other thread IDs are not assigned sequentially,
-// this is not expected to matter.
-size_t GetPoolID() {
-  static_assert(kPoolSize >= 1,
-                "At least one urbg instance is required for PoolURBG");
-
-  TURBO_CONST_INIT static std::atomic<uint64_t> sequence{0};
+ThreadEntryOwner::~ThreadEntryOwner() {
+  if (thread_entry != nullptr) RandenPoolEntry::Destroy(thread_entry);
+  thread_entry = nullptr;
+  thread_entry_owner_destroyed = true;
+}
 
-#ifdef TURBO_HAVE_THREAD_LOCAL
-  static thread_local size_t my_pool_id = kPoolSize;
-  if (TURBO_PREDICT_FALSE(my_pool_id == kPoolSize)) {
-    my_pool_id = (sequence++ % kPoolSize);
+RandenPoolEntry* GetThreadEntry() { return thread_entry; }
+
+void SetThreadEntry(RandenPoolEntry* entry) {
+  thread_entry = entry;
+  if (!thread_entry_owner_destroyed) {
+    static thread_local ThreadEntryOwner owner;
+    static_cast<void>(owner);
   }
-  return my_pool_id;
+}
 #else
-  static pthread_key_t tid_key = [] {
+pthread_key_t GetThreadEntryKey() {
+  static pthread_key_t key = [] {
     pthread_key_t tmp_key;
-    int err = pthread_key_create(&tmp_key, nullptr);
+    int err = pthread_key_create(&tmp_key, [](void* entry) {
+#ifdef TURBO_HAVE_THREAD_LOCAL
+      thread_entry = nullptr;
+#endif
+      RandenPoolEntry::Destroy(static_cast<RandenPoolEntry*>(entry));
+    });
     if (err) {
       TURBO_RAW_LOG(FATAL, "pthread_key_create failed with %d", err);
     }
     return tmp_key;
   }();
+  return key;
+}
 
-  // Store the value in the pthread_{get/set}specific. However an uninitialized
-  // value is 0, so add +1 to distinguish from the null value.
-  uintptr_t my_pool_id =
-      reinterpret_cast<uintptr_t>(pthread_getspecific(tid_key));
-  if (TURBO_PREDICT_FALSE(my_pool_id == 0)) {
-    // No allocated ID, allocate the next value, cache it, and return.
-    my_pool_id = (sequence++ % kPoolSize) + 1;
-    int err = pthread_setspecific(tid_key, reinterpret_cast<void*>(my_pool_id));
-    if (err) {
-      TURBO_RAW_LOG(FATAL, "pthread_setspecific failed with %d", err);
-    }
-  }
-  return my_pool_id - 1;
+RandenPoolEntry* GetThreadEntry() {
+#ifdef TURBO_HAVE_THREAD_LOCAL
+  return thread_entry;
+#else
+  return static_cast<RandenPoolEntry*>(
+      pthread_getspecific(GetThreadEntryKey()));
 #endif
 }
 
-// Allocate a RandenPoolEntry with at least 32-byte alignment, which is required
-// by ARM platform code.
-RandenPoolEntry* PoolAlignedAlloc() {
-  constexpr size_t kAlignment =
-      TURBO_CACHELINE_SIZE > 32 ? TURBO_CACHELINE_SIZE : 32;
+void SetThreadEntry(RandenPoolEntry* entry) {
+  int err = pthread_setspecific(GetThreadEntryKey(), entry);
+  if (err) {
+    TURBO_RAW_LOG(FATAL, "pthread_setspecific failed with %d", err);
+  }
+#ifdef TURBO_HAVE_THREAD_LOCAL
+  thread_entry = entry;
+#endif
+}
+#endif
 
-  // Not all the platforms that we build for have std::aligned_alloc, however
-  // since we never free these objects, we can over allocate and munge the
-  // pointers to the correct alignment.
-  uintptr_t x = reinterpret_cast<uintptr_t>(
-      new char[sizeof(RandenPoolEntry) + kAlignment]);
-  auto y = x % kAlignment;
-  void* aligned = reinterpret_cast<void*>(y == 0 ? x : (x + kAlignment - y));
-  return new (aligned) RandenPoolEntry();
+#ifndef _WIN32
+// Only the thread which called fork() runs in the child: its entry is the only
+// one which may be used there.
+void ResetThreadEntryInChild() {
+  RandenPoolEntry* entry = GetThreadEntry();
+  if (entry != nullptr) entry->Reset();
 }
+#endif
 
-// Allocate and initialize kPoolSize objects of type RandenPoolEntry.
-//
-// The initialization strategy is to initialize one object directly from
-// OS entropy, then to use that object to seed all of the individual
-// pool instances.
-void InitPoolURBG() {
-  static constexpr size_t kSeedSize =
-      RandenTraits::kStateBytes / sizeof(uint32_t);
-  // Read the seed data from OS entropy once.
-  uint32_t seed_material[kPoolSize * kSeedSize];
-  if (!random_internal::ReadSeedMaterialFromOSEntropy(
-          turbo::MakeSpan(seed_material))) {
-    random_internal::ThrowSeedGenException();
-  }
-  for (size_t i = 0; i < kPoolSize; i++) {
-    shared_pools[i] = PoolAlignedAlloc();
-    shared_pools[i]->Init(
-        turbo::MakeSpan(&seed_material[i * kSeedSize], kSeedSize));
-  }
+TURBO_ATTRIBUTE_NOINLINE RandenPoolEntry* CreateThreadEntry() {
+#ifndef _WIN32
+  static const bool registered = [] {
+    pthread_atfork(nullptr, nullptr, ResetThreadEntryInChild);
+    return true;
+  }();
+  static_cast<void>(registered);
+#endif
+  RandenPoolEntry* entry = RandenPoolEntry::Create();
+  SetThreadEntry(entry);
+  return entry;
 }
 
 // Returns the pool entry for the current thread.
-RandenPoolEntry* GetPoolForCurrentThread() {
-  turbo::call_once(pool_once, InitPoolURBG);
-  return shared_pools[GetPoolID()];
+inline RandenPoolEntry* GetPoolForCurrentThread() {
+  RandenPoolEntry* entry = GetThreadEntry();
+  if (TURBO_PREDICT_FALSE(entry == nullptr)) entry = CreateThreadEntry();
+  return entry;
 }
 
 }  // namespace
@@ -27,8 +27,8 @@ namespace random_internal {
 
 // RandenPool is a thread-safe random number generator [random.req.urbg] that
 // uses an underlying pool of Randen generators to generate values.  Each thread
-// has affinity to one instance of the underlying pool generators.  Concurrent
-// access is guarded by a spin-lock.
+// has a generator of its own, seeded from OS entropy on first use and again in
+// the child after fork(), so no lock is taken.
 template <typename T>
 class RandenPool {
  public:
@@ -14,11 +14,19 @@
 
 #include "turbo/random/internal/pool_urbg.h"
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <cstdint>
 #include <iterator>
+#include <set>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "turbo/meta/type_traits.h"
@@ -153,6 +161,91 @@ TYPED_TEST(PoolURBGTypedTest, VerifySequences) {
   EXPECT_LE(equal_count, 1.0 + kExpected);
 }
 
+// Each thread has a generator of its own: no two threads share a sequence.
+TEST(RandenPoolTest, ThreadsHaveDistinctSequences) {
+  constexpr int kThreads = 16;
+  constexpr int kNumOutputs = 64;
+  std::vector<std::vector<uint64_t>> outputs(
+      kThreads, std::vector<uint64_t>(kNumOutputs));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&outputs, i] {
+      RandenPool<uint64_t>::Fill(turbo::MakeSpan(outputs[i]));
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  std::set<uint64_t> values;
+  for (const auto& output : outputs) {
+    values.insert(output.begin(), output.end());
+  }
+  EXPECT_EQ(values.size(), kThreads * kNumOutputs);
+}
+
+// Draws from the pool when its thread exits.
+struct DrawOnThreadExit {
+  ~DrawOnThreadExit() {
+    if (out != nullptr) RandenPool<uint64_t>::Fill(turbo::MakeSpan(*out));
+  }
+  std::vector<uint64_t>* out = nullptr;
+};
+
+// The destructors of thread_locals may use the pool, even those destroyed
+// after the pool would be if it were a thread_local itself.
+TEST(RandenPoolTest, UsableByThreadLocalDestructors) {
+  std::vector<uint64_t> outputs(4, 0);
+  std::thread thread([&outputs] {
+    // Constructed before the first use of the pool, so destroyed after any
+    // thread_local that use creates.
+    static thread_local DrawOnThreadExit draw;
+    draw.out = &outputs;
+    RandenPool<uint64_t> rng;
+    (void)rng();
+  });
+  thread.join();
+  EXPECT_EQ(std::set<uint64_t>(outputs.begin(), outputs.end()).size(),
+            outputs.size());
+}
+
+#ifndef _WIN32
+// The child of fork() does not repeat the sequence of its parent.
+TEST(RandenPoolTest, ForkedChildHasDistinctSequence) {
+  RandenPool<uint64_t> rng;
+  (void)rng();  // Seeds the generator of this thread.
+
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  const pid_t pid = fork();
+  ASSERT_NE(-1, pid);
+  constexpr int kNumOutputs = 16;
+  uint64_t values[kNumOutputs];
+  RandenPool<uint64_t>::Fill(turbo::MakeSpan(values));
+  if (pid == 0) {
+    const ssize_t written = write(fds[1], values, sizeof(values));
+    _exit(written == static_cast<ssize_t>(sizeof(values)) ? 0 : 1);
+  }
+  close(fds[1]);
+  uint64_t child_values[kNumOutputs];
+  size_t read_bytes = 0;
+  while (read_bytes < sizeof(child_values)) {
+    const ssize_t n = read(fds[0], reinterpret_cast<char*>(child_values) +
+                                       read_bytes,
+                           sizeof(child_values) - read_bytes);
+    ASSERT_GT(n, 0);
+    read_bytes += static_cast<size_t>(n);
+  }
+  close(fds[0]);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  int equal_count = 0;
+  for (int i = 0; i < kNumOutputs; ++i) {
+    equal_count += values[i] == child_values[i] ? 1 : 0;
+  }
+  EXPECT_EQ(0, equal_count);
+}
+#endif
+
 }  // namespace
 
 /*
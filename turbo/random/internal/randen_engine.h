@@ -24,6 +24,7 @@
 #include <type_traits>
 
 #include "turbo/base/endian.h"
+#include "turbo/meta/span.h"
 #include "turbo/meta/type_traits.h"
 #include "turbo/random/internal/iostream_state_saver.h"
 #include "turbo/random/internal/randen.h"
@@ -91,6 +92,28 @@ class alignas(8) randen_engine {
     return little_endian::ToHost(begin[next_++]);
   }
 
+  // Fills `out` with the values of as many calls to operator(), copied from
+  // the buffer a block at a time.
+  void Fill(turbo::Span<result_type> out) {
+    auto* begin = state();
+    result_type* dst = out.data();
+    size_t remaining = out.size();
+    while (remaining > 0) {
+      if (next_ >= kStateSizeT) {
+        next_ = kCapacityT;
+        impl_.Generate(begin);
+      }
+      const size_t n = std::min(remaining, kStateSizeT - next_);
+      const result_type* src = begin + next_;
+      for (size_t i = 0; i < n; ++i) {
+        dst[i] = little_endian::ToHost(src[i]);
+      }
+      next_ += n;
+      dst += n;
+      remaining -= n;
+    }
+  }
+
   template <class SeedSequence>
   typename turbo::enable_if_t<
       !std::is_convertible<SeedSequence, result_type>::value>
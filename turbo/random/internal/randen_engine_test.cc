@@ -18,6 +18,7 @@
 #include <bitset>
 #include <random>
 #include <sstream>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -128,6 +129,30 @@ TYPED_TEST(RandenEngineTypedTest, VerifyDiscard) {
   }
 }
 
+TYPED_TEST(RandenEngineTypedTest, VerifyFill) {
+  using randen = typename turbo::random_internal::randen_engine<TypeParam>;
+
+  for (size_t num_used = 0; num_used < kTwoBufferValues; num_used += 7) {
+    randen engine_used;
+    for (size_t i = 0; i < num_used; ++i) {
+      engine_used();
+    }
+
+    for (size_t num_fill = 0; num_fill < 2 * kTwoBufferValues;
+         num_fill += 13) {
+      randen engine1 = engine_used;
+      randen engine2 = engine_used;
+      std::vector<TypeParam> values(num_fill);
+      engine2.Fill(turbo::MakeSpan(values));
+      for (size_t i = 0; i < num_fill; ++i) {
+        ASSERT_EQ(engine1(), values[i])
+            << "used=" << num_used << " fill=" << num_fill << " i=" << i;
+      }
+      ASSERT_EQ(engine1, engine2);
+    }
+  }
+}
+
 TYPED_TEST(RandenEngineTypedTest, StreamOperatorsResult) {
   using randen = typename turbo::random_internal::randen_engine<TypeParam>;
   std::wostringstream os;
@@ -0,0 +1,183 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: weighted_reservoir.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::WeightedReservoir`, which keeps a weighted
+// random sample, without replacement, of the items of a stream of unknown
+// length, in O(k) memory.
+//
+// Each item gets the key u ^ (1 / w), for its weight w and u uniform in
+// (0, 1), and the sample holds the items of the k largest keys, as in the
+// algorithm A-Res of Efraimidis and Spirakis. The reservoir implements their
+// algorithm A-ExpJ, which draws how much weight to skip before the next item
+// entering the sample instead of a key per item: once the reservoir is full,
+// an item costs a subtraction, and only O(k log(n / k)) items draw random
+// values. The keys are kept as their logarithms, which do not underflow for
+// small weights.
+//
+// Example:
+//
+//   turbo::BitGen bitgen;
+//   turbo::WeightedReservoir<std::string> reservoir(10);
+//   for (const Request& request : requests) {
+//     reservoir.Add(bitgen, request.id(), request.cost());
+//   }
+//   std::vector<std::string> sample = reservoir.Sample();
+
+#ifndef TURBO_RANDOM_WEIGHTED_RESERVOIR_H_
+#define TURBO_RANDOM_WEIGHTED_RESERVOIR_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "turbo/platform/port.h"
+#include "turbo/random/exponential_distribution.h"
+#include "turbo/random/uniform_real_distribution.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// WeightedReservoir
+//
+// Keeps a weighted sample of at most `capacity()` items without replacement.
+// The probability of the sample is that of drawing its items one at a time,
+// each with a probability proportional to its weight among the items not yet
+// drawn.
+template <typename T>
+class WeightedReservoir {
+ public:
+  using value_type = T;
+
+  explicit WeightedReservoir(size_t capacity) : capacity_(capacity) {
+    heap_.reserve(capacity);
+  }
+
+  // size()
+  //
+  // Returns the number of items in the sample.
+  size_t size() const { return heap_.size(); }
+
+  // capacity()
+  //
+  // Returns the largest number of items in the sample.
+  size_t capacity() const { return capacity_; }
+
+  // Add()
+  //
+  // Offers `item` of weight `weight` to the sample. Items of weight zero or
+  // less are never sampled.
+  template <typename URBG>
+  void Add(URBG& g, T item, double weight);  // NOLINT(runtime/references)
+
+  // Sample()
+  //
+  // Returns the items of the sample, in the order they would have been drawn
+  // one at a time.
+  std::vector<T> Sample() const;
+
+  // Clear()
+  //
+  // Empties the sample, which then starts a new stream.
+  void Clear() {
+    heap_.clear();
+    skip_ = 0;
+  }
+
+ private:
+  struct Entry {
+    // The logarithm of the key of the item, at most 0.
+    double log_key;
+    T item;
+
+    // Orders the heap so that its front is the entry of the smallest key.
+    bool operator<(const Entry& other) const {
+      return log_key > other.log_key;
+    }
+  };
+
+  // Draws the weight to skip before the next item entering the full sample.
+  template <typename URBG>
+  void DrawSkip(URBG& g) {  // NOLINT(runtime/references)
+    // The next key above exp(t) belongs to the item whose cumulative weight
+    // crosses E / -t, for E exponentially distributed.
+    skip_ = turbo::exponential_distribution<double>(1.0)(g) /
+            -heap_.front().log_key;
+  }
+
+  size_t capacity_;
+  std::vector<Entry> heap_;
+  double skip_ = 0;
+};
+
+// --------------------------------------------------------------------------
+// Implementation details follow
+// --------------------------------------------------------------------------
+
+template <typename T>
+template <typename URBG>
+void WeightedReservoir<T>::Add(URBG& g,  // NOLINT(runtime/references)
+                               T item, double weight) {
+  if (!(weight > 0) || capacity_ == 0) return;
+  if (heap_.size() < capacity_) {
+    // log(u ^ (1 / w)) = log(u) / w, where -log(u) is exponentially
+    // distributed.
+    const double log_key =
+        -turbo::exponential_distribution<double>(1.0)(g) / weight;
+    heap_.push_back(Entry{log_key, std::move(item)});
+    std::push_heap(heap_.begin(), heap_.end());
+    if (heap_.size() == capacity_) DrawSkip(g);
+    return;
+  }
+  skip_ -= weight;
+  if (skip_ > 0) return;
+  // The key of the item is uniform in (t_w, 1), for t_w = exp(w * t) the key
+  // it must exceed, t the logarithm of the smallest key of the sample.
+  const double t_w = std::exp(weight * heap_.front().log_key);
+  const double u = turbo::uniform_real_distribution<double>(0, 1)(g);
+  double log_key = std::log1p(-(1 - t_w) * u) / weight;
+  // Rounding must not let the key fall below the one it replaces.
+  log_key = std::min(0.0, std::max(log_key, heap_.front().log_key));
+  std::pop_heap(heap_.begin(), heap_.end());
+  heap_.back() = Entry{log_key, std::move(item)};
+  std::push_heap(heap_.begin(), heap_.end());
+  DrawSkip(g);
+}
+
+template <typename T>
+std::vector<T> WeightedReservoir<T>::Sample() const {
+  std::vector<const Entry*> entries;
+  entries.reserve(heap_.size());
+  for (const Entry& entry : heap_) entries.push_back(&entry);
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->log_key > b->log_key;
+            });
+  std::vector<T> sample;
+  sample.reserve(entries.size());
+  for (const Entry* entry : entries) sample.push_back(entry->item);
+  return sample;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_RANDOM_WEIGHTED_RESERVOIR_H_
@@ -0,0 +1,146 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/random/weighted_reservoir.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/random/internal/chi_square.h"
+#include "turbo/random/internal/pcg_engine.h"
+#include "turbo/strings/str_cat.h"
+
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+// Checks the observed counts against the expected ones with a chi-squared
+// test.
+void CheckCounts(const std::vector<int64_t>& observed,
+                 const std::vector<double>& expected) {
+  using turbo::random_internal::kChiSquared;
+
+  const int dof = static_cast<int>(observed.size()) - 1;
+  const double threshold =
+      turbo::random_internal::ChiSquareValue(dof, 0.99999);
+  const double chi_square = turbo::random_internal::ChiSquare(
+      observed.begin(), observed.end(), expected.begin(), expected.end());
+  if (chi_square > threshold) {
+    std::string msg;
+    for (size_t i = 0; i < observed.size(); ++i) {
+      turbo::StrAppend(&msg, i, ": ", observed[i], " vs ", expected[i], "\n");
+    }
+    turbo::StrAppend(&msg, "High ", kChiSquared, " value: ", chi_square, " > ",
+                     threshold);
+    FAIL() << msg;
+  }
+}
+
+TEST(WeightedReservoirTest, FewerItemsThanCapacity) {
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedReservoir<std::string> reservoir(4);
+  EXPECT_EQ(4, reservoir.capacity());
+  EXPECT_THAT(reservoir.Sample(), IsEmpty());
+
+  reservoir.Add(rng, "a", 1.0);
+  reservoir.Add(rng, "b", 0.0);
+  reservoir.Add(rng, "c", 2.0);
+  reservoir.Add(rng, "d", -1.0);
+  EXPECT_EQ(2, reservoir.size());
+  EXPECT_THAT(reservoir.Sample(), UnorderedElementsAre("a", "c"));
+
+  reservoir.Clear();
+  EXPECT_EQ(0, reservoir.size());
+  reservoir.Add(rng, "e", 1.0);
+  EXPECT_THAT(reservoir.Sample(), ElementsAre("e"));
+}
+
+TEST(WeightedReservoirTest, ZeroCapacity) {
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedReservoir<int> reservoir(0);
+  for (int i = 0; i < 10; ++i) reservoir.Add(rng, i, 1.0);
+  EXPECT_THAT(reservoir.Sample(), IsEmpty());
+}
+
+TEST(WeightedReservoirTest, SingleItemIsProportionalToWeight) {
+  // A sample of one item is drawn with probabilities proportional to the
+  // weights. The long stream exercises the skips of the full reservoir.
+  constexpr int kItems = 100;
+  constexpr int kTrials = 50000;
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedReservoir<int> reservoir(1);
+  std::vector<int64_t> counts(kItems, 0);
+  for (int trial = 0; trial < kTrials; ++trial) {
+    reservoir.Clear();
+    for (int i = 0; i < kItems; ++i) reservoir.Add(rng, i, i + 1);
+    ASSERT_EQ(1, reservoir.size());
+    counts[reservoir.Sample()[0]]++;
+  }
+  const double total = kItems * (kItems + 1) / 2.0;
+  std::vector<double> expected;
+  for (int i = 0; i < kItems; ++i) expected.push_back(kTrials * (i + 1) / total);
+  CheckCounts(counts, expected);
+}
+
+TEST(WeightedReservoirTest, OrderedSampleWithoutReplacement) {
+  // Samples two of three items: each of the six ordered pairs has the
+  // probability of drawing its items one at a time without replacement.
+  constexpr int kTrials = 60000;
+  const double weights[] = {1.0, 2.0, 3.0};
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedReservoir<int> reservoir(2);
+  std::vector<int64_t> counts(9, 0);
+  for (int trial = 0; trial < kTrials; ++trial) {
+    reservoir.Clear();
+    for (int i = 0; i < 3; ++i) reservoir.Add(rng, i, weights[i]);
+    const std::vector<int> sample = reservoir.Sample();
+    ASSERT_EQ(2, sample.size());
+    counts[sample[0] * 3 + sample[1]]++;
+  }
+  std::vector<int64_t> observed;
+  std::vector<double> expected;
+  for (int a = 0; a < 3; ++a) {
+    for (int b = 0; b < 3; ++b) {
+      if (a == b) {
+        EXPECT_EQ(0, counts[a * 3 + b]);
+        continue;
+      }
+      observed.push_back(counts[a * 3 + b]);
+      expected.push_back(kTrials * weights[a] / 6.0 * weights[b] /
+                         (6.0 - weights[a]));
+    }
+  }
+  CheckCounts(observed, expected);
+}
+
+TEST(WeightedReservoirTest, InclusionInLongStream) {
+  // With a few heavy items in a long stream of light ones, the heavy items
+  // are nearly always sampled, wherever they are.
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedReservoir<int> reservoir(3);
+  for (int i = 0; i < 100000; ++i) {
+    const bool heavy = i == 10 || i == 50000 || i == 99999;
+    reservoir.Add(rng, i, heavy ? 1e9 : 1.0);
+  }
+  EXPECT_THAT(reservoir.Sample(), UnorderedElementsAre(10, 50000, 99999));
+}
+
+}  // namespace
@@ -0,0 +1,100 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/random/weighted_sampler.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+WeightedSampler::WeightedSampler(size_t n) : weights_(n, 0.0) { Rebuild(); }
+
+void WeightedSampler::Set(size_t i, double weight) {
+  assert(i < weights_.size());
+  assert(weight >= 0 && std::isfinite(weight));
+  const double delta = weight - weights_[i];
+  if (weights_[i] > 0) --num_positive_;
+  if (weight > 0) ++num_positive_;
+  weights_[i] = weight;
+  if (++updates_ > weights_.size()) {
+    Rebuild();
+    return;
+  }
+  for (size_t j = i + 1; j < tree_.size(); j += j & (~j + 1)) {
+    tree_[j] += delta;
+  }
+  // Updates which cancel out may leave a rounding error in the total, which
+  // must not hide that no weight is positive.
+  total_ = num_positive_ > 0 ? total_ + delta : 0;
+}
+
+void WeightedSampler::Resize(size_t n) {
+  weights_.resize(n, 0.0);
+  Rebuild();
+}
+
+void WeightedSampler::Rebuild() {
+  const size_t n = weights_.size();
+  tree_.assign(n + 1, 0.0);
+  total_ = 0;
+  num_positive_ = 0;
+  for (size_t i = 1; i <= n; ++i) {
+    assert(weights_[i - 1] >= 0 && std::isfinite(weights_[i - 1]));
+    if (weights_[i - 1] > 0) ++num_positive_;
+    tree_[i] += weights_[i - 1];
+    total_ += weights_[i - 1];
+    const size_t parent = i + (i & (~i + 1));
+    if (parent <= n) tree_[parent] += tree_[i];
+  }
+  top_ = 0;
+  if (n > 0) {
+    top_ = 1;
+    while (top_ <= n / 2) top_ *= 2;
+  }
+  updates_ = 0;
+}
+
+size_t WeightedSampler::Find(double target) const {
+  // Finds the largest `pos` whose partial sum of the weights in [0, pos) is at
+  // most `target`: index `pos` is the first whose partial sum exceeds it.
+  size_t pos = 0;
+  for (size_t step = top_; step > 0; step /= 2) {
+    const size_t next = pos + step;
+    if (next < tree_.size() && tree_[next] <= target) {
+      pos = next;
+      target -= tree_[next];
+    }
+  }
+  return pos;
+}
+
+size_t WeightedSampler::FindExact(double u) const {
+  double total = 0;
+  for (double weight : weights_) total += weight;
+  double target = u * total;
+  size_t last = 0;
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    if (weights_[i] <= 0) continue;
+    if (target < weights_[i]) return i;
+    target -= weights_[i];
+    last = i;
+  }
+  // Rounding may exhaust the target past the last positive weight.
+  return last;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,155 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: weighted_sampler.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::WeightedSampler`, which draws indices with
+// probabilities proportional to weights which may change between draws, such
+// as the capacities of the backends of a load balancer.
+//
+// `turbo::discrete_distribution` draws a variate in O(1) time, but must be
+// rebuilt in O(n) time when a weight changes. `turbo::WeightedSampler` keeps
+// the partial sums of the weights in a Fenwick tree, so that both changing a
+// weight and drawing a variate take O(log n) time.
+//
+// Example:
+//
+//   turbo::WeightedSampler sampler(backends.size());
+//   for (size_t i = 0; i < backends.size(); ++i) {
+//     sampler.Set(i, backends[i].capacity());
+//   }
+//   ...
+//   turbo::BitGen bitgen;
+//   Backend& backend = backends[sampler(bitgen)];
+//   ...
+//   // The capacity of a backend changed.
+//   sampler.Set(i, backends[i].capacity());
+
+#ifndef TURBO_RANDOM_WEIGHTED_SAMPLER_H_
+#define TURBO_RANDOM_WEIGHTED_SAMPLER_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "turbo/base/internal/raw_logging.h"
+#include "turbo/platform/port.h"
+#include "turbo/random/uniform_real_distribution.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// WeightedSampler
+//
+// Draws indices in [0, size()), with probabilities proportional to their
+// weights. The weights must be finite and non-negative, and they may all be
+// zero except when drawing: drawing with no positive weight is a fatal error.
+//
+// Drawing is thread-safe; changing the weights is thread-compatible.
+class WeightedSampler {
+ public:
+  WeightedSampler() = default;
+
+  // Constructs a sampler of `n` indices of weight zero.
+  explicit WeightedSampler(size_t n);
+
+  template <typename InputIterator>
+  WeightedSampler(InputIterator begin, InputIterator end)
+      : weights_(begin, end) {
+    Rebuild();
+  }
+
+  WeightedSampler(std::initializer_list<double> weights)
+      : WeightedSampler(weights.begin(), weights.end()) {}
+
+  // size()
+  //
+  // Returns the number of indices.
+  size_t size() const { return weights_.size(); }
+
+  // weight()
+  //
+  // Returns the weight of index `i`.
+  double weight(size_t i) const { return weights_[i]; }
+
+  // total_weight()
+  //
+  // Returns the sum of the weights, which is exactly zero if every weight is.
+  double total_weight() const { return total_; }
+
+  // Set()
+  //
+  // Sets the weight of index `i`, in O(log n) time.
+  void Set(size_t i, double weight);
+
+  // Resize()
+  //
+  // Adds indices of weight zero, or removes the last ones, in O(n) time.
+  void Resize(size_t n);
+
+  // operator()
+  //
+  // Returns an index drawn with a probability proportional to its weight.
+  // Requires a positive weight, which is checked even in optimized builds.
+  template <typename URBG>
+  size_t operator()(URBG& g) const {  // NOLINT(runtime/references)
+    TURBO_RAW_CHECK(num_positive_ > 0,
+                    "WeightedSampler requires a positive weight to draw");
+    // Rounding may land past the last index, or on an index of weight zero.
+    // Retrying succeeds quickly unless the updates cancelled out to a total
+    // far from the sum of the weights, which are then summed again.
+    constexpr int kMaxAttempts = 16;
+    if (TURBO_PREDICT_TRUE(total_ > 0)) {
+      turbo::uniform_real_distribution<double> dist(0, total_);
+      for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        const size_t i = Find(dist(g));
+        if (TURBO_PREDICT_TRUE(i < weights_.size() && weights_[i] > 0)) {
+          return i;
+        }
+      }
+    }
+    return FindExact(turbo::uniform_real_distribution<double>(0, 1)(g));
+  }
+
+ private:
+  // Returns the index whose range of partial sums contains `target`.
+  size_t Find(double target) const;
+
+  // Returns the index drawn by `u` in [0, 1) from the weights rather than the
+  // tree, in O(n) time.
+  size_t FindExact(double u) const;
+
+  // Computes the tree and the total from the weights, in O(n) time.
+  void Rebuild();
+
+  std::vector<double> weights_;
+  // The Fenwick tree of the weights, from index 1: tree_[i] is the sum of the
+  // weights in [i - (i & -i), i).
+  std::vector<double> tree_;
+  double total_ = 0;
+  // The number of positive weights.
+  size_t num_positive_ = 0;
+  // The highest power of two at most size(), where the search starts.
+  size_t top_ = 0;
+  // The tree is computed again after size() updates, which bounds the
+  // rounding errors accumulated by the updates for amortized O(1) time.
+  size_t updates_ = 0;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_RANDOM_WEIGHTED_SAMPLER_H_
@@ -0,0 +1,188 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/random/weighted_sampler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/random/internal/chi_square.h"
+#include "turbo/random/internal/pcg_engine.h"
+#include "turbo/random/random.h"
+#include "turbo/strings/str_cat.h"
+
+namespace {
+
+// Draws `trials` indices from `sampler` and checks their counts against the
+// weights with a chi-squared test.
+void CheckDistribution(const turbo::WeightedSampler& sampler, size_t trials) {
+  using turbo::random_internal::kChiSquared;
+
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  std::vector<int64_t> counts(sampler.size(), 0);
+  for (size_t i = 0; i < trials; ++i) {
+    const size_t x = sampler(rng);
+    ASSERT_LT(x, sampler.size());
+    ASSERT_GT(sampler.weight(x), 0) << x;
+    counts[x]++;
+  }
+
+  std::vector<double> expected;
+  std::vector<int64_t> observed;
+  for (size_t i = 0; i < sampler.size(); ++i) {
+    if (sampler.weight(i) == 0) continue;
+    expected.push_back(trials * sampler.weight(i) / sampler.total_weight());
+    observed.push_back(counts[i]);
+  }
+  const int dof = static_cast<int>(observed.size()) - 1;
+  if (dof <= 0) return;
+  const double threshold =
+      turbo::random_internal::ChiSquareValue(dof, 0.99999);
+  const double chi_square = turbo::random_internal::ChiSquare(
+      observed.begin(), observed.end(), expected.begin(), expected.end());
+  if (chi_square > threshold) {
+    std::string msg;
+    for (size_t i = 0; i < observed.size(); ++i) {
+      turbo::StrAppend(&msg, i, ": ", observed[i], " vs ", expected[i], "\n");
+    }
+    turbo::StrAppend(&msg, "High ", kChiSquared, " value: ", chi_square, " > ",
+                     threshold);
+    FAIL() << msg;
+  }
+}
+
+TEST(WeightedSamplerTest, Construction) {
+  turbo::WeightedSampler empty;
+  EXPECT_EQ(0, empty.size());
+  EXPECT_EQ(0, empty.total_weight());
+
+  turbo::WeightedSampler zeros(5);
+  EXPECT_EQ(5, zeros.size());
+  EXPECT_EQ(0, zeros.total_weight());
+
+  turbo::WeightedSampler list({1.0, 2.0, 3.0});
+  EXPECT_EQ(3, list.size());
+  EXPECT_EQ(2.0, list.weight(1));
+  EXPECT_EQ(6.0, list.total_weight());
+
+  std::vector<double> weights = {4.0, 0.0, 1.0};
+  turbo::WeightedSampler range(weights.begin(), weights.end());
+  EXPECT_EQ(3, range.size());
+  EXPECT_EQ(5.0, range.total_weight());
+}
+
+TEST(WeightedSamplerTest, SingleIndex) {
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedSampler sampler({0.0, 0.0, 7.0, 0.0});
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(2, sampler(rng));
+  }
+  sampler.Set(2, 0.0);
+  sampler.Set(0, 1e-300);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(0, sampler(rng));
+  }
+}
+
+TEST(WeightedSamplerTest, ChiSquaredTest) {
+  std::vector<double> weights(50);
+  std::iota(weights.begin(), weights.end(), 1);
+  turbo::WeightedSampler sampler(weights.begin(), weights.end());
+  CheckDistribution(sampler, 20000);
+
+  // Sizes which are not powers of two exercise the top of the tree.
+  turbo::WeightedSampler odd({3.0, 0.0, 1.0, 2.0, 5.0, 0.0, 4.0});
+  CheckDistribution(odd, 20000);
+}
+
+TEST(WeightedSamplerTest, Set) {
+  turbo::WeightedSampler sampler(64);
+  for (size_t i = 0; i < sampler.size(); ++i) {
+    sampler.Set(i, static_cast<double>(i % 8));
+  }
+  EXPECT_EQ(8 * (0 + 1 + 2 + 3 + 4 + 5 + 6 + 7), sampler.total_weight());
+  CheckDistribution(sampler, 20000);
+
+  sampler.Set(63, 100.0);
+  EXPECT_EQ(100.0, sampler.weight(63));
+  CheckDistribution(sampler, 20000);
+}
+
+TEST(WeightedSamplerTest, ManyUpdates) {
+  // Updates rebuild the tree from time to time, which must keep the weights
+  // and the total exact.
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::WeightedSampler sampler(100);
+  std::vector<double> weights(100, 0.0);
+  for (int i = 0; i < 100000; ++i) {
+    const size_t index = turbo::Uniform<size_t>(rng, 0, weights.size());
+    const double weight = turbo::Uniform<double>(rng, 0, 1000);
+    weights[index] = weight;
+    sampler.Set(index, weight);
+  }
+  const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+  EXPECT_NEAR(total, sampler.total_weight(), total * 1e-9);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_EQ(weights[i], sampler.weight(i));
+  }
+  CheckDistribution(sampler, 50000);
+}
+
+TEST(WeightedSamplerTest, AllWeightsSetToZero) {
+  // Updates which cancel out leave rounding errors in the running total;
+  // 1000 indices keep these updates from rebuilding the tree.
+  turbo::WeightedSampler sampler(1000);
+  sampler.Set(0, 0.1);
+  sampler.Set(1, 0.2);
+  sampler.Set(0, 0.0);
+  sampler.Set(1, 0.0);
+  EXPECT_EQ(0.0, sampler.total_weight());
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  EXPECT_DEATH_IF_SUPPORTED(sampler(rng), "positive weight");
+
+  sampler.Set(7, 0.3);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(7, sampler(rng));
+}
+
+TEST(WeightedSamplerTest, TotalLostToRounding) {
+  // Removing the large weight leaves a total of zero rather than the small
+  // one, which must still be drawn.
+  turbo::WeightedSampler sampler(1000);
+  sampler.Set(0, 1e300);
+  sampler.Set(1, 1e-300);
+  sampler.Set(0, 0.0);
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(1, sampler(rng));
+}
+
+TEST(WeightedSamplerTest, Resize) {
+  turbo::WeightedSampler sampler({1.0, 2.0, 3.0});
+  sampler.Resize(5);
+  EXPECT_EQ(5, sampler.size());
+  EXPECT_EQ(0.0, sampler.weight(4));
+  EXPECT_EQ(6.0, sampler.total_weight());
+  sampler.Set(4, 4.0);
+  CheckDistribution(sampler, 20000);
+
+  sampler.Resize(2);
+  EXPECT_EQ(2, sampler.size());
+  EXPECT_EQ(3.0, sampler.total_weight());
+  CheckDistribution(sampler, 20000);
+}
+
+}  // namespace
@@ -0,0 +1,186 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TURBO_RANDOM_ZIPF_TABLE_DISTRIBUTION_H_
+#define TURBO_RANDOM_ZIPF_TABLE_DISTRIBUTION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "turbo/random/discrete_distribution.h"
+#include "turbo/random/internal/fast_uniform_bits.h"
+#include "turbo/random/internal/wide_multiply.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// turbo::zipf_table_distribution produces random integer-values in the range
+// [0, k], distributed according to the unnormalized discrete probability
+// function:
+//
+//  P(x) = (v + x) ^ -q
+//
+// as `turbo::zipf_distribution` does, from a table of the k + 1 probabilities
+// built at construction. The table takes O(k) time to build and O(k) memory,
+// and each variate then takes O(1) time, without the calls to `std::pow()` and
+// `std::log()` of the rejection-inversion of `turbo::zipf_distribution`: it
+// suits the workloads drawing many variates of a few million values at most.
+//
+// The parameter `v` must be greater than 0 and the parameter `q` must be
+// greater than 0; unlike `turbo::zipf_distribution`, `q` may be at most 1, as
+// in the usual models of key popularity. If either of these parameters take
+// invalid values then the behavior is undefined.
+//
+// The table is built with Walker's Aliasing algorithm, as for
+// `turbo::discrete_distribution`.
+template <typename IntType = int>
+class zipf_table_distribution {
+ public:
+  using result_type = IntType;
+
+  class param_type {
+   public:
+    using distribution_type = zipf_table_distribution;
+
+    // Preconditions: k >= 0, v > 0, q > 0
+    // The preconditions on `q` and `v` are validated when NDEBUG is not
+    // defined via a pair of assert() directives.
+    explicit param_type(result_type k, double q = 1.0, double v = 1.0);
+
+    result_type k() const { return k_; }
+    double q() const { return q_; }
+    double v() const { return v_; }
+
+    friend bool operator==(const param_type& a, const param_type& b) {
+      return a.k_ == b.k_ && a.q_ == b.q_ && a.v_ == b.v_;
+    }
+    friend bool operator!=(const param_type& a, const param_type& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class zipf_table_distribution;
+
+    struct Column {
+      // The value of the column is kept when the top 53 bits of a random
+      // value are below `threshold`, and replaced by `alias` otherwise.
+      uint64_t threshold;
+      result_type alias;
+    };
+
+    result_type k_;
+    double q_;
+    double v_;
+    std::vector<Column> table_;
+
+    static_assert(std::is_integral<IntType>::value,
+                  "Class-template turbo::zipf_table_distribution<> must be "
+                  "parameterized using an integral type.");
+  };
+
+  explicit zipf_table_distribution(result_type k, double q = 1.0,
+                                   double v = 1.0)
+      : param_(k, q, v) {}
+
+  explicit zipf_table_distribution(const param_type& p) : param_(p) {}
+
+  void reset() {}
+
+  template <typename URBG>
+  result_type operator()(URBG& g) {  // NOLINT(runtime/references)
+    return (*this)(g, param_);
+  }
+
+  template <typename URBG>
+  result_type operator()(URBG& g,  // NOLINT(runtime/references)
+                         const param_type& p);
+
+  result_type k() const { return param_.k(); }
+  double q() const { return param_.q(); }
+  double v() const { return param_.v(); }
+
+  const param_type& param() const { return param_; }
+  void param(const param_type& p) { param_ = p; }
+
+  result_type(min)() const { return 0; }
+  result_type(max)() const { return k(); }
+
+  friend bool operator==(const zipf_table_distribution& a,
+                         const zipf_table_distribution& b) {
+    return a.param_ == b.param_;
+  }
+  friend bool operator!=(const zipf_table_distribution& a,
+                         const zipf_table_distribution& b) {
+    return a.param_ != b.param_;
+  }
+
+ private:
+  param_type param_;
+  random_internal::FastUniformBits<uint64_t> fast_u64_;
+};
+
+// --------------------------------------------------------------------------
+// Implementation details follow
+// --------------------------------------------------------------------------
+
+template <typename IntType>
+zipf_table_distribution<IntType>::param_type::param_type(
+    typename zipf_table_distribution<IntType>::result_type k, double q,
+    double v)
+    : k_(k), q_(q), v_(v) {
+  assert(q > 0);
+  assert(v > 0);
+  const size_t n = static_cast<size_t>(k) + 1;
+  std::vector<double> probabilities(n);
+  for (size_t i = 0; i < n; ++i) {
+    probabilities[i] = std::pow(v + static_cast<double>(i), -q);
+  }
+  const std::vector<std::pair<double, size_t>> q_table =
+      random_internal::InitDiscreteDistribution(&probabilities);
+  table_.reserve(n);
+  constexpr double k2p53 = 9007199254740992.0;  // 2^53
+  for (const auto& column : q_table) {
+    const double acceptance = std::min(column.first, 1.0);
+    table_.push_back(Column{static_cast<uint64_t>(acceptance * k2p53),
+                            static_cast<result_type>(column.second)});
+  }
+}
+
+template <typename IntType>
+template <typename URBG>
+typename zipf_table_distribution<IntType>::result_type
+zipf_table_distribution<IntType>::operator()(
+    URBG& g, const param_type& p) {  // NOLINT(runtime/references)
+  // A single 64-bit value gives both the column, from the high half of its
+  // product with the number of columns, and the value within the column, from
+  // the low half. The columns are uniform within (k + 1) / 2^64.
+  using helper = random_internal::wide_multiply<uint64_t>;
+  const auto product = helper::multiply(fast_u64_(g), p.table_.size());
+  const size_t idx = static_cast<size_t>(helper::hi(product));
+  const auto& column = p.table_[idx];
+  return (helper::lo(product) >> 11) < column.threshold
+             ? static_cast<result_type>(idx)
+             : column.alias;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_RANDOM_ZIPF_TABLE_DISTRIBUTION_H_
@@ -0,0 +1,138 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/random/zipf_table_distribution.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/random/internal/chi_square.h"
+#include "turbo/random/internal/pcg_engine.h"
+#include "turbo/strings/str_cat.h"
+
+namespace {
+
+template <typename IntType>
+class ZipfTableDistributionTypedTest : public ::testing::Test {};
+
+using IntTypes = ::testing::Types<int, int8_t, int16_t, int32_t, int64_t,
+                                  uint8_t, uint16_t, uint32_t, uint64_t>;
+TYPED_TEST_SUITE(ZipfTableDistributionTypedTest, IntTypes);
+
+TYPED_TEST(ZipfTableDistributionTypedTest, SerializeTest) {
+  using param_type =
+      typename turbo::zipf_table_distribution<TypeParam>::param_type;
+
+  constexpr int kCount = 1000;
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  for (const auto& param : {
+           param_type(1, 1.0, 1.0),          //
+           param_type(50, 1.0, 1.0),         //
+           param_type(100, 0.5, 2.0),        //
+           param_type(100, 2.0, 0.5),        //
+           param_type(100, 1.0, 100000.0),  //
+       }) {
+    turbo::zipf_table_distribution<TypeParam> before(param);
+    EXPECT_EQ(before.k(), param.k());
+    EXPECT_EQ(before.q(), param.q());
+    EXPECT_EQ(before.v(), param.v());
+    EXPECT_EQ(before.min(), 0);
+    EXPECT_EQ(before.max(), param.k());
+    EXPECT_EQ(before.param(), param);
+
+    turbo::zipf_table_distribution<TypeParam> copy(before.k(), before.q(),
+                                                   before.v());
+    EXPECT_EQ(before, copy);
+
+    for (int i = 0; i < kCount; ++i) {
+      const auto sample = before(rng);
+      EXPECT_GE(sample, before.min());
+      EXPECT_LE(sample, before.max());
+    }
+  }
+}
+
+class ZipfTableTest : public testing::TestWithParam<std::pair<double, double>> {
+};
+
+TEST_P(ZipfTableTest, ChiSquaredTest) {
+  using turbo::random_internal::kChiSquared;
+
+  constexpr int kK = 100;
+  constexpr size_t kTrials = 100000;
+  const double q = GetParam().first;
+  const double v = GetParam().second;
+
+  turbo::random_internal::pcg64_2018_engine rng(0x2B7E151628AED2A6);
+  turbo::zipf_table_distribution<int> dist(kK, q, v);
+  std::vector<int64_t> counts(kK + 1, 0);
+  for (size_t i = 0; i < kTrials; ++i) {
+    counts[dist(rng)]++;
+  }
+
+  // Merges the tail buckets until each expects at least 10 samples.
+  std::vector<double> weights;
+  double total = 0;
+  for (int i = 0; i <= kK; ++i) {
+    weights.push_back(std::pow(v + i, -q));
+    total += weights.back();
+  }
+  std::vector<int64_t> observed;
+  std::vector<double> expected;
+  int64_t tail_count = 0;
+  double tail_expected = 0;
+  for (int i = 0; i <= kK; ++i) {
+    tail_count += counts[i];
+    tail_expected += kTrials * weights[i] / total;
+    if (tail_expected >= 10) {
+      observed.push_back(tail_count);
+      expected.push_back(tail_expected);
+      tail_count = 0;
+      tail_expected = 0;
+    }
+  }
+  if (tail_expected > 0) {
+    observed.back() += tail_count;
+    expected.back() += tail_expected;
+  }
+
+  const int dof = static_cast<int>(observed.size()) - 1;
+  const double threshold =
+      turbo::random_internal::ChiSquareValue(dof, 0.99999);
+  const double chi_square = turbo::random_internal::ChiSquare(
+      observed.begin(), observed.end(), expected.begin(), expected.end());
+  if (chi_square > threshold) {
+    std::string msg;
+    for (size_t i = 0; i < observed.size(); ++i) {
+      turbo::StrAppend(&msg, i, ": ", observed[i], " vs ", expected[i], "\n");
+    }
+    turbo::StrAppend(&msg, "High ", kChiSquared, " value: ", chi_square, " > ",
+                     threshold);
+    FAIL() << msg;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(All, ZipfTableTest,
+                         ::testing::Values(std::make_pair(1.0, 1.0),
+                                           std::make_pair(0.5, 1.0),
+                                           std::make_pair(0.99, 10.0),
+                                           std::make_pair(2.0, 1.0),
+                                           std::make_pair(1.5, 0.5)));
+
+}  // namespace
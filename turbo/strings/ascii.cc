@@ -13,8 +13,25 @@
 // limitations under the License.
 
 #include "turbo/strings/ascii.h"
+
+#include <cstdint>
+
+#include "turbo/base/bits.h"
 #include "turbo/strings/inlined_string.h"
 
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+// The AVX2 kernels are compiled with a function-level target attribute and
+// selected at runtime, so the rest of the library keeps its baseline ISA.
+#if defined(TURBO_INTERNAL_HAVE_SSE2) && defined(TURBO_PROCESSOR_X86_64) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TURBO_STRINGS_INTERNAL_HAVE_AVX2 1
+#define TURBO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 namespace turbo {
 TURBO_NAMESPACE_BEGIN
 namespace ascii_internal {
@@ -154,22 +171,463 @@ TURBO_DLL const char kToUpper[256] = {
 };
 // clang-format on
 
+namespace {
+
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+
+// An inclusive byte range [lo, hi]. If `fold` is set the byte is OR'ed with
+// 0x20 before the comparison, which maps 'A'-'Z' onto 'a'-'z'.
+struct ByteRange {
+  unsigned char lo;
+  unsigned char hi;
+  bool fold;
+};
+
+// Every `AsciiClass` is the union of at most four byte ranges; this lets the
+// vector kernels below classify 16 or 32 bytes with a handful of
+// add/compare/or instructions per range instead of a table lookup per byte.
+struct ClassRanges {
+  int size;
+  ByteRange ranges[4];
+};
+
+ClassRanges GetClassRanges(AsciiClass c) {
+  switch (c) {
+    case AsciiClass::kAlpha:
+      return {1, {{'a', 'z', true}}};
+    case AsciiClass::kAlnum:
+      return {2, {{'a', 'z', true}, {'0', '9', false}}};
+    case AsciiClass::kSpace:
+      return {2, {{'\t', '\r', false}, {' ', ' ', false}}};
+    case AsciiClass::kPunct:
+      return {4,
+              {{'!', '/', false},
+               {':', '@', false},
+               {'[', '`', false},
+               {'{', '~', false}}};
+    case AsciiClass::kBlank:
+      return {2, {{'\t', '\t', false}, {' ', ' ', false}}};
+    case AsciiClass::kCntrl:
+      return {2, {{0x00, 0x1f, false}, {0x7f, 0x7f, false}}};
+    case AsciiClass::kXDigit:
+      return {2, {{'a', 'f', true}, {'0', '9', false}}};
+    case AsciiClass::kDigit:
+      return {1, {{'0', '9', false}}};
+    case AsciiClass::kPrint:
+      return {1, {{0x20, 0x7e, false}}};
+    case AsciiClass::kGraph:
+      return {1, {{0x21, 0x7e, false}}};
+    case AsciiClass::kUpper:
+      return {1, {{'A', 'Z', false}}};
+    case AsciiClass::kLower:
+      return {1, {{'a', 'z', false}}};
+    case AsciiClass::kAscii:
+      return {1, {{0x00, 0x7f, false}}};
+  }
+  return {0, {}};
+}
+
+#endif  // TURBO_INTERNAL_HAVE_SSE2
+
+// Scalar classification, used for short inputs and where no vector unit is
+// available.
+inline bool InClass(AsciiClass c, unsigned char ch) {
+  switch (c) {
+    case AsciiClass::kAlpha:
+      return turbo::ascii_isalpha(ch);
+    case AsciiClass::kAlnum:
+      return turbo::ascii_isalnum(ch);
+    case AsciiClass::kSpace:
+      return turbo::ascii_isspace(ch);
+    case AsciiClass::kPunct:
+      return turbo::ascii_ispunct(ch);
+    case AsciiClass::kBlank:
+      return turbo::ascii_isblank(ch);
+    case AsciiClass::kCntrl:
+      return turbo::ascii_iscntrl(ch);
+    case AsciiClass::kXDigit:
+      return turbo::ascii_isxdigit(ch);
+    case AsciiClass::kDigit:
+      return turbo::ascii_isdigit(ch);
+    case AsciiClass::kPrint:
+      return turbo::ascii_isprint(ch);
+    case AsciiClass::kGraph:
+      return turbo::ascii_isgraph(ch);
+    case AsciiClass::kUpper:
+      return turbo::ascii_isupper(ch);
+    case AsciiClass::kLower:
+      return turbo::ascii_islower(ch);
+    case AsciiClass::kAscii:
+      return turbo::ascii_isascii(ch);
+  }
+  return false;
+}
+
+inline size_t ScalarCountIf(AsciiClass c, const char* p, size_t n) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += InClass(c, static_cast<unsigned char>(p[i])) ? 1 : 0;
+  }
+  return count;
+}
+
+inline size_t ScalarFindFirst(AsciiClass c, bool match, const char* p,
+                              size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if (InClass(c, static_cast<unsigned char>(p[i])) == match) return i;
+  }
+  return turbo::string_view::npos;
+}
+
+inline size_t ScalarFindLast(AsciiClass c, bool match, const char* p,
+                             size_t n) {
+  while (n > 0) {
+    --n;
+    if (InClass(c, static_cast<unsigned char>(p[n])) == match) return n;
+  }
+  return turbo::string_view::npos;
+}
+
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+
+// SSE2 only provides signed byte comparisons. A byte `x` lies in [lo, hi] iff
+// `(x - lo)` is unsigned-less-or-equal to `(hi - lo)`; biasing both sides by
+// 0x80 turns that into a signed comparison.
+struct Sse2Classifier {
+  explicit Sse2Classifier(const ClassRanges& cr) : size(cr.size) {
+    for (int i = 0; i < cr.size; ++i) {
+      const ByteRange& r = cr.ranges[i];
+      bias[i] = _mm_set1_epi8(static_cast<char>(0x80 - r.lo));
+      limit[i] = _mm_set1_epi8(static_cast<char>(0x80 + (r.hi - r.lo) + 1));
+      fold[i] = _mm_set1_epi8(r.fold ? 0x20 : 0);
+    }
+  }
+
+  // Returns 0xff in every lane whose byte belongs to the class.
+  __m128i Match(__m128i v) const {
+    __m128i m = _mm_setzero_si128();
+    for (int i = 0; i < size; ++i) {
+      __m128i x = _mm_add_epi8(_mm_or_si128(v, fold[i]), bias[i]);
+      m = _mm_or_si128(m, _mm_cmplt_epi8(x, limit[i]));
+    }
+    return m;
+  }
+
+  // Returns one bit per byte of the 16 bytes at `p`, set where the byte's
+  // membership equals `match`.
+  uint32_t Mask(const char* p, bool match) const {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(Match(v)));
+    return match ? m : (~m & 0xffffu);
+  }
+
+  int size;
+  __m128i bias[4];
+  __m128i limit[4];
+  __m128i fold[4];
+};
+
+// Shifts the bytes in [lo, hi] by `delta`. Used for both case directions.
+inline __m128i Sse2ShiftRange(__m128i v, unsigned char lo, unsigned char hi,
+                              char delta) {
+  __m128i x = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+  __m128i m = _mm_cmplt_epi8(
+      x, _mm_set1_epi8(static_cast<char>(0x80 + (hi - lo) + 1)));
+  return _mm_add_epi8(v, _mm_and_si128(m, _mm_set1_epi8(delta)));
+}
+
+// Requires n >= 16. The final block overlaps the previous one rather than
+// falling back to a scalar tail; case mapping is idempotent so this is safe
+// whenever `dst == src`, and harmless otherwise.
+void Sse2ShiftCase(char* dst, const char* src, size_t n, unsigned char lo,
+                   unsigned char hi, char delta) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     Sse2ShiftRange(v, lo, hi, delta));
+  }
+  if (i < n) {
+    __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n - 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n - 16),
+                     Sse2ShiftRange(v, lo, hi, delta));
+  }
+}
+
+// Requires n >= 16.
+size_t Sse2CountIf(const ClassRanges& cr, const char* p, size_t n) {
+  Sse2Classifier cls(cr);
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    count += static_cast<size_t>(turbo::popcount(cls.Mask(p + i, true)));
+  }
+  if (i < n) {
+    // Re-read the last 16 bytes and drop the lanes already counted.
+    uint32_t m = cls.Mask(p + n - 16, true) >> (16 - (n - i));
+    count += static_cast<size_t>(turbo::popcount(m));
+  }
+  return count;
+}
+
+// Requires n >= 16.
+size_t Sse2FindFirst(const ClassRanges& cr, bool match, const char* p,
+                     size_t n) {
+  Sse2Classifier cls(cr);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint32_t m = cls.Mask(p + i, match);
+    if (m != 0) return i + static_cast<size_t>(turbo::countr_zero(m));
+  }
+  if (i < n) {
+    uint32_t m = cls.Mask(p + n - 16, match);
+    if (m != 0) return n - 16 + static_cast<size_t>(turbo::countr_zero(m));
+  }
+  return turbo::string_view::npos;
+}
+
+// Requires n >= 16.
+size_t Sse2FindLast(const ClassRanges& cr, bool match, const char* p,
+                    size_t n) {
+  Sse2Classifier cls(cr);
+  size_t i = n;
+  for (; i >= 16; i -= 16) {
+    uint32_t m = cls.Mask(p + i - 16, match);
+    if (m != 0) return i - 1 - static_cast<size_t>(turbo::countl_zero(m) - 16);
+  }
+  if (i > 0) {
+    uint32_t m = cls.Mask(p, match);
+    if (m != 0) return 15 - static_cast<size_t>(turbo::countl_zero(m) - 16);
+  }
+  return turbo::string_view::npos;
+}
+
+#endif  // TURBO_INTERNAL_HAVE_SSE2
+
+#ifdef TURBO_STRINGS_INTERNAL_HAVE_AVX2
+
+bool HaveAvx2() {
+  static const bool kHaveAvx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return kHaveAvx2;
+}
+
+// 32-byte counterparts of the SSE2 kernels above.
+struct Avx2Classifier {
+  TURBO_TARGET_AVX2 explicit Avx2Classifier(const ClassRanges& cr)
+      : size(cr.size) {
+    for (int i = 0; i < cr.size; ++i) {
+      const ByteRange& r = cr.ranges[i];
+      bias[i] = _mm256_set1_epi8(static_cast<char>(0x80 - r.lo));
+      limit[i] = _mm256_set1_epi8(static_cast<char>(0x80 + (r.hi - r.lo) + 1));
+      fold[i] = _mm256_set1_epi8(r.fold ? 0x20 : 0);
+    }
+  }
+
+  TURBO_TARGET_AVX2 uint32_t Mask(const char* p, bool match) const {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i m = _mm256_setzero_si256();
+    for (int i = 0; i < size; ++i) {
+      __m256i x = _mm256_add_epi8(_mm256_or_si256(v, fold[i]), bias[i]);
+      m = _mm256_or_si256(m, _mm256_cmpgt_epi8(limit[i], x));
+    }
+    uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+    return match ? bits : ~bits;
+  }
+
+  int size;
+  __m256i bias[4];
+  __m256i limit[4];
+  __m256i fold[4];
+};
+
+TURBO_TARGET_AVX2 inline __m256i Avx2ShiftRange(__m256i v, unsigned char lo,
+                                                unsigned char hi, char delta) {
+  __m256i x =
+      _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+  __m256i m = _mm256_cmpgt_epi8(
+      _mm256_set1_epi8(static_cast<char>(0x80 + (hi - lo) + 1)), x);
+  return _mm256_add_epi8(v, _mm256_and_si256(m, _mm256_set1_epi8(delta)));
+}
+
+// Requires n >= 32.
+TURBO_TARGET_AVX2 void Avx2ShiftCase(char* dst, const char* src, size_t n,
+                                     unsigned char lo, unsigned char hi,
+                                     char delta) {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        Avx2ShiftRange(v, lo, hi, delta));
+  }
+  if (i < n) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + n - 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n - 32),
+                        Avx2ShiftRange(v, lo, hi, delta));
+  }
+}
+
+// Requires n >= 32.
+TURBO_TARGET_AVX2 size_t Avx2CountIf(const ClassRanges& cr, const char* p,
+                                     size_t n) {
+  Avx2Classifier cls(cr);
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    count += static_cast<size_t>(turbo::popcount(cls.Mask(p + i, true)));
+  }
+  if (i < n) {
+    uint32_t m = cls.Mask(p + n - 32, true) >> (32 - (n - i));
+    count += static_cast<size_t>(turbo::popcount(m));
+  }
+  return count;
+}
+
+// Requires n >= 32.
+TURBO_TARGET_AVX2 size_t Avx2FindFirst(const ClassRanges& cr, bool match,
+                                       const char* p, size_t n) {
+  Avx2Classifier cls(cr);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    uint32_t m = cls.Mask(p + i, match);
+    if (m != 0) return i + static_cast<size_t>(turbo::countr_zero(m));
+  }
+  if (i < n) {
+    uint32_t m = cls.Mask(p + n - 32, match);
+    if (m != 0) return n - 32 + static_cast<size_t>(turbo::countr_zero(m));
+  }
+  return turbo::string_view::npos;
+}
+
+// Requires n >= 32.
+TURBO_TARGET_AVX2 size_t Avx2FindLast(const ClassRanges& cr, bool match,
+                                      const char* p, size_t n) {
+  Avx2Classifier cls(cr);
+  size_t i = n;
+  for (; i >= 32; i -= 32) {
+    uint32_t m = cls.Mask(p + i - 32, match);
+    if (m != 0) return i - 1 - static_cast<size_t>(turbo::countl_zero(m));
+  }
+  if (i > 0) {
+    uint32_t m = cls.Mask(p, match);
+    if (m != 0) return 31 - static_cast<size_t>(turbo::countl_zero(m));
+  }
+  return turbo::string_view::npos;
+}
+
+#endif  // TURBO_STRINGS_INTERNAL_HAVE_AVX2
+
+void ShiftCase(char* dst, const char* src, size_t n, unsigned char lo,
+               unsigned char hi, char delta) {
+#ifdef TURBO_STRINGS_INTERNAL_HAVE_AVX2
+  if (n >= 32 && HaveAvx2()) {
+    Avx2ShiftCase(dst, src, n, lo, hi, delta);
+    return;
+  }
+#endif
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+  if (n >= 16) {
+    Sse2ShiftCase(dst, src, n, lo, hi, delta);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    unsigned char ch = static_cast<unsigned char>(src[i]);
+    dst[i] = (ch >= lo && ch <= hi) ? static_cast<char>(ch + delta)
+                                    : static_cast<char>(ch);
+  }
+}
+
+size_t FindFirst(turbo::string_view s, AsciiClass c, bool match) {
+#ifdef TURBO_STRINGS_INTERNAL_HAVE_AVX2
+  if (s.size() >= 32 && HaveAvx2()) {
+    return Avx2FindFirst(GetClassRanges(c), match, s.data(), s.size());
+  }
+#endif
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+  if (s.size() >= 16) {
+    return Sse2FindFirst(GetClassRanges(c), match, s.data(), s.size());
+  }
+#endif
+  return ScalarFindFirst(c, match, s.data(), s.size());
+}
+
+size_t FindLast(turbo::string_view s, AsciiClass c, bool match) {
+#ifdef TURBO_STRINGS_INTERNAL_HAVE_AVX2
+  if (s.size() >= 32 && HaveAvx2()) {
+    return Avx2FindLast(GetClassRanges(c), match, s.data(), s.size());
+  }
+#endif
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+  if (s.size() >= 16) {
+    return Sse2FindLast(GetClassRanges(c), match, s.data(), s.size());
+  }
+#endif
+  return ScalarFindLast(c, match, s.data(), s.size());
+}
+
+size_t CountIf(turbo::string_view s, AsciiClass c) {
+#ifdef TURBO_STRINGS_INTERNAL_HAVE_AVX2
+  if (s.size() >= 32 && HaveAvx2()) {
+    return Avx2CountIf(GetClassRanges(c), s.data(), s.size());
+  }
+#endif
+#ifdef TURBO_INTERNAL_HAVE_SSE2
+  if (s.size() >= 16) return Sse2CountIf(GetClassRanges(c), s.data(), s.size());
+#endif
+  return ScalarCountIf(c, s.data(), s.size());
+}
+
+}  // namespace
+
+void AsciiStrToLower(char* dst, const char* src, size_t n) {
+  ShiftCase(dst, src, n, 'A', 'Z', 'a' - 'A');
+}
+
+void AsciiStrToUpper(char* dst, const char* src, size_t n) {
+  ShiftCase(dst, src, n, 'a', 'z', 'A' - 'a');
+}
+
 }  // namespace ascii_internal
 
+size_t AsciiCountIf(turbo::string_view s, AsciiClass c) {
+  return ascii_internal::CountIf(s, c);
+}
+
+size_t AsciiFindFirstOf(turbo::string_view s, AsciiClass c) {
+  return ascii_internal::FindFirst(s, c, true);
+}
+
+size_t AsciiFindFirstNotOf(turbo::string_view s, AsciiClass c) {
+  return ascii_internal::FindFirst(s, c, false);
+}
+
+size_t AsciiFindLastOf(turbo::string_view s, AsciiClass c) {
+  return ascii_internal::FindLast(s, c, true);
+}
+
+size_t AsciiFindLastNotOf(turbo::string_view s, AsciiClass c) {
+  return ascii_internal::FindLast(s, c, false);
+}
+
 template <typename String>
 typename std::enable_if<turbo::is_string_type<String>::value>::type
 AsciiStrToLower(String* s) {
-  for (auto& ch : *s) {
-    ch = turbo::ascii_tolower(static_cast<unsigned char>(ch));
-  }
+  if (s->empty()) return;
+  char* p = &(*s)[0];
+  ascii_internal::AsciiStrToLower(p, p, s->size());
 }
 
 template <typename String>
 TURBO_MUST_USE_RESULT typename std::enable_if<turbo::is_string_type<String>::value>::type
 AsciiStrToUpper(String* s) {
-  for (auto& ch : *s) {
-    ch = turbo::ascii_toupper(static_cast<unsigned char>(ch));
-  }
+  if (s->empty()) return;
+  char* p = &(*s)[0];
+  ascii_internal::AsciiStrToUpper(p, p, s->size());
 }
 
 template <typename String>
@@ -48,6 +48,13 @@
 //   If the input character is not an ASCII {lower,upper}-case letter (including
 //   numerical values greater than 127) then the functions return the same value
 //   as the input character.
+//
+// `AsciiCountIf()`, `AsciiFindFirstOf()`, `AsciiFindFirstNotOf()`,
+// `AsciiFindLastOf()`, `AsciiFindLastNotOf()`
+//   Bulk versions of the classification functions above, operating on a whole
+//   string at a time for a given `AsciiClass`. Where the platform supports it
+//   (SSE2, and AVX2 when detected at runtime), these process 16 or 32 bytes per
+//   iteration rather than one.
 
 #ifndef TURBO_STRINGS_ASCII_H_
 #define TURBO_STRINGS_ASCII_H_
@@ -74,6 +81,38 @@ TURBO_DLL extern const char kToLower[256];
 
 }  // namespace ascii_internal
 
+// AsciiClass
+//
+// Enumerates the character classes accepted by the bulk classification
+// functions (`AsciiCountIf()` and the `AsciiFind*()` family). Each value
+// corresponds to the single-character predicate of the same name, e.g.
+// `AsciiClass::kSpace` matches exactly the characters for which
+// `ascii_isspace()` returns `true`.
+enum class AsciiClass {
+  kAlpha,
+  kAlnum,
+  kSpace,
+  kPunct,
+  kBlank,
+  kCntrl,
+  kXDigit,
+  kDigit,
+  kPrint,
+  kGraph,
+  kUpper,
+  kLower,
+  kAscii,
+};
+
+namespace ascii_internal {
+
+// Bulk case mapping of `n` characters from `src` into `dst`. `src` and `dst`
+// may be the same buffer, but must not otherwise overlap.
+void AsciiStrToLower(char* dst, const char* src, size_t n);
+void AsciiStrToUpper(char* dst, const char* src, size_t n);
+
+}  // namespace ascii_internal
+
 // ascii_isalpha()
 //
 // Determines whether the given character is an alphabetic character.
@@ -201,36 +240,72 @@ AsciiStrToUpper(turbo::string_view s) {
   return result;
 }
 
+// AsciiCountIf()
+//
+// Returns the number of characters in `s` belonging to the class `c`.
+size_t AsciiCountIf(turbo::string_view s, AsciiClass c);
+
+// AsciiFindFirstOf()
+//
+// Returns the position of the first character in `s` belonging to the class
+// `c`, or `turbo::string_view::npos` if there is none.
+size_t AsciiFindFirstOf(turbo::string_view s, AsciiClass c);
+
+// AsciiFindFirstNotOf()
+//
+// Returns the position of the first character in `s` not belonging to the
+// class `c`, or `turbo::string_view::npos` if there is none.
+size_t AsciiFindFirstNotOf(turbo::string_view s, AsciiClass c);
+
+// AsciiFindLastOf()
+//
+// Returns the position of the last character in `s` belonging to the class
+// `c`, or `turbo::string_view::npos` if there is none.
+size_t AsciiFindLastOf(turbo::string_view s, AsciiClass c);
+
+// AsciiFindLastNotOf()
+//
+// Returns the position of the last character in `s` not belonging to the
+// class `c`, or `turbo::string_view::npos` if there is none.
+size_t AsciiFindLastNotOf(turbo::string_view s, AsciiClass c);
+
 // Returns turbo::string_view with whitespace stripped from the beginning of the
 // given string_view.
 TURBO_MUST_USE_RESULT inline turbo::string_view StripLeadingAsciiWhitespace(
     turbo::string_view str) {
-  auto it = std::find_if_not(str.begin(), str.end(), turbo::ascii_isspace);
-  return str.substr(static_cast<size_t>(it - str.begin()));
+  // Most inputs carry no whitespace at all; answer those without a call.
+  if (str.empty() || !turbo::ascii_isspace(static_cast<unsigned char>(str.front()))) {
+    return str;
+  }
+  size_t pos = AsciiFindFirstNotOf(str, AsciiClass::kSpace);
+  return pos == turbo::string_view::npos ? str.substr(str.size())
+                                         : str.substr(pos);
 }
 
 // Strips in place whitespace from the beginning of the given string.
 template <typename String>
 inline typename std::enable_if<turbo::is_string_type<String>::value>::type
 StripLeadingAsciiWhitespace(String* str) {
-  auto it = std::find_if_not(str->begin(), str->end(), turbo::ascii_isspace);
-  str->erase(str->begin(), it);
+  size_t n = str->size() - StripLeadingAsciiWhitespace(turbo::string_view(*str)).size();
+  str->erase(0, n);
 }
 
 // Returns turbo::string_view with whitespace stripped from the end of the given
 // string_view.
 TURBO_MUST_USE_RESULT inline turbo::string_view StripTrailingAsciiWhitespace(
     turbo::string_view str) {
-  auto it = std::find_if_not(str.rbegin(), str.rend(), turbo::ascii_isspace);
-  return str.substr(0, static_cast<size_t>(str.rend() - it));
+  if (str.empty() || !turbo::ascii_isspace(static_cast<unsigned char>(str.back()))) {
+    return str;
+  }
+  size_t pos = AsciiFindLastNotOf(str, AsciiClass::kSpace);
+  return str.substr(0, pos == turbo::string_view::npos ? 0 : pos + 1);
 }
 
 // Strips in place whitespace from the end of the given string
 template <typename String>
 inline typename std::enable_if<turbo::is_string_type<String>::value>::type
 StripTrailingAsciiWhitespace(String* str) {
-  auto it = std::find_if_not(str->rbegin(), str->rend(), turbo::ascii_isspace);
-  str->erase(static_cast<size_t>(str->rend() - it));
+  str->erase(StripTrailingAsciiWhitespace(turbo::string_view(*str)).size());
 }
 
 // Returns turbo::string_view with whitespace stripped from both ends of the
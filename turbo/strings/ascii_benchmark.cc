@@ -14,6 +14,7 @@
 
 #include "turbo/strings/ascii.h"
 
+#include <algorithm>
 #include <cctype>
 #include <string>
 #include <array>
@@ -117,4 +118,117 @@ static void BM_StrToUpper(benchmark::State& state) {
 }
 BENCHMARK(BM_StrToUpper)->Range(1, 1 << 20);
 
+// The bulk kernels below are measured on short keys (16 bytes) and on larger
+// payloads (4 KB), each against the equivalent byte-at-a-time loop.
+
+std::string MakeMixedCase(size_t size) {
+  std::string s(size, 'x');
+  for (size_t i = 0; i < size; ++i) {
+    s[i] = static_cast<char>((i % 3 == 0 ? 'A' : 'a') + i % 26);
+  }
+  return s;
+}
+
+static void BM_StrToLowerInPlace(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    turbo::AsciiStrToLower(&s);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrToLowerInPlace)->Arg(16)->Arg(4096);
+
+static void BM_StrToLowerInPlaceScalar(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (auto& ch : s) ch = turbo::ascii_tolower(static_cast<unsigned char>(ch));
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrToLowerInPlaceScalar)->Arg(16)->Arg(4096);
+
+static void BM_StrToUpperInPlace(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    turbo::AsciiStrToUpper(&s);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrToUpperInPlace)->Arg(16)->Arg(4096);
+
+// Whitespace on both ends, with the payload in the middle.
+static void BM_StripAsciiWhitespace(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string s(size / 4, ' ');
+  s += MakeMixedCase(size / 2);
+  s.append(size - s.size(), '\t');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::StripAsciiWhitespace(s));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StripAsciiWhitespace)->Arg(16)->Arg(4096);
+
+static void BM_StripAsciiWhitespaceScalar(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  std::string s(size / 4, ' ');
+  s += MakeMixedCase(size / 2);
+  s.append(size - s.size(), '\t');
+  for (auto _ : state) {
+    turbo::string_view v(s);
+    auto b = std::find_if_not(v.begin(), v.end(), turbo::ascii_isspace);
+    auto e = std::find_if_not(v.rbegin(), v.rend(), turbo::ascii_isspace);
+    benchmark::DoNotOptimize(b);
+    benchmark::DoNotOptimize(e);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StripAsciiWhitespaceScalar)->Arg(16)->Arg(4096);
+
+static void BM_AsciiCountIf(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(turbo::AsciiCountIf(s, turbo::AsciiClass::kUpper));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsciiCountIf)->Arg(16)->Arg(4096);
+
+static void BM_AsciiCountIfScalar(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::count_if(s.begin(), s.end(), turbo::ascii_isupper));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsciiCountIfScalar)->Arg(16)->Arg(4096);
+
+// Searches a string of alphanumerics for the first non-alphanumeric, which is
+// placed at the very end.
+static void BM_AsciiFindFirstNotOf(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  s.back() = '-';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        turbo::AsciiFindFirstNotOf(s, turbo::AsciiClass::kAlnum));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsciiFindFirstNotOf)->Arg(16)->Arg(4096);
+
+static void BM_AsciiFindFirstNotOfScalar(benchmark::State& state) {
+  std::string s = MakeMixedCase(static_cast<size_t>(state.range(0)));
+  s.back() = '-';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::find_if_not(s.begin(), s.end(), turbo::ascii_isalnum));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsciiFindFirstNotOfScalar)->Arg(16)->Arg(4096);
+
 }  // namespace
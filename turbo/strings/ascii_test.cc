@@ -18,6 +18,7 @@
 #include <clocale>
 #include <cstring>
 #include <string>
+#include <utility>
 
 #include "turbo/platform/port.h"
 #include "gtest/gtest.h"
@@ -220,6 +221,107 @@ TEST(AsciiStrTo, Upper) {
   EXPECT_STREQ("MUTABLE", mutable_buf);
 }
 
+// Lengths straddling the 16 and 32 byte vector widths, so that every kernel
+// sees full blocks, overlapping tails and the scalar path.
+std::string MakeBytes(size_t n, unsigned seed) {
+  std::string s(n, '\0');
+  for (size_t i = 0; i < n; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    s[i] = static_cast<char>(seed >> 16);
+  }
+  return s;
+}
+
+TEST(AsciiStrTo, LongAndUnaligned) {
+  for (size_t n = 0; n < 100; ++n) {
+    std::string s = MakeBytes(n + 3, static_cast<unsigned>(n)).substr(3);
+    std::string lower = s;
+    std::string upper = s;
+    turbo::AsciiStrToLower(&lower);
+    turbo::AsciiStrToUpper(&upper);
+    ASSERT_EQ(lower.size(), n);
+    ASSERT_EQ(upper.size(), n);
+    for (size_t i = 0; i < n; ++i) {
+      const auto c = static_cast<unsigned char>(s[i]);
+      EXPECT_EQ(turbo::ascii_tolower(c), lower[i]) << n << " " << i;
+      EXPECT_EQ(turbo::ascii_toupper(c), upper[i]) << n << " " << i;
+    }
+    EXPECT_EQ(lower, turbo::AsciiStrToLower(upper));
+  }
+}
+
+TEST(AsciiClass, MatchesCharacterPredicates) {
+  const std::pair<turbo::AsciiClass, bool (*)(unsigned char)> kClasses[] = {
+      {turbo::AsciiClass::kAlpha, turbo::ascii_isalpha},
+      {turbo::AsciiClass::kAlnum, turbo::ascii_isalnum},
+      {turbo::AsciiClass::kSpace, turbo::ascii_isspace},
+      {turbo::AsciiClass::kPunct, turbo::ascii_ispunct},
+      {turbo::AsciiClass::kBlank, turbo::ascii_isblank},
+      {turbo::AsciiClass::kCntrl, turbo::ascii_iscntrl},
+      {turbo::AsciiClass::kXDigit, turbo::ascii_isxdigit},
+      {turbo::AsciiClass::kDigit, turbo::ascii_isdigit},
+      {turbo::AsciiClass::kPrint, turbo::ascii_isprint},
+      {turbo::AsciiClass::kGraph, turbo::ascii_isgraph},
+      {turbo::AsciiClass::kUpper, turbo::ascii_isupper},
+      {turbo::AsciiClass::kLower, turbo::ascii_islower},
+      {turbo::AsciiClass::kAscii, turbo::ascii_isascii},
+  };
+
+  // Every byte value, in every lane position of a vector.
+  std::string all(256, '\0');
+  for (int i = 0; i < 256; ++i) all[i] = static_cast<char>(i);
+
+  for (const auto& cls : kClasses) {
+    for (int i = 0; i < 256; ++i) {
+      std::string one(1, static_cast<char>(i));
+      std::string padded(40, static_cast<char>(i));
+      bool expected = cls.second(static_cast<unsigned char>(i));
+      EXPECT_EQ(expected ? 1u : 0u, turbo::AsciiCountIf(one, cls.first)) << i;
+      EXPECT_EQ(expected ? 40u : 0u, turbo::AsciiCountIf(padded, cls.first))
+          << i;
+    }
+
+    for (size_t n = 0; n < 100; ++n) {
+      std::string s = n == 0 ? std::string() : all.substr(n, n);
+      if (n > 50) s = MakeBytes(n, static_cast<unsigned>(n));
+      size_t count = 0;
+      size_t first_of = turbo::string_view::npos;
+      size_t first_not = turbo::string_view::npos;
+      size_t last_of = turbo::string_view::npos;
+      size_t last_not = turbo::string_view::npos;
+      for (size_t i = 0; i < s.size(); ++i) {
+        if (cls.second(static_cast<unsigned char>(s[i]))) {
+          ++count;
+          if (first_of == turbo::string_view::npos) first_of = i;
+          last_of = i;
+        } else {
+          if (first_not == turbo::string_view::npos) first_not = i;
+          last_not = i;
+        }
+      }
+      EXPECT_EQ(count, turbo::AsciiCountIf(s, cls.first)) << n;
+      EXPECT_EQ(first_of, turbo::AsciiFindFirstOf(s, cls.first)) << n;
+      EXPECT_EQ(first_not, turbo::AsciiFindFirstNotOf(s, cls.first)) << n;
+      EXPECT_EQ(last_of, turbo::AsciiFindLastOf(s, cls.first)) << n;
+      EXPECT_EQ(last_not, turbo::AsciiFindLastNotOf(s, cls.first)) << n;
+    }
+  }
+}
+
+TEST(AsciiClass, FindAroundVectorBoundaries) {
+  for (size_t n = 1; n < 80; ++n) {
+    for (size_t pos = 0; pos < n; ++pos) {
+      std::string s(n, 'a');
+      s[pos] = '7';
+      EXPECT_EQ(pos, turbo::AsciiFindFirstOf(s, turbo::AsciiClass::kDigit));
+      EXPECT_EQ(pos, turbo::AsciiFindLastOf(s, turbo::AsciiClass::kDigit));
+      EXPECT_EQ(pos, turbo::AsciiFindFirstNotOf(s, turbo::AsciiClass::kLower));
+      EXPECT_EQ(pos, turbo::AsciiFindLastNotOf(s, turbo::AsciiClass::kLower));
+      EXPECT_EQ(1u, turbo::AsciiCountIf(s, turbo::AsciiClass::kDigit));
+    }
+  }
+}
+
 TEST(StripLeadingAsciiWhitespace, FromStringView) {
   EXPECT_EQ(turbo::string_view{},
             turbo::StripLeadingAsciiWhitespace(turbo::string_view{}));
@@ -229,6 +331,9 @@ TEST(StripLeadingAsciiWhitespace, FromStringView) {
             turbo::StripLeadingAsciiWhitespace({"\t  \n\f\r\n\vfoo foo\n "}));
   EXPECT_EQ(turbo::string_view{}, turbo::StripLeadingAsciiWhitespace(
                                      {"\t  \n\f\r\v\n\t  \n\f\r\v\n"}));
+  const std::string long_ws(70, ' ');
+  EXPECT_EQ("foo ", turbo::StripLeadingAsciiWhitespace(long_ws + "foo "));
+  EXPECT_EQ(turbo::string_view{}, turbo::StripLeadingAsciiWhitespace(long_ws));
 }
 
 template<typename Str>
@@ -268,6 +373,9 @@ TEST(StripTrailingAsciiWhitespace, FromStringView) {
             turbo::StripTrailingAsciiWhitespace({" \nfoo foo\t  \n\f\r\n\v"}));
   EXPECT_EQ(turbo::string_view{}, turbo::StripTrailingAsciiWhitespace(
                                      {"\t  \n\f\r\v\n\t  \n\f\r\v\n"}));
+  const std::string long_ws(70, '\t');
+  EXPECT_EQ(" foo", turbo::StripTrailingAsciiWhitespace(" foo" + long_ws));
+  EXPECT_EQ(turbo::string_view{}, turbo::StripTrailingAsciiWhitespace(long_ws));
 }
 
 template <typename String>
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <ios>
 #include <iostream>
@@ -37,6 +38,7 @@
 #include "turbo/platform/port.h"
 #include "turbo/strings/cord_buffer.h"
 #include "turbo/strings/escaping.h"
+#include "turbo/strings/internal/char_map.h"
 #include "turbo/strings/internal/cord_data_edge.h"
 #include "turbo/strings/internal/cord_internal.h"
 #include "turbo/strings/internal/cord_rep_btree.h"
@@ -1037,6 +1039,117 @@ bool Cord::EndsWith(const Cord& rhs) const {
   return tmp.EqualsImpl(rhs, rhs_size);
 }
 
+// --------------------------------------------------------------------
+// Search.
+
+namespace {
+
+// Chunks shorter than this are searched with memchr() and memcmp() only.
+constexpr size_t kMinMemmemChunk = 256;
+
+// Returns the first occurrence of `needle` entirely within `chunk`, or nullptr.
+inline const char* FindInChunk(turbo::string_view chunk,
+                               turbo::string_view needle) {
+#if defined(__GLIBC__)
+  // glibc implements memmem() with the two-way algorithm and vectorized
+  // first-byte scanning.
+  return static_cast<const char*>(
+      ::memmem(chunk.data(), chunk.size(), needle.data(), needle.size()));
+#else
+  size_t pos = chunk.find(needle);
+  return pos == turbo::string_view::npos ? nullptr : chunk.data() + pos;
+#endif
+}
+
+}  // namespace
+
+Cord::CharIterator Cord::FindImpl(CharIterator it, turbo::string_view needle) {
+  assert(!needle.empty());
+  const size_t n = needle.size();
+  ChunkIterator& chunks = it.chunk_iterator_;
+  while (chunks.bytes_remaining_ >= n) {
+    turbo::string_view chunk = *chunks;
+
+    // Occurrences contained in this chunk come first. Short chunks are
+    // scanned below instead, as memmem() has a setup cost per call.
+    size_t pos = 0;
+    if (chunk.size() >= kMinMemmemChunk && chunk.size() >= n) {
+      if (const char* hit = FindInChunk(chunk, needle)) {
+        chunks.RemoveChunkPrefix(static_cast<size_t>(hit - chunk.data()));
+        return it;
+      }
+      pos = chunk.size() - n + 1;
+    }
+
+    // Then candidates starting at `pos`, which may continue into the
+    // following chunks.
+    for (; pos < chunk.size(); ++pos) {
+      const void* first = std::memchr(chunk.data() + pos, needle[0],
+                                      chunk.size() - pos);
+      if (first == nullptr) break;
+      pos = static_cast<size_t>(static_cast<const char*>(first) - chunk.data());
+      if (chunks.bytes_remaining_ - pos < n) return CharIterator();
+      if (pos + n <= chunk.size()) {
+        if (std::memcmp(chunk.data() + pos, needle.data(), n) == 0) {
+          chunks.RemoveChunkPrefix(pos);
+          return it;
+        }
+        continue;
+      }
+
+      turbo::string_view head = chunk.substr(pos);
+      if (std::memcmp(head.data(), needle.data(), head.size()) != 0) continue;
+      turbo::string_view rest = needle.substr(head.size());
+      ChunkIterator next = chunks;
+      ++next;
+      while (!rest.empty()) {
+        turbo::string_view piece = next->substr(0, rest.size());
+        if (std::memcmp(piece.data(), rest.data(), piece.size()) != 0) break;
+        rest.remove_prefix(piece.size());
+        if (!rest.empty()) ++next;
+      }
+      if (rest.empty()) {
+        chunks.RemoveChunkPrefix(pos);
+        return it;
+      }
+    }
+    ++chunks;
+  }
+  return CharIterator();
+}
+
+Cord::CharIterator Cord::FindFirstOfImpl(CharIterator it,
+                                         turbo::string_view chars) {
+  ChunkIterator& chunks = it.chunk_iterator_;
+  if (chars.size() == 1) {
+    while (chunks.bytes_remaining_ > 0) {
+      turbo::string_view chunk = *chunks;
+      if (const void* hit = std::memchr(chunk.data(), chars[0], chunk.size())) {
+        chunks.RemoveChunkPrefix(
+            static_cast<size_t>(static_cast<const char*>(hit) - chunk.data()));
+        return it;
+      }
+      ++chunks;
+    }
+    return it;
+  }
+
+  const strings_internal::Charmap set(chars.data(),
+                                      static_cast<int>(chars.size()));
+  if (set.IsZero()) return CharIterator();
+  while (chunks.bytes_remaining_ > 0) {
+    turbo::string_view chunk = *chunks;
+    for (size_t i = 0; i < chunk.size(); ++i) {
+      if (set.contains(static_cast<unsigned char>(chunk[i]))) {
+        chunks.RemoveChunkPrefix(i);
+        return it;
+      }
+    }
+    ++chunks;
+  }
+  return it;
+}
+
 // --------------------------------------------------------------------
 // Misc.
 
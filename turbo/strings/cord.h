@@ -697,6 +697,25 @@ class Cord {
   //   }
   CharRange Chars() const;
 
+  // Cord::Find()
+  //
+  // Returns an iterator to the first occurrence of `needle` within the Cord,
+  // or `char_end()` if there is none. Occurrences spanning chunk boundaries are
+  // found without flattening the Cord. An empty `needle` matches at
+  // `char_begin()`.
+  CharIterator Find(turbo::string_view needle) const;
+
+  // Cord::Contains()
+  //
+  // Determines whether the Cord contains the passed string data `needle`.
+  bool Contains(turbo::string_view needle) const;
+
+  // Cord::FindFirstOf()
+  //
+  // Returns an iterator to the first character of the Cord that is contained
+  // in `chars`, or `char_end()` if there is none.
+  CharIterator FindFirstOf(turbo::string_view chars) const;
+
   // Cord::operator[]
   //
   // Gets the "i"th character of the Cord and returns it, provided that
@@ -781,6 +800,7 @@ class Cord {
   // public API call causing the cord to be created.
   explicit Cord(turbo::string_view src, MethodIdentifier method);
 
+  friend class CordReader;
   friend class CordTestPeer;
   friend bool operator==(const Cord& lhs, const Cord& rhs);
   friend bool operator==(const Cord& lhs, turbo::string_view rhs);
@@ -795,6 +815,19 @@ class Cord {
   // called by Flatten() when the cord was not already flat.
   turbo::string_view FlattenSlowPath();
 
+  // Returns the number of bytes from `it` to the end of the Cord.
+  static size_t BytesRemaining(const CharIterator& it) {
+    return it.chunk_iterator_.bytes_remaining_;
+  }
+
+  // Returns an iterator to the first occurrence of `needle` at or after `it`,
+  // or `char_end()` if there is none. `needle` must not be empty.
+  static CharIterator FindImpl(CharIterator it, turbo::string_view needle);
+
+  // Returns an iterator to the first character at or after `it` contained in
+  // `chars`, or `char_end()` if there is none.
+  static CharIterator FindFirstOfImpl(CharIterator it, turbo::string_view chars);
+
   // Actual cord contents are hidden inside the following simple
   // class so that we can isolate the bulk of cord.cc from changes
   // to the representation.
@@ -1557,6 +1590,19 @@ inline Cord::CharIterator Cord::CharRange::end() const {
 
 inline Cord::CharRange Cord::Chars() const { return CharRange(this); }
 
+inline Cord::CharIterator Cord::Find(turbo::string_view needle) const {
+  if (needle.empty()) return char_begin();
+  return FindImpl(char_begin(), needle);
+}
+
+inline bool Cord::Contains(turbo::string_view needle) const {
+  return Find(needle) != char_end();
+}
+
+inline Cord::CharIterator Cord::FindFirstOf(turbo::string_view chars) const {
+  return FindFirstOfImpl(char_begin(), chars);
+}
+
 inline void Cord::ForEachChunk(
     turbo::FunctionRef<void(turbo::string_view)> callback) const {
   turbo::cord_internal::CordRep* rep = contents_.tree();
@@ -0,0 +1,200 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord.h"
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+// The representations benchmarked. Ring buffers are not listed as the public
+// Cord API no longer creates them.
+enum Shape {
+  // Cord(std::string): a single flat, or a btree of maximum size flats.
+  kFlat,
+  // A btree of 64 byte external chunks.
+  kFragmented,
+  // A single external chunk.
+  kExternal,
+  // A flat or btree cord carrying an expected checksum.
+  kCrc,
+  // A substring of a larger external chunk.
+  kSubstring,
+};
+
+const char* ShapeName(int shape) {
+  switch (shape) {
+    case kFlat:
+      return "flat";
+    case kFragmented:
+      return "fragmented";
+    case kExternal:
+      return "external";
+    case kCrc:
+      return "crc";
+    case kSubstring:
+      return "substring";
+  }
+  return "?";
+}
+
+turbo::Cord MakeShape(int shape, size_t size) {
+  std::string data(size, 'x');
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>('a' + i % 26);
+  switch (shape) {
+    case kFlat:
+      return turbo::Cord(data);
+    case kFragmented: {
+      std::vector<std::string> pieces;
+      for (size_t i = 0; i < size; i += 64) pieces.push_back(data.substr(i, 64));
+      return turbo::MakeFragmentedCord(pieces);
+    }
+    case kExternal:
+      return turbo::MakeFragmentedCord({data});
+    case kCrc: {
+      turbo::Cord cord(data);
+      cord.SetExpectedChecksum(1);
+      return cord;
+    }
+    case kSubstring: {
+      turbo::Cord cord = turbo::MakeFragmentedCord({"0123456789" + data});
+      return cord.Subcord(10, size);
+    }
+  }
+  return turbo::Cord();
+}
+
+void ShapeArgs(benchmark::internal::Benchmark* b) {
+  for (int shape : {kFlat, kFragmented, kExternal, kCrc, kSubstring}) {
+    for (int size : {1 << 10, 64 << 10, 1 << 20}) {
+      b->Args({shape, size});
+    }
+  }
+  b->ArgNames({"shape", "size"});
+}
+
+turbo::Cord MakeShape(benchmark::State& state) {
+  state.SetLabel(ShapeName(static_cast<int>(state.range(0))));
+  return MakeShape(static_cast<int>(state.range(0)),
+                   static_cast<size_t>(state.range(1)));
+}
+
+void SetBytes(benchmark::State& state) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(1));
+}
+
+void BM_AppendCord(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  for (auto _ : state) {
+    turbo::Cord cord(src);
+    cord.Append(src);
+    benchmark::DoNotOptimize(cord);
+  }
+}
+BENCHMARK(BM_AppendCord)->Apply(ShapeArgs);
+
+void BM_AppendSmallStrings(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  const std::string piece(20, 'p');
+  for (auto _ : state) {
+    turbo::Cord cord(src);
+    for (int i = 0; i < 100; ++i) cord.Append(piece);
+    benchmark::DoNotOptimize(cord);
+  }
+}
+BENCHMARK(BM_AppendSmallStrings)->Apply(ShapeArgs);
+
+void BM_PrependSmallStrings(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  const std::string piece(20, 'p');
+  for (auto _ : state) {
+    turbo::Cord cord(src);
+    for (int i = 0; i < 100; ++i) cord.Prepend(piece);
+    benchmark::DoNotOptimize(cord);
+  }
+}
+BENCHMARK(BM_PrependSmallStrings)->Apply(ShapeArgs);
+
+void BM_Subcord(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  const size_t size = src.size();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(src.Subcord(size / 4, size / 2));
+  }
+}
+BENCHMARK(BM_Subcord)->Apply(ShapeArgs);
+
+void BM_IterateChunks(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  for (auto _ : state) {
+    size_t total = 0;
+    for (turbo::string_view chunk : src.Chunks()) total += chunk.size();
+    benchmark::DoNotOptimize(total);
+  }
+  SetBytes(state);
+}
+BENCHMARK(BM_IterateChunks)->Apply(ShapeArgs);
+
+void BM_IterateChars(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  for (auto _ : state) {
+    unsigned sum = 0;
+    for (char c : src.Chars()) sum += static_cast<unsigned char>(c);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetBytes(state);
+}
+BENCHMARK(BM_IterateChars)->Apply(ShapeArgs);
+
+// Compares against an equal cord with a different chunk layout, so the
+// comparison has to walk both trees.
+void BM_Compare(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  const turbo::Cord other =
+      MakeShape(state.range(0) == kFragmented ? kFlat : kFragmented,
+                static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(src.Compare(other));
+  }
+  SetBytes(state);
+}
+BENCHMARK(BM_Compare)->Apply(ShapeArgs);
+
+void BM_Flatten(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  for (auto _ : state) {
+    turbo::Cord cord(src);
+    benchmark::DoNotOptimize(cord.Flatten());
+  }
+  SetBytes(state);
+}
+BENCHMARK(BM_Flatten)->Apply(ShapeArgs);
+
+void BM_CopyToString(benchmark::State& state) {
+  const turbo::Cord src = MakeShape(state);
+  std::string dst;
+  for (auto _ : state) {
+    turbo::CopyCordToString(src, &dst);
+    benchmark::DoNotOptimize(dst);
+  }
+  SetBytes(state);
+}
+BENCHMARK(BM_CopyToString)->Apply(ShapeArgs);
+
+}  // namespace
@@ -0,0 +1,522 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord_compression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#include "turbo/base/bits.h"
+#include "turbo/base/endian.h"
+#include "turbo/base/internal/raw_logging.h"
+#include "turbo/strings/internal/cord_rep_flat.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr uint32_t kFrameMagic = 0x315a4354;  // "TCZ1"
+constexpr size_t kFrameHeaderSize = 5;
+constexpr size_t kBlockHeaderSize = 8;
+constexpr size_t kEndMarkerSize = 4;
+
+// -----------------------------------------------------------------------------
+// LZ4-style block codec
+// -----------------------------------------------------------------------------
+//
+// Produces the LZ4 block format: a sequence of (token, literals, offset, match
+// length) records. The token holds 4 bits of literal length and 4 bits of match
+// length, each extended by 255-valued bytes when saturated. The final record
+// carries literals only.
+
+constexpr size_t kMinMatch = 4;
+// The last 5 bytes of a block are always literals.
+constexpr size_t kLastLiterals = 5;
+// No match may start within the last 12 bytes of a block.
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 12;
+// After 2^kSkipTrigger consecutive misses the search stride grows by one, so
+// incompressible input is skipped over quickly.
+constexpr int kSkipTrigger = 6;
+
+inline uint32_t Load32(const char* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Load64(const char* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t HashSequence(uint32_t v) {
+  return (v * 2654435761u) >> (32 - kHashLog);
+}
+
+// Returns the length of the common prefix of `a` and `b`, looking at no more
+// than `limit` bytes.
+inline size_t CommonPrefix(const char* a, const char* b, size_t limit) {
+  size_t n = 0;
+  while (n + 8 <= limit) {
+    uint64_t diff = Load64(a + n) ^ Load64(b + n);
+    if (diff != 0) {
+#ifdef TURBO_IS_LITTLE_ENDIAN
+      return n + static_cast<size_t>(turbo::countr_zero(diff)) / 8;
+#else
+      break;
+#endif
+    }
+    n += 8;
+  }
+  while (n < limit && a[n] == b[n]) ++n;
+  return n;
+}
+
+inline char* WriteLengthExtension(char* op, size_t len) {
+  while (len >= 255) {
+    *op++ = static_cast<char>(255);
+    len -= 255;
+  }
+  *op++ = static_cast<char>(len);
+  return op;
+}
+
+// Writes one record and returns the new output position. `match_len` of zero
+// denotes the final, literal-only record.
+inline char* WriteSequence(char* op, const char* literals, size_t literal_len,
+                           size_t offset, size_t match_len) {
+  char* token = op++;
+  unsigned char t;
+  if (literal_len >= 15) {
+    t = 15 << 4;
+    op = WriteLengthExtension(op, literal_len - 15);
+  } else {
+    t = static_cast<unsigned char>(literal_len << 4);
+  }
+  memcpy(op, literals, literal_len);
+  op += literal_len;
+  if (match_len != 0) {
+    *op++ = static_cast<char>(offset & 0xff);
+    *op++ = static_cast<char>(offset >> 8);
+    size_t ml = match_len - kMinMatch;
+    if (ml >= 15) {
+      t |= 15;
+      op = WriteLengthExtension(op, ml - 15);
+    } else {
+      t |= static_cast<unsigned char>(ml);
+    }
+  }
+  *token = static_cast<char>(t);
+  return op;
+}
+
+size_t Lz4Compress(turbo::string_view src, char* dst) {
+  const char* const base = src.data();
+  const size_t n = src.size();
+  char* op = dst;
+  size_t anchor = 0;
+
+  if (n > kMatchFindLimit) {
+    uint32_t table[1 << kHashLog];
+    memset(table, 0, sizeof(table));
+    const size_t match_limit = n - kLastLiterals;
+    const size_t find_limit = n - kMatchFindLimit;
+
+    size_t ip = 1;
+    while (ip <= find_limit) {
+      // Look for a 4-byte match.
+      size_t ref = 0;
+      size_t misses = size_t{1} << kSkipTrigger;
+      bool found = false;
+      while (ip <= find_limit) {
+        const uint32_t seq = Load32(base + ip);
+        const uint32_t h = HashSequence(seq);
+        ref = table[h];
+        table[h] = static_cast<uint32_t>(ip);
+        if (ip - ref <= kMaxOffset && ref < ip && Load32(base + ref) == seq) {
+          found = true;
+          break;
+        }
+        ip += misses++ >> kSkipTrigger;
+      }
+      if (!found) break;
+
+      // Extend the match backwards over pending literals, then forwards.
+      while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1]) {
+        --ip;
+        --ref;
+      }
+      const size_t len =
+          kMinMatch + CommonPrefix(base + ip + kMinMatch, base + ref + kMinMatch,
+                                   match_limit - ip - kMinMatch);
+
+      op = WriteSequence(op, base + anchor, ip - anchor, ip - ref, len);
+      ip += len;
+      anchor = ip;
+      if (ip <= find_limit) {
+        table[HashSequence(Load32(base + ip - 2))] =
+            static_cast<uint32_t>(ip - 2);
+      }
+    }
+  }
+  op = WriteSequence(op, base + anchor, n - anchor, 0, 0);
+  return static_cast<size_t>(op - dst);
+}
+
+// Reads a length extension; returns false if the input ends prematurely.
+inline bool ReadLengthExtension(const unsigned char*& ip,
+                                const unsigned char* iend, size_t* len) {
+  unsigned char b;
+  do {
+    if (ip == iend) return false;
+    b = *ip++;
+    *len += b;
+  } while (b == 255);
+  return true;
+}
+
+bool Lz4Decompress(turbo::string_view src, char* dst, size_t dst_size) {
+  const unsigned char* ip = reinterpret_cast<const unsigned char*>(src.data());
+  const unsigned char* const iend = ip + src.size();
+  char* op = dst;
+  char* const oend = dst + dst_size;
+
+  for (;;) {
+    if (ip == iend) return false;
+    const unsigned token = *ip++;
+
+    size_t literal_len = token >> 4;
+    if (literal_len == 15 && !ReadLengthExtension(ip, iend, &literal_len)) {
+      return false;
+    }
+    if (literal_len > static_cast<size_t>(iend - ip) ||
+        literal_len > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    memcpy(op, ip, literal_len);
+    op += literal_len;
+    ip += literal_len;
+    if (ip == iend) return op == oend;
+
+    if (iend - ip < 2) return false;
+    const size_t offset = static_cast<size_t>(ip[0]) |
+                          (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+    size_t match_len = token & 15;
+    if (match_len == 15 && !ReadLengthExtension(ip, iend, &match_len)) {
+      return false;
+    }
+    match_len += kMinMatch;
+    if (match_len > static_cast<size_t>(oend - op)) return false;
+
+    const char* match = op - offset;
+    if (offset >= match_len) {
+      memcpy(op, match, match_len);
+    } else {
+      // Overlapping copy of a periodic pattern: each step copies everything
+      // produced so far, doubling the amount while keeping source and
+      // destination disjoint.
+      size_t copied = 0;
+      while (copied < match_len) {
+        size_t n = (std::min)(offset + copied, match_len - copied);
+        memcpy(op + copied, match, n);
+        copied += n;
+      }
+    }
+    op += match_len;
+  }
+}
+
+class Lz4Codec final : public CordCodec {
+ public:
+  CordCodecId id() const override { return CordCodecId::kLz4; }
+
+  size_t MaxCompressedLength(size_t n) const override {
+    return n + n / 255 + 16;
+  }
+
+  size_t Compress(turbo::string_view src, char* dst) const override {
+    return Lz4Compress(src, dst);
+  }
+
+  bool Decompress(turbo::string_view src, char* dst,
+                  size_t dst_size) const override {
+    return Lz4Decompress(src, dst, dst_size);
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Codec registry
+// -----------------------------------------------------------------------------
+
+std::atomic<const CordCodec*> codec_registry[256];
+
+const CordCodec* BuiltinLz4Codec() {
+  static const CordCodec* codec = new Lz4Codec;
+  return codec;
+}
+
+// Returns a buffer with room for at least `n` bytes.
+CordBuffer CreateBuffer(size_t n) {
+  if (n <= CordBuffer::kDefaultLimit) {
+    return CordBuffer::CreateWithDefaultLimit(n);
+  }
+  assert(n + cord_internal::kFlatOverhead <= CordBuffer::kCustomLimit);
+  // Ask for the whole block so the allocator cannot round the capacity down.
+  size_t block = turbo::bit_ceil(n + cord_internal::kFlatOverhead);
+  return CordBuffer::CreateWithCustomLimit(block, block);
+}
+
+// Copies the first `n` bytes of `src` to `dst`.
+void CopyPrefix(const turbo::Cord& src, size_t n, char* dst) {
+  for (turbo::string_view chunk : src.Chunks()) {
+    if (n == 0) break;
+    size_t len = (std::min)(n, chunk.size());
+    memcpy(dst, chunk.data(), len);
+    dst += len;
+    n -= len;
+  }
+}
+
+}  // namespace
+
+void RegisterCordCodec(const CordCodec* codec) {
+  codec_registry[static_cast<uint8_t>(codec->id())].store(
+      codec, std::memory_order_release);
+}
+
+const CordCodec* GetCordCodec(CordCodecId id) {
+  const CordCodec* codec =
+      codec_registry[static_cast<uint8_t>(id)].load(std::memory_order_acquire);
+  if (codec == nullptr && id == CordCodecId::kLz4) codec = BuiltinLz4Codec();
+  return codec;
+}
+
+// -----------------------------------------------------------------------------
+// CordCompressor
+// -----------------------------------------------------------------------------
+
+constexpr size_t CordCompressor::kMaxBlockSize;
+
+CordCompressor::CordCompressor(CordCodecId codec, size_t block_size)
+    : codec_(GetCordCodec(codec)),
+      block_size_((std::max)(size_t{1}, (std::min)(block_size, kMaxBlockSize))) {
+  TURBO_RAW_CHECK(codec_ != nullptr, "CordCompressor: codec not registered");
+  Reserve(kFrameHeaderSize);
+  char* p = buffer_.data() + buffer_.length();
+  little_endian::Store32(p, kFrameMagic);
+  p[4] = static_cast<char>(codec);
+  Commit(kFrameHeaderSize);
+}
+
+void CordCompressor::Reserve(size_t n) {
+  if (buffer_.capacity() - buffer_.length() < n) {
+    FlushBuffer();
+    buffer_ = CreateBuffer(n);
+  }
+}
+
+void CordCompressor::Commit(size_t n) { buffer_.IncreaseLengthBy(n); }
+
+void CordCompressor::FlushBuffer() {
+  if (buffer_.length() != 0) output_.Append(std::move(buffer_));
+  buffer_ = CordBuffer();
+}
+
+void CordCompressor::CompressBlock(turbo::string_view block) {
+  Reserve(kBlockHeaderSize + codec_->MaxCompressedLength(block.size()));
+  char* header = buffer_.data() + buffer_.length();
+  char* payload = header + kBlockHeaderSize;
+  size_t stored = codec_->Compress(block, payload);
+  if (stored >= block.size()) {
+    // Incompressible; keep the raw bytes.
+    memcpy(payload, block.data(), block.size());
+    stored = block.size();
+  }
+  little_endian::Store32(header, static_cast<uint32_t>(block.size()));
+  little_endian::Store32(header + 4, static_cast<uint32_t>(stored));
+  Commit(kBlockHeaderSize + stored);
+}
+
+void CordCompressor::Write(const turbo::Cord& src) {
+  for (turbo::string_view chunk : src.Chunks()) Write(chunk);
+}
+
+void CordCompressor::Write(turbo::string_view src) {
+  while (!src.empty()) {
+    if (staging_.empty() && src.size() >= block_size_) {
+      // Whole block available in place: no copy needed.
+      CompressBlock(src.substr(0, block_size_));
+      src.remove_prefix(block_size_);
+      continue;
+    }
+    size_t n = (std::min)(block_size_ - staging_.size(), src.size());
+    staging_.append(src.data(), n);
+    src.remove_prefix(n);
+    if (staging_.size() == block_size_) {
+      CompressBlock(staging_);
+      staging_.clear();
+    }
+  }
+}
+
+void CordCompressor::Flush(turbo::Cord* dst) {
+  if (!staging_.empty()) {
+    CompressBlock(staging_);
+    staging_.clear();
+  }
+  FlushBuffer();
+  dst->Append(std::move(output_));
+  output_.Clear();
+}
+
+turbo::Cord CordCompressor::Finish() {
+  if (!staging_.empty()) {
+    CompressBlock(staging_);
+    staging_.clear();
+  }
+  Reserve(kEndMarkerSize);
+  little_endian::Store32(buffer_.data() + buffer_.length(), 0);
+  Commit(kEndMarkerSize);
+  FlushBuffer();
+  return std::move(output_);
+}
+
+// -----------------------------------------------------------------------------
+// CordDecompressor
+// -----------------------------------------------------------------------------
+
+turbo::Status CordDecompressor::Write(const turbo::Cord& src) {
+  if (!status_.ok()) return status_;
+  if (finished_) {
+    if (!src.empty()) status_ = DataLossError("data after end of frame");
+    return status_;
+  }
+  pending_.Append(src);
+  status_ = Process();
+  return status_;
+}
+
+turbo::Status CordDecompressor::Process() {
+  if (!header_done_) {
+    if (pending_.size() < kFrameHeaderSize) return turbo::OkStatus();
+    char header[kFrameHeaderSize];
+    CopyPrefix(pending_, kFrameHeaderSize, header);
+    if (little_endian::Load32(header) != kFrameMagic) {
+      return DataLossError("not a compressed cord frame");
+    }
+    codec_ = GetCordCodec(static_cast<CordCodecId>(header[4]));
+    if (codec_ == nullptr) {
+      return UnimplementedError("compressed cord uses an unregistered codec");
+    }
+    pending_.RemovePrefix(kFrameHeaderSize);
+    header_done_ = true;
+  }
+
+  while (!finished_) {
+    if (pending_.size() < kEndMarkerSize) break;
+    char header[kBlockHeaderSize];
+    CopyPrefix(pending_, kEndMarkerSize, header);
+    const size_t raw_size = little_endian::Load32(header);
+    if (raw_size == 0) {
+      pending_.RemovePrefix(kEndMarkerSize);
+      finished_ = true;
+      break;
+    }
+    if (raw_size > CordCompressor::kMaxBlockSize) {
+      return DataLossError("compressed cord block too large");
+    }
+    if (pending_.size() < kBlockHeaderSize) break;
+    CopyPrefix(pending_, kBlockHeaderSize, header);
+    const size_t stored_size = little_endian::Load32(header + 4);
+    if (stored_size > raw_size) {
+      return DataLossError("corrupt compressed cord block header");
+    }
+    if (pending_.size() < kBlockHeaderSize + stored_size) break;
+    pending_.RemovePrefix(kBlockHeaderSize);
+    turbo::Status status = DecodeBlock(raw_size, stored_size);
+    if (!status.ok()) return status;
+    pending_.RemovePrefix(stored_size);
+  }
+
+  if (finished_ && !pending_.empty()) {
+    return DataLossError("data after end of frame");
+  }
+  return turbo::OkStatus();
+}
+
+turbo::Status CordDecompressor::DecodeBlock(size_t raw_size,
+                                            size_t stored_size) {
+  // Decode straight from the input chunk when the payload is contiguous,
+  // otherwise gather it first. An empty payload may end the input written so
+  // far, leaving no chunk to look at.
+  turbo::string_view payload;
+  if (!pending_.empty()) payload = *pending_.chunk_begin();
+  if (payload.size() >= stored_size) {
+    payload = payload.substr(0, stored_size);
+  } else {
+    staging_.resize(stored_size);
+    CopyPrefix(pending_, stored_size, &staging_[0]);
+    payload = staging_;
+  }
+
+  CordBuffer buffer = CreateBuffer(raw_size);
+  if (stored_size == raw_size) {
+    memcpy(buffer.data(), payload.data(), raw_size);
+  } else if (!codec_->Decompress(payload, buffer.data(), raw_size)) {
+    return DataLossError("corrupt compressed cord block");
+  }
+  buffer.SetLength(raw_size);
+  output_.Append(std::move(buffer));
+  return turbo::OkStatus();
+}
+
+void CordDecompressor::Flush(turbo::Cord* dst) {
+  dst->Append(std::move(output_));
+  output_.Clear();
+}
+
+turbo::Status CordDecompressor::Finish(turbo::Cord* dst) {
+  if (status_.ok() && !finished_) {
+    status_ = DataLossError("truncated compressed cord");
+  }
+  if (!status_.ok()) return status_;
+  Flush(dst);
+  return turbo::OkStatus();
+}
+
+turbo::Cord CompressCord(const turbo::Cord& src, CordCodecId codec) {
+  CordCompressor compressor(codec);
+  compressor.Write(src);
+  return compressor.Finish();
+}
+
+turbo::Status DecompressCord(const turbo::Cord& src, turbo::Cord* dst) {
+  CordDecompressor decompressor;
+  turbo::Status status = decompressor.Write(src);
+  if (!status.ok()) return status;
+  return decompressor.Finish(dst);
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
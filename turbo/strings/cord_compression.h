@@ -0,0 +1,221 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: cord_compression.h
+// -----------------------------------------------------------------------------
+//
+// This file defines streaming compression adapters operating directly on
+// `turbo::Cord` values. Input is consumed chunk by chunk through
+// `Cord::Chunks()` and output is written straight into `CordBuffer`s which are
+// then appended to the result, so neither side is ever flattened.
+//
+// Data is cut into independent blocks of at most `block_size` bytes, each
+// compressed with a `CordCodec`. Input chunks that hold a whole block are
+// compressed in place; smaller fragments are gathered into a single bounded
+// staging block first. A built-in LZ4-style codec is always available. Other
+// codecs (zstd, snappy, ...) can be plugged in through `RegisterCordCodec()`
+// by applications that link them.
+//
+// Example:
+//
+//   turbo::Cord compressed = turbo::CompressCord(payload);
+//   turbo::Cord restored;
+//   turbo::Status status = turbo::DecompressCord(compressed, &restored);
+//
+// The framed format is:
+//
+//   frame   := magic:u32 codec:u8 block* end
+//   block   := raw_size:u32 stored_size:u32 payload[stored_size]
+//   end     := 0:u32
+//
+// All integers are little endian. A block whose `stored_size` equals its
+// `raw_size` is stored uncompressed.
+
+#ifndef TURBO_STRINGS_CORD_COMPRESSION_H_
+#define TURBO_STRINGS_CORD_COMPRESSION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "turbo/base/status.h"
+#include "turbo/platform/port.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_buffer.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// CordCodecId
+//
+// Identifies the block codec used in a compressed frame. The id is recorded in
+// the frame so that `CordDecompressor` can pick the matching codec.
+enum class CordCodecId : uint8_t {
+  kLz4 = 1,
+  // Reserved for applications linking the respective libraries; see
+  // `RegisterCordCodec()`.
+  kSnappy = 2,
+  kZstd = 3,
+};
+
+// CordCodec
+//
+// Interface of a block codec. Implementations must be thread-safe, as a single
+// registered instance is shared by all compressors and decompressors.
+class CordCodec {
+ public:
+  virtual ~CordCodec() = default;
+
+  // Returns the id recorded in frames produced with this codec.
+  virtual CordCodecId id() const = 0;
+
+  // Returns the maximum number of bytes `Compress()` may write for an input of
+  // `n` bytes.
+  virtual size_t MaxCompressedLength(size_t n) const = 0;
+
+  // Compresses `src` into `dst`, which holds at least
+  // `MaxCompressedLength(src.size())` bytes. Returns the compressed length.
+  virtual size_t Compress(turbo::string_view src, char* dst) const = 0;
+
+  // Decompresses `src` into exactly `dst_size` bytes at `dst`. Returns false if
+  // `src` is malformed or does not decompress to exactly `dst_size` bytes.
+  virtual bool Decompress(turbo::string_view src, char* dst,
+                          size_t dst_size) const = 0;
+};
+
+// RegisterCordCodec()
+//
+// Makes `codec` available under `codec->id()`, replacing any previous codec
+// registered for that id. `codec` must outlive all uses. The built-in
+// `CordCodecId::kLz4` codec is registered by default.
+void RegisterCordCodec(const CordCodec* codec);
+
+// GetCordCodec()
+//
+// Returns the codec registered for `id`, or nullptr if there is none.
+const CordCodec* GetCordCodec(CordCodecId id);
+
+// CordCompressor
+//
+// Produces a compressed frame incrementally. Feed data with `Write()` and
+// collect the result with `Finish()`:
+//
+//   turbo::CordCompressor compressor;
+//   for (const turbo::Cord& part : parts) compressor.Write(part);
+//   turbo::Cord compressed = compressor.Finish();
+//
+// Output produced so far can also be drained with `Flush()`, which is useful
+// when streaming a frame onto the wire. A compressor is not thread-safe.
+class CordCompressor {
+ public:
+  // Maximum, and default, amount of uncompressed data per block. Chosen so
+  // that a decoded block exactly fills a 32 KiB cord buffer.
+  static constexpr size_t kMaxBlockSize = CordBuffer::MaximumPayload(32 << 10);
+
+  // Creates a compressor using the codec registered for `codec`, which must
+  // exist. `block_size` is clamped to [1, kMaxBlockSize].
+  explicit CordCompressor(CordCodecId codec = CordCodecId::kLz4,
+                          size_t block_size = kMaxBlockSize);
+
+  CordCompressor(const CordCompressor&) = delete;
+  CordCompressor& operator=(const CordCompressor&) = delete;
+
+  // Adds `src` to the frame.
+  void Write(const turbo::Cord& src);
+  void Write(turbo::string_view src);
+
+  // Compresses any staged input and moves all complete output to `dst`.
+  // The frame is not terminated; call `Finish()` for that.
+  void Flush(turbo::Cord* dst);
+
+  // Terminates the frame and returns all output not yet flushed. The
+  // compressor must not be used afterwards.
+  turbo::Cord Finish();
+
+ private:
+  void CompressBlock(turbo::string_view block);
+  void Reserve(size_t n);
+  void Commit(size_t n);
+  void FlushBuffer();
+
+  const CordCodec* codec_;
+  size_t block_size_;
+  std::string staging_;
+  turbo::CordBuffer buffer_;
+  turbo::Cord output_;
+};
+
+// CordDecompressor
+//
+// Decodes a frame produced by `CordCompressor`. The compressed input may be
+// fed in arbitrary pieces; complete blocks are decoded as soon as they are
+// available:
+//
+//   turbo::CordDecompressor decompressor;
+//   while (...) {
+//     turbo::Status status = decompressor.Write(next_piece);
+//     if (!status.ok()) return status;
+//   }
+//   turbo::Cord plain;
+//   return decompressor.Finish(&plain);
+//
+// A decompressor is not thread-safe.
+class CordDecompressor {
+ public:
+  CordDecompressor() = default;
+
+  CordDecompressor(const CordDecompressor&) = delete;
+  CordDecompressor& operator=(const CordDecompressor&) = delete;
+
+  // Adds compressed input. Returns an error once the input is known to be
+  // malformed or uses an unregistered codec.
+  turbo::Status Write(const turbo::Cord& src);
+
+  // Moves all data decoded so far to `dst`.
+  void Flush(turbo::Cord* dst);
+
+  // Verifies that a complete frame has been consumed and appends any remaining
+  // decoded data to `dst`.
+  turbo::Status Finish(turbo::Cord* dst);
+
+ private:
+  turbo::Status Process();
+  turbo::Status DecodeBlock(size_t raw_size, size_t stored_size);
+
+  const CordCodec* codec_ = nullptr;
+  bool header_done_ = false;
+  bool finished_ = false;
+  turbo::Status status_;
+  turbo::Cord pending_;
+  std::string staging_;
+  turbo::Cord output_;
+};
+
+// CompressCord()
+//
+// Returns `src` compressed as a single frame.
+turbo::Cord CompressCord(const turbo::Cord& src,
+                         CordCodecId codec = CordCodecId::kLz4);
+
+// DecompressCord()
+//
+// Decodes the frame in `src` and appends the result to `dst`.
+turbo::Status DecompressCord(const turbo::Cord& src, turbo::Cord* dst);
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_STRINGS_CORD_COMPRESSION_H_
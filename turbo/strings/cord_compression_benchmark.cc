@@ -0,0 +1,113 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord_compression.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+constexpr size_t kPayloadSize = 1 << 20;
+
+std::string MakePayload() {
+  static const char* const kWords[] = {
+      "GET ",   "/api/v1/", "users",  "?id=",    "&session=", "HTTP/1.1\r\n",
+      "Host: ", "example",  ".com\r\n", "Accept: ", "*/*\r\n",   "\r\n"};
+  std::minstd_rand rng(42);
+  std::string s;
+  while (s.size() < kPayloadSize) {
+    s += kWords[rng() % 12];
+    if (rng() % 4 == 0) s += std::to_string(rng() % 100000);
+  }
+  s.resize(kPayloadSize);
+  return s;
+}
+
+// Returns the payload as a cord of `state.range(0)` sized fragments, or a
+// single flat cord when the range is 0.
+turbo::Cord MakeCord(const benchmark::State& state) {
+  const std::string payload = MakePayload();
+  const size_t piece = static_cast<size_t>(state.range(0));
+  if (piece == 0) return turbo::Cord(payload);
+  std::vector<std::string> parts;
+  for (size_t i = 0; i < payload.size(); i += piece) {
+    parts.push_back(payload.substr(i, piece));
+  }
+  return turbo::MakeFragmentedCord(parts);
+}
+
+void BM_CompressCord(benchmark::State& state) {
+  const turbo::Cord src = MakeCord(state);
+  size_t compressed_size = 0;
+  for (auto _ : state) {
+    turbo::Cord compressed = turbo::CompressCord(src);
+    compressed_size = compressed.size();
+    benchmark::DoNotOptimize(compressed);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(src.size()));
+  state.counters["ratio"] =
+      static_cast<double>(src.size()) / static_cast<double>(compressed_size);
+}
+BENCHMARK(BM_CompressCord)->Arg(0)->Arg(64)->Arg(4096)->Arg(65536);
+
+// Baseline: flatten the cord into one contiguous string before compressing,
+// as callers without cord-aware compression have to.
+void BM_FlattenThenCompress(benchmark::State& state) {
+  const turbo::Cord src = MakeCord(state);
+  for (auto _ : state) {
+    std::string flat(src);
+    turbo::Cord compressed = turbo::CompressCord(turbo::Cord(std::move(flat)));
+    benchmark::DoNotOptimize(compressed);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(src.size()));
+}
+BENCHMARK(BM_FlattenThenCompress)->Arg(0)->Arg(64)->Arg(4096)->Arg(65536);
+
+void BM_DecompressCord(benchmark::State& state) {
+  const turbo::Cord src = MakeCord(state);
+  // Re-fragment the compressed frame the same way as the input.
+  std::string frame(turbo::CompressCord(src));
+  const size_t piece = static_cast<size_t>(state.range(0));
+  turbo::Cord compressed;
+  if (piece == 0) {
+    compressed = turbo::Cord(frame);
+  } else {
+    std::vector<std::string> parts;
+    for (size_t i = 0; i < frame.size(); i += piece) {
+      parts.push_back(frame.substr(i, piece));
+    }
+    compressed = turbo::MakeFragmentedCord(parts);
+  }
+  for (auto _ : state) {
+    turbo::Cord restored;
+    if (!turbo::DecompressCord(compressed, &restored).ok()) {
+      state.SkipWithError("decompression failed");
+      break;
+    }
+    benchmark::DoNotOptimize(restored);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(src.size()));
+}
+BENCHMARK(BM_DecompressCord)->Arg(0)->Arg(64)->Arg(4096)->Arg(65536);
+
+}  // namespace
@@ -0,0 +1,231 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord_compression.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_test_helpers.h"
+
+namespace {
+
+std::string RandomBytes(size_t n, uint32_t seed) {
+  std::minstd_rand rng(seed);
+  std::string s(n, '\0');
+  for (char& c : s) c = static_cast<char>(rng());
+  return s;
+}
+
+// Text-like data with plenty of repetition at varying distances.
+std::string CompressibleBytes(size_t n, uint32_t seed) {
+  static const char* const kWords[] = {"turbo ", "cord ",   "compress ",
+                                       "chunk ", "buffer ", "rpc payload\n"};
+  std::minstd_rand rng(seed);
+  std::string s;
+  while (s.size() < n) s += kWords[rng() % 6];
+  s.resize(n);
+  return s;
+}
+
+// Splits `s` into a cord of `piece`-sized fragments.
+turbo::Cord Fragment(const std::string& s, size_t piece) {
+  std::vector<std::string> parts;
+  for (size_t i = 0; i < s.size(); i += piece) parts.push_back(s.substr(i, piece));
+  return turbo::MakeFragmentedCord(parts);
+}
+
+void ExpectRoundTrip(const turbo::Cord& src) {
+  turbo::Cord compressed = turbo::CompressCord(src);
+  turbo::Cord restored;
+  ASSERT_TRUE(turbo::DecompressCord(compressed, &restored).ok());
+  EXPECT_EQ(src.size(), restored.size());
+  EXPECT_TRUE(src == restored);
+}
+
+TEST(CordCompression, Empty) { ExpectRoundTrip(turbo::Cord()); }
+
+TEST(CordCompression, SmallSizes) {
+  for (size_t n = 1; n < 80; ++n) {
+    ExpectRoundTrip(turbo::Cord(CompressibleBytes(n, static_cast<uint32_t>(n))));
+    ExpectRoundTrip(turbo::Cord(RandomBytes(n, static_cast<uint32_t>(n))));
+    ExpectRoundTrip(turbo::Cord(std::string(n, 'z')));
+  }
+}
+
+TEST(CordCompression, FlatAndFragmented) {
+  const std::string text = CompressibleBytes(300000, 1);
+  ExpectRoundTrip(turbo::Cord(text));
+  ExpectRoundTrip(Fragment(text, 1));
+  ExpectRoundTrip(Fragment(text, 100));
+  ExpectRoundTrip(Fragment(text, 4000));
+  ExpectRoundTrip(Fragment(text, 50000));
+
+  const std::string noise = RandomBytes(100000, 2);
+  ExpectRoundTrip(turbo::Cord(noise));
+  ExpectRoundTrip(Fragment(noise, 777));
+}
+
+TEST(CordCompression, CompressesRedundantData) {
+  turbo::Cord src(CompressibleBytes(1 << 20, 3));
+  turbo::Cord compressed = turbo::CompressCord(src);
+  EXPECT_LT(compressed.size(), src.size() / 2);
+
+  turbo::Cord zeros(std::string(1 << 20, '\0'));
+  EXPECT_LT(turbo::CompressCord(zeros).size(), zeros.size() / 100);
+}
+
+TEST(CordCompression, IncompressibleDataIsStored) {
+  turbo::Cord src(RandomBytes(1 << 18, 4));
+  turbo::Cord compressed = turbo::CompressCord(src);
+  // Header, per-block headers and end marker only.
+  EXPECT_LT(compressed.size(), src.size() + src.size() / 1000);
+}
+
+TEST(CordCompression, StreamingCompressor) {
+  const std::string text = CompressibleBytes(200000, 5);
+  turbo::CordCompressor compressor(turbo::CordCodecId::kLz4, 1000);
+  turbo::Cord compressed;
+  for (size_t i = 0; i < text.size(); i += 12345) {
+    compressor.Write(turbo::Cord(text.substr(i, 12345)));
+    if (i % 3 == 0) compressor.Flush(&compressed);
+  }
+  compressed.Append(compressor.Finish());
+
+  turbo::Cord restored;
+  ASSERT_TRUE(turbo::DecompressCord(compressed, &restored).ok());
+  EXPECT_EQ(text, std::string(restored));
+}
+
+TEST(CordCompression, FlushWithNothingPending) {
+  turbo::Cord out;
+  turbo::CordCompressor compressor;
+  compressor.Flush(&out);  // The frame header.
+  const size_t header_size = out.size();
+  compressor.Flush(&out);
+  EXPECT_EQ(header_size, out.size());
+  out.Append(compressor.Finish());
+
+  turbo::CordDecompressor decompressor;
+  turbo::Cord restored;
+  decompressor.Flush(&restored);
+  EXPECT_TRUE(restored.empty());
+  ASSERT_TRUE(decompressor.Write(out).ok());
+  decompressor.Flush(&restored);
+  ASSERT_TRUE(decompressor.Finish(&restored).ok());
+  EXPECT_TRUE(restored.empty());
+}
+
+TEST(CordCompression, StreamingDecompressor) {
+  const std::string text = CompressibleBytes(100000, 6);
+  std::string compressed(turbo::CompressCord(turbo::Cord(text)));
+
+  for (size_t piece : {1, 7, 4096, 100000}) {
+    turbo::CordDecompressor decompressor;
+    turbo::Cord restored;
+    for (size_t i = 0; i < compressed.size(); i += piece) {
+      ASSERT_TRUE(
+          decompressor.Write(turbo::Cord(compressed.substr(i, piece))).ok());
+      decompressor.Flush(&restored);
+    }
+    ASSERT_TRUE(decompressor.Finish(&restored).ok());
+    EXPECT_EQ(text, std::string(restored)) << piece;
+  }
+}
+
+TEST(CordCompression, RejectsMalformedInput) {
+  turbo::Cord out;
+  EXPECT_FALSE(turbo::DecompressCord(turbo::Cord("not a frame"), &out).ok());
+
+  std::string compressed(
+      turbo::CompressCord(turbo::Cord(CompressibleBytes(50000, 7))));
+  // Truncated.
+  EXPECT_FALSE(
+      turbo::DecompressCord(turbo::Cord(compressed.substr(0, 1000)), &out)
+          .ok());
+  // Trailing garbage.
+  EXPECT_FALSE(turbo::DecompressCord(turbo::Cord(compressed + "x"), &out).ok());
+  // Corrupted payload bytes must be detected or decode to the right size;
+  // they must never crash or overrun.
+  for (size_t i = 9; i < compressed.size(); i += 97) {
+    std::string bad = compressed;
+    bad[i] = static_cast<char>(bad[i] ^ 0x5a);
+    turbo::Cord restored;
+    if (turbo::DecompressCord(turbo::Cord(bad), &restored).ok()) {
+      EXPECT_EQ(50000u, restored.size());
+    }
+  }
+}
+
+TEST(CordCompression, UnregisteredCodec) {
+  std::string compressed(turbo::CompressCord(turbo::Cord("hello")));
+  compressed[4] = static_cast<char>(turbo::CordCodecId::kZstd);
+  turbo::Cord out;
+  turbo::Status status = turbo::DecompressCord(turbo::Cord(compressed), &out);
+  EXPECT_EQ(turbo::StatusCode::kUnimplemented, status.code());
+}
+
+// A trivial codec standing in for an externally linked library.
+class XorCodec : public turbo::CordCodec {
+ public:
+  turbo::CordCodecId id() const override { return turbo::CordCodecId::kSnappy; }
+  size_t MaxCompressedLength(size_t n) const override { return n; }
+  size_t Compress(turbo::string_view src, char* dst) const override {
+    // Claim a one byte saving so the block is not stored raw.
+    for (size_t i = 0; i + 1 < src.size(); ++i) dst[i] = src[i] ^ 0x33;
+    return src.empty() ? 0 : src.size() - 1;
+  }
+  bool Decompress(turbo::string_view src, char* dst,
+                  size_t dst_size) const override {
+    if (src.size() + 1 != dst_size) return false;
+    for (size_t i = 0; i < src.size(); ++i) dst[i] = src[i] ^ 0x33;
+    dst[src.size()] = 'x';
+    return true;
+  }
+};
+
+TEST(CordCompression, RegisteredCodec) {
+  static XorCodec codec;
+  EXPECT_EQ(nullptr, turbo::GetCordCodec(turbo::CordCodecId::kSnappy));
+  turbo::RegisterCordCodec(&codec);
+  EXPECT_EQ(&codec, turbo::GetCordCodec(turbo::CordCodecId::kSnappy));
+
+  turbo::Cord compressed =
+      turbo::CompressCord(turbo::Cord("abcx"), turbo::CordCodecId::kSnappy);
+  turbo::Cord restored;
+  ASSERT_TRUE(turbo::DecompressCord(compressed, &restored).ok());
+  EXPECT_EQ("abcx", std::string(restored));
+
+  // "x" compresses to an empty payload, which decodes with nothing pending
+  // when the input stops right after it.
+  const std::string bytes(
+      turbo::CompressCord(turbo::Cord("x"), turbo::CordCodecId::kSnappy));
+  turbo::CordDecompressor decompressor;
+  ASSERT_TRUE(
+      decompressor.Write(turbo::Cord(bytes.substr(0, bytes.size() - 4))).ok());
+  restored.Clear();
+  decompressor.Flush(&restored);
+  EXPECT_EQ("x", std::string(restored));
+  ASSERT_TRUE(
+      decompressor.Write(turbo::Cord(bytes.substr(bytes.size() - 4))).ok());
+  ASSERT_TRUE(decompressor.Finish(&restored).ok());
+  EXPECT_EQ("x", std::string(restored));
+}
+
+}  // namespace
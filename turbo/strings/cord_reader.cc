@@ -0,0 +1,58 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord_reader.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+size_t CordReader::Distance(turbo::string_view delimiter) const {
+  const size_t left = remaining();
+  if (delimiter.empty()) return 0;
+  if (left < delimiter.size()) return left + 1;
+
+  // Most delimiters are found in the current chunk; search it directly rather
+  // than copying the iterator.
+  turbo::string_view chunk = Cord::ChunkRemaining(it_);
+  size_t pos = chunk.find(delimiter);
+  if (pos != turbo::string_view::npos) return pos;
+
+  // Continue with occurrences spanning or following the chunk boundary.
+  size_t skip = chunk.size() >= delimiter.size()
+                    ? chunk.size() - delimiter.size() + 1
+                    : 0;
+  Cord::CharIterator it = it_;
+  Cord::Advance(&it, skip);
+  Cord::CharIterator match = Cord::FindImpl(it, delimiter);
+  if (Cord::BytesRemaining(match) == 0) return left + 1;
+  return left - Cord::BytesRemaining(match);
+}
+
+bool CordReader::ReadUntil(turbo::string_view delimiter, Cord* out) {
+  size_t n = Distance(delimiter);
+  if (n > remaining()) return false;
+  *out = Cord::AdvanceAndRead(&it_, n);
+  Cord::Advance(&it_, delimiter.size());
+  return true;
+}
+
+bool CordReader::SkipUntil(turbo::string_view delimiter) {
+  size_t n = Distance(delimiter);
+  if (n > remaining()) return false;
+  Cord::Advance(&it_, n + delimiter.size());
+  return true;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,95 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: cord_reader.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `turbo::CordReader`, a forward cursor for parsing the
+// contents of a `turbo::Cord` without flattening it. Data read from the cursor
+// is returned as `Cord`s sharing the underlying chunks of the source where
+// possible, so splitting a large fragmented cord into records does not copy
+// the record payloads.
+//
+// Example:
+//
+//   turbo::CordReader reader(request);
+//   turbo::Cord line;
+//   while (reader.ReadUntil("\r\n", &line)) {
+//     ProcessHeader(line);
+//     if (line.empty()) break;
+//   }
+//   turbo::Cord body = reader.Read(reader.remaining());
+
+#ifndef TURBO_STRINGS_CORD_READER_H_
+#define TURBO_STRINGS_CORD_READER_H_
+
+#include <cstddef>
+
+#include "turbo/platform/port.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// CordReader
+//
+// A cursor over the bytes of a `Cord`. The reader refers to the cord it was
+// created from, which must outlive it and must not be modified while the
+// reader is in use.
+class CordReader {
+ public:
+  explicit CordReader(const Cord& cord) : it_(cord.char_begin()) {}
+
+  // Returns the number of bytes not yet consumed.
+  size_t remaining() const { return Cord::BytesRemaining(it_); }
+
+  // Returns true if all bytes have been consumed.
+  bool empty() const { return remaining() == 0; }
+
+  // Returns the longest contiguous run of bytes at the current position
+  // without consuming it, or an empty view if the reader is exhausted.
+  turbo::string_view Peek() const {
+    return empty() ? turbo::string_view() : Cord::ChunkRemaining(it_);
+  }
+
+  // Consumes `n` bytes. `n` must not exceed `remaining()`.
+  void Skip(size_t n) { Cord::Advance(&it_, n); }
+
+  // Consumes and returns the next `n` bytes. `n` must not exceed
+  // `remaining()`.
+  Cord Read(size_t n) { return Cord::AdvanceAndRead(&it_, n); }
+
+  // Looks for the next occurrence of `delimiter`. If found, stores the bytes
+  // preceding it in `*out`, consumes them along with the delimiter and returns
+  // true. Otherwise returns false and leaves both the reader and `*out`
+  // unchanged.
+  bool ReadUntil(turbo::string_view delimiter, Cord* out);
+
+  // Like `ReadUntil()`, but consumes the bytes without returning them.
+  bool SkipUntil(turbo::string_view delimiter);
+
+ private:
+  // Returns the number of bytes preceding the next occurrence of `delimiter`,
+  // or `remaining() + 1` if there is none.
+  size_t Distance(turbo::string_view delimiter) const;
+
+  Cord::CharIterator it_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_STRINGS_CORD_READER_H_
@@ -0,0 +1,109 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cord_reader.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_test_helpers.h"
+#include "turbo/strings/str_split.h"
+
+namespace {
+
+TEST(CordReader, Empty) {
+  turbo::Cord cord;
+  turbo::CordReader reader(cord);
+  EXPECT_TRUE(reader.empty());
+  EXPECT_EQ(0u, reader.remaining());
+  EXPECT_EQ("", reader.Peek());
+  turbo::Cord out("unchanged");
+  EXPECT_FALSE(reader.ReadUntil(",", &out));
+  EXPECT_EQ("unchanged", out);
+  EXPECT_TRUE(reader.ReadUntil("", &out));
+  EXPECT_EQ("", out);
+}
+
+TEST(CordReader, ReadAndSkip) {
+  turbo::Cord cord = turbo::MakeFragmentedCord({"abc", "defg", "hi"});
+  turbo::CordReader reader(cord);
+  EXPECT_EQ(9u, reader.remaining());
+  EXPECT_EQ("abc", reader.Peek());
+  EXPECT_EQ("ab", reader.Read(2));
+  EXPECT_EQ("c", reader.Peek());
+  reader.Skip(2);
+  EXPECT_EQ("efg", reader.Peek());
+  EXPECT_EQ(5u, reader.remaining());
+  EXPECT_EQ("efghi", reader.Read(5));
+  EXPECT_EQ("", reader.Read(0));
+  EXPECT_TRUE(reader.empty());
+}
+
+TEST(CordReader, ReadUntil) {
+  turbo::Cord cord = turbo::MakeFragmentedCord(
+      {"GET / HTTP/1.1\r", "\nHost: a\r\nAccept:", " */*", "\r\n\r", "\nbody"});
+  turbo::CordReader reader(cord);
+  turbo::Cord line;
+  std::vector<std::string> lines;
+  while (reader.ReadUntil("\r\n", &line)) {
+    if (line.empty()) break;
+    lines.push_back(std::string(line));
+  }
+  EXPECT_THAT(lines,
+              testing::ElementsAre("GET / HTTP/1.1", "Host: a", "Accept: */*"));
+  EXPECT_EQ("body", reader.Read(reader.remaining()));
+}
+
+TEST(CordReader, ReadUntilMissingDelimiter) {
+  turbo::Cord cord = turbo::MakeFragmentedCord({"key=", "value"});
+  turbo::CordReader reader(cord);
+  turbo::Cord out;
+  EXPECT_TRUE(reader.ReadUntil("=", &out));
+  EXPECT_EQ("key", out);
+  EXPECT_FALSE(reader.ReadUntil("=", &out));
+  EXPECT_EQ("key", out);
+  EXPECT_EQ(5u, reader.remaining());
+  EXPECT_FALSE(reader.SkipUntil("valuex"));
+  EXPECT_TRUE(reader.SkipUntil("lu"));
+  EXPECT_EQ("e", reader.Read(1));
+}
+
+TEST(CordReader, MatchesStrSplit) {
+  std::string text;
+  for (int i = 0; i < 2000; ++i) {
+    text += std::to_string(i * 7919 % 1000);
+    text += i % 3 == 0 ? ";;" : ";";
+  }
+  std::vector<std::string> expected = turbo::StrSplit(text, ';');
+  expected.pop_back();
+
+  for (size_t piece : {1, 3, 64, 5000}) {
+    std::vector<std::string> fragments;
+    for (size_t i = 0; i < text.size(); i += piece) {
+      fragments.push_back(text.substr(i, piece));
+    }
+    turbo::Cord cord = turbo::MakeFragmentedCord(fragments);
+    turbo::CordReader reader(cord);
+    std::vector<std::string> actual;
+    turbo::Cord field;
+    while (reader.ReadUntil(";", &field)) actual.push_back(std::string(field));
+    EXPECT_EQ(expected, actual) << piece;
+    EXPECT_TRUE(reader.empty());
+  }
+}
+
+}  // namespace
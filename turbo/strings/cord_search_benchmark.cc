@@ -0,0 +1,109 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_reader.h"
+#include "turbo/strings/cord_test_helpers.h"
+#include "turbo/strings/str_split.h"
+
+namespace {
+
+constexpr size_t kCordSize = 4 << 20;
+
+// A `kCordSize` cord of `piece` sized chunks holding ';'-separated records,
+// with `needle` appended at the very end.
+turbo::Cord MakeCord(size_t piece, turbo::string_view needle) {
+  std::string text;
+  for (int i = 0; text.size() < kCordSize - needle.size(); ++i) {
+    text += "record-";
+    text += std::to_string(i);
+    text += ';';
+  }
+  text.resize(kCordSize - needle.size());
+  text.append(needle.data(), needle.size());
+  std::vector<std::string> parts;
+  for (size_t i = 0; i < text.size(); i += piece) {
+    parts.push_back(text.substr(i, piece));
+  }
+  return turbo::MakeFragmentedCord(parts);
+}
+
+void BM_CordFind(benchmark::State& state) {
+  turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)), "needle!");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cord.Find("needle!"));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kCordSize));
+}
+BENCHMARK(BM_CordFind)->Arg(64)->Arg(4096)->Arg(kCordSize);
+
+// Baseline: copy the cord into a string and search that.
+void BM_FlattenAndFind(benchmark::State& state) {
+  turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)), "needle!");
+  for (auto _ : state) {
+    std::string flat(cord);
+    benchmark::DoNotOptimize(flat.find("needle!"));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kCordSize));
+}
+BENCHMARK(BM_FlattenAndFind)->Arg(64)->Arg(4096)->Arg(kCordSize);
+
+void BM_CordFindFirstOf(benchmark::State& state) {
+  turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)), "!");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cord.FindFirstOf("!?"));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kCordSize));
+}
+BENCHMARK(BM_CordFindFirstOf)->Arg(64)->Arg(4096)->Arg(kCordSize);
+
+void BM_CordReaderSplit(benchmark::State& state) {
+  turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)), ";");
+  for (auto _ : state) {
+    turbo::CordReader reader(cord);
+    turbo::Cord record;
+    size_t records = 0;
+    while (reader.ReadUntil(";", &record)) ++records;
+    benchmark::DoNotOptimize(records);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kCordSize));
+}
+BENCHMARK(BM_CordReaderSplit)->Arg(64)->Arg(4096)->Arg(kCordSize);
+
+// Baseline: flatten the cord and split it with StrSplit.
+void BM_FlattenAndSplit(benchmark::State& state) {
+  turbo::Cord cord = MakeCord(static_cast<size_t>(state.range(0)), ";");
+  for (auto _ : state) {
+    std::string flat(cord);
+    size_t records = 0;
+    for (turbo::string_view record : turbo::StrSplit(flat, ';')) {
+      benchmark::DoNotOptimize(record);
+      ++records;
+    }
+    benchmark::DoNotOptimize(records);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kCordSize));
+}
+BENCHMARK(BM_FlattenAndSplit)->Arg(64)->Arg(4096)->Arg(kCordSize);
+
+}  // namespace
@@ -481,6 +481,71 @@ TEST_P(CordTest, StartsEndsWith) {
   ASSERT_TRUE(!empty.EndsWith("xyz"));
 }
 
+// Returns the offset of `it` within `c`, or npos for `c.char_end()`.
+static size_t OffsetOf(const turbo::Cord& c, turbo::Cord::CharIterator it) {
+  if (it == c.char_end()) return std::string::npos;
+  size_t offset = 0;
+  for (turbo::Cord::CharIterator i = c.char_begin(); i != it; ++i) ++offset;
+  return offset;
+}
+
+TEST_P(CordTest, Find) {
+  turbo::Cord x = turbo::MakeFragmentedCord(
+      {"abc", "ab", "cabd", "x", "y", "zab", "c", "d" + std::string(100, 'e')});
+  MaybeHarden(x);
+  const std::string flat(x);
+  for (turbo::string_view needle :
+       {"a", "abc", "bca", "cabdxyza", "xyz", "dxy", "bcd", "abcd", "eee",
+        "de", "q", "abq", "zabcdeeeeee", "", "e"}) {
+    EXPECT_EQ(flat.find(std::string(needle)), OffsetOf(x, x.Find(needle)))
+        << needle;
+    EXPECT_EQ(flat.find(std::string(needle)) != std::string::npos,
+              x.Contains(needle))
+        << needle;
+  }
+  EXPECT_TRUE(x.Contains(flat));
+  EXPECT_FALSE(x.Contains(flat + "e"));
+
+  turbo::Cord empty;
+  EXPECT_TRUE(empty.Find("") == empty.char_begin());
+  EXPECT_TRUE(empty.Find("a") == empty.char_end());
+}
+
+TEST_P(CordTest, FindRandomized) {
+  RandomEngine rng(GTEST_FLAG_GET(random_seed));
+  for (int iter = 0; iter < 50; ++iter) {
+    // A small alphabet makes partial matches across boundaries frequent.
+    std::string s;
+    std::uniform_int_distribution<int> letter('a', 'c');
+    for (int i = 0; i < 3000; ++i) s.push_back(static_cast<char>(letter(rng)));
+    turbo::Cord c;
+    AppendWithFragments(s, &rng, &c);
+    MaybeHarden(c);
+    for (int j = 0; j < 20; ++j) {
+      size_t len = std::uniform_int_distribution<size_t>(1, 12)(rng);
+      std::string needle;
+      for (size_t i = 0; i < len; ++i) {
+        needle.push_back(static_cast<char>(letter(rng)));
+      }
+      ASSERT_EQ(s.find(needle), OffsetOf(c, c.Find(needle))) << needle;
+    }
+  }
+}
+
+TEST_P(CordTest, FindFirstOf) {
+  turbo::Cord x = turbo::MakeFragmentedCord({"hello", " ", "wor", "ld!"});
+  MaybeHarden(x);
+  const std::string flat(x);
+  for (turbo::string_view chars :
+       {"h", "o", "d", "!", "dw", " !", "xyz", "", "rl", "ld"}) {
+    EXPECT_EQ(flat.find_first_of(std::string(chars)),
+              OffsetOf(x, x.FindFirstOf(chars)))
+        << chars;
+  }
+  turbo::Cord nul(std::string("a\0b", 3));
+  EXPECT_EQ(1u, OffsetOf(nul, nul.FindFirstOf(turbo::string_view("\0b", 2))));
+}
+
 TEST_P(CordTest, Subcord) {
   RandomEngine rng(GTEST_FLAG_GET(random_seed));
   const std::string s = RandomLowercaseString(&rng, 1024);
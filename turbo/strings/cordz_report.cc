@@ -0,0 +1,131 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cordz_report.h"
+
+#include <algorithm>
+
+#include "turbo/profiling/internal/log2_histogram.h"
+#include "turbo/strings/internal/cordz_info.h"
+#include "turbo/strings/internal/cordz_sample_token.h"
+#include "turbo/strings/internal/cordz_statistics.h"
+#include "turbo/strings/internal/cordz_update_tracker.h"
+#include "turbo/strings/str_format.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+using cord_internal::CordzStatistics;
+using cord_internal::CordzUpdateTracker;
+
+constexpr const char* kMethodNames[] = {
+    "Unknown",           "AppendCord",         "AppendCordBuffer",
+    "AppendExternalMemory", "AppendString",    "AssignCord",
+    "AssignString",      "Clear",              "ConstructorCord",
+    "ConstructorString", "CordReader",         "Flatten",
+    "GetAppendBuffer",   "GetAppendRegion",    "MakeCordFromExternal",
+    "MoveAppendCord",    "MoveAssignCord",     "MovePrependCord",
+    "PrependCord",       "PrependCordBuffer",  "PrependString",
+    "RemovePrefix",      "RemoveSuffix",       "SetExpectedChecksum",
+    "SubCord",
+};
+static_assert(TURBO_ARRAY_SIZE(kMethodNames) == CordzUpdateTracker::kNumMethods,
+              "kMethodNames must name every CordzUpdateTracker method");
+
+// Orders samples from most to least fragmented.
+bool MoreFragmented(const CordzFragmentationReport::Sample& a,
+                    const CordzFragmentationReport::Sample& b) {
+  if (a.average_chunk_size() != b.average_chunk_size()) {
+    return a.average_chunk_size() < b.average_chunk_size();
+  }
+  return a.chunks > b.chunks;
+}
+
+}  // namespace
+
+std::string CordzFragmentationReport::ToString() const {
+  std::string out;
+  turbo::StrAppendFormat(
+      &out,
+      "sampled cords: %u\nbytes: %u\nchunks: %u (%u small)\n"
+      "average chunk size: %.1f\nmemory: %u (fair share %u, %.1f%% shared)\n",
+      cords, bytes, chunks, small_chunks, average_chunk_size(), memory_usage,
+      fair_share_memory_usage, 100 * shared_memory_ratio());
+  profiling_internal::AppendLog2Histogram("cords by chunk count",
+                                          chunk_count_histogram, &out);
+  profiling_internal::AppendLog2Histogram("cords by average chunk size",
+                                          average_chunk_size_histogram, &out);
+  if (!most_fragmented.empty()) {
+    out += "most fragmented:\n";
+    for (const Sample& sample : most_fragmented) {
+      turbo::StrAppendFormat(
+          &out,
+          "  size=%u chunks=%u avg=%.1f small=%u shared=%.1f%% method=%s\n",
+          sample.size, sample.chunks, sample.average_chunk_size(),
+          sample.small_chunks, 100 * sample.shared_memory_ratio(),
+          sample.method);
+    }
+  }
+  return out;
+}
+
+CordzFragmentationReport GetCordzFragmentationReport(size_t max_samples) {
+  CordzFragmentationReport report;
+  cord_internal::CordzSampleToken token;
+  for (const cord_internal::CordzInfo& info : token) {
+    const CordzStatistics stats = info.GetCordzStatistics();
+    CordzFragmentationReport::Sample sample;
+    sample.size = stats.size;
+    sample.chunks = stats.node_counts.flat + stats.node_counts.external;
+    sample.small_chunks = stats.node_counts.flat_64 +
+                          stats.node_counts.flat_128 +
+                          stats.node_counts.flat_256;
+    sample.memory_usage = stats.estimated_memory_usage;
+    sample.fair_share_memory_usage = stats.estimated_fair_share_memory_usage;
+
+    report.cords++;
+    report.bytes += sample.size;
+    report.chunks += sample.chunks;
+    report.small_chunks += sample.small_chunks;
+    report.memory_usage += sample.memory_usage;
+    report.fair_share_memory_usage += sample.fair_share_memory_usage;
+    report.chunk_count_histogram[profiling_internal::Log2Bucket(
+        static_cast<double>(sample.chunks),
+        CordzFragmentationReport::kHistogramBuckets)]++;
+    report.average_chunk_size_histogram[profiling_internal::Log2Bucket(
+        sample.average_chunk_size(),
+        CordzFragmentationReport::kHistogramBuckets)]++;
+
+    if (max_samples == 0 || sample.chunks < 2) continue;
+    auto& worst = report.most_fragmented;
+    if (worst.size() == max_samples) {
+      // `worst` is kept as a heap whose top is its least fragmented entry.
+      if (!MoreFragmented(sample, worst.front())) continue;
+      std::pop_heap(worst.begin(), worst.end(), MoreFragmented);
+      worst.pop_back();
+    }
+    sample.method = kMethodNames[stats.method];
+    turbo::Span<void* const> stack = info.GetStack();
+    sample.stack.assign(stack.begin(), stack.end());
+    worst.push_back(std::move(sample));
+    std::push_heap(worst.begin(), worst.end(), MoreFragmented);
+  }
+  std::sort_heap(report.most_fragmented.begin(), report.most_fragmented.end(),
+                 MoreFragmented);
+  return report;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,132 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: cordz_report.h
+// -----------------------------------------------------------------------------
+//
+// This file exports aggregated statistics over the cords currently sampled by
+// cordz, the cord sampling profiler. Cordz samples a small random fraction of
+// all cords (see `cordz_functions.h`) and keeps their creation stacks; the
+// report summarizes how fragmented those cords are and which ones are the
+// worst offenders, which helps finding code paths that build cords from many
+// tiny chunks or pin large shared buffers.
+//
+// Example:
+//
+//   turbo::CordzFragmentationReport report = turbo::GetCordzFragmentationReport();
+//   if (report.average_chunk_size() < 256) {
+//     TURBO_LOG(WARNING) << report.ToString();
+//   }
+//
+// All values are empty if cordz is not compiled in, see
+// `TURBO_INTERNAL_CORDZ_ENABLED`.
+
+#ifndef TURBO_STRINGS_CORDZ_REPORT_H_
+#define TURBO_STRINGS_CORDZ_REPORT_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// CordzFragmentationReport
+//
+// Aggregated fragmentation statistics over a set of sampled cords. A "chunk" is
+// a flat or external leaf node holding cord data.
+struct CordzFragmentationReport {
+  // Histograms use power of two buckets: bucket `i` counts values in
+  // [2^i, 2^(i+1)), bucket 0 also counts zero.
+  static constexpr size_t kHistogramBuckets = 32;
+  using Histogram = std::array<size_t, kHistogramBuckets>;
+
+  // Statistics of a single sampled cord.
+  struct Sample {
+    // Cord::size() of the sampled cord.
+    size_t size = 0;
+    // Number of chunks in the cord.
+    size_t chunks = 0;
+    // Number of chunks whose allocation is at most 256 bytes.
+    size_t small_chunks = 0;
+    // Estimated memory used by the cord, including memory shared with other
+    // cords, and the part of it attributed to this cord.
+    size_t memory_usage = 0;
+    size_t fair_share_memory_usage = 0;
+    // Name of the Cord method which created the sampled cord.
+    turbo::string_view method;
+    // Stack of the call which created the sampled cord.
+    std::vector<void*> stack;
+
+    double average_chunk_size() const {
+      return chunks == 0 ? 0.0 : static_cast<double>(size) / chunks;
+    }
+
+    // Fraction of `memory_usage` shared with other cords.
+    double shared_memory_ratio() const {
+      return memory_usage == 0
+                 ? 0.0
+                 : 1.0 - static_cast<double>(fair_share_memory_usage) /
+                             memory_usage;
+    }
+  };
+
+  // Number of sampled cords and their accumulated statistics.
+  size_t cords = 0;
+  size_t bytes = 0;
+  size_t chunks = 0;
+  size_t small_chunks = 0;
+  size_t memory_usage = 0;
+  size_t fair_share_memory_usage = 0;
+
+  // Number of cords by chunk count and by average chunk size.
+  Histogram chunk_count_histogram = {};
+  Histogram average_chunk_size_histogram = {};
+
+  // The most fragmented cords, i.e. those with more than one chunk and the
+  // smallest average chunk size, most fragmented first.
+  std::vector<Sample> most_fragmented;
+
+  double average_chunk_size() const {
+    return chunks == 0 ? 0.0 : static_cast<double>(bytes) / chunks;
+  }
+
+  double shared_memory_ratio() const {
+    return memory_usage == 0
+               ? 0.0
+               : 1.0 - static_cast<double>(fair_share_memory_usage) /
+                           memory_usage;
+  }
+
+  // Returns a human readable multi-line summary of the report.
+  std::string ToString() const;
+};
+
+// GetCordzFragmentationReport()
+//
+// Aggregates the statistics of all cords currently sampled by cordz. At most
+// `max_samples` entries are kept in `most_fragmented`.
+//
+// This walks every sampled cord and should not be called on a hot path.
+CordzFragmentationReport GetCordzFragmentationReport(size_t max_samples = 10);
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_STRINGS_CORDZ_REPORT_H_
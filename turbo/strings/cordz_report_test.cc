@@ -0,0 +1,101 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/strings/cordz_report.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "turbo/strings/cord.h"
+#include "turbo/strings/cord_buffer.h"
+#include "turbo/strings/cord_test_helpers.h"
+#include "turbo/strings/cordz_test_helpers.h"
+
+#ifdef TURBO_INTERNAL_CORDZ_ENABLED
+
+namespace {
+
+using testing::HasSubstr;
+
+TEST(CordzReport, Empty) {
+  turbo::CordzFragmentationReport report = turbo::GetCordzFragmentationReport();
+  EXPECT_EQ(0u, report.cords);
+  EXPECT_EQ(0.0, report.average_chunk_size());
+  EXPECT_EQ(0.0, report.shared_memory_ratio());
+  EXPECT_TRUE(report.most_fragmented.empty());
+}
+
+TEST(CordzReport, FragmentedAndSharedCords) {
+  turbo::CordzSamplingIntervalHelper always(1);
+
+  // One cord of 500 small flat chunks.
+  turbo::Cord fragmented;
+  for (int i = 0; i < 500; ++i) {
+    turbo::CordBuffer buffer = turbo::CordBuffer::CreateWithDefaultLimit(100);
+    turbo::Span<char> data = buffer.available_up_to(100);
+    std::fill(data.begin(), data.end(), 'f');
+    buffer.IncreaseLengthBy(data.size());
+    fragmented.Append(std::move(buffer));
+  }
+  // One large flat cord, shared with a copy.
+  turbo::Cord large(std::string(100000, 'l'));
+  turbo::Cord copy = large;
+
+  turbo::CordzFragmentationReport report = turbo::GetCordzFragmentationReport(1);
+  EXPECT_GE(report.cords, 2u);
+  EXPECT_GE(report.chunks, 501u);
+  EXPECT_GE(report.small_chunks, 500u);
+  EXPECT_GE(report.bytes, fragmented.size() + large.size());
+  EXPECT_GT(report.shared_memory_ratio(), 0.0);
+
+  ASSERT_EQ(1u, report.most_fragmented.size());
+  const auto& worst = report.most_fragmented[0];
+  EXPECT_EQ(fragmented.size(), worst.size);
+  EXPECT_EQ(500u, worst.chunks);
+  EXPECT_EQ(100.0, worst.average_chunk_size());
+  EXPECT_FALSE(worst.stack.empty());
+
+  size_t histogram_total = 0;
+  for (size_t n : report.chunk_count_histogram) histogram_total += n;
+  EXPECT_EQ(report.cords, histogram_total);
+  // 500 chunks fall into [256, 512).
+  EXPECT_GE(report.chunk_count_histogram[8], 1u);
+  // 100 byte chunks fall into [64, 128).
+  EXPECT_GE(report.average_chunk_size_histogram[6], 1u);
+
+  std::string text = report.ToString();
+  EXPECT_THAT(text, HasSubstr("most fragmented:"));
+  EXPECT_THAT(text, HasSubstr("chunks=500"));
+}
+
+TEST(CordzReport, MostFragmentedIsOrdered) {
+  turbo::CordzSamplingIntervalHelper always(1);
+  std::vector<turbo::Cord> cords;
+  for (size_t chunk : {1000, 50, 300, 20, 700}) {
+    cords.push_back(turbo::MakeFragmentedCord(
+        std::vector<std::string>(10, std::string(chunk, 'x'))));
+  }
+  turbo::CordzFragmentationReport report = turbo::GetCordzFragmentationReport(3);
+  ASSERT_EQ(3u, report.most_fragmented.size());
+  EXPECT_EQ(20.0, report.most_fragmented[0].average_chunk_size());
+  EXPECT_EQ(50.0, report.most_fragmented[1].average_chunk_size());
+  EXPECT_EQ(300.0, report.most_fragmented[2].average_chunk_size());
+}
+
+}  // namespace
+
+#endif  // TURBO_INTERNAL_CORDZ_ENABLED
@@ -0,0 +1,178 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: atomic_shared_snapshot.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::AtomicSharedSnapshot<T>`, an immutable
+// snapshot of a value which is read often and replaced rarely, such as a
+// routing table or a parsed configuration.
+//
+// Readers access the current snapshot in place, without copying it and
+// without updating a reference count shared with other readers: they only
+// increment and decrement a counter of their CPU, like the readers of
+// `turbo::DistributedRWMutex`. Writers publish a new snapshot with a pointer
+// swap and reclaim the previous one once the readers which may still see it
+// are done, so readers never block.
+//
+// Example:
+//
+//   turbo::AtomicSharedSnapshot<RoutingTable> routes(LoadRoutes());
+//
+//   // On the hot path:
+//   Backend backend = routes.Read(
+//       [&](const RoutingTable& table) { return table.Lookup(request); });
+//
+//   // Rarely:
+//   routes.Store(LoadRoutes());
+//
+// The function passed to `Read()` must not block for long or call `Store()`,
+// as writers wait for it. For small trivially copyable values, a
+// `turbo::SeqLocked` from seq_locked.h is cheaper to read.
+
+#ifndef TURBO_SYNCHRONIZATION_ATOMIC_SHARED_SNAPSHOT_H_
+#define TURBO_SYNCHRONIZATION_ATOMIC_SHARED_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "turbo/platform/port.h"
+#include "turbo/synchronization/distributed_rw_mutex.h"
+#include "turbo/synchronization/internal/sharded_counters.h"
+#include "turbo/synchronization/mutex.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// AtomicSharedSnapshot
+//
+// An immutable value of type `T` which may be replaced as a whole while it is
+// being read. Thread-safe.
+template <typename T>
+class AtomicSharedSnapshot {
+ public:
+  explicit AtomicSharedSnapshot(T value)
+      : AtomicSharedSnapshot(std::unique_ptr<T>(new T(std::move(value)))) {}
+
+  // REQUIRES: `value` is not null.
+  explicit AtomicSharedSnapshot(std::unique_ptr<T> value)
+      : num_slots_(synchronization_internal::NumCounterShards()),
+        counts_(2 * num_slots_),
+        current_(value.release()) {}
+
+  ~AtomicSharedSnapshot() { delete current_.load(std::memory_order_relaxed); }
+
+  AtomicSharedSnapshot(const AtomicSharedSnapshot&) = delete;
+  AtomicSharedSnapshot& operator=(const AtomicSharedSnapshot&) = delete;
+
+  // Read()
+  //
+  // Returns `f(const T&)` called on the current snapshot. The snapshot stays
+  // valid until `f` returns.
+  template <typename F>
+  auto Read(F&& f) const -> decltype(f(std::declval<const T&>())) {
+    ReadSection section(this);
+    return f(*current_.load(std::memory_order_seq_cst));
+  }
+
+  // Returns a copy of the current snapshot.
+  T Load() const {
+    return Read([](const T& value) { return value; });
+  }
+
+  // Store()
+  //
+  // Replaces the snapshot and destroys the previous one, after waiting for the
+  // readers which may still access it.
+  void Store(T value) { Store(std::unique_ptr<T>(new T(std::move(value)))); }
+
+  // REQUIRES: `value` is not null.
+  void Store(std::unique_ptr<T> value) {
+    std::unique_ptr<const T> previous;
+    {
+      MutexLock lock(&write_mu_);
+      previous.reset(
+          current_.exchange(value.release(), std::memory_order_seq_cst));
+      // Readers which start from now on count themselves in the other epoch
+      // and see the new snapshot, so the previous one is released once the
+      // readers of the current epoch are done.
+      const int epoch = epoch_.load(std::memory_order_relaxed);
+      epoch_.store(epoch ^ 1, std::memory_order_seq_cst);
+      synchronization_internal::WaitForDistributedReaders(
+          &counts_[static_cast<size_t>(epoch) * num_slots_], num_slots_);
+    }
+  }
+
+  // Update()
+  //
+  // Stores the result of `f(T*)` applied to a copy of the current snapshot.
+  // Writers are serialized, so concurrent updates are not lost.
+  template <typename F>
+  void Update(F f) {
+    MutexLock lock(&update_mu_);
+    std::unique_ptr<T> value(new T(Load()));
+    f(value.get());
+    Store(std::move(value));
+  }
+
+ private:
+  // Counts a reader in the current epoch for the lifetime of the object.
+  class ReadSection {
+   public:
+    explicit ReadSection(const AtomicSharedSnapshot* snapshot)
+        : count_(snapshot->EnterRead()) {}
+    ~ReadSection() { count_->fetch_sub(1, std::memory_order_release); }
+
+    ReadSection(const ReadSection&) = delete;
+    ReadSection& operator=(const ReadSection&) = delete;
+
+   private:
+    std::atomic<int64_t>* const count_;
+  };
+
+  std::atomic<int64_t>* EnterRead() const {
+    while (true) {
+      const int epoch = epoch_.load(std::memory_order_seq_cst);
+      std::atomic<int64_t>& count =
+          counts_[static_cast<size_t>(epoch) * num_slots_ +
+                  synchronization_internal::CounterShardIndex(num_slots_)]
+              .value;
+      count.fetch_add(1, std::memory_order_seq_cst);
+      // A reader counted in an epoch which is still current is waited for by
+      // the next writer. Otherwise a writer may have already checked the
+      // counter: retry in the new epoch.
+      if (TURBO_PREDICT_TRUE(epoch_.load(std::memory_order_seq_cst) ==
+                             epoch)) {
+        return &count;
+      }
+      count.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  const size_t num_slots_;
+  // The reader counters of the two epochs, `num_slots_` each.
+  mutable synchronization_internal::PaddedCounterArray counts_;
+  std::atomic<int> epoch_{0};
+  std::atomic<const T*> current_;
+  Mutex write_mu_;
+  Mutex update_mu_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_SYNCHRONIZATION_ATOMIC_SHARED_SNAPSHOT_H_
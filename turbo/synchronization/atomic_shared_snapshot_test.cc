@@ -0,0 +1,124 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/atomic_shared_snapshot.h"
+
+#include <atomic>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/synchronization/notification.h"
+#include "turbo/time/clock.h"
+
+namespace {
+
+// Counts live instances, and detects use after destruction.
+struct Tracked {
+  explicit Tracked(int v) : value(v) { live.fetch_add(1); }
+  Tracked(const Tracked& other) : value(other.value) { live.fetch_add(1); }
+  ~Tracked() {
+    value = -1;
+    live.fetch_sub(1);
+  }
+
+  int value;
+  static std::atomic<int> live;
+};
+
+std::atomic<int> Tracked::live{0};
+
+TEST(AtomicSharedSnapshotTest, ReadAndStore) {
+  turbo::AtomicSharedSnapshot<std::string> snapshot(std::string("first"));
+  EXPECT_EQ(5u, snapshot.Read([](const std::string& s) { return s.size(); }));
+  snapshot.Store("second");
+  EXPECT_EQ("second", snapshot.Load());
+  snapshot.Update([](std::string* s) { s->append("!"); });
+  EXPECT_EQ("second!", snapshot.Load());
+}
+
+TEST(AtomicSharedSnapshotTest, ReclaimsPreviousSnapshots) {
+  {
+    turbo::AtomicSharedSnapshot<Tracked> snapshot(Tracked(1));
+    EXPECT_EQ(1, Tracked::live.load());
+    for (int i = 2; i <= 10; ++i) snapshot.Store(Tracked(i));
+    EXPECT_EQ(1, Tracked::live.load());
+    EXPECT_EQ(10, snapshot.Load().value);
+  }
+  EXPECT_EQ(0, Tracked::live.load());
+}
+
+TEST(AtomicSharedSnapshotTest, StoreWaitsForReaders) {
+  turbo::AtomicSharedSnapshot<Tracked> snapshot(Tracked(1));
+  turbo::Notification reading;
+  turbo::Notification stored;
+  std::thread reader([&] {
+    snapshot.Read([&](const Tracked& t) {
+      reading.Notify();
+      turbo::SleepFor(turbo::Milliseconds(50));
+      // The snapshot is still valid although a new one was published.
+      EXPECT_EQ(1, t.value);
+      return 0;
+    });
+  });
+  reading.WaitForNotification();
+  std::thread writer([&] {
+    snapshot.Store(Tracked(2));
+    stored.Notify();
+  });
+  EXPECT_FALSE(stored.WaitForNotificationWithTimeout(turbo::Milliseconds(10)));
+  // New readers see the new snapshot while the writer waits.
+  EXPECT_EQ(2, snapshot.Load().value);
+  reader.join();
+  writer.join();
+  EXPECT_TRUE(stored.HasBeenNotified());
+}
+
+TEST(AtomicSharedSnapshotTest, ConcurrentReadersAndWriters) {
+  turbo::AtomicSharedSnapshot<std::vector<int>> snapshot(
+      std::vector<int>(16, 0));
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        snapshot.Read([&](const std::vector<int>& v) {
+          for (int x : v) {
+            if (x != v[0]) inconsistent.fetch_add(1);
+          }
+          return 0;
+        });
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 2; ++i) {
+    writers.emplace_back([&] {
+      for (int j = 0; j < 500; ++j) {
+        snapshot.Update([](std::vector<int>* v) {
+          for (int& x : *v) ++x;
+        });
+      }
+    });
+  }
+  for (std::thread& t : writers) t.join();
+  done.store(true);
+  for (std::thread& t : readers) t.join();
+  EXPECT_EQ(0, inconsistent.load());
+  EXPECT_EQ(1000, snapshot.Load()[0]);
+}
+
+}  // namespace
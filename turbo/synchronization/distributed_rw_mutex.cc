@@ -0,0 +1,102 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/distributed_rw_mutex.h"
+
+#include <thread>  // NOLINT(build/c++11)
+
+#include "turbo/time/clock.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace synchronization_internal {
+int64_t CountDistributedReaders(const PaddedCounter* counts,
+                                size_t num_slots) {
+  int64_t readers = 0;
+  for (size_t i = 0; i < num_slots; ++i) {
+    readers += counts[i].value.load(std::memory_order_acquire);
+  }
+  return readers;
+}
+
+void WaitForDistributedReaders(const PaddedCounter* counts,
+                               size_t num_slots) {
+  // Critical sections of readers are short, so spin before yielding and
+  // sleeping.
+  for (int i = 0; CountDistributedReaders(counts, num_slots) != 0; ++i) {
+    if (i < 100) {
+      continue;
+    } else if (i < 200) {
+      std::this_thread::yield();
+    } else {
+      turbo::SleepFor(turbo::Microseconds(10));
+    }
+  }
+}
+
+}  // namespace synchronization_internal
+
+DistributedRWMutex::DistributedRWMutex()
+    : num_slots_(synchronization_internal::NumCounterShards()),
+      slots_(num_slots_) {}
+
+DistributedRWMutex::~DistributedRWMutex() = default;
+
+void DistributedRWMutex::Lock() {
+  writer_mu_.Lock();
+  writer_.store(true, std::memory_order_seq_cst);
+  // Readers which did not see `writer_` are counted by now.
+  synchronization_internal::WaitForDistributedReaders(slots_.data(),
+                                                      num_slots_);
+}
+
+bool DistributedRWMutex::TryLock() {
+  if (!writer_mu_.TryLock()) return false;
+  writer_.store(true, std::memory_order_seq_cst);
+  if (synchronization_internal::CountDistributedReaders(slots_.data(),
+                                                        num_slots_) != 0) {
+    writer_.store(false, std::memory_order_release);
+    writer_mu_.Unlock();
+    return false;
+  }
+  return true;
+}
+
+void DistributedRWMutex::Unlock() {
+  writer_.store(false, std::memory_order_release);
+  writer_mu_.Unlock();
+}
+
+void DistributedRWMutex::ReaderLockSlow() {
+  while (true) {
+    // Wait for the writer to release the lock.
+    writer_mu_.ReaderLock();
+    writer_mu_.ReaderUnlock();
+    std::atomic<int64_t>& count = ReaderCount();
+    count.fetch_add(1, std::memory_order_seq_cst);
+    if (!writer_.load(std::memory_order_seq_cst)) return;
+    count.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+bool DistributedRWMutex::ReaderTryLock() {
+  std::atomic<int64_t>& count = ReaderCount();
+  count.fetch_add(1, std::memory_order_seq_cst);
+  if (!writer_.load(std::memory_order_seq_cst)) return true;
+  count.fetch_sub(1, std::memory_order_release);
+  return false;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,100 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/distributed_rw_mutex.h"
+
+#include <atomic>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/synchronization/notification.h"
+#include "turbo/time/clock.h"
+
+namespace {
+
+TEST(DistributedRWMutexTest, TryLock) {
+  turbo::DistributedRWMutex mu;
+  ASSERT_TRUE(mu.TryLock());
+  EXPECT_FALSE(mu.ReaderTryLock());
+  mu.Unlock();
+
+  ASSERT_TRUE(mu.ReaderTryLock());
+  ASSERT_TRUE(mu.ReaderTryLock());
+  EXPECT_FALSE(mu.TryLock());
+  mu.ReaderUnlock();
+  EXPECT_FALSE(mu.TryLock());
+  mu.ReaderUnlock();
+  EXPECT_TRUE(mu.TryLock());
+  mu.Unlock();
+}
+
+TEST(DistributedRWMutexTest, WriterWaitsForReaders) {
+  turbo::DistributedRWMutex mu;
+  std::atomic<bool> writer_done{false};
+  mu.ReaderLock();
+  std::thread writer([&] {
+    turbo::DistributedWriterMutexLock lock(&mu);
+    writer_done.store(true);
+  });
+  turbo::SleepFor(turbo::Milliseconds(20));
+  EXPECT_FALSE(writer_done.load());
+  mu.ReaderUnlock();
+  writer.join();
+  EXPECT_TRUE(writer_done.load());
+}
+
+TEST(DistributedRWMutexTest, ReadersWaitForWriter) {
+  turbo::DistributedRWMutex mu;
+  std::atomic<bool> reader_done{false};
+  mu.Lock();
+  std::thread reader([&] {
+    turbo::DistributedReaderMutexLock lock(&mu);
+    reader_done.store(true);
+  });
+  turbo::SleepFor(turbo::Milliseconds(20));
+  EXPECT_FALSE(reader_done.load());
+  mu.Unlock();
+  reader.join();
+  EXPECT_TRUE(reader_done.load());
+}
+
+// Writers keep two values equal, which readers must never see differ.
+TEST(DistributedRWMutexTest, ReadersAndWriters) {
+  turbo::DistributedRWMutex mu;
+  int64_t a = 0;
+  int64_t b = 0;
+  std::atomic<int> inconsistent{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 2000; ++i) {
+        if ((i + t) % 16 == 0) {
+          turbo::DistributedWriterMutexLock lock(&mu);
+          ++a;
+          ++b;
+        } else {
+          turbo::DistributedReaderMutexLock lock(&mu);
+          if (a != b) inconsistent.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(0, inconsistent.load());
+  EXPECT_EQ(8 * 2000 / 16, a);
+  EXPECT_EQ(a, b);
+}
+
+}  // namespace
@@ -13,8 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef TURBO_FLAGS_INTERNAL_SEQUENCE_LOCK_H_
-#define TURBO_FLAGS_INTERNAL_SEQUENCE_LOCK_H_
+#ifndef TURBO_SYNCHRONIZATION_INTERNAL_SEQUENCE_LOCK_H_
+#define TURBO_SYNCHRONIZATION_INTERNAL_SEQUENCE_LOCK_H_
 
 #include <stddef.h>
 #include <stdint.h>
@@ -27,7 +27,7 @@
 
 namespace turbo {
 TURBO_NAMESPACE_BEGIN
-namespace flags_internal {
+namespace synchronization_internal {
 
 // Align 'x' up to the nearest 'align' bytes.
 inline constexpr size_t AlignUp(size_t x, size_t align) {
@@ -43,8 +43,8 @@ inline constexpr size_t AlignUp(size_t x, size_t align) {
 //
 // This particular SequenceLock starts in an "uninitialized" state in which
 // TryRead() returns false. It must be enabled by calling MarkInitialized().
-// This serves as a marker that the associated flag value has not yet been
-// initialized and a slow path needs to be taken.
+// This serves as a marker that the protected data, such as the value of a
+// flag, has not yet been initialized and a slow path needs to be taken.
 //
 // The memory reads and writes protected by this lock must use the provided
 // `TryRead()` and `Write()` functions. These functions behave similarly to
@@ -180,8 +180,8 @@ class SequenceLock {
   std::atomic<int64_t> lock_;
 };
 
-}  // namespace flags_internal
+}  // namespace synchronization_internal
 TURBO_NAMESPACE_END
 }  // namespace turbo
 
-#endif  // TURBO_FLAGS_INTERNAL_SEQUENCE_LOCK_H_
+#endif  // TURBO_SYNCHRONIZATION_INTERNAL_SEQUENCE_LOCK_H_
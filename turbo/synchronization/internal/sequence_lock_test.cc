@@ -11,7 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-#include "turbo/flags/internal/sequence_lock.h"
+#include "turbo/synchronization/internal/sequence_lock.h"
 
 #include <algorithm>
 #include <atomic>
@@ -26,7 +26,7 @@
 
 namespace {
 
-namespace flags = turbo::flags_internal;
+namespace flags = turbo::synchronization_internal;
 
 class ConcurrentSequenceLockTest
     : public testing::TestWithParam<std::tuple<int, int>> {
@@ -0,0 +1,93 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/internal/sharded_counters.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <new>
+
+#include "turbo/base/bits.h"
+#include "turbo/platform/internal/sysinfo.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace synchronization_internal {
+namespace {
+
+// More shards than this cost readers of the sum more than they save writers.
+constexpr size_t kMaxCounterShards = 64;
+
+static_assert(sizeof(PaddedCounter) % TURBO_CACHELINE_SIZE == 0,
+              "PaddedCounter must fill whole cache lines");
+
+size_t ThreadShard() {
+  static std::atomic<size_t> next_thread{0};
+  static thread_local size_t thread_shard =
+      next_thread.fetch_add(1, std::memory_order_relaxed);
+  return thread_shard;
+}
+
+char* AllocateCounters(size_t size) {
+  return new char[size * sizeof(PaddedCounter) + TURBO_CACHELINE_SIZE - 1];
+}
+
+PaddedCounter* ConstructCounters(char* storage, size_t size) {
+  constexpr uintptr_t kMask = TURBO_CACHELINE_SIZE - 1;
+  char* const aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(storage) + kMask) & ~kMask);
+  PaddedCounter* const counters = reinterpret_cast<PaddedCounter*>(aligned);
+  for (size_t i = 0; i < size; ++i) new (&counters[i]) PaddedCounter();
+  return counters;
+}
+
+}  // namespace
+
+size_t NumCounterShards() {
+  static const size_t num_shards = [] {
+    const int cpus = std::max(base_internal::NumCPUs(), 1);
+    return std::min(turbo::bit_ceil(static_cast<size_t>(cpus)),
+                    kMaxCounterShards);
+  }();
+  return num_shards;
+}
+
+size_t CounterShardIndex(size_t num_shards) {
+#if defined(__linux__) && defined(__GLIBC__)
+  // Recent glibc versions read the CPU from rseq, older ones from the vDSO;
+  // both are cheaper than a shared cache line miss.
+  const int cpu = sched_getcpu();
+  if (TURBO_PREDICT_TRUE(cpu >= 0)) {
+    return static_cast<size_t>(cpu) & (num_shards - 1);
+  }
+#endif
+  return ThreadShard() & (num_shards - 1);
+}
+
+PaddedCounterArray::PaddedCounterArray(size_t size)
+    : size_(size),
+      storage_(AllocateCounters(size)),
+      counters_(ConstructCounters(storage_, size)) {}
+
+PaddedCounterArray::~PaddedCounterArray() {
+  for (size_t i = 0; i < size_; ++i) counters_[i].~PaddedCounter();
+  delete[] storage_;
+}
+
+}  // namespace synchronization_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,79 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Counters split into cache line aligned shards, one per CPU, so that threads
+// running on different CPUs update them without contending. Used by
+// `turbo::DistributedRWMutex`, `turbo::AtomicSharedSnapshot` and the metrics
+// of turbo/profiling.
+
+#ifndef TURBO_SYNCHRONIZATION_INTERNAL_SHARDED_COUNTERS_H_
+#define TURBO_SYNCHRONIZATION_INTERNAL_SHARDED_COUNTERS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace synchronization_internal {
+
+// Returns the number of shards of sharded counters: the number of CPUs
+// rounded up to a power of two, at most 64.
+size_t NumCounterShards();
+
+// Returns the shard the calling thread should update among `num_shards`, a
+// power of two: the index of the current CPU where it is cheap to find, or
+// otherwise a per-thread index.
+size_t CounterShardIndex(size_t num_shards);
+
+// An atomic counter alone on its cache line.
+struct TURBO_CACHELINE_ALIGNED PaddedCounter {
+  std::atomic<int64_t> value{0};
+  char padding[TURBO_CACHELINE_SIZE - sizeof(std::atomic<int64_t>)];
+};
+
+// PaddedCounterArray
+//
+// A fixed size array of zeroed `PaddedCounter`s starting on a cache line
+// boundary, which `new PaddedCounter[]` does not guarantee before C++17.
+class PaddedCounterArray {
+ public:
+  explicit PaddedCounterArray(size_t size);
+  ~PaddedCounterArray();
+
+  PaddedCounterArray(const PaddedCounterArray&) = delete;
+  PaddedCounterArray& operator=(const PaddedCounterArray&) = delete;
+
+  PaddedCounter& operator[](size_t i) { return counters_[i]; }
+  const PaddedCounter& operator[](size_t i) const { return counters_[i]; }
+
+  PaddedCounter* data() { return counters_; }
+  const PaddedCounter* data() const { return counters_; }
+  size_t size() const { return size_; }
+
+ private:
+  const size_t size_;
+  // The allocation, over-sized by up to a cache line.
+  char* const storage_;
+  PaddedCounter* const counters_;
+};
+
+}  // namespace synchronization_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_SYNCHRONIZATION_INTERNAL_SHARDED_COUNTERS_H_
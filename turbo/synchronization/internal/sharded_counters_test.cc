@@ -0,0 +1,77 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/internal/sharded_counters.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/platform/port.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace synchronization_internal {
+namespace {
+
+TEST(PaddedCounter, FillsCacheLines) {
+  EXPECT_EQ(sizeof(PaddedCounter), size_t{TURBO_CACHELINE_SIZE});
+  EXPECT_EQ(alignof(PaddedCounter), size_t{TURBO_CACHELINE_SIZE});
+}
+
+TEST(PaddedCounterArray, CountersAreCacheLineAligned) {
+  // Interleave the arrays with small allocations so that they do not all
+  // start where the allocator happens to return aligned memory.
+  std::vector<std::unique_ptr<PaddedCounterArray>> arrays;
+  std::vector<std::unique_ptr<char[]>> fillers;
+  for (size_t size = 1; size <= 16; ++size) {
+    fillers.emplace_back(new char[size * 8]);
+    arrays.emplace_back(new PaddedCounterArray(size));
+    const PaddedCounterArray& counters = *arrays.back();
+    ASSERT_EQ(counters.size(), size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(&counters[i]) %
+                    TURBO_CACHELINE_SIZE,
+                0u);
+      EXPECT_EQ(counters[i].value.load(), 0);
+    }
+  }
+}
+
+TEST(PaddedCounterArray, CountersAreIndependent) {
+  PaddedCounterArray counters(4);
+  for (size_t i = 0; i < counters.size(); ++i) {
+    counters[i].value.fetch_add(static_cast<int64_t>(i) + 1);
+  }
+  for (size_t i = 0; i < counters.size(); ++i) {
+    EXPECT_EQ(counters.data()[i].value.load(), static_cast<int64_t>(i) + 1);
+  }
+}
+
+TEST(CounterShardIndex, IsInRange) {
+  const size_t num_shards = NumCounterShards();
+  ASSERT_GE(num_shards, 1u);
+  ASSERT_LE(num_shards, 64u);
+  EXPECT_EQ(num_shards & (num_shards - 1), 0u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_LT(CounterShardIndex(num_shards), num_shards);
+    EXPECT_EQ(CounterShardIndex(1), 0u);
+  }
+}
+
+}  // namespace
+}  // namespace synchronization_internal
+TURBO_NAMESPACE_END
+}  // namespace turbo
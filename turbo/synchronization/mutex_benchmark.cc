@@ -21,6 +21,7 @@
 #include "turbo/platform/internal/cycleclock.h"
 #include "turbo/platform/internal/spinlock.h"
 #include "turbo/synchronization/blocking_counter.h"
+#include "turbo/synchronization/distributed_rw_mutex.h"
 #include "turbo/synchronization/internal/thread_pool.h"
 #include "turbo/synchronization/mutex.h"
 
@@ -247,6 +248,50 @@ BENCHMARK_TEMPLATE(BM_Contended, std::mutex)
       SetupBenchmarkArgs(bm, /*do_test_priorities=*/false);
     });
 
+// Measures read throughput of read-mostly data: one in `1 << 16` iterations
+// takes the lock exclusively.
+template <typename MutexType>
+void BM_ReadMostly(benchmark::State& state) {
+  struct Shared {
+    MutexType mu;
+    int data[4] = {};
+  };
+  static auto* shared = new Shared;
+  int local = 0;
+  int64_t iterations = 0;
+  for (auto _ : state) {
+    if (TURBO_PREDICT_FALSE((++iterations & 0xffff) == 0)) {
+      shared->mu.WriterLock();
+      ++shared->data[0];
+      shared->mu.WriterUnlock();
+    } else {
+      shared->mu.ReaderLock();
+      local += shared->data[state.thread_index() & 3];
+      shared->mu.ReaderUnlock();
+    }
+    DelayNs(state.range(0), &local);
+  }
+  benchmark::DoNotOptimize(local);
+}
+
+void SetupReadMostlyArgs(benchmark::internal::Benchmark* bm) {
+  bm->UseRealTime()
+      ->Threads(1)
+      ->Threads(2)
+      ->Threads(4)
+      ->Threads(8)
+      ->Threads(16)
+      ->Threads(32)
+      ->Threads(64)
+      ->ArgName("work_ns")
+      ->Arg(0)
+      ->Arg(100);
+}
+
+BENCHMARK_TEMPLATE(BM_ReadMostly, turbo::Mutex)->Apply(SetupReadMostlyArgs);
+BENCHMARK_TEMPLATE(BM_ReadMostly, turbo::DistributedRWMutex)
+    ->Apply(SetupReadMostlyArgs);
+
 // Measure the overhead of conditions on mutex release (when they must be
 // evaluated).  Mutex has (some) support for equivalence classes allowing
 // Conditions with the same function/argument to potentially not be multiply
@@ -0,0 +1,132 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: seq_locked.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::SeqLocked<T>`, a value of a small trivially
+// copyable type which is read often and written rarely, such as a set of
+// configuration knobs read on a hot path.
+//
+// Reads do not write to shared memory: they copy the value and retry if a
+// write happened concurrently, using the sequence lock which also protects the
+// values of flags. Readers therefore never contend with each other, and only
+// retry while a write is in progress.
+//
+// Example:
+//
+//   struct Limits {
+//     int max_connections;
+//     int64_t max_request_bytes;
+//   };
+//   turbo::SeqLocked<Limits> limits(Limits{100, 1 << 20});
+//
+//   // On the hot path:
+//   if (request.size() > limits.Load().max_request_bytes) { ... }
+//
+//   // Rarely:
+//   limits.Update([](Limits* l) { l->max_connections *= 2; });
+//
+// As every read copies the whole value, `SeqLocked` suits values of up to a
+// few cache lines. For larger or non trivially copyable values, see
+// `turbo::AtomicSharedSnapshot` in atomic_shared_snapshot.h.
+
+#ifndef TURBO_SYNCHRONIZATION_SEQ_LOCKED_H_
+#define TURBO_SYNCHRONIZATION_SEQ_LOCKED_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
+#include <type_traits>
+
+#include "turbo/platform/port.h"
+#include "turbo/synchronization/internal/sequence_lock.h"
+#include "turbo/synchronization/mutex.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// SeqLocked
+//
+// A value of type `T` with lock-free reads. `T` must be trivially copyable and
+// default constructible. Thread-safe.
+template <typename T>
+class SeqLocked {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLocked requires a trivially copyable type");
+  static_assert(std::is_default_constructible<T>::value,
+                "SeqLocked requires a default constructible type");
+
+ public:
+  SeqLocked() : SeqLocked(T()) {}
+
+  explicit SeqLocked(const T& value) {
+    lock_.MarkInitialized();
+    lock_.Write(words_, &value, sizeof(T));
+  }
+
+  SeqLocked(const SeqLocked&) = delete;
+  SeqLocked& operator=(const SeqLocked&) = delete;
+
+  // Returns a copy of the value. Retries while writes are in progress.
+  T Load() const {
+    T value{};
+    for (int attempt = 0; !lock_.TryRead(&value, words_, sizeof(T));
+         ++attempt) {
+      // The writer may have been preempted in the middle of a write.
+      if (attempt >= 16) std::this_thread::yield();
+    }
+    return value;
+  }
+
+  // Replaces the value.
+  void Store(const T& value) {
+    MutexLock lock(&write_mu_);
+    lock_.Write(words_, &value, sizeof(T));
+  }
+
+  // Calls `f(T*)` on a copy of the value and stores the result. Writers are
+  // serialized, so concurrent updates are not lost.
+  template <typename F>
+  void Update(F f) {
+    MutexLock lock(&write_mu_);
+    T value{};
+    // Writes are excluded, so the read cannot fail.
+    lock_.TryRead(&value, words_, sizeof(T));
+    f(&value);
+    lock_.Write(words_, &value, sizeof(T));
+  }
+
+  // Returns the number of writes since construction.
+  int64_t ModificationCount() const {
+    MutexLock lock(&write_mu_);
+    return lock_.ModificationCount() - 1;
+  }
+
+ private:
+  static constexpr size_t kNumWords =
+      synchronization_internal::AlignUp(sizeof(T), sizeof(uint64_t)) /
+      sizeof(uint64_t);
+
+  synchronization_internal::SequenceLock lock_;
+  std::atomic<uint64_t> words_[kNumWords];
+  mutable Mutex write_mu_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_SYNCHRONIZATION_SEQ_LOCKED_H_
@@ -0,0 +1,90 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/synchronization/seq_locked.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Not a multiple of 8 bytes, to cover partial words.
+struct Config {
+  int64_t a;
+  int64_t b;
+  int32_t c;
+};
+
+TEST(SeqLockedTest, LoadAndStore) {
+  turbo::SeqLocked<Config> config(Config{1, 2, 3});
+  Config loaded = config.Load();
+  EXPECT_EQ(1, loaded.a);
+  EXPECT_EQ(2, loaded.b);
+  EXPECT_EQ(3, loaded.c);
+  EXPECT_EQ(0, config.ModificationCount());
+
+  config.Store(Config{4, 5, 6});
+  loaded = config.Load();
+  EXPECT_EQ(4, loaded.a);
+  EXPECT_EQ(5, loaded.b);
+  EXPECT_EQ(6, loaded.c);
+  EXPECT_EQ(1, config.ModificationCount());
+}
+
+TEST(SeqLockedTest, DefaultConstructed) {
+  turbo::SeqLocked<int> value;
+  EXPECT_EQ(0, value.Load());
+  value.Update([](int* v) { *v += 5; });
+  EXPECT_EQ(5, value.Load());
+}
+
+// Writers keep all fields equal, which readers must never see differ.
+TEST(SeqLockedTest, ReadsAreConsistent) {
+  turbo::SeqLocked<Config> config(Config{0, 0, 0});
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        const Config c = config.Load();
+        if (c.a != c.b || c.b != c.c) inconsistent.fetch_add(1);
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 2; ++i) {
+    writers.emplace_back([&] {
+      for (int j = 0; j < 10000; ++j) {
+        config.Update([](Config* c) {
+          ++c->a;
+          ++c->b;
+          ++c->c;
+        });
+      }
+    });
+  }
+  for (std::thread& t : writers) t.join();
+  done.store(true);
+  for (std::thread& t : readers) t.join();
+  EXPECT_EQ(0, inconsistent.load());
+  EXPECT_EQ(20000, config.Load().c);
+  EXPECT_EQ(20000, config.ModificationCount());
+}
+
+}  // namespace
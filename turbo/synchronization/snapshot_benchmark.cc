@@ -0,0 +1,77 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares reads of a rarely written configuration snapshot.
+
+#include <cstdint>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "turbo/synchronization/atomic_shared_snapshot.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/synchronization/seq_locked.h"
+
+namespace {
+
+struct Config {
+  int64_t limits[4];
+};
+
+void ApplyThreads(benchmark::internal::Benchmark* bm) {
+  bm->UseRealTime()->Threads(1)->Threads(2)->Threads(4)->Threads(8)->Threads(
+      16);
+}
+
+void BM_SeqLockedLoad(benchmark::State& state) {
+  static auto* config = new turbo::SeqLocked<Config>(Config{{1, 2, 3, 4}});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(config->Load().limits[2]);
+  }
+}
+BENCHMARK(BM_SeqLockedLoad)->Apply(ApplyThreads);
+
+void BM_MutexReaderLock(benchmark::State& state) {
+  struct Shared {
+    turbo::Mutex mu;
+    Config config = {{1, 2, 3, 4}};
+  };
+  static auto* shared = new Shared;
+  for (auto _ : state) {
+    turbo::ReaderMutexLock lock(&shared->mu);
+    benchmark::DoNotOptimize(shared->config.limits[2]);
+  }
+}
+BENCHMARK(BM_MutexReaderLock)->Apply(ApplyThreads);
+
+void BM_SharedPtrAtomicLoad(benchmark::State& state) {
+  static auto* config =
+      new std::shared_ptr<const Config>(new Config{{1, 2, 3, 4}});
+  for (auto _ : state) {
+    std::shared_ptr<const Config> snapshot = std::atomic_load(config);
+    benchmark::DoNotOptimize(snapshot->limits[2]);
+  }
+}
+BENCHMARK(BM_SharedPtrAtomicLoad)->Apply(ApplyThreads);
+
+void BM_AtomicSharedSnapshotRead(benchmark::State& state) {
+  static auto* config =
+      new turbo::AtomicSharedSnapshot<Config>(Config{{1, 2, 3, 4}});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        config->Read([](const Config& c) { return c.limits[2]; }));
+  }
+}
+BENCHMARK(BM_AtomicSharedSnapshotRead)->Apply(ApplyThreads);
+
+}  // namespace
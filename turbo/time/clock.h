@@ -22,6 +22,8 @@
 #ifndef TURBO_TIME_CLOCK_H_
 #define TURBO_TIME_CLOCK_H_
 
+#include <cstdint>
+
 #include "turbo/platform/port.h"
 #include "turbo/time/time.h"
 
@@ -41,6 +43,60 @@ turbo::Time Now();
 // this function hundreds of thousands of times per second).
 int64_t GetCurrentTimeNanos();
 
+// CoarseNow()
+//
+// Returns the current time with a granularity of about a millisecond, as last
+// read by a background thread which the first call starts. Reading it costs
+// about as much as reading a global variable, which makes it suitable for
+// hot paths which only need a rough timestamp, like expiration checks.
+//
+// The granularity may be coarser when the machine is overloaded, as the
+// background thread is then scheduled late. The result may go backwards when
+// the system clock is set.
+turbo::Time CoarseNow();
+
+// FastMonotonicNanos()
+//
+// Returns the number of nanoseconds since an unspecified point in the past,
+// read directly from the CPU cycle counter and scaled at its calibrated rate.
+// The result never decreases in a thread, and is not affected by changes to
+// the system clock. It is cheaper than `turbo::Now()` and than
+// `std::chrono::steady_clock::now()`, but drifts from the latter by the error
+// of the calibration; see `RecalibrateFastMonotonicClock()`.
+//
+// Results are comparable between threads on platforms where the cycle
+// counters of CPUs are synchronized, as with the invariant TSC of x86 CPUs.
+int64_t FastMonotonicNanos();
+
+// FastMonotonicClockCalibration
+//
+// The parameters `turbo::FastMonotonicNanos()` converts cycle counts with:
+//
+//   nanos = base_nanos + (cycles - base_cycles) * 1e9 / cycles_per_second
+//
+// where `cycles` is the value of `turbo::base_internal::CycleClock::Now()`.
+struct FastMonotonicClockCalibration {
+  int64_t base_cycles;
+  int64_t base_nanos;
+  double cycles_per_second;
+};
+
+// GetFastMonotonicClockCalibration()
+//
+// Returns the current calibration of `turbo::FastMonotonicNanos()`.
+FastMonotonicClockCalibration GetFastMonotonicClockCalibration();
+
+// RecalibrateFastMonotonicClock()
+//
+// Measures the rate of the cycle counter against
+// `std::chrono::steady_clock` since the previous calibration, and uses it in
+// `turbo::FastMonotonicNanos()` from now on. The first calibration uses the
+// nominal rate of the counter, so a program which needs accurate durations
+// over long periods should call this function every few seconds. Results
+// still never decrease: when `FastMonotonicNanos()` got ahead of the steady
+// clock, it runs slower until the next calibration instead of going back.
+void RecalibrateFastMonotonicClock();
+
 // SleepFor()
 //
 // Sleeps for the specified duration, expressed as an `turbo::Duration`.
@@ -18,6 +18,7 @@
 #else
 #include <winsock2.h>
 #endif  // _WIN32
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdio>
 
 #include "turbo/platform/internal/cycleclock.h"
@@ -46,6 +47,33 @@ void BM_Clock_Now_TurboTime_ToUnixNanos(benchmark::State& state) {
 }
 BENCHMARK(BM_Clock_Now_TurboTime_ToUnixNanos);
 
+void BM_Clock_CoarseNow(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(turbo::CoarseNow());
+  }
+}
+BENCHMARK(BM_Clock_CoarseNow);
+
+void BM_Clock_FastMonotonicNanos(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(turbo::FastMonotonicNanos());
+  }
+}
+BENCHMARK(BM_Clock_FastMonotonicNanos);
+
+void BM_Clock_SteadyClock(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+  }
+}
+BENCHMARK(BM_Clock_SteadyClock);
+
+// The clocks above under load from other threads reading them.
+BENCHMARK(BM_Clock_Now_TurboTime)->ThreadRange(1, 8);
+BENCHMARK(BM_Clock_CoarseNow)->ThreadRange(1, 8);
+BENCHMARK(BM_Clock_FastMonotonicNanos)->ThreadRange(1, 8);
+BENCHMARK(BM_Clock_SteadyClock)->ThreadRange(1, 8);
+
 void BM_Clock_Now_CycleClock(benchmark::State& state) {
   while (state.KeepRunning()) {
     benchmark::DoNotOptimize(turbo::base_internal::CycleClock::Now());
@@ -69,6 +97,16 @@ static void BM_Clock_Now_clock_gettime(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_Clock_Now_clock_gettime);
+
+#ifdef CLOCK_REALTIME_COARSE
+static void BM_Clock_Now_clock_gettime_coarse(benchmark::State& state) {
+  struct timespec ts;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(clock_gettime(CLOCK_REALTIME_COARSE, &ts));
+  }
+}
+BENCHMARK(BM_Clock_Now_clock_gettime_coarse)->ThreadRange(1, 8);
+#endif  // CLOCK_REALTIME_COARSE
 #endif  // _WIN32
 
 }  // namespace
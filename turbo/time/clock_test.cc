@@ -39,6 +39,51 @@ TEST(Time, Now) {
   EXPECT_GE(after, now);
 }
 
+TEST(Time, CoarseNow) {
+  const turbo::Time before = turbo::Now();
+  const turbo::Time coarse = turbo::CoarseNow();
+  EXPECT_LT(turbo::AbsDuration(coarse - before), turbo::Seconds(1));
+
+  // The background thread may be scheduled late on a loaded machine.
+  const turbo::Time deadline = turbo::Now() + turbo::Seconds(30);
+  while (turbo::CoarseNow() <= coarse && turbo::Now() < deadline) {
+    turbo::SleepFor(turbo::Milliseconds(1));
+  }
+  EXPECT_GT(turbo::CoarseNow(), coarse);
+}
+
+TEST(Time, FastMonotonicNanos) {
+  int64_t last = turbo::FastMonotonicNanos();
+  for (int i = 0; i < 100000; ++i) {
+    const int64_t now = turbo::FastMonotonicNanos();
+    ASSERT_GE(now, last);
+    last = now;
+  }
+
+  const int64_t before = turbo::FastMonotonicNanos();
+  turbo::SleepFor(turbo::Milliseconds(100));
+  const int64_t elapsed = turbo::FastMonotonicNanos() - before;
+  EXPECT_GE(elapsed, 90 * 1000 * 1000);
+  EXPECT_LT(elapsed, 10 * 1000 * 1000 * int64_t{1000});
+}
+
+TEST(Time, RecalibrateFastMonotonicClock) {
+  const turbo::FastMonotonicClockCalibration initial =
+      turbo::GetFastMonotonicClockCalibration();
+  EXPECT_GT(initial.cycles_per_second, 0);
+  const int64_t before = turbo::FastMonotonicNanos();
+  turbo::SleepFor(turbo::Milliseconds(50));
+  turbo::RecalibrateFastMonotonicClock();
+  EXPECT_GE(turbo::FastMonotonicNanos(), before + 50 * 1000 * 1000);
+
+  const turbo::FastMonotonicClockCalibration recalibrated =
+      turbo::GetFastMonotonicClockCalibration();
+  EXPECT_GT(recalibrated.base_cycles, initial.base_cycles);
+  EXPECT_GE(recalibrated.base_nanos, before);
+  EXPECT_NEAR(initial.cycles_per_second, recalibrated.cycles_per_second,
+              initial.cycles_per_second / 4);
+}
+
 enum class AlarmPolicy { kWithoutAlarm, kWithAlarm };
 
 #if defined(TURBO_HAVE_ALARM)
@@ -0,0 +1,230 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The clocks of clock.h which trade accuracy for speed: CoarseNow() and
+// FastMonotonicNanos().
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "turbo/base/int128.h"
+#include "turbo/platform/internal/cycleclock.h"
+#include "turbo/platform/internal/spinlock.h"
+#include "turbo/platform/port.h"
+#include "turbo/platform/thread_annotations.h"
+#include "turbo/time/clock.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace {
+
+// ---------------------------------------------------------------------
+// CoarseNow()
+
+// The interval between updates of the coarse clock.
+constexpr turbo::Duration kCoarseClockTick = turbo::Milliseconds(1);
+
+// The current time in nanoseconds as of the last tick, or 0 while no thread
+// updates it.
+TURBO_CONST_INIT std::atomic<int64_t> coarse_now_nanos{0};
+TURBO_CONST_INIT std::atomic<bool> coarse_ticker_started{false};
+
+void CoarseTicker() {
+  while (true) {
+    coarse_now_nanos.store(turbo::GetCurrentTimeNanos(),
+                           std::memory_order_relaxed);
+    turbo::SleepFor(kCoarseClockTick);
+  }
+}
+
+#ifndef _WIN32
+// The ticker thread does not survive fork(): the child starts its own.
+void ResetCoarseClockInChild() {
+  coarse_now_nanos.store(0, std::memory_order_relaxed);
+  coarse_ticker_started.store(false, std::memory_order_relaxed);
+}
+#endif
+
+TURBO_ATTRIBUTE_NOINLINE int64_t StartCoarseClock() {
+  const int64_t now = turbo::GetCurrentTimeNanos();
+  if (!coarse_ticker_started.exchange(true, std::memory_order_acq_rel)) {
+#ifndef _WIN32
+    static const bool registered = [] {
+      pthread_atfork(nullptr, nullptr, ResetCoarseClockInChild);
+      return true;
+    }();
+    static_cast<void>(registered);
+#endif
+    coarse_now_nanos.store(now, std::memory_order_relaxed);
+    std::thread(CoarseTicker).detach();
+  }
+  return now;
+}
+
+// ---------------------------------------------------------------------
+// FastMonotonicNanos()
+
+// Nanoseconds per cycle are scaled by 2^kScale.
+constexpr int kScale = 32;
+
+int64_t SteadyNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct TURBO_CACHELINE_ALIGNED FastClockState {
+  // Readers retry while `seq` is odd or changed: the calibration is written
+  // between two increments.
+  std::atomic<uint64_t> seq{0};
+  std::atomic<int64_t> base_cycles{0};
+  std::atomic<int64_t> base_nanos{0};
+  // Zero until the first calibration.
+  std::atomic<uint64_t> scaled_nanos_per_cycle{0};
+
+  base_internal::SpinLock lock{turbo::kConstInit,
+                               base_internal::SCHEDULE_KERNEL_ONLY};
+  double cycles_per_second TURBO_GUARDED_BY(lock) = 0;
+  // The cycle counter and steady clock at the last calibration.
+  int64_t sample_cycles TURBO_GUARDED_BY(lock) = 0;
+  int64_t sample_nanos TURBO_GUARDED_BY(lock) = 0;
+};
+TURBO_CONST_INIT FastClockState fast_clock;
+
+// Reads the cycle counter and the steady clock at about the same time.
+void SampleClocks(int64_t* cycles, int64_t* nanos) {
+  const int64_t before = base_internal::CycleClock::Now();
+  *nanos = SteadyNanos();
+  const int64_t after = base_internal::CycleClock::Now();
+  *cycles = before + (after - before) / 2;
+}
+
+int64_t ToNanos(int64_t cycles, int64_t base_cycles, int64_t base_nanos,
+                uint64_t scaled_nanos_per_cycle) {
+  // A thread which moved to a CPU whose counter is slightly behind may read
+  // a count before the calibration.
+  const uint64_t elapsed =
+      static_cast<uint64_t>(std::max<int64_t>(cycles - base_cycles, 0));
+  const turbo::uint128 scaled =
+      turbo::uint128(elapsed) * turbo::uint128(scaled_nanos_per_cycle);
+  return base_nanos + static_cast<int64_t>(scaled >> kScale);
+}
+
+void Calibrate(int64_t base_cycles, int64_t base_nanos,
+               double cycles_per_second)
+    TURBO_EXCLUSIVE_LOCKS_REQUIRED(fast_clock.lock) {
+  fast_clock.cycles_per_second = cycles_per_second;
+  const uint64_t seq = fast_clock.seq.load(std::memory_order_relaxed);
+  fast_clock.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  fast_clock.base_cycles.store(base_cycles, std::memory_order_relaxed);
+  fast_clock.base_nanos.store(base_nanos, std::memory_order_relaxed);
+  fast_clock.scaled_nanos_per_cycle.store(
+      static_cast<uint64_t>(1e9 * static_cast<double>(uint64_t{1} << kScale) /
+                            cycles_per_second),
+      std::memory_order_relaxed);
+  fast_clock.seq.store(seq + 2, std::memory_order_release);
+}
+
+TURBO_ATTRIBUTE_NOINLINE void InitializeFastClock() {
+  base_internal::SpinLockHolder l(&fast_clock.lock);
+  if (fast_clock.scaled_nanos_per_cycle.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+  SampleClocks(&fast_clock.sample_cycles, &fast_clock.sample_nanos);
+  Calibrate(fast_clock.sample_cycles, fast_clock.sample_nanos,
+            base_internal::CycleClock::Frequency());
+}
+
+}  // namespace
+
+Time CoarseNow() {
+  int64_t n = coarse_now_nanos.load(std::memory_order_relaxed);
+  if (TURBO_PREDICT_FALSE(n == 0)) n = StartCoarseClock();
+  return time_internal::FromUnixDuration(
+      time_internal::MakeDuration(n / 1000000000, n % 1000000000 * 4));
+}
+
+int64_t FastMonotonicNanos() {
+  const int64_t cycles = base_internal::CycleClock::Now();
+  while (true) {
+    const uint64_t seq0 = fast_clock.seq.load(std::memory_order_acquire);
+    const int64_t base_cycles =
+        fast_clock.base_cycles.load(std::memory_order_relaxed);
+    const int64_t base_nanos =
+        fast_clock.base_nanos.load(std::memory_order_relaxed);
+    const uint64_t scaled_nanos_per_cycle =
+        fast_clock.scaled_nanos_per_cycle.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t seq1 = fast_clock.seq.load(std::memory_order_relaxed);
+    if (TURBO_PREDICT_FALSE(seq0 != seq1 || (seq0 & 1) != 0)) continue;
+    if (TURBO_PREDICT_FALSE(scaled_nanos_per_cycle == 0)) {
+      InitializeFastClock();
+      continue;
+    }
+    return ToNanos(cycles, base_cycles, base_nanos, scaled_nanos_per_cycle);
+  }
+}
+
+FastMonotonicClockCalibration GetFastMonotonicClockCalibration() {
+  FastMonotonicNanos();  // Initializes the calibration.
+  base_internal::SpinLockHolder l(&fast_clock.lock);
+  return {fast_clock.base_cycles.load(std::memory_order_relaxed),
+          fast_clock.base_nanos.load(std::memory_order_relaxed),
+          fast_clock.cycles_per_second};
+}
+
+void RecalibrateFastMonotonicClock() {
+  FastMonotonicNanos();  // Initializes the calibration.
+  base_internal::SpinLockHolder l(&fast_clock.lock);
+  int64_t cycles;
+  int64_t nanos;
+  SampleClocks(&cycles, &nanos);
+  const int64_t elapsed_cycles = cycles - fast_clock.sample_cycles;
+  const int64_t elapsed_nanos = nanos - fast_clock.sample_nanos;
+  // Shorter intervals measure the rate less accurately than the nominal one.
+  if (elapsed_cycles <= 0 || elapsed_nanos < 10 * 1000 * 1000) return;
+  const double measured = static_cast<double>(elapsed_cycles) * 1e9 /
+                          static_cast<double>(elapsed_nanos);
+
+  const int64_t current = ToNanos(
+      cycles, fast_clock.base_cycles.load(std::memory_order_relaxed),
+      fast_clock.base_nanos.load(std::memory_order_relaxed),
+      fast_clock.scaled_nanos_per_cycle.load(std::memory_order_relaxed));
+  double cycles_per_second = measured;
+  int64_t base_nanos = nanos;
+  if (current > nanos) {
+    // Going back to the steady clock would go back in time: run slower, to
+    // catch up with it over an interval as long as the last one.
+    base_nanos = current;
+    const double ahead = static_cast<double>(current - nanos);
+    cycles_per_second =
+        measured * static_cast<double>(elapsed_nanos) /
+        std::max(static_cast<double>(elapsed_nanos) - ahead,
+                 static_cast<double>(elapsed_nanos) / 2);
+  }
+  fast_clock.sample_cycles = cycles;
+  fast_clock.sample_nanos = nanos;
+  Calibrate(cycles, base_nanos, cycles_per_second);
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
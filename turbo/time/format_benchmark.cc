@@ -12,10 +12,14 @@
 // limitations under the License.
 
 #include <cstddef>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "turbo/time/internal/test_util.h"
 #include "turbo/time/time.h"
+#include "turbo/time/time_formatter.h"
+#include "turbo/time/time_parser.h"
 #include "benchmark/benchmark.h"
 
 namespace {
@@ -46,6 +50,50 @@ void BM_Format_FormatTime(benchmark::State& state) {
 }
 BENCHMARK(BM_Format_FormatTime)->DenseRange(0, kNumFormats - 1);
 
+void BM_Format_TimeFormatter(benchmark::State& state) {
+  const std::string fmt = kFormats[state.range(0)];
+  state.SetLabel(fmt);
+  const turbo::TimeZone lax =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  const turbo::TimeFormatter formatter(fmt, lax);
+  const turbo::Time t =
+      turbo::FromCivil(turbo::CivilSecond(1977, 6, 28, 9, 8, 7), lax) +
+      turbo::Nanoseconds(1);
+  char buf[64];
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(formatter.Format(t, buf, sizeof(buf)));
+  }
+}
+BENCHMARK(BM_Format_TimeFormatter)->DenseRange(0, kNumFormats - 1);
+
+// Formats increasing times, like the timestamps of log lines: `state.range(0)`
+// is the number of nanoseconds between them.
+void BM_Format_FormatTime_Increasing(benchmark::State& state) {
+  const turbo::TimeZone lax =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  const turbo::Duration step = turbo::Nanoseconds(state.range(0));
+  turbo::Time t = turbo::FromCivil(turbo::CivilSecond(2023, 6, 28, 9, 8, 7), lax);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(turbo::FormatTime(turbo::RFC3339_full, t, lax));
+    t += step;
+  }
+}
+BENCHMARK(BM_Format_FormatTime_Increasing)->Arg(1000)->Arg(1000000000);
+
+void BM_Format_TimeFormatter_Increasing(benchmark::State& state) {
+  const turbo::TimeZone lax =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  const turbo::TimeFormatter formatter(turbo::RFC3339_full, lax);
+  const turbo::Duration step = turbo::Nanoseconds(state.range(0));
+  turbo::Time t = turbo::FromCivil(turbo::CivilSecond(2023, 6, 28, 9, 8, 7), lax);
+  char buf[64];
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(formatter.Format(t, buf, sizeof(buf)));
+    t += step;
+  }
+}
+BENCHMARK(BM_Format_TimeFormatter_Increasing)->Arg(1000)->Arg(1000000000);
+
 void BM_Format_ParseTime(benchmark::State& state) {
   const std::string fmt = kFormats[state.range(0)];
   state.SetLabel(fmt);
@@ -61,4 +109,80 @@ void BM_Format_ParseTime(benchmark::State& state) {
 }
 BENCHMARK(BM_Format_ParseTime)->DenseRange(0, kNumFormats - 1);
 
+// Returns a million timestamps of the last few years in the given format.
+std::vector<std::string> Timestamps(const char* format) {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> nanos(
+      int64_t{1600000000} * 1000000000, int64_t{1700000000} * 1000000000);
+  std::vector<std::string> timestamps;
+  for (int i = 0; i < 1000000; ++i) {
+    timestamps.push_back(turbo::FormatTime(
+        format, turbo::FromUnixNanos(nanos(gen)), turbo::UTCTimeZone()));
+  }
+  return timestamps;
+}
+
+template <typename Parse>
+void ParseTimestamps(benchmark::State& state, const char* format,
+                     Parse parse) {
+  static const auto* const timestamps =
+      new std::vector<std::string>(Timestamps(format));
+  size_t i = 0;
+  turbo::Time t;
+  std::string err;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(parse((*timestamps)[i], &t, &err));
+    if (++i == timestamps->size()) i = 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Parse_RFC3339_ParseTime(benchmark::State& state) {
+  ParseTimestamps(state, turbo::RFC3339_full,
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseTime(turbo::RFC3339_full, s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_RFC3339_ParseTime);
+
+void BM_Parse_RFC3339_ParseRFC3339Time(benchmark::State& state) {
+  ParseTimestamps(state, turbo::RFC3339_full,
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseRFC3339Time(s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_RFC3339_ParseRFC3339Time);
+
+void BM_Parse_Unix_ParseTime(benchmark::State& state) {
+  ParseTimestamps(state, "%s",
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseTime("%s", s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_Unix_ParseTime);
+
+void BM_Parse_Unix_ParseUnixTime(benchmark::State& state) {
+  ParseTimestamps(state, "%s",
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseUnixTime(s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_Unix_ParseUnixTime);
+
+void BM_Parse_CommonLog_ParseTime(benchmark::State& state) {
+  ParseTimestamps(state, turbo::CommonLog_time,
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseTime(turbo::CommonLog_time, s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_CommonLog_ParseTime);
+
+void BM_Parse_CommonLog_ParseCommonLogTime(benchmark::State& state) {
+  ParseTimestamps(state, turbo::CommonLog_time,
+                  [](const std::string& s, turbo::Time* t, std::string* err) {
+                    return turbo::ParseCommonLogTime(s, t, err);
+                  });
+}
+BENCHMARK(BM_Parse_CommonLog_ParseCommonLogTime);
+
 }  // namespace
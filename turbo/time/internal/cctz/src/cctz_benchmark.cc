@@ -23,6 +23,7 @@
 #include "benchmark/benchmark.h"
 #include "turbo/time/internal/cctz/include/cctz/civil_time.h"
 #include "turbo/time/internal/cctz/include/cctz/time_zone.h"
+#include "turbo/time/time.h"
 #include "time_zone_impl.h"
 
 namespace {
@@ -893,6 +894,58 @@ void BM_Time_ToCivilUTC_Libc(benchmark::State& state) {
 }
 BENCHMARK(BM_Time_ToCivilUTC_Libc);
 
+// The "Batch" benchmarks convert 64K times from 2000 to 2030 in the
+// Google/local time zone (arg 0) or UTC (arg 1), either sorted, a few minutes
+// apart, or shuffled, one at a time with turbo::ToCivilSecond() ("Each") or
+// all together with turbo::ToCivilBatch().
+
+std::vector<turbo::Time> BatchTimes(bool sorted) {
+  std::mt19937_64 gen(42);
+  std::vector<turbo::Time> times(1 << 16);
+  const int64_t begin = 946684800;  // 2000-01-01T00:00:00+00:00
+  const int64_t end = 1893456000;   // 2030-01-01T00:00:00+00:00
+  int64_t sec = begin;
+  for (turbo::Time& t : times) {
+    sec = sorted ? sec + static_cast<int64_t>(gen() % 600)
+                 : begin + static_cast<int64_t>(gen() % (end - begin));
+    t = turbo::FromUnixSeconds(sec) + turbo::Nanoseconds(gen() % 1000000000);
+  }
+  return times;
+}
+
+turbo::TimeZone BatchTimeZone(const benchmark::State& state) {
+  return turbo::TimeZone(state.range(0) == 0 ? TestTimeZone()
+                                             : cctz::utc_time_zone());
+}
+
+void BM_Time_ToCivil_Each(benchmark::State& state, bool sorted) {
+  const turbo::TimeZone tz = BatchTimeZone(state);
+  const std::vector<turbo::Time> times = BatchTimes(sorted);
+  std::vector<turbo::CivilSecond> civil(times.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < times.size(); ++i) {
+      civil[i] = turbo::ToCivilSecond(times[i], tz);
+    }
+    benchmark::DoNotOptimize(civil.data());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+BENCHMARK_CAPTURE(BM_Time_ToCivil_Each, Sorted, true)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_Time_ToCivil_Each, Shuffled, false)->Arg(0)->Arg(1);
+
+void BM_Time_ToCivil_Batch(benchmark::State& state, bool sorted) {
+  const turbo::TimeZone tz = BatchTimeZone(state);
+  const std::vector<turbo::Time> times = BatchTimes(sorted);
+  std::vector<turbo::CivilSecond> civil(times.size());
+  for (auto _ : state) {
+    turbo::ToCivilBatch(times, tz, turbo::MakeSpan(civil));
+    benchmark::DoNotOptimize(civil.data());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+BENCHMARK_CAPTURE(BM_Time_ToCivil_Batch, Sorted, true)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_Time_ToCivil_Batch, Shuffled, false)->Arg(0)->Arg(1);
+
 // In each "FromCivil" benchmark we switch between two YMDhms values
 // separated by at least one transition in order to defeat any internal
 // caching of previous results (e.g., see time_local_hint_).
@@ -37,6 +37,8 @@
 #include <winsock2.h>  // for timeval
 #endif
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <ctime>
 #include <limits>
@@ -197,6 +199,53 @@ bool FindTransition(const cctz::time_zone& tz,
   return true;
 }
 
+// The seconds since the epoch which ToCivilBatch() converts without
+// TimeZone::At(Time), about 34000 years each way, so that its arithmetic
+// cannot overflow.
+constexpr int64_t kBatchLimit = int64_t{1} << 40;
+constexpr int64_t kSecsPerDay = 24 * 60 * 60;
+
+// A range of seconds since the epoch, [begin, end), in which the offset of a
+// time zone does not change.
+struct OffsetWindow {
+  int64_t begin;
+  int64_t end;
+  int64_t offset;
+};
+
+inline int64_t CivilToUnixSeconds(const CivilSecond& cs) {
+  return cs - CivilSecond(1970, 1, 1, 0, 0, 0);
+}
+
+// Converts `t`, which is `sec` seconds since the epoch, with TimeZone::At(),
+// and returns the window of `tz` around it.
+OffsetWindow MakeOffsetWindow(Time t, int64_t sec, TimeZone tz,
+                              CivilSecond* cs) {
+  const TimeZone::CivilInfo ci = tz.At(t);
+  *cs = ci.cs;
+  OffsetWindow w = {sec, sec + 1, ci.offset};
+  TimeZone::CivilTransition trans;
+  if (tz.NextTransition(t, &trans)) {
+    // `trans.from` is in the offset of `t`, and `trans.to` of the previous
+    // transition too.
+    w.end = std::min(CivilToUnixSeconds(trans.from) - w.offset, kBatchLimit);
+    if (tz.PrevTransition(t + Seconds(1), &trans)) {
+      w.begin =
+          std::max(CivilToUnixSeconds(trans.to) - w.offset, -kBatchLimit);
+    } else {
+      w.begin = -kBatchLimit;
+    }
+  } else if (!tz.PrevTransition(t, &trans) &&
+             tz.name().compare(0, 5, "libc:") != 0) {
+    // A zone without transitions, other than one of the C library, which
+    // cannot report them. The offsets of other zones after their last
+    // transition follow rules, so `t` gets a window of its own.
+    w.begin = -kBatchLimit;
+    w.end = kBatchLimit;
+  }
+  return w;
+}
+
 }  // namespace
 
 //
@@ -431,6 +480,71 @@ turbo::TimeConversion ConvertDateTime(int64_t year, int mon, int day, int hour,
   return tc;
 }
 
+void ToCivilBatch(turbo::Span<const Time> times, TimeZone tz,
+                  turbo::Span<CivilSecond> civil) {
+  // Windows which serve fewer times than this do not pay for the lookups of
+  // their transitions, so the next ones are skipped for a while.
+  constexpr int64_t kMinWindowHits = 4;
+  constexpr int64_t kMaxBackoff = 1024;
+  assert(civil.size() >= times.size());
+
+  OffsetWindow w = {0, 0, 0};
+  int64_t hits = -1;  // Of `w`, or -1 before `w` is made.
+  int64_t backoff = 0;
+  int64_t skip = 0;
+  // The civil day of the last conversion, as local seconds since the epoch.
+  int64_t day_begin = 0;
+  int64_t day_end = 0;
+  civil_year_t year = 0;
+  int month = 0;
+  int day = 0;
+  for (size_t i = 0; i < times.size(); ++i) {
+    const Time t = times[i];
+    const int64_t sec =
+        time_internal::GetRepHi(time_internal::ToUnixDuration(t));
+    if (TURBO_PREDICT_FALSE(sec < w.begin || sec >= w.end)) {
+      if (skip > 0 || sec < -kBatchLimit || sec >= kBatchLimit) {
+        if (skip > 0) --skip;
+        civil[i] = tz.At(t).cs;
+        continue;
+      }
+      if (hits >= 0 && hits < kMinWindowHits) {
+        backoff = std::min(2 * backoff + 1, kMaxBackoff);
+        skip = backoff;
+        hits = -1;
+        civil[i] = tz.At(t).cs;
+        continue;
+      }
+      if (hits >= kMinWindowHits) backoff = 0;
+      w = MakeOffsetWindow(t, sec, tz, &civil[i]);
+      hits = 0;
+      continue;
+    }
+    ++hits;
+    const int64_t local = sec + w.offset;
+    if (TURBO_PREDICT_FALSE(local < day_begin || local >= day_end)) {
+      // The civil date of the days since the epoch, per
+      // http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+      const int64_t days =
+          (local >= 0 ? local : local - (kSecsPerDay - 1)) / kSecsPerDay;
+      day_begin = days * kSecsPerDay;
+      day_end = day_begin + kSecsPerDay;
+      const int64_t z = days + 719468;
+      const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+      const int64_t doe = z - era * 146097;
+      const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+      const int64_t mp = (5 * doy + 2) / 153;
+      day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+      month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+      year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    }
+    const int sod = static_cast<int>(local - day_begin);
+    civil[i] = CivilSecond(year, month, day, sod / 3600, sod / 60 % 60,
+                           sod % 60);
+  }
+}
+
 turbo::Time FromTM(const struct tm& tm, turbo::TimeZone tz) {
   civil_year_t tm_year = tm.tm_year;
   // Avoids years that are too extreme for CivilSecond to normalize.
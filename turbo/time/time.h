@@ -84,6 +84,7 @@ struct timeval;
 #include <type_traits>
 #include <utility>
 
+#include "turbo/meta/span.h"
 #include "turbo/platform/port.h"
 #include "turbo/strings/string_view.h"
 #include "turbo/time/civil_time.h"
@@ -1209,6 +1210,25 @@ TURBO_ATTRIBUTE_PURE_FUNCTION inline CivilYear ToCivilYear(Time t, TimeZone tz)
   return CivilYear(tz.At(t).cs);
 }
 
+// ToCivilBatch()
+//
+// Converts each of `times` to its civil time in `tz`, as `ToCivilSecond()`
+// does, and stores it at the same index of `civil`, which must be at least as
+// large as `times`.
+//
+// Times between the same two offset changes of `tz` are converted with the
+// offset of the previous one, and times in the same civil day share the date
+// computation, so converting times which are sorted, or close to each other,
+// is much cheaper than calling `ToCivilSecond()` for each of them.
+//
+// Example:
+//
+//   std::vector<turbo::Time> times = ...;
+//   std::vector<turbo::CivilSecond> civil(times.size());
+//   turbo::ToCivilBatch(times, tz, turbo::MakeSpan(civil));
+void ToCivilBatch(turbo::Span<const Time> times, TimeZone tz,
+                  turbo::Span<CivilSecond> civil);
+
 // FromCivil()
 //
 // Helper for TimeZone::At(CivilSecond) that provides "order-preserving
@@ -0,0 +1,590 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/time_formatter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace time_internal {
+
+// The text of the last second formatted by a `TimeFormatter` in a thread,
+// and the civil time of the minute it belongs to.
+struct FormatterCacheEntry {
+  static constexpr size_t kMaxTextSize = 128;
+  static constexpr size_t kMaxHoles = 4;
+
+  // The `id_` of the formatter, or 0.
+  uint64_t id;
+
+  // Whether `text` holds the second `unix_seconds`.
+  bool has_second;
+  int64_t unix_seconds;
+  // The formatted second, without the fractional seconds, which are written
+  // at `holes[0, num_holes)`.
+  uint16_t size;
+  uint16_t num_holes;
+  uint16_t holes[kMaxHoles];
+  char text[kMaxTextSize];
+
+  // Whether the minute starting at `minute_start` has a single UTC offset,
+  // so that the civil time of its seconds follows from the civil minute.
+  bool has_minute;
+  int64_t minute_start;
+  int64_t year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int offset;
+  const char* zone_abbr;
+};
+
+}  // namespace time_internal
+
+namespace {
+
+using time_internal::FormatterCacheEntry;
+
+constexpr size_t kNumCacheEntries = 4;
+
+FormatterCacheEntry* CacheEntry(uint64_t id) {
+  static thread_local FormatterCacheEntry entries[kNumCacheEntries];
+  FormatterCacheEntry* entry = &entries[id & (kNumCacheEntries - 1)];
+  if (entry->id != id) {
+    entry->id = id;
+    entry->has_second = false;
+    entry->has_minute = false;
+  }
+  return entry;
+}
+
+uint64_t NextFormatterId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+const char kInfiniteFutureStr[] = "infinite-future";
+const char kInfinitePastStr[] = "infinite-past";
+
+// Writes to a caller buffer, and counts the characters which did not fit.
+class Writer {
+ public:
+  Writer(char* buf, size_t size) : p_(buf), avail_(size) {}
+
+  void Append(const char* s, size_t n) {
+    if (TURBO_PREDICT_TRUE(n <= avail_)) {
+      memcpy(p_, s, n);
+      p_ += n;
+      avail_ -= n;
+    } else {
+      memcpy(p_, s, avail_);
+      p_ += avail_;
+      avail_ = 0;
+    }
+    size_ += n;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  char* p_;
+  size_t avail_;
+  size_t size_ = 0;
+};
+
+// The helpers below follow those of cctz's format(): they write backwards
+// from `ep`, and the caller provides enough room.
+
+const char kDigits[] = "0123456789";
+
+// Formats `v` zero padded to `width` characters, including the sign.
+char* Format64(char* ep, int width, int64_t v) {
+  bool neg = false;
+  uint64_t u = static_cast<uint64_t>(v);
+  if (v < 0) {
+    --width;
+    neg = true;
+    u = 0 - u;
+  }
+  do {
+    --width;
+    *--ep = kDigits[u % 10];
+  } while (u /= 10);
+  while (--width >= 0) *--ep = '0';
+  if (neg) *--ep = '-';
+  return ep;
+}
+
+// Formats [0 .. 99] as %02d.
+char* Format02d(char* ep, int v) {
+  *--ep = kDigits[v % 10];
+  *--ep = kDigits[(v / 10) % 10];
+  return ep;
+}
+
+// Formats a UTC offset, like +00:00, in the given mode: "" for %z, ":" for
+// %Ez and %:z, ":*" for %E*z and %::z, ":*:" for %:::z.
+char* FormatOffset(char* ep, int offset, const char* mode) {
+  char sign = '+';
+  if (offset < 0) {
+    offset = -offset;
+    sign = '-';
+  }
+  const int seconds = offset % 60;
+  const int minutes = (offset /= 60) % 60;
+  const int hours = offset /= 60;
+  const char sep = mode[0];
+  const bool ext = (sep != '\0' && mode[1] == '*');
+  const bool ccc = (ext && mode[2] == ':');
+  if (ext && (!ccc || seconds != 0)) {
+    ep = Format02d(ep, seconds);
+    *--ep = sep;
+  } else {
+    // Sub-minute negative offsets get a positive sign when the seconds are
+    // not rendered.
+    if (hours == 0 && minutes == 0) sign = '+';
+  }
+  if (!ccc || minutes != 0 || seconds != 0) {
+    ep = Format02d(ep, minutes);
+    if (sep != '\0') *--ep = sep;
+  }
+  ep = Format02d(ep, hours);
+  *--ep = sign;
+  return ep;
+}
+
+constexpr int kMaxFractionDigits = 18;
+
+// 10^n for the fractional digits beyond femtoseconds.
+constexpr uint64_t kExp10[] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+};
+
+// Writes the fractional seconds of a kSubsecond segment of `width` digits,
+// or of all of its non-zero digits if `width` is -1, given the quarters of a
+// nanosecond of the time.
+template <typename Sink>
+void RenderSubsecond(int width, bool seconds, uint32_t rep_lo, Sink* sink) {
+  char buf[kMaxFractionDigits + 1];
+  char* const ep = buf + sizeof(buf);
+  const uint64_t femtos = uint64_t{rep_lo} * (1000 * 1000 / 4);
+  char* bp = ep;
+  if (width < 0) {
+    char* cp = ep;
+    bp = Format64(cp, 15, static_cast<int64_t>(femtos));
+    while (cp != bp && cp[-1] == '0') --cp;
+    if (cp != bp) {
+      if (seconds) *--bp = '.';
+    } else if (!seconds) {
+      *--bp = '0';
+      cp = bp + 1;
+    }
+    sink->Append(bp, static_cast<size_t>(cp - bp));
+    return;
+  }
+  if (width > 0) {
+    const uint64_t digits = width > 15 ? femtos * kExp10[width - 15]
+                                       : femtos / kExp10[15 - width];
+    bp = Format64(ep, width, static_cast<int64_t>(digits));
+    if (seconds) *--bp = '.';
+  }
+  sink->Append(bp, static_cast<size_t>(ep - bp));
+}
+
+// Writes the second directly to a caller buffer.
+class DirectSink {
+ public:
+  DirectSink(Writer* writer, uint32_t rep_lo)
+      : writer_(writer), rep_lo_(rep_lo) {}
+
+  void Append(const char* s, size_t n) { writer_->Append(s, n); }
+  void Subsecond(int width, bool seconds) {
+    RenderSubsecond(width, seconds, rep_lo_, writer_);
+  }
+
+ private:
+  Writer* writer_;
+  uint32_t rep_lo_;
+};
+
+// Writes the second to the text of a cache entry, leaving holes for the
+// fractional seconds.
+class CacheSink {
+ public:
+  explicit CacheSink(FormatterCacheEntry* entry) : entry_(entry) {
+    entry_->size = 0;
+    entry_->num_holes = 0;
+  }
+
+  void Append(const char* s, size_t n) {
+    if (n > FormatterCacheEntry::kMaxTextSize - entry_->size) {
+      overflow_ = true;
+      return;
+    }
+    memcpy(entry_->text + entry_->size, s, n);
+    entry_->size = static_cast<uint16_t>(entry_->size + n);
+  }
+  void Subsecond(int, bool) {
+    if (entry_->num_holes == FormatterCacheEntry::kMaxHoles) {
+      overflow_ = true;
+      return;
+    }
+    entry_->holes[entry_->num_holes++] = entry_->size;
+  }
+
+  bool overflow() const { return overflow_; }
+
+ private:
+  FormatterCacheEntry* entry_;
+  bool overflow_ = false;
+};
+
+}  // namespace
+
+TimeFormatter::TimeFormatter(turbo::string_view format, TimeZone tz)
+    : format_(format), tz_(tz), id_(NextFormatterId()) {
+  Compile();
+}
+
+void TimeFormatter::AddSegment(Kind kind, turbo::string_view text, int width,
+                               bool seconds) {
+  if (kind == Kind::kLiteral) {
+    if (text.empty()) return;
+    if (!segments_.empty() && segments_.back().kind == Kind::kLiteral) {
+      segments_.back().text.append(text.data(), text.size());
+      return;
+    }
+  }
+  if (kind == Kind::kSubsecond) subseconds_.push_back(segments_.size());
+  segments_.push_back(Segment{kind, width, seconds, std::string(text)});
+}
+
+// Splits the format the way cctz's format() interprets it.
+void TimeFormatter::Compile() {
+  rfc3339_ = format_ == RFC3339_full || format_ == RFC3339_sec;
+  const char* cur = format_.data();
+  const char* const end = cur + format_.size();
+  while (cur != end) {
+    const char* start = cur;
+    while (cur != end && *cur != '%') ++cur;
+    AddSegment(Kind::kLiteral, turbo::string_view(start, cur - start));
+
+    // Every pair of percent signs is a literal one, as is a trailing one.
+    const char* percent = cur;
+    while (cur != end && *cur == '%') ++cur;
+    const size_t percents = static_cast<size_t>(cur - percent);
+    AddSegment(Kind::kLiteral, turbo::string_view(percent, percents / 2));
+    if (percents % 2 == 0) continue;
+    if (cur == end) {
+      AddSegment(Kind::kLiteral, "%");
+      continue;
+    }
+
+    const char* const spec = cur - 1;
+    switch (*cur) {
+      case 'Y':
+        AddSegment(Kind::kYear);
+        ++cur;
+        continue;
+      case 'm':
+        AddSegment(Kind::kMonth);
+        ++cur;
+        continue;
+      case 'd':
+        AddSegment(Kind::kDay);
+        ++cur;
+        continue;
+      case 'e':
+        AddSegment(Kind::kDaySpace);
+        ++cur;
+        continue;
+      case 'H':
+        AddSegment(Kind::kHour);
+        ++cur;
+        continue;
+      case 'M':
+        AddSegment(Kind::kMinute);
+        ++cur;
+        continue;
+      case 'S':
+        AddSegment(Kind::kSecond);
+        ++cur;
+        continue;
+      case 'z':
+        AddSegment(Kind::kOffset, "");
+        ++cur;
+        continue;
+      case 'Z':
+        AddSegment(Kind::kAbbr);
+        ++cur;
+        continue;
+      case 's':
+        AddSegment(Kind::kUnixSeconds);
+        ++cur;
+        continue;
+      case ':': {
+        // %:z, %::z and %:::z.
+        const char* colons = cur;
+        while (cur != end && *cur == ':' && cur - colons < 3) ++cur;
+        if (cur != end && *cur == 'z') {
+          static const char* const kModes[] = {":", ":*", ":*:"};
+          AddSegment(Kind::kOffset, kModes[cur - colons - 1]);
+          ++cur;
+          continue;
+        }
+        cur = colons;
+        break;
+      }
+      case 'E': {
+        const char* ext = cur + 1;
+        if (ext == end) break;
+        if (*ext == 'T') {
+          AddSegment(Kind::kLiteral, "T");
+          cur = ext + 1;
+          continue;
+        }
+        if (*ext == 'z') {
+          AddSegment(Kind::kOffset, ":");
+          cur = ext + 1;
+          continue;
+        }
+        if (*ext == '*' && ext + 1 != end) {
+          if (ext[1] == 'z') {
+            AddSegment(Kind::kOffset, ":*");
+            cur = ext + 2;
+            continue;
+          }
+          if (ext[1] == 'S' || ext[1] == 'f') {
+            if (ext[1] == 'S') AddSegment(Kind::kSecond);
+            AddSegment(Kind::kSubsecond, {}, -1, ext[1] == 'S');
+            cur = ext + 2;
+            continue;
+          }
+        }
+        if (*ext == '4' && ext + 1 != end && ext[1] == 'Y') {
+          AddSegment(Kind::kYear, {}, 4);
+          cur = ext + 2;
+          continue;
+        }
+        const char* np = ext;
+        int n = 0;
+        while (np != end && *np >= '0' && *np <= '9' && n <= 1024) {
+          n = n * 10 + (*np++ - '0');
+        }
+        if (np != ext && n <= 1024 && np != end && (*np == 'S' || *np == 'f')) {
+          if (*np == 'S') AddSegment(Kind::kSecond);
+          if (n > 0) {
+            AddSegment(Kind::kSubsecond, {},
+                       std::min(n, kMaxFractionDigits), *np == 'S');
+          }
+          cur = np + 1;
+          continue;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    // Leave other specifiers to strftime(3), with their modifier if any.
+    if ((*cur == 'E' || *cur == 'O') && cur + 1 != end) ++cur;
+    ++cur;
+    AddSegment(Kind::kStrftime, turbo::string_view(spec, cur - spec));
+  }
+}
+
+TimeFormatter::SecondInfo TimeFormatter::Lookup(
+    int64_t unix_seconds, FormatterCacheEntry* entry) const {
+  const int64_t second = unix_seconds - entry->minute_start;
+  if (entry->has_minute && second >= 0 && second < 60) {
+    return {unix_seconds,
+            CivilSecond(entry->year, entry->month, entry->day, entry->hour,
+                        entry->minute, static_cast<int>(second)),
+            entry->offset, entry->zone_abbr};
+  }
+  const TimeZone::CivilInfo ci = tz_.At(FromUnixSeconds(unix_seconds));
+  // Offsets change at most once in a minute: the minute has a single offset
+  // if it starts and ends with the same one.
+  const int64_t minute_start = unix_seconds - ci.cs.second();
+  const TimeZone::CivilInfo first = tz_.At(FromUnixSeconds(minute_start));
+  const TimeZone::CivilInfo last = tz_.At(FromUnixSeconds(minute_start + 59));
+  entry->has_minute = first.offset == ci.offset && last.offset == ci.offset &&
+                      first.zone_abbr == ci.zone_abbr &&
+                      last.zone_abbr == ci.zone_abbr;
+  entry->minute_start = minute_start;
+  entry->year = ci.cs.year();
+  entry->month = ci.cs.month();
+  entry->day = ci.cs.day();
+  entry->hour = ci.cs.hour();
+  entry->minute = ci.cs.minute();
+  entry->offset = ci.offset;
+  entry->zone_abbr = ci.zone_abbr;
+  return {unix_seconds, ci.cs, ci.offset, ci.zone_abbr};
+}
+
+template <typename Sink>
+void TimeFormatter::RenderRFC3339(const SecondInfo& info, Sink* sink) const {
+  // "YYYY-MM-DDTHH:MM:SS" and "+hh:mm".
+  char buf[19 + 6];
+  char* ep = buf + 19;
+  ep = Format02d(ep, info.cs.second());
+  *--ep = ':';
+  ep = Format02d(ep, info.cs.minute());
+  *--ep = ':';
+  ep = Format02d(ep, info.cs.hour());
+  *--ep = 'T';
+  ep = Format02d(ep, info.cs.day());
+  *--ep = '-';
+  ep = Format02d(ep, info.cs.month());
+  *--ep = '-';
+  const int year = static_cast<int>(info.cs.year());
+  ep = Format02d(ep, year % 100);
+  Format02d(ep, year / 100);
+  sink->Append(buf, 19);
+  if (!subseconds_.empty()) sink->Subsecond(-1, true);
+  char* const offset = FormatOffset(buf + sizeof(buf), info.offset, ":");
+  sink->Append(offset, static_cast<size_t>(buf + sizeof(buf) - offset));
+}
+
+template <typename Sink>
+void TimeFormatter::RenderSecond(const SecondInfo& info, Sink* sink) const {
+  // %Y has four digits in these years.
+  if (rfc3339_ && info.cs.year() >= 1000 && info.cs.year() <= 9999) {
+    RenderRFC3339(info, sink);
+    return;
+  }
+  // Enough for any integer or offset.
+  char buf[24];
+  char* const ep = buf + sizeof(buf);
+  char* bp = ep;
+  for (const Segment& segment : segments_) {
+    switch (segment.kind) {
+      case Kind::kLiteral:
+        sink->Append(segment.text.data(), segment.text.size());
+        continue;
+      case Kind::kYear:
+        bp = Format64(ep, segment.width, info.cs.year());
+        break;
+      case Kind::kMonth:
+        bp = Format02d(ep, info.cs.month());
+        break;
+      case Kind::kDay:
+        bp = Format02d(ep, info.cs.day());
+        break;
+      case Kind::kDaySpace:
+        bp = Format02d(ep, info.cs.day());
+        if (*bp == '0') *bp = ' ';
+        break;
+      case Kind::kHour:
+        bp = Format02d(ep, info.cs.hour());
+        break;
+      case Kind::kMinute:
+        bp = Format02d(ep, info.cs.minute());
+        break;
+      case Kind::kSecond:
+        bp = Format02d(ep, info.cs.second());
+        break;
+      case Kind::kOffset:
+        bp = FormatOffset(ep, info.offset, segment.text.c_str());
+        break;
+      case Kind::kAbbr:
+        sink->Append(info.zone_abbr, strlen(info.zone_abbr));
+        continue;
+      case Kind::kUnixSeconds:
+        bp = Format64(ep, 0, info.unix_seconds);
+        break;
+      case Kind::kSubsecond:
+        sink->Subsecond(segment.width, segment.seconds);
+        continue;
+      case Kind::kStrftime: {
+        const std::string text = turbo::FormatTime(
+            segment.text, FromUnixSeconds(info.unix_seconds), tz_);
+        sink->Append(text.data(), text.size());
+        continue;
+      }
+    }
+    sink->Append(bp, static_cast<size_t>(ep - bp));
+  }
+}
+
+size_t TimeFormatter::Format(Time t, char* buf, size_t size) const {
+  Writer writer(buf, size);
+  if (TURBO_PREDICT_FALSE(t == InfiniteFuture())) {
+    writer.Append(kInfiniteFutureStr, sizeof(kInfiniteFutureStr) - 1);
+    return writer.size();
+  }
+  if (TURBO_PREDICT_FALSE(t == InfinitePast())) {
+    writer.Append(kInfinitePastStr, sizeof(kInfinitePastStr) - 1);
+    return writer.size();
+  }
+  const Duration d = time_internal::ToUnixDuration(t);
+  const int64_t unix_seconds = time_internal::GetRepHi(d);
+  const uint32_t rep_lo = time_internal::GetRepLo(d);
+
+  FormatterCacheEntry* const entry = CacheEntry(id_);
+  if (TURBO_PREDICT_FALSE(!entry->has_second ||
+                          entry->unix_seconds != unix_seconds)) {
+    const SecondInfo info = Lookup(unix_seconds, entry);
+    CacheSink cache(entry);
+    RenderSecond(info, &cache);
+    entry->has_second = !cache.overflow();
+    entry->unix_seconds = unix_seconds;
+    if (!entry->has_second) {
+      DirectSink direct(&writer, rep_lo);
+      RenderSecond(info, &direct);
+      return writer.size();
+    }
+  }
+
+  // Only the fractional seconds change within the second.
+  size_t pos = 0;
+  for (size_t i = 0; i < entry->num_holes; ++i) {
+    writer.Append(entry->text + pos, entry->holes[i] - pos);
+    const Segment& segment = segments_[subseconds_[i]];
+    RenderSubsecond(segment.width, segment.seconds, rep_lo, &writer);
+    pos = entry->holes[i];
+  }
+  writer.Append(entry->text + pos, entry->size - pos);
+  return writer.size();
+}
+
+std::string TimeFormatter::Format(Time t) const {
+  char buf[FormatterCacheEntry::kMaxTextSize + 64];
+  const size_t size = Format(t, buf, sizeof(buf));
+  if (TURBO_PREDICT_TRUE(size <= sizeof(buf))) return std::string(buf, size);
+  std::string result(size, '\0');
+  Format(t, &result[0], size);
+  return result;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,154 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: time_formatter.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::TimeFormatter`, which formats many
+// `turbo::Time` values with the same format string and time zone, such as
+// the timestamps of log lines.
+//
+// `turbo::FormatTime()` interprets its format string, converts the time to a
+// civil time and allocates a string on every call. A `TimeFormatter` parses
+// its format string once, and remembers in each thread the text of the last
+// second it formatted: formatting another time within the same second only
+// renders the fractional seconds. The result is written to a caller buffer.
+//
+// Example:
+//
+//   const turbo::TimeFormatter formatter(turbo::RFC3339_full,
+//                                        turbo::UTCTimeZone());
+//   char buf[64];
+//   size_t len = formatter.Format(turbo::Now(), buf, sizeof(buf));
+//   fwrite(buf, 1, len, stderr);  // "2023-06-28T09:08:07.123456+00:00"
+//
+// The output is identical to that of `turbo::FormatTime()` with the same
+// arguments.
+
+#ifndef TURBO_TIME_TIME_FORMATTER_H_
+#define TURBO_TIME_TIME_FORMATTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+namespace time_internal {
+struct FormatterCacheEntry;
+}  // namespace time_internal
+
+// TimeFormatter
+//
+// Formats times according to a `turbo::FormatTime()` format string in a
+// given time zone. Thread-safe.
+//
+// Formats made of the specifiers `%Y`, `%E4Y`, `%m`, `%d`, `%e`, `%H`, `%M`,
+// `%S`, `%E#S`, `%E*S`, `%E#f`, `%E*f`, `%z`, `%Ez`, `%E*z`, `%:z`, `%Z`,
+// `%s`, `%ET` and `%%` never call into strftime(3). `turbo::RFC3339_full` and
+// `turbo::RFC3339_sec` have a dedicated path. Other specifiers are supported,
+// but are rendered by `turbo::FormatTime()` once per second.
+class TimeFormatter {
+ public:
+  TimeFormatter(turbo::string_view format, TimeZone tz);
+
+  // Formats times as `turbo::RFC3339_full` in `tz`.
+  explicit TimeFormatter(TimeZone tz) : TimeFormatter(RFC3339_full, tz) {}
+
+  TimeFormatter(const TimeFormatter&) = default;
+  TimeFormatter& operator=(const TimeFormatter&) = default;
+
+  // Format()
+  //
+  // Writes the formatted time `t` to `buf`, without a terminating NUL
+  // character, and returns the length of the formatted time. If this length
+  // is greater than `size`, only the first `size` characters are written.
+  size_t Format(Time t, char* buf, size_t size) const;
+
+  // Returns the formatted time `t`.
+  std::string Format(Time t) const;
+
+  turbo::string_view format() const { return format_; }
+  TimeZone time_zone() const { return tz_; }
+
+ private:
+  enum class Kind : uint8_t {
+    kLiteral,      // `text`
+    kYear,         // %Y, or %E4Y if `width` is 4
+    kMonth,        // %m
+    kDay,          // %d
+    kDaySpace,     // %e
+    kHour,         // %H
+    kMinute,       // %M
+    kSecond,       // %S
+    kOffset,       // %z, %Ez, %E*z, %:z, ... `text` is the mode of the offset
+    kAbbr,         // %Z
+    kUnixSeconds,  // %s
+    kSubsecond,    // %E#S, %E*S, %E#f or %E*f, after the seconds if any
+    kStrftime,     // Other specifiers, in `text`
+  };
+
+  struct Segment {
+    Kind kind;
+    // The number of fractional digits of kSubsecond, or -1 for all of the
+    // non-zero ones.
+    int width;
+    // Whether a kSubsecond follows the seconds (%E#S and %E*S): its digits
+    // then start with a decimal point, and %E*S writes nothing when the
+    // fractional seconds are zero.
+    bool seconds;
+    std::string text;
+  };
+
+  // The fields of the civil time a second is formatted from.
+  struct SecondInfo {
+    int64_t unix_seconds;
+    CivilSecond cs;
+    int offset;
+    const char* zone_abbr;
+  };
+
+  void Compile();
+  void AddSegment(Kind kind, turbo::string_view text = {}, int width = 0,
+                  bool seconds = false);
+  SecondInfo Lookup(int64_t unix_seconds,
+                    time_internal::FormatterCacheEntry* entry) const;
+  // Renders the fields of `info` to `sink`, and asks the sink to render the
+  // fractional seconds of each kSubsecond.
+  template <typename Sink>
+  void RenderSecond(const SecondInfo& info, Sink* sink) const;
+  template <typename Sink>
+  void RenderRFC3339(const SecondInfo& info, Sink* sink) const;
+
+  std::string format_;
+  TimeZone tz_;
+  std::vector<Segment> segments_;
+  // The indices of the kSubsecond segments.
+  std::vector<size_t> subseconds_;
+  // Whether `format_` is `RFC3339_full` or `RFC3339_sec`.
+  bool rfc3339_ = false;
+  // Identifies the format and time zone in the per-thread caches.
+  uint64_t id_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_TIME_TIME_FORMATTER_H_
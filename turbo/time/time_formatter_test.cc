@@ -0,0 +1,157 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/time_formatter.h"
+
+#include <cstring>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/time/internal/test_util.h"
+#include "turbo/time/time.h"
+
+namespace {
+
+const char* const kFormats[] = {
+    turbo::RFC3339_full,
+    turbo::RFC3339_sec,
+    turbo::RFC1123_full,
+    turbo::RFC1123_no_wday,
+    "%Y-%m-%d %H:%M:%E3S %Z",
+    "%E4Y%m%d %e %E*z %:::z %::z %s",
+    "[%E6f] %E0S %E0f %E*f %E12S %E20S",
+    "%% %%%Y %%%% %",
+    "%a %j %Ec %Oz %E",
+    "",
+    "no specifiers",
+};
+
+// Times from before 1000 to after 9999, with and without fractional seconds.
+std::vector<turbo::Time> TestTimes(turbo::TimeZone tz) {
+  std::vector<turbo::Time> times;
+  for (int64_t year : {-12345, -1, 0, 7, 999, 1000, 1970, 2023, 9999, 10000}) {
+    const turbo::Time t =
+        turbo::FromCivil(turbo::CivilSecond(year, 3, 4, 5, 6, 7), tz);
+    times.push_back(t);
+    times.push_back(t + turbo::Nanoseconds(1));
+    times.push_back(t + turbo::Milliseconds(120));
+    times.push_back(t + turbo::Nanoseconds(999999999));
+    times.push_back(t + turbo::Nanoseconds(1) / 4);
+  }
+  times.push_back(turbo::InfiniteFuture());
+  times.push_back(turbo::InfinitePast());
+  return times;
+}
+
+TEST(TimeFormatter, MatchesFormatTime) {
+  for (const char* tz_name : {"UTC", "America/Los_Angeles", "Asia/Kolkata"}) {
+    const turbo::TimeZone tz = turbo::time_internal::LoadTimeZone(tz_name);
+    for (const char* format : kFormats) {
+      const turbo::TimeFormatter formatter(format, tz);
+      for (turbo::Time t : TestTimes(tz)) {
+        EXPECT_EQ(turbo::FormatTime(format, t, tz), formatter.Format(t))
+            << format << " in " << tz_name;
+      }
+    }
+  }
+}
+
+TEST(TimeFormatter, DefaultsToRFC3339Full) {
+  const turbo::TimeZone tz = turbo::UTCTimeZone();
+  const turbo::TimeFormatter formatter(tz);
+  EXPECT_EQ(turbo::RFC3339_full, formatter.format());
+  EXPECT_EQ(tz, formatter.time_zone());
+  const turbo::Time t = turbo::FromUnixMicros(1234567890123456);
+  EXPECT_EQ("2009-02-13T23:31:30.123456+00:00", formatter.Format(t));
+}
+
+TEST(TimeFormatter, WithinTheSameSecond) {
+  const turbo::TimeZone tz =
+      turbo::time_internal::LoadTimeZone("America/New_York");
+  const turbo::TimeFormatter formatter("%H:%M:%E3S|%E*S|%Ez", tz);
+  const turbo::Time t = turbo::FromUnixSeconds(1700000000);
+  for (int ms = 0; ms < 1000; ms += 7) {
+    const turbo::Time u = t + turbo::Milliseconds(ms);
+    EXPECT_EQ(turbo::FormatTime(formatter.format(), u, tz),
+              formatter.Format(u));
+  }
+}
+
+// Crosses the transitions to and from daylight saving time second by second.
+TEST(TimeFormatter, AcrossOffsetTransitions) {
+  const turbo::TimeZone tz =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  const turbo::TimeFormatter formatter(turbo::RFC3339_full, tz);
+  for (const turbo::CivilSecond cs : {turbo::CivilSecond(2023, 3, 12, 1, 58),
+                                      turbo::CivilSecond(2023, 11, 5, 0, 58)}) {
+    turbo::Time t = turbo::FromCivil(cs, tz);
+    for (int i = 0; i < 2 * 3600 + 240; ++i) {
+      ASSERT_EQ(turbo::FormatTime(turbo::RFC3339_full, t, tz),
+                formatter.Format(t));
+      t += turbo::Seconds(1);
+    }
+  }
+}
+
+TEST(TimeFormatter, TruncatesToBuffer) {
+  const turbo::TimeFormatter formatter(turbo::RFC3339_full,
+                                       turbo::UTCTimeZone());
+  const turbo::Time t = turbo::FromUnixMillis(1234567890123);
+  const std::string expected = "2009-02-13T23:31:30.123+00:00";
+  char buf[64];
+  EXPECT_EQ(expected.size(), formatter.Format(t, buf, sizeof(buf)));
+  EXPECT_EQ(expected, std::string(buf, expected.size()));
+  for (size_t size : {0, 1, 19, 20, 22, 23, 28}) {
+    memset(buf, '#', sizeof(buf));
+    EXPECT_EQ(expected.size(), formatter.Format(t, buf, size));
+    EXPECT_EQ(expected.substr(0, size), std::string(buf, size));
+    EXPECT_EQ('#', buf[size]);
+  }
+}
+
+TEST(TimeFormatter, LongFormat) {
+  const turbo::TimeZone tz = turbo::UTCTimeZone();
+  const std::string format = std::string(300, 'x') + "%E3S%E*S%E3f%E9f%Ez";
+  const turbo::TimeFormatter formatter(format, tz);
+  const turbo::Time t = turbo::FromUnixNanos(1234567890123456789);
+  EXPECT_EQ(turbo::FormatTime(format, t, tz), formatter.Format(t));
+  EXPECT_EQ(turbo::FormatTime(format, t + turbo::Seconds(1), tz),
+            formatter.Format(t + turbo::Seconds(1)));
+}
+
+// Formatters share the caches of their thread.
+TEST(TimeFormatter, ManyFormattersAndThreads) {
+  const turbo::TimeZone tz =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  std::vector<turbo::TimeFormatter> formatters;
+  for (const char* format : kFormats) formatters.emplace_back(format, tz);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&formatters, &tz, i] {
+      turbo::Time t = turbo::FromUnixSeconds(1700000000 + i);
+      for (int j = 0; j < 1000; ++j) {
+        for (const turbo::TimeFormatter& formatter : formatters) {
+          EXPECT_EQ(turbo::FormatTime(formatter.format(), t, tz),
+                    formatter.Format(t));
+        }
+        t += turbo::Milliseconds(337);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
+}  // namespace
@@ -0,0 +1,344 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/time_parser.h"
+
+#include <cctype>
+#include <cstdint>
+
+#include "turbo/base/endian.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+TURBO_DLL extern const char CommonLog_time[] = "%d/%b/%Y:%H:%M:%S %z";
+
+namespace {
+
+// RFC3339 without the UTC offset.
+const char kRFC3339Civil[] = "%Y-%m-%d%ET%H:%M:%E*S";
+
+constexpr uint64_t kZeros = 0x3030303030303030;
+
+// Returns whether the 8 characters of `v`, loaded in little-endian order,
+// are all digits.
+inline bool AllDigits8(uint64_t v) {
+  return (v & 0xF0F0F0F0F0F0F0F0) == kZeros &&
+         ((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) == kZeros;
+}
+
+// Returns the value of the 8 digits of `v`, loaded in little-endian order.
+inline uint32_t Digits8(uint64_t v) {
+  v -= kZeros;
+  // Combines pairs of digits, then pairs of pairs, and so on.
+  v = (v * 10) + (v >> 8);
+  v = (((v & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+       (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+      32;
+  return static_cast<uint32_t>(v);
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Parses the two digits at `p`, or returns -1.
+inline int Digits2(const char* p) {
+  if (!IsDigit(p[0]) || !IsDigit(p[1])) return -1;
+  return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+// Parses the digits at `p`, and returns the first character after them. Up
+// to 15 digits are kept in `femtos`, like `ParseTime()` does.
+const char* ParseFraction(const char* p, const char* end, uint64_t* femtos) {
+  uint64_t value = 0;
+  int digits = 0;
+  while (end - p >= 8 && digits <= 15 - 8) {
+    const uint64_t v = little_endian::Load64(p);
+    if (!AllDigits8(v)) break;
+    value = value * 100000000 + Digits8(v);
+    digits += 8;
+    p += 8;
+  }
+  for (; p != end && IsDigit(*p); ++p) {
+    if (digits < 15) {
+      value = value * 10 + static_cast<uint64_t>(*p - '0');
+      ++digits;
+    }
+  }
+  static constexpr uint64_t kExp10[] = {
+      1,
+      10,
+      100,
+      1000,
+      10000,
+      100000,
+      1000000,
+      10000000,
+      100000000,
+      1000000000,
+      10000000000,
+      100000000000,
+      1000000000000,
+      10000000000000,
+      100000000000000,
+      1000000000000000,
+  };
+  *femtos = value * kExp10[15 - digits];
+  return p;
+}
+
+inline bool IsLeapYear(int year) {
+  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+inline int DaysPerMonth(int year, int month) {
+  static constexpr int kDaysPerMonth[] = {31, 28, 31, 30, 31, 30,
+                                          31, 31, 30, 31, 30, 31};
+  return kDaysPerMonth[month - 1] + (month == 2 && IsLeapYear(year));
+}
+
+// Returns the days since the Unix epoch of a valid date.
+inline int64_t DaysFromCivil(int year, int month, int day) {
+  year -= month <= 2;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int yoe = year - era * 400;
+  const int mp = month > 2 ? month - 3 : month + 9;
+  const int doy = (153 * mp + 2) / 5 + day - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return int64_t{era} * 146097 + doe - 719468;
+}
+
+// A civil time parsed without a time zone.
+struct Fields {
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+  uint64_t femtos;
+};
+
+// Returns whether the fields form a valid civil time. A leap second is left
+// to `ParseTime()`, which normalizes it.
+inline bool Valid(const Fields& f) {
+  return f.month >= 1 && f.month <= 12 && f.day >= 1 &&
+         f.day <= DaysPerMonth(f.year, f.month) && f.hour <= 23 &&
+         f.minute <= 59 && f.second <= 59;
+}
+
+inline Duration Subseconds(uint64_t femtos) {
+  return time_internal::MakeDuration(
+      0, static_cast<uint32_t>(femtos / (1000 * 1000 / 4)));
+}
+
+// Returns the time of `f` at the given UTC offset in seconds.
+inline Time ToTime(const Fields& f, int offset) {
+  const int64_t seconds =
+      DaysFromCivil(f.year, f.month, f.day) * 86400 + f.hour * 3600 +
+      f.minute * 60 + f.second - offset;
+  return time_internal::FromUnixDuration(time_internal::MakeDuration(
+      seconds, static_cast<uint32_t>(f.femtos / (1000 * 1000 / 4))));
+}
+
+// Parses "[+-]hh:mm" or "[+-]hhmm" at the end of the input, given the
+// position of its separator.
+inline bool ParseOffset(const char* p, const char* end, bool colon,
+                        int* offset) {
+  if (end - p != (colon ? 6 : 5)) return false;
+  if (p[0] != '+' && p[0] != '-') return false;
+  if (colon && p[3] != ':') return false;
+  const int hours = Digits2(p + 1);
+  const int minutes = Digits2(p + (colon ? 4 : 3));
+  if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) return false;
+  *offset = (hours * 60 + minutes) * 60;
+  if (p[0] == '-') *offset = -*offset;
+  return true;
+}
+
+// Parses "YYYY-MM-DDTHH:MM:SS[.s+][Z|+hh:mm]". Returns false for anything
+// else, including valid inputs of other shapes.
+bool FastParseRFC3339(turbo::string_view input, TimeZone tz, Time* time) {
+  if (input.size() < 19) return false;
+  const char* p = input.data();
+  const char* const end = p + input.size();
+
+  // "YYYY-MM-": the separators are replaced by zeros to convert all of the
+  // digits at once.
+  constexpr uint64_t kDateSeparators = 0xFF0000FF00000000;
+  const uint64_t date = little_endian::Load64(p);
+  if ((date & kDateSeparators) != 0x2D00002D00000000) return false;
+  const uint64_t date_digits =
+      (date & ~kDateSeparators) | (kZeros & kDateSeparators);
+  // "DDTHH:MM", where 'T' may be lowercase.
+  constexpr uint64_t kTimeSeparators = 0x0000FF0000FF0000;
+  const uint64_t dt = little_endian::Load64(p + 8);
+  if (((dt | 0x200000) & kTimeSeparators) != 0x00003A0000740000) {
+    return false;
+  }
+  const uint64_t dt_digits =
+      (dt & ~kTimeSeparators) | (kZeros & kTimeSeparators);
+  if (!AllDigits8(date_digits) || !AllDigits8(dt_digits) || p[16] != ':') {
+    return false;
+  }
+  const uint32_t ymd = Digits8(date_digits);  // YYYY0MM0
+  const uint32_t dhm = Digits8(dt_digits);    // DD0HH0MM
+  Fields f;
+  f.year = static_cast<int>(ymd / 10000);
+  f.month = static_cast<int>(ymd / 10 % 100);
+  f.day = static_cast<int>(dhm / 1000000);
+  f.hour = static_cast<int>(dhm / 1000 % 100);
+  f.minute = static_cast<int>(dhm % 100);
+  f.second = Digits2(p + 17);
+  f.femtos = 0;
+  if (f.second < 0 || !Valid(f)) return false;
+  p += 19;
+  if (p != end && *p == '.') {
+    const char* const digits = p + 1;
+    p = ParseFraction(digits, end, &f.femtos);
+    if (p == digits) return false;
+  }
+
+  if (p == end) {
+    // No offset: the civil time is in `tz`.
+    if (tz == UTCTimeZone()) {
+      *time = ToTime(f, 0);
+    } else {
+      *time = FromCivil(
+                  CivilSecond(f.year, f.month, f.day, f.hour, f.minute,
+                              f.second),
+                  tz) +
+              Subseconds(f.femtos);
+    }
+    return true;
+  }
+  int offset = 0;
+  if ((*p == 'Z' || *p == 'z') && p + 1 == end) {
+    offset = 0;
+  } else if (!ParseOffset(p, end, /*colon=*/true, &offset)) {
+    return false;
+  }
+  *time = ToTime(f, offset);
+  return true;
+}
+
+// Parses "DD/Mon/YYYY:HH:MM:SS +hhmm".
+bool FastParseCommonLog(turbo::string_view input, Time* time) {
+  if (input.size() != 26) return false;
+  const char* const p = input.data();
+  if (p[2] != '/' || p[6] != '/' || p[11] != ':' || p[14] != ':' ||
+      p[17] != ':' || p[20] != ' ') {
+    return false;
+  }
+  static const char kMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  int month = 0;
+  while (month < 12 && (kMonths[3 * month] != p[3] ||
+                        kMonths[3 * month + 1] != p[4] ||
+                        kMonths[3 * month + 2] != p[5])) {
+    ++month;
+  }
+  const uint32_t year = little_endian::Load32(p + 7);
+  if (month == 12 || !AllDigits8((uint64_t{year} << 32) | 0x30303030)) {
+    return false;
+  }
+  Fields f;
+  f.year = static_cast<int>(Digits8((uint64_t{year} << 32) | 0x30303030));
+  f.month = month + 1;
+  f.day = Digits2(p);
+  f.hour = Digits2(p + 12);
+  f.minute = Digits2(p + 15);
+  f.second = Digits2(p + 18);
+  f.femtos = 0;
+  int offset = 0;
+  if (f.day < 0 || f.hour < 0 || f.minute < 0 || f.second < 0 || !Valid(f) ||
+      !ParseOffset(p + 21, p + 26, /*colon=*/false, &offset)) {
+    return false;
+  }
+  *time = ToTime(f, offset);
+  return true;
+}
+
+// Parses "[-]s+[.s+]".
+bool FastParseUnix(turbo::string_view input, Time* time) {
+  const char* p = input.data();
+  const char* const end = p + input.size();
+  const bool negative = p != end && *p == '-';
+  if (negative) ++p;
+  const char* const digits = p;
+  int64_t seconds = 0;
+  while (end - p >= 8 && p - digits <= 8) {
+    const uint64_t v = little_endian::Load64(p);
+    if (!AllDigits8(v)) break;
+    seconds = seconds * 100000000 + Digits8(v);
+    p += 8;
+  }
+  for (; p != end && IsDigit(*p); ++p) {
+    // More digits could overflow.
+    if (p - digits >= 18) return false;
+    seconds = seconds * 10 + (*p - '0');
+  }
+  if (p == digits) return false;
+  uint64_t femtos = 0;
+  if (p != end && *p == '.') {
+    const char* const fraction = p + 1;
+    p = ParseFraction(fraction, end, &femtos);
+    if (p == fraction) return false;
+  }
+  if (p != end) return false;
+  Duration d = time_internal::MakeDuration(
+      seconds, static_cast<uint32_t>(femtos / (1000 * 1000 / 4)));
+  if (negative) d = -d;
+  *time = time_internal::FromUnixDuration(d);
+  return true;
+}
+
+turbo::string_view StripSpace(turbo::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+}  // namespace
+
+bool ParseRFC3339Time(turbo::string_view input, TimeZone tz, Time* time,
+                      std::string* err) {
+  if (FastParseRFC3339(input, tz, time)) return true;
+  // Reports the error of the complete format.
+  std::string error;
+  if (turbo::ParseTime(RFC3339_full, input, tz, time, &error)) return true;
+  if (turbo::ParseTime(kRFC3339Civil, input, tz, time, nullptr)) return true;
+  if (err != nullptr) *err = error;
+  return false;
+}
+
+bool ParseRFC3339Time(turbo::string_view input, Time* time, std::string* err) {
+  return ParseRFC3339Time(input, UTCTimeZone(), time, err);
+}
+
+bool ParseUnixTime(turbo::string_view input, Time* time, std::string* err) {
+  if (FastParseUnix(StripSpace(input), time)) return true;
+  return turbo::ParseTime("%s", input, time, err);
+}
+
+bool ParseCommonLogTime(turbo::string_view input, Time* time,
+                        std::string* err) {
+  if (FastParseCommonLog(input, time)) return true;
+  return turbo::ParseTime(CommonLog_time, input, time, err);
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
@@ -0,0 +1,86 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: time_parser.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines parsers of the timestamp formats found in event
+// streams and logs, for inputs with many timestamps.
+//
+// `turbo::ParseTime()` interprets its format string for every input. The
+// parsers below recognize the usual shape of their format with a few word
+// comparisons and convert its digits eight at a time, and fall back to
+// `turbo::ParseTime()` for anything else, so that they accept the same
+// inputs and return the same times and errors.
+//
+// Example:
+//
+//   turbo::Time t;
+//   std::string err;
+//   if (!turbo::ParseRFC3339Time("2023-06-28T09:08:07.123Z", &t, &err)) {
+//     ...
+//   }
+
+#ifndef TURBO_TIME_TIME_PARSER_H_
+#define TURBO_TIME_TIME_PARSER_H_
+
+#include <string>
+
+#include "turbo/platform/port.h"
+#include "turbo/strings/string_view.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// CommonLog_time
+//
+// The `ParseTime()` format of the timestamps of the Common Log Format of web
+// servers, as in "10/Oct/2000:13:55:36 -0700".
+TURBO_DLL extern const char CommonLog_time[];  // %d/%b/%Y:%H:%M:%S %z
+
+// ParseRFC3339Time()
+//
+// Parses an RFC3339 date and time, with or without fractional seconds, like
+// `turbo::ParseTime(turbo::RFC3339_full, ...)`. The UTC offset may be
+// omitted, in which case the civil time is interpreted in `tz`, as with
+// `turbo::ParseTime("%Y-%m-%d%ET%H:%M:%E*S", ...)`. The overload without a
+// time zone uses UTC.
+//
+// Inputs like "2023-06-28T09:08:07Z" and "2023-06-28T09:08:07.123+02:00" are
+// parsed without calling `turbo::ParseTime()`.
+bool ParseRFC3339Time(turbo::string_view input, TimeZone tz, Time* time,
+                      std::string* err);
+bool ParseRFC3339Time(turbo::string_view input, Time* time, std::string* err);
+
+// ParseUnixTime()
+//
+// Parses a number of seconds since the Unix epoch, which may be negative and
+// have fractional seconds, like "1687943287" or "1687943287.123". Inputs
+// without fractional seconds are accepted as with `turbo::ParseTime("%s",
+// ...)`.
+bool ParseUnixTime(turbo::string_view input, Time* time, std::string* err);
+
+// ParseCommonLogTime()
+//
+// Parses a timestamp of the Common Log Format, like
+// `turbo::ParseTime(turbo::CommonLog_time, ...)`.
+bool ParseCommonLogTime(turbo::string_view input, Time* time,
+                        std::string* err);
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_TIME_TIME_PARSER_H_
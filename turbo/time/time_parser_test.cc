@@ -0,0 +1,227 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/time_parser.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "turbo/time/internal/test_util.h"
+#include "turbo/time/time.h"
+
+namespace {
+
+// Expects `parse` to accept the same inputs as `ParseTime(format, ...)`, and
+// to return the same times.
+template <typename Parse>
+void ExpectSameAsParseTime(Parse parse, const char* format,
+                           turbo::TimeZone tz, const std::string& input) {
+  turbo::Time expected = turbo::UnixEpoch();
+  std::string expected_err;
+  const bool ok =
+      turbo::ParseTime(format, input, tz, &expected, &expected_err);
+  turbo::Time t = turbo::UnixEpoch();
+  std::string err;
+  ASSERT_EQ(ok, parse(input, &t, &err)) << input;
+  if (ok) {
+    EXPECT_EQ(expected, t) << input;
+  } else {
+    EXPECT_EQ(expected_err, err) << input;
+  }
+}
+
+TEST(ParseRFC3339Time, Basics) {
+  turbo::Time t;
+  std::string err;
+  ASSERT_TRUE(turbo::ParseRFC3339Time("2009-02-13T23:31:30.123456789Z", &t,
+                                      &err));
+  EXPECT_EQ(turbo::FromUnixNanos(1234567890123456789), t);
+  ASSERT_TRUE(turbo::ParseRFC3339Time("2009-02-14t00:31:30+01:00", &t, &err));
+  EXPECT_EQ(turbo::FromUnixSeconds(1234567890), t);
+  ASSERT_TRUE(turbo::ParseRFC3339Time("2009-02-13T23:31:30.5", &t, &err));
+  EXPECT_EQ(turbo::FromUnixMillis(1234567890500), t);
+
+  const turbo::TimeZone lax =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  ASSERT_TRUE(turbo::ParseRFC3339Time("2009-02-13T15:31:30", lax, &t, &err));
+  EXPECT_EQ(turbo::FromUnixSeconds(1234567890), t);
+
+  EXPECT_FALSE(turbo::ParseRFC3339Time("2009-02-30T23:31:30Z", &t, &err));
+  EXPECT_FALSE(err.empty());
+}
+
+TEST(ParseRFC3339Time, SameAsParseTime) {
+  const char* const kInputs[] = {
+      "2023-06-28T09:08:07Z",
+      "2023-06-28T09:08:07z",
+      "2023-06-28t09:08:07+00:00",
+      "2023-06-28T09:08:07.1-07:00",
+      "2023-06-28T09:08:07.123456789123456789+05:30",
+      "2023-06-28T09:08:07.000000000000001Z",
+      "2023-06-28T09:08:07.0000000000000001Z",
+      "2024-02-29T00:00:00Z",
+      "2023-02-29T00:00:00Z",
+      "2000-12-31T23:59:59.999999999-23:59",
+      "0000-01-01T00:00:00Z",
+      "0001-03-01T00:00:00Z",
+      "9999-12-31T23:59:59Z",
+      "2023-06-28T09:08:60Z",
+      "2023-06-28T09:08:60.5+01:00",
+      "2023-06-28T24:00:00Z",
+      "2023-06-28T09:60:00Z",
+      "2023-13-28T09:08:07Z",
+      "2023-00-28T09:08:07Z",
+      "2023-06-00T09:08:07Z",
+      "2023-06-28T09:08:07.Z",
+      "2023-06-28T09:08:07+0100",
+      "2023-06-28T09:08:07+01",
+      "2023-06-28T09:08:07+24:00",
+      "2023-06-28T09:08:07+01:60",
+      "2023-06-28T09:08:07 Z",
+      "2023-06-28T09:08:07Z ",
+      " 2023-06-28T09:08:07Z",
+      "2023-06-28 09:08:07Z",
+      "2023-06-28T09:08:7Z",
+      "2023-6-28T09:08:07Z",
+      "12023-06-28T09:08:07Z",
+      "-2023-06-28T09:08:07Z",
+      "2023-06-28T09:08:07",
+      "2023-06-28T09:08:07.25",
+      "2023-06-28T09:08",
+      "2023-06-28",
+      "infinite-future",
+      "infinite-past",
+      "",
+      "x",
+  };
+  for (const char* tz_name : {"UTC", "America/Los_Angeles"}) {
+    const turbo::TimeZone tz = turbo::time_internal::LoadTimeZone(tz_name);
+    for (const std::string input : kInputs) {
+      // Without an offset, the civil time is in `tz`.
+      turbo::Time expected;
+      std::string expected_err;
+      bool ok = turbo::ParseTime(turbo::RFC3339_full, input, tz, &expected,
+                                 &expected_err);
+      if (!ok) {
+        ok = turbo::ParseTime("%Y-%m-%d%ET%H:%M:%E*S", input, tz, &expected,
+                              nullptr);
+      }
+      turbo::Time t;
+      std::string err;
+      ASSERT_EQ(ok, turbo::ParseRFC3339Time(input, tz, &t, &err))
+          << input << " in " << tz_name;
+      if (ok) {
+        EXPECT_EQ(expected, t) << input << " in " << tz_name;
+      } else {
+        EXPECT_EQ(expected_err, err) << input << " in " << tz_name;
+      }
+    }
+  }
+}
+
+// Offsets of seconds are lost in formatting, so the parsed times may differ
+// from the formatted ones before standard time.
+TEST(ParseRFC3339Time, FormattedTimes) {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> seconds(-62135596800, 253402300799);
+  std::uniform_int_distribution<int64_t> nanos(0, 999999999);
+  const turbo::TimeZone lax =
+      turbo::time_internal::LoadTimeZone("America/Los_Angeles");
+  for (int i = 0; i < 10000; ++i) {
+    const turbo::Time t = turbo::FromUnixSeconds(seconds(gen)) +
+                          turbo::Nanoseconds(i % 3 == 0 ? 0 : nanos(gen));
+    for (const turbo::TimeZone tz : {turbo::UTCTimeZone(), lax}) {
+      const std::string input = turbo::FormatTime(turbo::RFC3339_full, t, tz);
+      turbo::Time expected;
+      std::string err;
+      ASSERT_TRUE(
+          turbo::ParseTime(turbo::RFC3339_full, input, &expected, &err));
+      turbo::Time parsed;
+      ASSERT_TRUE(turbo::ParseRFC3339Time(input, &parsed, &err)) << input;
+      EXPECT_EQ(expected, parsed) << input;
+    }
+  }
+}
+
+TEST(ParseUnixTime, SameAsParseTime) {
+  const char* const kInputs[] = {
+      "0",
+      "1687943287",
+      "-1687943287",
+      "123456789012345678",
+      "1234567890123456789",
+      "9223372036854775807",
+      "-9223372036854775808",
+      "99999999999999999999",
+      " 1687943287 ",
+      "+1687943287",
+      "-",
+      "1687943287x",
+      "",
+      "infinite-future",
+  };
+  for (const std::string input : kInputs) {
+    ExpectSameAsParseTime(
+        [](turbo::string_view in, turbo::Time* t, std::string* err) {
+          return turbo::ParseUnixTime(in, t, err);
+        },
+        "%s", turbo::UTCTimeZone(), input);
+  }
+}
+
+TEST(ParseUnixTime, Fractions) {
+  turbo::Time t;
+  std::string err;
+  ASSERT_TRUE(turbo::ParseUnixTime("1687943287.25", &t, &err));
+  EXPECT_EQ(turbo::FromUnixMillis(1687943287250), t);
+  ASSERT_TRUE(turbo::ParseUnixTime("-1.5", &t, &err));
+  EXPECT_EQ(turbo::FromUnixMillis(-1500), t);
+  ASSERT_TRUE(turbo::ParseUnixTime(" 0.000000001\n", &t, &err));
+  EXPECT_EQ(turbo::FromUnixNanos(1), t);
+  EXPECT_FALSE(turbo::ParseUnixTime("1.", &t, &err));
+  EXPECT_FALSE(turbo::ParseUnixTime(".5", &t, &err));
+  EXPECT_FALSE(turbo::ParseUnixTime("1.5.5", &t, &err));
+}
+
+TEST(ParseCommonLogTime, SameAsParseTime) {
+  const char* const kInputs[] = {
+      "10/Oct/2000:13:55:36 -0700",
+      "01/Jan/1970:00:00:00 +0000",
+      "29/Feb/2024:23:59:59 +0530",
+      "29/Feb/2023:23:59:59 +0530",
+      "31/Dec/9999:23:59:59 -2359",
+      "10/oct/2000:13:55:36 -0700",
+      "10/October/2000:13:55:36 -0700",
+      "10/Oct/2000:13:55:36 -07:00",
+      "10/Oct/2000:13:55:36 Z",
+      "10/Oct/2000:13:55:60 +0000",
+      "10/Oct/2000:24:55:36 +0000",
+      "32/Oct/2000:13:55:36 +0000",
+      "1/Oct/2000:13:55:36 +0000",
+      "10/Oct/2000:13:55:36",
+      "10/Xyz/2000:13:55:36 +0000",
+      "[10/Oct/2000:13:55:36 -0700]",
+  };
+  for (const std::string input : kInputs) {
+    ExpectSameAsParseTime(
+        [](turbo::string_view in, turbo::Time* t, std::string* err) {
+          return turbo::ParseCommonLogTime(in, t, err);
+        },
+        turbo::CommonLog_time, turbo::UTCTimeZone(), input);
+  }
+}
+
+}  // namespace
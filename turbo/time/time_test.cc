@@ -23,7 +23,9 @@
 #include <ctime>
 #include <iomanip>
 #include <limits>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -1287,4 +1289,82 @@ TEST(Time, PrevTransitionNYC) {
   // We have a transition but we don't know which one.
 }
 
+// Expects ToCivilBatch() to convert `times` as ToCivilSecond() does.
+void ExpectToCivilBatch(const std::vector<turbo::Time>& times,
+                        turbo::TimeZone tz) {
+  std::vector<turbo::CivilSecond> civil(times.size());
+  turbo::ToCivilBatch(times, tz, turbo::MakeSpan(civil));
+  for (size_t i = 0; i < times.size(); ++i) {
+    ASSERT_EQ(turbo::ToCivilSecond(times[i], tz), civil[i])
+        << turbo::FormatTime(times[i]) << " in " << tz.name();
+  }
+}
+
+std::vector<turbo::TimeZone> BatchTimeZones() {
+  std::vector<turbo::TimeZone> zones = {turbo::UTCTimeZone(),
+                                        turbo::FixedTimeZone(-(5 * 3600 + 30))};
+  for (const char* name : {"America/Los_Angeles", "Australia/Lord_Howe",
+                           "Asia/Kolkata", "Europe/Dublin"}) {
+    zones.push_back(turbo::time_internal::LoadTimeZone(name));
+  }
+  return zones;
+}
+
+TEST(Time, ToCivilBatchSorted) {
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<int64_t> step(0, 12 * 3600 * 1000);
+  for (const turbo::TimeZone tz : BatchTimeZones()) {
+    std::vector<turbo::Time> times;
+    turbo::Time t = turbo::FromCivil(turbo::CivilSecond(1890, 1, 1), tz);
+    while (t < turbo::FromCivil(turbo::CivilSecond(2050, 1, 1), tz)) {
+      times.push_back(t);
+      t += turbo::Milliseconds(step(gen));
+    }
+    ExpectToCivilBatch(times, tz);
+  }
+}
+
+TEST(Time, ToCivilBatchAroundTransitions) {
+  for (const turbo::TimeZone tz : BatchTimeZones()) {
+    std::vector<turbo::Time> times;
+    turbo::Time t = turbo::FromCivil(turbo::CivilSecond(1970, 1, 1), tz);
+    turbo::TimeZone::CivilTransition trans;
+    for (int i = 0; i < 200 && tz.NextTransition(t, &trans); ++i) {
+      t = tz.At(trans.to).trans;
+      for (int64_t ms : {-1001, -1000, -999, -1, 0, 1, 999, 1000}) {
+        times.push_back(t + turbo::Milliseconds(ms));
+      }
+    }
+    ExpectToCivilBatch(times, tz);
+  }
+}
+
+TEST(Time, ToCivilBatchUnsorted) {
+  std::mt19937_64 gen(2);
+  std::uniform_int_distribution<int64_t> seconds(-(int64_t{1} << 42),
+                                                 int64_t{1} << 42);
+  std::uniform_int_distribution<int64_t> nanos(0, 999999999);
+  for (const turbo::TimeZone tz : BatchTimeZones()) {
+    std::vector<turbo::Time> times = {
+        turbo::InfinitePast(),
+        turbo::InfiniteFuture(),
+        turbo::UnixEpoch() - turbo::Nanoseconds(1),
+        turbo::UnixEpoch(),
+        turbo::FromCivil(turbo::CivilSecond(2500, 7, 1), tz),
+        turbo::FromUnixSeconds(std::numeric_limits<int64_t>::max()),
+        turbo::FromUnixSeconds(std::numeric_limits<int64_t>::min()),
+    };
+    for (int i = 0; i < 10000; ++i) {
+      // Runs of nearby times, far from each other.
+      const int64_t base = seconds(gen) >> (i % 4 * 10);
+      for (int j = 0; j < i % 7; ++j) {
+        times.push_back(turbo::FromUnixSeconds(base + nanos(gen) % 100000) +
+                        turbo::Nanoseconds(nanos(gen)));
+      }
+    }
+    ExpectToCivilBatch(times, tz);
+  }
+  ExpectToCivilBatch({}, turbo::UTCTimeZone());
+}
+
 }  // namespace
@@ -0,0 +1,247 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/timer_wheel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "turbo/base/bits.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+constexpr int TimerWheel::kSlotBits;
+constexpr int TimerWheel::kSlots;
+constexpr int TimerWheel::kLevels;
+constexpr uint32_t TimerWheel::kNone;
+
+TimerWheel::TimerWheel(const TimerWheelOptions& options)
+    : tick_(options.tick), clock_(options.clock), start_(options.clock()) {
+  assert(tick_ > turbo::ZeroDuration());
+  for (auto& level : slots_) {
+    for (uint32_t& slot : level) slot = kNone;
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  if (thread_ != nullptr) {
+    {
+      turbo::MutexLock l(&thread_mu_);
+      stopping_ = true;
+    }
+    thread_->join();
+  }
+}
+
+int64_t TimerWheel::ToTicks(turbo::Time t, bool round_up) const {
+  // Far enough for any deadline, and close enough to the range of int64_t
+  // for the arithmetic of the levels not to overflow.
+  constexpr int64_t kMaxTicks = int64_t{1} << 62;
+  if (t <= start_) return 0;
+  turbo::Duration rem;
+  const int64_t ticks = turbo::IDivDuration(t - start_, tick_, &rem);
+  if (ticks >= kMaxTicks) return kMaxTicks;
+  return round_up && rem > turbo::ZeroDuration() ? ticks + 1 : ticks;
+}
+
+void TimerWheel::Link(uint32_t index) {
+  Node& node = nodes_[index];
+  // Timers expiring within the next 64 ticks are kept per tick, and others in
+  // the level of their distance, by the bits of their expiry for that level.
+  // A slot of level L is emptied again when the lower levels wrap around to
+  // it, 64^L ticks before the earliest expiry it may hold.
+  int64_t expiry = node.expiry;
+  int level = 0;
+  const uint64_t delta = static_cast<uint64_t>(expiry - current_tick_);
+  if (delta >= kSlots) {
+    level = (63 - turbo::countl_zero(delta)) / kSlotBits;
+    if (level >= kLevels) {
+      level = kLevels - 1;
+      expiry = current_tick_ +
+               (int64_t{1} << (kSlotBits * kLevels)) - 1;
+    }
+  }
+  const int slot =
+      static_cast<int>(expiry >> (kSlotBits * level)) & (kSlots - 1);
+  uint32_t* head = &slots_[level][slot];
+  node.head = head;
+  node.prev = kNone;
+  node.next = *head;
+  if (*head != kNone) nodes_[*head].prev = index;
+  *head = index;
+  occupied_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+  Node& node = nodes_[index];
+  if (node.prev != kNone) {
+    nodes_[node.prev].next = node.next;
+  } else {
+    *node.head = node.next;
+    if (node.next == kNone) {
+      const auto pos = static_cast<size_t>(node.head - &slots_[0][0]);
+      occupied_[pos / kSlots] &= ~(uint64_t{1} << (pos % kSlots));
+    }
+  }
+  if (node.next != kNone) nodes_[node.next].prev = node.prev;
+  node.head = nullptr;
+}
+
+void TimerWheel::Release(uint32_t index) {
+  Node& node = nodes_[index];
+  node.head = nullptr;
+  ++node.generation;
+  node.next = free_;
+  free_ = index;
+  --size_;
+}
+
+uint32_t TimerWheel::TakeSlot(int level, int slot) {
+  const uint32_t first = slots_[level][slot];
+  slots_[level][slot] = kNone;
+  occupied_[level] &= ~(uint64_t{1} << slot);
+  return first;
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(turbo::Time deadline,
+                                         Callback callback) {
+  turbo::MutexLock l(&mu_);
+  uint32_t index = free_;
+  if (index != kNone) {
+    free_ = nodes_[index].next;
+  } else {
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  }
+  Node& node = nodes_[index];
+  node.callback = std::move(callback);
+  node.expiry = std::max(ToTicks(deadline, true), current_tick_ + 1);
+  Link(index);
+  ++size_;
+  return (uint64_t{node.generation} << 32) | (index + 1);
+}
+
+TimerWheel::TimerId TimerWheel::ScheduleAfter(turbo::Duration delay,
+                                              Callback callback) {
+  return Schedule(clock_() + delay, std::move(callback));
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+  const uint32_t index = static_cast<uint32_t>(id) - 1;
+  Callback callback;
+  {
+    turbo::MutexLock l(&mu_);
+    if (index >= nodes_.size()) return false;
+    Node& node = nodes_[index];
+    if (node.head == nullptr || node.generation != (id >> 32)) return false;
+    Unlink(index);
+    callback = std::move(node.callback);
+    Release(index);
+  }
+  // `callback` is destroyed without the lock held.
+  return true;
+}
+
+void TimerWheel::Expire(turbo::Time now, std::vector<Callback>* expired) {
+  const int64_t target = ToTicks(now, false);
+  turbo::MutexLock l(&mu_);
+  while (current_tick_ < target) {
+    // Finds the next tick which expires or moves timers: the next occupied
+    // slot of the first level, or the next wrap around to an occupied slot of
+    // another level.
+    int64_t tick = target + 1;
+    for (int level = 0; level < kLevels; ++level) {
+      const uint64_t occupied = occupied_[level];
+      if (occupied == 0) continue;
+      const int shift = kSlotBits * level;
+      const int64_t unit = (current_tick_ >> shift) + 1;
+      const int rotation = static_cast<int>(unit & (kSlots - 1));
+      const uint64_t rotated =
+          rotation == 0 ? occupied
+                        : (occupied >> rotation) |
+                              (occupied << (kSlots - rotation));
+      tick = std::min(tick, (unit + turbo::countr_zero(rotated)) << shift);
+    }
+    if (tick > target) break;
+    current_tick_ = tick;
+    for (int level = 1; level < kLevels; ++level) {
+      const int shift = kSlotBits * level;
+      if ((tick & ((int64_t{1} << shift) - 1)) != 0) break;
+      const int slot = static_cast<int>(tick >> shift) & (kSlots - 1);
+      for (uint32_t i = TakeSlot(level, slot); i != kNone;) {
+        const uint32_t next = nodes_[i].next;
+        Link(i);
+        i = next;
+      }
+    }
+    const int slot = static_cast<int>(tick & (kSlots - 1));
+    for (uint32_t i = TakeSlot(0, slot); i != kNone;) {
+      Node& node = nodes_[i];
+      const uint32_t next = node.next;
+      expired->push_back(std::move(node.callback));
+      Release(i);
+      i = next;
+    }
+  }
+  current_tick_ = std::max(current_tick_, target);
+}
+
+size_t TimerWheel::Advance(turbo::Time now) {
+  std::vector<Callback> expired;
+  Expire(now, &expired);
+  for (Callback& callback : expired) std::move(callback)();
+  return expired.size();
+}
+
+void TimerWheel::StartThread(Executor executor) {
+  assert(thread_ == nullptr);
+  executor_ = std::move(executor);
+  thread_.reset(new std::thread(&TimerWheel::ThreadLoop, this));
+}
+
+void TimerWheel::ThreadLoop() {
+  std::vector<Callback> expired;
+  while (true) {
+    {
+      turbo::MutexLock l(&thread_mu_);
+      if (thread_mu_.AwaitWithTimeout(turbo::Condition(&stopping_), tick_)) {
+        return;
+      }
+    }
+    Expire(clock_(), &expired);
+    for (Callback& callback : expired) {
+      if (executor_ != nullptr) {
+        executor_(std::move(callback));
+      } else {
+        std::move(callback)();
+      }
+    }
+    expired.clear();
+  }
+}
+
+size_t TimerWheel::size() const {
+  turbo::MutexLock l(&mu_);
+  return size_;
+}
+
+turbo::Time TimerWheel::now() const {
+  turbo::MutexLock l(&mu_);
+  return start_ + tick_ * current_tick_;
+}
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
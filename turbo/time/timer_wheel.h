@@ -0,0 +1,195 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: timer_wheel.h
+// -----------------------------------------------------------------------------
+//
+// This header file defines `turbo::TimerWheel`, which runs callbacks at
+// deadlines, for programs with very many pending deadlines, most of which are
+// cancelled before they expire, such as the idle timeouts of connections.
+//
+// A `TimerWheel` is a hierarchical hashed timing wheel: time is divided into
+// ticks, and timers are kept in lists per tick for the next 64 ticks, per 64
+// ticks for the next 4096 ticks, and so on. Scheduling and cancelling a timer
+// take constant time, and expiring timers takes constant time per timer and
+// per tick. Deadlines are rounded up to the next tick.
+//
+// The wheel is driven either by calls to `Advance()`, or by a thread of its
+// own started with `StartThread()`.
+//
+// Example:
+//
+//   turbo::TimerWheel wheel;
+//   wheel.StartThread();
+//   turbo::TimerWheel::TimerId id = wheel.ScheduleAfter(
+//       turbo::Seconds(30), [conn] { conn->CloseIdle(); });
+//   ...
+//   // Activity on the connection: push its timeout back.
+//   wheel.Cancel(id);
+//   id = wheel.ScheduleAfter(turbo::Seconds(30),
+//                            [conn] { conn->CloseIdle(); });
+
+#ifndef TURBO_TIME_TIMER_WHEEL_H_
+#define TURBO_TIME_TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "turbo/meta/any_invocable.h"
+#include "turbo/platform/port.h"
+#include "turbo/platform/thread_annotations.h"
+#include "turbo/synchronization/mutex.h"
+#include "turbo/time/clock.h"
+#include "turbo/time/time.h"
+
+namespace turbo {
+TURBO_NAMESPACE_BEGIN
+
+// TimerWheelOptions
+//
+// The configuration of a `turbo::TimerWheel`.
+struct TimerWheelOptions {
+  // The resolution of the wheel. Timers expire at most one tick late when the
+  // wheel is advanced every tick.
+  turbo::Duration tick = turbo::Milliseconds(1);
+
+  // The clock of `ScheduleAfter()` and of the thread of the wheel, which also
+  // gives the start time of the wheel. `turbo::CoarseNow` is cheaper than the
+  // default when the tick is a millisecond or more.
+  turbo::Time (*clock)() = turbo::Now;
+};
+
+// TimerWheel
+//
+// Runs callbacks at or after their deadlines. Thread-safe.
+//
+// The callbacks of expired timers run in the thread which advances the wheel,
+// without any lock held, so they may schedule and cancel timers.
+class TimerWheel {
+ public:
+  // Identifies a scheduled timer. Never zero.
+  using TimerId = uint64_t;
+  using Callback = turbo::AnyInvocable<void()>;
+  // Runs the callbacks of expired timers for the thread of the wheel.
+  using Executor = turbo::AnyInvocable<void(Callback)>;
+
+  TimerWheel() : TimerWheel(TimerWheelOptions()) {}
+  explicit TimerWheel(const TimerWheelOptions& options);
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Stops the thread of the wheel, if any. Pending timers are dropped without
+  // running their callbacks.
+  ~TimerWheel();
+
+  // Schedule()
+  //
+  // Schedules `callback` to run once the wheel has advanced to `deadline`,
+  // rounded up to the next tick. Deadlines in the past expire with the next
+  // tick.
+  TimerId Schedule(turbo::Time deadline, Callback callback);
+
+  // ScheduleAfter()
+  //
+  // Schedules `callback` to run after `delay` from now, by the clock of the
+  // wheel.
+  TimerId ScheduleAfter(turbo::Duration delay, Callback callback);
+
+  // Cancel()
+  //
+  // Cancels the timer `id` and destroys its callback. Returns false if the
+  // timer has already expired or been cancelled, in which case its callback
+  // may be running, or about to.
+  bool Cancel(TimerId id);
+
+  // Advance()
+  //
+  // Expires the timers with deadlines up to `now`, and runs their callbacks
+  // in the order of their deadlines, tick by tick. Returns the number of
+  // callbacks run. Times before the current time of the wheel are ignored.
+  size_t Advance(turbo::Time now);
+
+  // StartThread()
+  //
+  // Starts a thread which advances the wheel by its clock every tick, and
+  // passes the callbacks of expired timers to `executor`, or runs them itself
+  // when `executor` is null. May be called at most once.
+  void StartThread(Executor executor = nullptr);
+
+  // size()
+  //
+  // Returns the number of pending timers.
+  size_t size() const;
+
+  // now()
+  //
+  // Returns the time the wheel has advanced to.
+  turbo::Time now() const;
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  // 64^6 ticks, over two years of 1 ms ticks. Timers beyond are kept in the
+  // furthest slot, and rescheduled when it is reached.
+  static constexpr int kLevels = 6;
+  static constexpr uint32_t kNone = ~uint32_t{0};
+
+  struct Node {
+    Callback callback;
+    int64_t expiry = 0;  // In ticks.
+    uint32_t generation = 0;
+    uint32_t prev = kNone;
+    uint32_t next = kNone;  // Also links the free list.
+    uint32_t* head = nullptr;  // The list of the node, null if free.
+  };
+
+  int64_t ToTicks(turbo::Time t, bool round_up) const;
+  void Link(uint32_t index) TURBO_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Unlink(uint32_t index) TURBO_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Release(uint32_t index) TURBO_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Takes the list of a slot, to link its nodes again.
+  uint32_t TakeSlot(int level, int slot) TURBO_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Moves the callbacks of the timers expired up to `now` to `expired`.
+  void Expire(turbo::Time now, std::vector<Callback>* expired)
+      TURBO_LOCKS_EXCLUDED(mu_);
+  void ThreadLoop();
+
+  const turbo::Duration tick_;
+  turbo::Time (*const clock_)();
+  const turbo::Time start_;
+
+  mutable turbo::Mutex mu_;
+  int64_t current_tick_ TURBO_GUARDED_BY(mu_) = 0;
+  size_t size_ TURBO_GUARDED_BY(mu_) = 0;
+  std::vector<Node> nodes_ TURBO_GUARDED_BY(mu_);
+  uint32_t free_ TURBO_GUARDED_BY(mu_) = kNone;
+  // The first node of each slot, and a bit per non-empty slot.
+  uint32_t slots_[kLevels][kSlots] TURBO_GUARDED_BY(mu_);
+  uint64_t occupied_[kLevels] TURBO_GUARDED_BY(mu_) = {};
+
+  turbo::Mutex thread_mu_;
+  bool stopping_ TURBO_GUARDED_BY(thread_mu_) = false;
+  Executor executor_;
+  std::unique_ptr<std::thread> thread_;
+};
+
+TURBO_NAMESPACE_END
+}  // namespace turbo
+
+#endif  // TURBO_TIME_TIMER_WHEEL_H_
@@ -0,0 +1,158 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/timer_wheel.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "turbo/time/time.h"
+
+namespace {
+
+// The benchmarks keep state.range(0) timers pending, with deadlines spread
+// over the next minute in 1 ms ticks, like the idle timeouts of as many
+// connections. Each "Reschedule" iteration pushes back the deadline of one
+// timer, and each "Expire" iteration advances by one tick. They compare the
+// wheel with a multimap of deadlines.
+
+const turbo::Time kStart = turbo::FromUnixSeconds(1700000000);
+
+turbo::Time StartClock() { return kStart; }
+
+std::vector<int64_t> Deadlines(int64_t n) {
+  std::mt19937_64 gen(42);
+  std::vector<int64_t> deadlines(n);
+  for (int64_t& d : deadlines) d = static_cast<int64_t>(gen() % 60000);
+  return deadlines;
+}
+
+turbo::TimerWheelOptions BenchmarkOptions() {
+  turbo::TimerWheelOptions options;
+  options.clock = StartClock;
+  return options;
+}
+
+void BM_TimerWheel_Schedule(benchmark::State& state) {
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  for (auto _ : state) {
+    turbo::TimerWheel wheel(BenchmarkOptions());
+    for (int64_t d : deadlines) {
+      wheel.Schedule(kStart + turbo::Milliseconds(d), [] {});
+    }
+    benchmark::DoNotOptimize(wheel.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimerWheel_Schedule)->Range(1 << 10, 1 << 20);
+
+void BM_Multimap_Schedule(benchmark::State& state) {
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  for (auto _ : state) {
+    std::multimap<turbo::Time, std::function<void()>> timers;
+    for (int64_t d : deadlines) {
+      timers.emplace(kStart + turbo::Milliseconds(d), [] {});
+    }
+    benchmark::DoNotOptimize(timers.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Multimap_Schedule)->Range(1 << 10, 1 << 20);
+
+void BM_TimerWheel_Reschedule(benchmark::State& state) {
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  turbo::TimerWheel wheel(BenchmarkOptions());
+  std::vector<turbo::TimerWheel::TimerId> ids;
+  for (int64_t d : deadlines) {
+    ids.push_back(wheel.Schedule(kStart + turbo::Milliseconds(d), [] {}));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    wheel.Cancel(ids[i]);
+    ids[i] = wheel.Schedule(kStart + turbo::Milliseconds(60000), [] {});
+    if (++i == ids.size()) i = 0;
+  }
+}
+BENCHMARK(BM_TimerWheel_Reschedule)->Range(1 << 10, 1 << 20);
+
+void BM_Multimap_Reschedule(benchmark::State& state) {
+  using Timers = std::multimap<turbo::Time, std::function<void()>>;
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  Timers timers;
+  std::vector<Timers::iterator> ids;
+  for (int64_t d : deadlines) {
+    ids.push_back(timers.emplace(kStart + turbo::Milliseconds(d), [] {}));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    timers.erase(ids[i]);
+    ids[i] = timers.emplace(kStart + turbo::Milliseconds(60000), [] {});
+    if (++i == ids.size()) i = 0;
+  }
+}
+BENCHMARK(BM_Multimap_Reschedule)->Range(1 << 10, 1 << 20);
+
+// Each expired timer is scheduled again a minute later.
+void BM_TimerWheel_Expire(benchmark::State& state) {
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  turbo::TimerWheel wheel(BenchmarkOptions());
+  std::function<void()> reschedule = [&] {
+    wheel.Schedule(wheel.now() + turbo::Minutes(1), reschedule);
+  };
+  for (int64_t d : deadlines) {
+    wheel.Schedule(kStart + turbo::Milliseconds(d), reschedule);
+  }
+  int64_t expired = 0;
+  turbo::Time now = kStart;
+  for (auto _ : state) {
+    now += turbo::Milliseconds(1);
+    expired += static_cast<int64_t>(wheel.Advance(now));
+  }
+  state.SetItemsProcessed(expired);
+}
+BENCHMARK(BM_TimerWheel_Expire)->Range(1 << 10, 1 << 20);
+
+void BM_Multimap_Expire(benchmark::State& state) {
+  using Timers = std::multimap<turbo::Time, std::function<void()>>;
+  const std::vector<int64_t> deadlines = Deadlines(state.range(0));
+  Timers timers;
+  turbo::Time now = kStart;
+  std::function<void()> reschedule = [&] {
+    timers.emplace(now + turbo::Minutes(1), reschedule);
+  };
+  for (int64_t d : deadlines) {
+    timers.emplace(kStart + turbo::Milliseconds(d), reschedule);
+  }
+  int64_t expired = 0;
+  std::vector<std::function<void()>> callbacks;
+  for (auto _ : state) {
+    now += turbo::Milliseconds(1);
+    auto end = timers.upper_bound(now);
+    for (auto it = timers.begin(); it != end; ++it) {
+      callbacks.push_back(std::move(it->second));
+    }
+    timers.erase(timers.begin(), end);
+    for (auto& callback : callbacks) callback();
+    expired += static_cast<int64_t>(callbacks.size());
+    callbacks.clear();
+  }
+  state.SetItemsProcessed(expired);
+}
+BENCHMARK(BM_Multimap_Expire)->Range(1 << 10, 1 << 20);
+
+}  // namespace
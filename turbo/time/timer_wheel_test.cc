@@ -0,0 +1,193 @@
+// Copyright 2023 The Turbo Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "turbo/time/timer_wheel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "turbo/synchronization/notification.h"
+#include "turbo/time/clock.h"
+#include "turbo/time/time.h"
+
+namespace {
+
+const turbo::Time kStart = turbo::FromUnixSeconds(1700000000);
+
+turbo::Time StartClock() { return kStart; }
+
+turbo::TimerWheelOptions TestOptions() {
+  turbo::TimerWheelOptions options;
+  options.tick = turbo::Milliseconds(1);
+  options.clock = StartClock;
+  return options;
+}
+
+TEST(TimerWheel, ExpiresAtDeadline) {
+  turbo::TimerWheel wheel(TestOptions());
+  std::vector<int> fired;
+  wheel.Schedule(kStart + turbo::Milliseconds(5), [&] { fired.push_back(5); });
+  wheel.Schedule(kStart + turbo::Microseconds(2500),
+                 [&] { fired.push_back(3); });
+  wheel.Schedule(kStart + turbo::Seconds(10), [&] { fired.push_back(10000); });
+  EXPECT_EQ(3, wheel.size());
+
+  EXPECT_EQ(0, wheel.Advance(kStart + turbo::Microseconds(2999)));
+  EXPECT_EQ(1, wheel.Advance(kStart + turbo::Milliseconds(3)));
+  EXPECT_EQ(std::vector<int>({3}), fired);
+  EXPECT_EQ(0, wheel.Advance(kStart + turbo::Milliseconds(4)));
+  EXPECT_EQ(1, wheel.Advance(kStart + turbo::Seconds(9)));
+  EXPECT_EQ(std::vector<int>({3, 5}), fired);
+  EXPECT_EQ(kStart + turbo::Seconds(9), wheel.now());
+  EXPECT_EQ(1, wheel.Advance(kStart + turbo::Seconds(11)));
+  EXPECT_EQ(std::vector<int>({3, 5, 10000}), fired);
+  EXPECT_EQ(0, wheel.size());
+}
+
+TEST(TimerWheel, PastDeadlinesExpireWithTheNextTick) {
+  turbo::TimerWheel wheel(TestOptions());
+  wheel.Advance(kStart + turbo::Seconds(1));
+  int fired = 0;
+  wheel.Schedule(kStart, [&] { ++fired; });
+  wheel.Schedule(turbo::InfinitePast(), [&] { ++fired; });
+  EXPECT_EQ(0, wheel.Advance(kStart + turbo::Seconds(1)));
+  EXPECT_EQ(2, wheel.Advance(kStart + turbo::Seconds(1) +
+                             turbo::Milliseconds(1)));
+  EXPECT_EQ(2, fired);
+}
+
+TEST(TimerWheel, Cancel) {
+  turbo::TimerWheel wheel(TestOptions());
+  int fired = 0;
+  const turbo::TimerWheel::TimerId a =
+      wheel.Schedule(kStart + turbo::Milliseconds(10), [&] { ++fired; });
+  const turbo::TimerWheel::TimerId b =
+      wheel.Schedule(kStart + turbo::Milliseconds(10), [&] { ++fired; });
+  EXPECT_NE(a, b);
+  EXPECT_TRUE(wheel.Cancel(a));
+  EXPECT_FALSE(wheel.Cancel(a));
+  EXPECT_FALSE(wheel.Cancel(0));
+  EXPECT_EQ(1, wheel.size());
+
+  // The node of `a` is reused, under another id.
+  const turbo::TimerWheel::TimerId c =
+      wheel.Schedule(kStart + turbo::Hours(1), [&] { ++fired; });
+  EXPECT_NE(a, c);
+  EXPECT_FALSE(wheel.Cancel(a));
+
+  EXPECT_EQ(1, wheel.Advance(kStart + turbo::Seconds(1)));
+  EXPECT_EQ(1, fired);
+  EXPECT_FALSE(wheel.Cancel(b));
+  EXPECT_TRUE(wheel.Cancel(c));
+  EXPECT_EQ(0, wheel.size());
+}
+
+TEST(TimerWheel, CallbacksScheduleAndCancel) {
+  turbo::TimerWheel wheel(TestOptions());
+  int fired = 0;
+  turbo::TimerWheel::TimerId later = 0;
+  later = wheel.Schedule(kStart + turbo::Milliseconds(2), [&] { ++fired; });
+  wheel.Schedule(kStart + turbo::Milliseconds(1), [&] {
+    EXPECT_TRUE(wheel.Cancel(later));
+    wheel.Schedule(kStart + turbo::Milliseconds(3), [&] { fired += 10; });
+  });
+  wheel.Advance(kStart + turbo::Milliseconds(1));
+  EXPECT_EQ(1, wheel.size());
+  wheel.Advance(kStart + turbo::Milliseconds(3));
+  EXPECT_EQ(10, fired);
+}
+
+TEST(TimerWheel, BeyondTheLastLevel) {
+  turbo::TimerWheel wheel(TestOptions());
+  int fired = 0;
+  wheel.Schedule(kStart + turbo::Hours(24 * 1000), [&] { ++fired; });
+  wheel.Schedule(turbo::InfiniteFuture(), [&] { ++fired; });
+  // Sleeps through the first wrap around of all levels.
+  wheel.Advance(kStart + turbo::Milliseconds(int64_t{1} << 36));
+  EXPECT_EQ(0, fired);
+  wheel.Advance(kStart + turbo::Hours(24 * 1000) - turbo::Milliseconds(1));
+  EXPECT_EQ(0, fired);
+  wheel.Advance(kStart + turbo::Hours(24 * 1000));
+  EXPECT_EQ(1, fired);
+  EXPECT_EQ(1, wheel.size());
+}
+
+// Compares the wheel with a multimap of deadlines, for deadlines spread over
+// all levels, with cancellations and advances of random lengths.
+TEST(TimerWheel, MatchesReference) {
+  turbo::TimerWheel wheel(TestOptions());
+  std::mt19937_64 gen(42);
+  std::multimap<int64_t, turbo::TimerWheel::TimerId> pending;
+  std::deque<turbo::TimerWheel::TimerId> ids;
+  std::vector<turbo::TimerWheel::TimerId> fired;
+  int64_t now = 0;
+  for (int round = 0; round < 2000; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      const int64_t deadline =
+          now + static_cast<int64_t>(gen() % (uint64_t{1} << (gen() % 32)));
+      ids.emplace_back();
+      turbo::TimerWheel::TimerId* id = &ids.back();
+      *id = wheel.Schedule(kStart + turbo::Milliseconds(deadline),
+                           [&fired, id] { fired.push_back(*id); });
+      pending.emplace(std::max(deadline, now + 1), *id);
+    }
+    for (int i = 0; i < 20 && !pending.empty(); ++i) {
+      auto it = pending.begin();
+      std::advance(it, gen() % pending.size());
+      ASSERT_TRUE(wheel.Cancel(it->second));
+      pending.erase(it);
+    }
+    now += static_cast<int64_t>(gen() % (uint64_t{1} << (gen() % 24)));
+    fired.clear();
+    wheel.Advance(kStart + turbo::Milliseconds(now));
+    std::vector<turbo::TimerWheel::TimerId> expected;
+    for (auto it = pending.begin(); it != pending.end() && it->first <= now;) {
+      expected.push_back(it->second);
+      it = pending.erase(it);
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(fired.begin(), fired.end());
+    ASSERT_EQ(expected, fired) << "round " << round;
+    ASSERT_EQ(pending.size(), wheel.size());
+  }
+}
+
+TEST(TimerWheel, Thread) {
+  turbo::TimerWheelOptions options;
+  options.clock = turbo::CoarseNow;
+  turbo::TimerWheel wheel(options);
+  std::atomic<int> executed{0};
+  wheel.StartThread([&](turbo::TimerWheel::Callback callback) {
+    ++executed;
+    std::move(callback)();
+  });
+  turbo::Notification done;
+  const turbo::Time before = turbo::CoarseNow();
+  wheel.ScheduleAfter(turbo::Milliseconds(20), [&] { done.Notify(); });
+  const turbo::TimerWheel::TimerId cancelled =
+      wheel.ScheduleAfter(turbo::Milliseconds(10), [] { FAIL(); });
+  EXPECT_TRUE(wheel.Cancel(cancelled));
+  done.WaitForNotification();
+  EXPECT_GE(turbo::CoarseNow() - before, turbo::Milliseconds(19));
+  EXPECT_EQ(1, executed.load());
+}
+
+}  // namespace